@@ -79,6 +79,14 @@ let package = Package(
                 "TestSupportObjc"
             ]
         ),
+        .testTarget(
+            name: "EmbraceLoadTests",
+            dependencies: [
+                "EmbraceCore",
+                "TestSupport"
+            ],
+            exclude: ["README.md"]
+        ),
 
         // core ----------------------------------------------------------------------
         .target(
@@ -219,6 +227,7 @@ let package = Package(
             dependencies: [
                 "EmbraceCommonInternal",
                 "EmbraceCoreDataInternal",
+                "EmbraceSQLiteInternal",
                 "EmbraceSemantics"
             ]
         ),
@@ -236,7 +245,8 @@ let package = Package(
             dependencies: [
                 "EmbraceCommonInternal",
                 "EmbraceOTelInternal",
-                "EmbraceCoreDataInternal"
+                "EmbraceCoreDataInternal",
+                "EmbraceSQLiteInternal"
             ]
         ),
         .testTarget(
@@ -245,6 +255,7 @@ let package = Package(
                 "EmbraceUploadInternal",
                 "EmbraceOTelInternal",
                 "EmbraceCoreDataInternal",
+                "EmbraceSQLiteInternal",
                 "TestSupport"
             ]
         ),
@@ -265,6 +276,30 @@ let package = Package(
             ]
         ),
 
+        // sqlite ----------------------------------------------------------------------
+        // Foundation + system SQLite only, so it builds and tests on Linux too.
+        .target(
+            name: "EmbraceSQLiteInternal",
+            dependencies: [
+                .target(name: "CSQLite", condition: .when(platforms: [.linux]))
+            ],
+            linkerSettings: [
+                .linkedLibrary("sqlite3")
+            ]
+        ),
+        .systemLibrary(
+            name: "CSQLite",
+            path: "Sources/CSQLite",
+            pkgConfig: "sqlite3",
+            providers: [
+                .apt(["libsqlite3-dev"])
+            ]
+        ),
+        .testTarget(
+            name: "EmbraceSQLiteInternalTests",
+            dependencies: ["EmbraceSQLiteInternal"]
+        ),
+
         // macros support -----------------------------------------------------------
         .macro(
             name: "EmbraceMacroPlugin",
@@ -287,6 +322,9 @@ let package = Package(
             dependencies: [
                 "EmbraceMacroPlugin",
                 "EmbraceIO",
+                .product(name: "SwiftDiagnostics", package: "swift-syntax"),
+                .product(name: "SwiftParser", package: "swift-syntax"),
+                .product(name: "SwiftSyntaxMacroExpansion", package: "swift-syntax"),
                 .product(name: "SwiftSyntaxMacrosTestSupport", package: "swift-syntax")
             ]
         ),
@@ -0,0 +1,8 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+// Exposes the system SQLite to Swift on platforms without an `SQLite3` module (Linux).
+// Apple platforms import `SQLite3` directly.
+
+#include <sqlite3.h>
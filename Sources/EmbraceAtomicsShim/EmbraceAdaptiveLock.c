@@ -0,0 +1,150 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "EmbraceAdaptiveLock.h"
+#include "EmbraceSpin.h"
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(__APPLE__)
+#include <os/lock.h>
+#elif defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <sched.h>
+#endif
+
+#define EMB_SPIN_LIMIT 1000
+
+struct emb_adaptive_lock {
+#if defined(__APPLE__)
+    os_unfair_lock lock;
+#else
+    // 0: unlocked, 1: locked, 2: locked and there may be parked waiters.
+    _Atomic(uint32_t) state;
+#endif
+    // Moving average of the spins it took to get the lock, when spinning got it.
+    _Atomic(int32_t) spins;
+};
+
+emb_adaptive_lock_t *emb_adaptive_lock_create(void)
+{
+    emb_adaptive_lock_t *lock = malloc(sizeof(emb_adaptive_lock_t));
+    if (lock) {
+#if defined(__APPLE__)
+        lock->lock = OS_UNFAIR_LOCK_INIT;
+#else
+        atomic_init(&lock->state, 0);
+#endif
+        atomic_init(&lock->spins, 0);
+    }
+    return lock;
+}
+
+void emb_adaptive_lock_destroy(emb_adaptive_lock_t *lock) { free(lock); }
+
+// MARK: - Platform
+
+#if defined(__APPLE__)
+
+static inline bool emb_try_acquire(emb_adaptive_lock_t *lock) { return os_unfair_lock_trylock(&lock->lock); }
+
+static inline void emb_park(emb_adaptive_lock_t *lock) { os_unfair_lock_lock(&lock->lock); }
+
+static inline void emb_release(emb_adaptive_lock_t *lock) { os_unfair_lock_unlock(&lock->lock); }
+
+#else
+
+static inline bool emb_try_acquire(emb_adaptive_lock_t *lock)
+{
+    // Test before test-and-set, so spinning waiters only read the cache line.
+    uint32_t expected = 0;
+    return atomic_load_explicit(&lock->state, memory_order_relaxed) == 0 &&
+           atomic_compare_exchange_strong_explicit(&lock->state, &expected, 1, memory_order_acquire,
+                                                   memory_order_relaxed);
+}
+
+static inline void emb_wait(_Atomic(uint32_t) *address, uint32_t value)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, (uint32_t *)address, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+#else
+    (void)address;
+    (void)value;
+    sched_yield();
+#endif
+}
+
+static inline void emb_wake_one(_Atomic(uint32_t) *address)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, (uint32_t *)address, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#else
+    (void)address;
+#endif
+}
+
+// Drepper's "Futexes Are Tricky" mutex: waiters mark the lock contended (2) before
+// sleeping, so an unlock only makes a syscall when someone may be parked.
+static void emb_park(emb_adaptive_lock_t *lock)
+{
+    uint32_t state = atomic_exchange_explicit(&lock->state, 2, memory_order_acquire);
+    while (state != 0) {
+        emb_wait(&lock->state, 2);
+        state = atomic_exchange_explicit(&lock->state, 2, memory_order_acquire);
+    }
+}
+
+static inline void emb_release(emb_adaptive_lock_t *lock)
+{
+    if (atomic_exchange_explicit(&lock->state, 0, memory_order_release) == 2) {
+        emb_wake_one(&lock->state);
+    }
+}
+
+#endif
+
+// MARK: - Lock
+
+void emb_adaptive_lock_lock(emb_adaptive_lock_t *lock)
+{
+    if (emb_try_acquire(lock)) {
+        return;
+    }
+
+    int32_t average = atomic_load_explicit(&lock->spins, memory_order_relaxed);
+    int32_t limit = average * 2 + 16;
+    if (limit > EMB_SPIN_LIMIT) {
+        limit = EMB_SPIN_LIMIT;
+    }
+
+    for (int32_t spins = 1; spins <= limit; spins++) {
+        emb_cpu_relax();
+        if (emb_try_acquire(lock)) {
+            atomic_store_explicit(&lock->spins, average + (spins - average) / 8, memory_order_relaxed);
+            return;
+        }
+    }
+
+    // Spinning didn't pay off, so spin less next time. Rounded up so the average reaches 0.
+    atomic_store_explicit(&lock->spins, average - (average + 7) / 8, memory_order_relaxed);
+    emb_park(lock);
+}
+
+bool emb_adaptive_lock_trylock(emb_adaptive_lock_t *lock) { return emb_try_acquire(lock); }
+
+void emb_adaptive_lock_unlock(emb_adaptive_lock_t *lock) { emb_release(lock); }
+
+int32_t emb_adaptive_lock_spin_average(emb_adaptive_lock_t *lock)
+{
+    return atomic_load_explicit(&lock->spins, memory_order_relaxed);
+}
@@ -55,3 +55,51 @@ EMB_DEFINE_ATOMIC_TYPE(uint64_t, uint64)
 EMB_DEFINE_ATOMIC_TYPE(double, double)
 
 EMB_DEFINE_ATOMIC_TYPE(bool, bool)
+
+void emb_atomic_ptr_init(emb_atomic_ptr_t *a, void *value) { atomic_store_explicit(&a->v, value, memory_order_relaxed); }
+
+void *emb_atomic_ptr_load(const emb_atomic_ptr_t *a, EMBAtomicMemoryOrder order)
+{
+    return atomic_load_explicit(&a->v, (memory_order)order);
+}
+
+void emb_atomic_ptr_store(emb_atomic_ptr_t *a, void *value, EMBAtomicMemoryOrder order)
+{
+    atomic_store_explicit(&a->v, value, (memory_order)order);
+}
+
+void *emb_atomic_ptr_exchange(emb_atomic_ptr_t *a, void *value, EMBAtomicMemoryOrder order)
+{
+    return atomic_exchange_explicit(&a->v, value, (memory_order)order);
+}
+
+bool emb_atomic_ptr_compare_exchange(emb_atomic_ptr_t *a, void **expected, void *desired,
+                                     EMBAtomicMemoryOrder successOrder, EMBAtomicMemoryOrder failureOrder)
+{
+    return atomic_compare_exchange_strong_explicit(&a->v, expected, desired, (memory_order)successOrder,
+                                                   (memory_order)failureOrder);
+}
+
+void emb_atomic_tagged_ptr_init(emb_atomic_tagged_ptr_t *a, emb_tagged_ptr_t value)
+{
+    atomic_store_explicit(&a->v, value, memory_order_relaxed);
+}
+
+emb_tagged_ptr_t emb_atomic_tagged_ptr_load(emb_atomic_tagged_ptr_t *a, EMBAtomicMemoryOrder order)
+{
+    return atomic_load_explicit(&a->v, (memory_order)order);
+}
+
+bool emb_atomic_tagged_ptr_compare_exchange(emb_atomic_tagged_ptr_t *a, emb_tagged_ptr_t *expected,
+                                            emb_tagged_ptr_t desired, EMBAtomicMemoryOrder successOrder,
+                                            EMBAtomicMemoryOrder failureOrder)
+{
+    return atomic_compare_exchange_strong_explicit(&a->v, expected, desired, (memory_order)successOrder,
+                                                   (memory_order)failureOrder);
+}
+
+bool emb_atomic_tagged_ptr_is_lock_free(void)
+{
+    emb_atomic_tagged_ptr_t probe;
+    return atomic_is_lock_free(&probe.v);
+}
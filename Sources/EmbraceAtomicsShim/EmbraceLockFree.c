@@ -0,0 +1,462 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+// `posix_memalign` under strict C11.
+#if !defined(_POSIX_C_SOURCE) && !defined(__APPLE__)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "EmbraceLockFree.h"
+#include "EmbraceSpin.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Apple silicon uses 128 byte lines; padding to that also keeps x86 clear of adjacent line prefetching.
+#define EMB_CACHE_LINE 128
+
+static void *emb_aligned_calloc(size_t size)
+{
+    void *memory = NULL;
+    if (posix_memalign(&memory, EMB_CACHE_LINE, size) != 0) {
+        return NULL;
+    }
+    memset(memory, 0, size);
+    return memory;
+}
+
+static bool emb_is_power_of_two(size_t value) { return value > 0 && (value & (value - 1)) == 0; }
+
+// MARK: - SPSC ring
+
+struct emb_spsc_ring {
+    // Producer line: the tail it publishes and its last view of the consumer's head.
+    _Alignas(EMB_CACHE_LINE) _Atomic(size_t) tail;
+    size_t cachedHead;
+
+    // Consumer line: the head it publishes and its last view of the producer's tail.
+    _Alignas(EMB_CACHE_LINE) _Atomic(size_t) head;
+    size_t cachedTail;
+
+    _Alignas(EMB_CACHE_LINE) size_t capacity;
+};
+
+emb_spsc_ring_t *emb_spsc_ring_create(size_t capacity)
+{
+    if (!emb_is_power_of_two(capacity)) {
+        return NULL;
+    }
+
+    emb_spsc_ring_t *ring = emb_aligned_calloc(sizeof(emb_spsc_ring_t));
+    if (ring) {
+        atomic_init(&ring->tail, 0);
+        atomic_init(&ring->head, 0);
+        ring->capacity = capacity;
+    }
+    return ring;
+}
+
+void emb_spsc_ring_destroy(emb_spsc_ring_t *ring) { free(ring); }
+
+bool emb_spsc_ring_reserve(emb_spsc_ring_t *ring, size_t *position)
+{
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    if (tail - ring->cachedHead == ring->capacity) {
+        // Acquire pairs with the consumer's release, so it's done reading the slot we're about to reuse.
+        ring->cachedHead = atomic_load_explicit(&ring->head, memory_order_acquire);
+        if (tail - ring->cachedHead == ring->capacity) {
+            return false;
+        }
+    }
+
+    *position = tail;
+    return true;
+}
+
+void emb_spsc_ring_commit(emb_spsc_ring_t *ring, size_t position)
+{
+    atomic_store_explicit(&ring->tail, position + 1, memory_order_release);
+}
+
+bool emb_spsc_ring_peek(emb_spsc_ring_t *ring, size_t *position)
+{
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    if (head == ring->cachedTail) {
+        ring->cachedTail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        if (head == ring->cachedTail) {
+            return false;
+        }
+    }
+
+    *position = head;
+    return true;
+}
+
+void emb_spsc_ring_release(emb_spsc_ring_t *ring, size_t position)
+{
+    atomic_store_explicit(&ring->head, position + 1, memory_order_release);
+}
+
+size_t emb_spsc_ring_count(emb_spsc_ring_t *ring)
+{
+    // Head first: it never passes the tail, so this can't underflow.
+    size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    return tail - head;
+}
+
+// MARK: - Bounded MPSC queue
+
+// Slot `i` is free for position `p` when its sequence is `p`, and holds the element
+// for `p` when its sequence is `p + 1`. Releasing it sets the sequence to `p + capacity`,
+// the next position that maps to it.
+struct emb_mpsc_queue {
+    _Alignas(EMB_CACHE_LINE) _Atomic(size_t) tail;
+    _Alignas(EMB_CACHE_LINE) _Atomic(size_t) head;
+    _Alignas(EMB_CACHE_LINE) size_t mask;
+    _Atomic(size_t) *sequences;
+};
+
+emb_mpsc_queue_t *emb_mpsc_queue_create(size_t capacity)
+{
+    if (!emb_is_power_of_two(capacity)) {
+        return NULL;
+    }
+
+    emb_mpsc_queue_t *queue = emb_aligned_calloc(sizeof(emb_mpsc_queue_t));
+    if (!queue) {
+        return NULL;
+    }
+
+    queue->sequences = emb_aligned_calloc(capacity * sizeof(_Atomic(size_t)));
+    if (!queue->sequences) {
+        free(queue);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < capacity; i++) {
+        atomic_init(&queue->sequences[i], i);
+    }
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->head, 0);
+    queue->mask = capacity - 1;
+    return queue;
+}
+
+void emb_mpsc_queue_destroy(emb_mpsc_queue_t *queue)
+{
+    if (queue) {
+        free(queue->sequences);
+        free(queue);
+    }
+}
+
+bool emb_mpsc_queue_reserve(emb_mpsc_queue_t *queue, size_t *position)
+{
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    for (;;) {
+        size_t sequence = atomic_load_explicit(&queue->sequences[tail & queue->mask], memory_order_acquire);
+        intptr_t difference = (intptr_t)sequence - (intptr_t)tail;
+
+        if (difference == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->tail, &tail, tail + 1, memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                *position = tail;
+                return true;
+            }
+        } else if (difference < 0) {
+            // The slot still holds the element from a lap ago.
+            return false;
+        } else {
+            // Another producer took this position.
+            tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+        }
+    }
+}
+
+void emb_mpsc_queue_commit(emb_mpsc_queue_t *queue, size_t position)
+{
+    atomic_store_explicit(&queue->sequences[position & queue->mask], position + 1, memory_order_release);
+}
+
+bool emb_mpsc_queue_peek(emb_mpsc_queue_t *queue, size_t *position)
+{
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    size_t sequence = atomic_load_explicit(&queue->sequences[head & queue->mask], memory_order_acquire);
+    if (sequence != head + 1) {
+        return false;
+    }
+
+    *position = head;
+    return true;
+}
+
+void emb_mpsc_queue_release(emb_mpsc_queue_t *queue, size_t position)
+{
+    atomic_store_explicit(&queue->sequences[position & queue->mask], position + queue->mask + 1,
+                          memory_order_release);
+    atomic_store_explicit(&queue->head, position + 1, memory_order_relaxed);
+}
+
+size_t emb_mpsc_queue_count(emb_mpsc_queue_t *queue)
+{
+    size_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    return tail > head ? tail - head : 0;
+}
+
+// MARK: - Free-list
+
+// `head` and `next` hold `index + 1`, so 0 means none. The upper half of `head`
+// is bumped on every update, so a pop that read a stale `next` can't succeed.
+struct emb_free_list {
+    _Alignas(EMB_CACHE_LINE) _Atomic(uint64_t) head;
+    _Alignas(EMB_CACHE_LINE) uint32_t capacity;
+    _Atomic(uint32_t) *next;
+};
+
+static inline uint64_t emb_free_list_head(uint64_t previous, uint32_t top)
+{
+    return (((previous >> 32) + 1) << 32) | top;
+}
+
+emb_free_list_t *emb_free_list_create(uint32_t capacity)
+{
+    if (capacity == 0 || capacity == UINT32_MAX) {
+        return NULL;
+    }
+
+    emb_free_list_t *list = emb_aligned_calloc(sizeof(emb_free_list_t));
+    if (!list) {
+        return NULL;
+    }
+
+    list->next = emb_aligned_calloc(capacity * sizeof(_Atomic(uint32_t)));
+    if (!list->next) {
+        free(list);
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < capacity; i++) {
+        atomic_init(&list->next[i], i + 1 < capacity ? i + 2 : 0);
+    }
+    atomic_init(&list->head, 1);
+    list->capacity = capacity;
+    return list;
+}
+
+void emb_free_list_destroy(emb_free_list_t *list)
+{
+    if (list) {
+        free(list->next);
+        free(list);
+    }
+}
+
+bool emb_free_list_pop(emb_free_list_t *list, uint32_t *index)
+{
+    uint64_t head = atomic_load_explicit(&list->head, memory_order_acquire);
+    for (;;) {
+        uint32_t top = (uint32_t)head;
+        if (top == 0) {
+            return false;
+        }
+
+        uint32_t next = atomic_load_explicit(&list->next[top - 1], memory_order_relaxed);
+        if (atomic_compare_exchange_weak_explicit(&list->head, &head, emb_free_list_head(head, next),
+                                                  memory_order_acq_rel, memory_order_acquire)) {
+            *index = top - 1;
+            return true;
+        }
+    }
+}
+
+void emb_free_list_push(emb_free_list_t *list, uint32_t index)
+{
+    uint64_t head = atomic_load_explicit(&list->head, memory_order_relaxed);
+    for (;;) {
+        atomic_store_explicit(&list->next[index], (uint32_t)head, memory_order_relaxed);
+        if (atomic_compare_exchange_weak_explicit(&list->head, &head, emb_free_list_head(head, index + 1),
+                                                  memory_order_release, memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+// MARK: - Seqlock
+
+// The sequence is odd while a write is in progress. The fences follow the
+// "seqlocks with relaxed data" pattern: readers bracket their copy with an acquire
+// load and an acquire fence, writers with a release fence and a release store.
+struct emb_seqlock {
+    _Alignas(EMB_CACHE_LINE) _Atomic(uint32_t) sequence;
+    size_t size;
+    size_t words;
+    _Atomic(uint64_t) data[];
+};
+
+emb_seqlock_t *emb_seqlock_create(const void *initial, size_t size)
+{
+    size_t words = (size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    emb_seqlock_t *lock = emb_aligned_calloc(sizeof(emb_seqlock_t) + words * sizeof(_Atomic(uint64_t)));
+    if (!lock) {
+        return NULL;
+    }
+
+    atomic_init(&lock->sequence, 0);
+    lock->size = size;
+    lock->words = words;
+    for (size_t i = 0; i < words; i++) {
+        uint64_t word = 0;
+        size_t offset = i * sizeof(uint64_t);
+        size_t length = size - offset < sizeof(uint64_t) ? size - offset : sizeof(uint64_t);
+        memcpy(&word, (const uint8_t *)initial + offset, length);
+        atomic_init(&lock->data[i], word);
+    }
+    return lock;
+}
+
+void emb_seqlock_destroy(emb_seqlock_t *lock) { free(lock); }
+
+void emb_seqlock_read(emb_seqlock_t *lock, void *destination)
+{
+    for (;;) {
+        uint32_t before = atomic_load_explicit(&lock->sequence, memory_order_acquire);
+        if (before & 1) {
+            emb_cpu_relax();
+            continue;
+        }
+
+        // A torn copy is overwritten by the retry, so it's fine to copy straight into `destination`.
+        for (size_t i = 0; i < lock->words; i++) {
+            uint64_t word = atomic_load_explicit(&lock->data[i], memory_order_relaxed);
+            size_t offset = i * sizeof(uint64_t);
+            size_t length = lock->size - offset < sizeof(uint64_t) ? lock->size - offset : sizeof(uint64_t);
+            memcpy((uint8_t *)destination + offset, &word, length);
+        }
+
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&lock->sequence, memory_order_relaxed) == before) {
+            return;
+        }
+    }
+}
+
+void emb_seqlock_write(emb_seqlock_t *lock, const void *source)
+{
+    uint32_t sequence = atomic_load_explicit(&lock->sequence, memory_order_relaxed);
+    for (;;) {
+        if ((sequence & 1) == 0 &&
+            atomic_compare_exchange_weak_explicit(&lock->sequence, &sequence, sequence + 1, memory_order_acquire,
+                                                  memory_order_relaxed)) {
+            break;
+        }
+        emb_cpu_relax();
+        sequence = atomic_load_explicit(&lock->sequence, memory_order_relaxed);
+    }
+
+    atomic_thread_fence(memory_order_release);
+    for (size_t i = 0; i < lock->words; i++) {
+        uint64_t word = 0;
+        size_t offset = i * sizeof(uint64_t);
+        size_t length = lock->size - offset < sizeof(uint64_t) ? lock->size - offset : sizeof(uint64_t);
+        memcpy(&word, (const uint8_t *)source + offset, length);
+        atomic_store_explicit(&lock->data[i], word, memory_order_relaxed);
+    }
+
+    atomic_store_explicit(&lock->sequence, sequence + 2, memory_order_release);
+}
+
+uint32_t emb_seqlock_version(emb_seqlock_t *lock)
+{
+    return atomic_load_explicit(&lock->sequence, memory_order_acquire) >> 1;
+}
+
+// MARK: - Snapshot publishing (RCU)
+
+#define EMB_RCU_CELLS 16
+
+typedef struct {
+    _Alignas(EMB_CACHE_LINE) _Atomic(intptr_t) readers;
+} emb_rcu_cell_t;
+
+struct emb_rcu {
+    _Alignas(EMB_CACHE_LINE) _Atomic(void *) pointer;
+    _Atomic(uint32_t) epoch;
+    emb_rcu_cell_t cells[2][EMB_RCU_CELLS];
+};
+
+// Readers are spread over cells by thread, so a read never writes a line other threads are reading.
+// The read and the matching unlock always use the same cell, so its count drains to zero.
+static inline uint32_t emb_rcu_current_cell(void)
+{
+    uint64_t thread = (uint64_t)(uintptr_t)pthread_self();
+    return (uint32_t)((thread * 0x9E3779B97F4A7C15ull) >> 40) & (EMB_RCU_CELLS - 1);
+}
+
+emb_rcu_t *emb_rcu_create(void *initial)
+{
+    emb_rcu_t *rcu = emb_aligned_calloc(sizeof(emb_rcu_t));
+    if (!rcu) {
+        return NULL;
+    }
+
+    atomic_init(&rcu->pointer, initial);
+    atomic_init(&rcu->epoch, 0);
+    for (int parity = 0; parity < 2; parity++) {
+        for (int cell = 0; cell < EMB_RCU_CELLS; cell++) {
+            atomic_init(&rcu->cells[parity][cell].readers, 0);
+        }
+    }
+    return rcu;
+}
+
+void emb_rcu_destroy(emb_rcu_t *rcu) { free(rcu); }
+
+uint32_t emb_rcu_read_lock(emb_rcu_t *rcu)
+{
+    uint32_t parity = atomic_load_explicit(&rcu->epoch, memory_order_seq_cst) & 1;
+    uint32_t cell = emb_rcu_current_cell();
+    atomic_fetch_add_explicit(&rcu->cells[parity][cell].readers, 1, memory_order_seq_cst);
+    return (parity << 16) | cell;
+}
+
+void *emb_rcu_dereference(emb_rcu_t *rcu) { return atomic_load_explicit(&rcu->pointer, memory_order_seq_cst); }
+
+void emb_rcu_read_unlock(emb_rcu_t *rcu, uint32_t token)
+{
+    atomic_fetch_sub_explicit(&rcu->cells[token >> 16][token & 0xFFFF].readers, 1, memory_order_release);
+}
+
+static bool emb_rcu_drained(emb_rcu_t *rcu, uint32_t parity)
+{
+    intptr_t readers = 0;
+    for (int cell = 0; cell < EMB_RCU_CELLS; cell++) {
+        readers += atomic_load_explicit(&rcu->cells[parity][cell].readers, memory_order_seq_cst);
+    }
+    return readers == 0;
+}
+
+void *emb_rcu_replace(emb_rcu_t *rcu, void *value)
+{
+    void *previous = atomic_exchange_explicit(&rcu->pointer, value, memory_order_seq_cst);
+
+    // A reader can sample the epoch, stall, and register under that stale parity at any point
+    // later, so both parities have to drain. Flipping before each wait keeps new readers off
+    // the cells being drained. Readers that register after a drain see `value`, not `previous`.
+    for (int flip = 0; flip < 2; flip++) {
+        uint32_t parity = atomic_fetch_add_explicit(&rcu->epoch, 1, memory_order_seq_cst) & 1;
+        for (int spins = 0; !emb_rcu_drained(rcu, parity); spins++) {
+            if (spins < 64) {
+                emb_cpu_relax();
+            } else {
+                sched_yield();
+            }
+        }
+    }
+
+    return previous;
+}
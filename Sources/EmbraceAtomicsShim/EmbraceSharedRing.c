@@ -0,0 +1,246 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+#include "EmbraceSharedRing.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define EMB_CACHE_LINE 128
+
+// "EMBR" in the upper half, then the version and the log2 of the geometry.
+#define EMB_SHARED_RING_MAGIC 0x454D4252u
+#define EMB_SHARED_RING_VERSION 1u
+
+// Shared memory layout. Only fixed width fields, so every process agrees on it.
+//
+// Slot `i` is free for position `p` when its sequence is `p`, and holds the record
+// for `p` when its sequence is `p + 1`, same as `emb_mpsc_queue_t`. The sequence is
+// stored minus `i`, so all zeroes means every slot is free for its first position.
+typedef struct {
+    _Alignas(EMB_CACHE_LINE) _Atomic(uint64_t) format;
+    // Position + 1 of the uncommitted slot the consumer is waiting on, 0 if none.
+    _Atomic(uint64_t) stalledPosition;
+    _Atomic(uint64_t) stalledSince;
+
+    _Alignas(EMB_CACHE_LINE) _Atomic(uint64_t) tail;
+    _Alignas(EMB_CACHE_LINE) _Atomic(uint64_t) head;
+} emb_shared_ring_header_t;
+
+typedef struct {
+    _Atomic(uint64_t) sequence;
+    uint32_t length;
+    uint32_t checksum;
+    unsigned char data[];
+} emb_shared_ring_slot_t;
+
+struct emb_shared_ring {
+    emb_shared_ring_header_t *header;
+    unsigned char *slots;
+    uint64_t mask;
+    uint32_t slotSize;
+};
+
+static bool emb_is_power_of_two(uint64_t value) { return value > 0 && (value & (value - 1)) == 0; }
+
+static uint32_t emb_log2(uint64_t value)
+{
+    uint32_t result = 0;
+    while (value > 1) {
+        value >>= 1;
+        result++;
+    }
+    return result;
+}
+
+// FNV-1a, enough to catch a record overwritten half way.
+static uint32_t emb_checksum(const unsigned char *data, uint32_t length)
+{
+    uint32_t hash = 2166136261u;
+    for (uint32_t i = 0; i < length; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static inline emb_shared_ring_slot_t *emb_slot(emb_shared_ring_t *ring, uint64_t position)
+{
+    return (emb_shared_ring_slot_t *)(ring->slots + (position & ring->mask) * ring->slotSize);
+}
+
+static inline uint64_t emb_slot_sequence(emb_shared_ring_t *ring, emb_shared_ring_slot_t *slot, uint64_t position,
+                                         memory_order order)
+{
+    return atomic_load_explicit(&slot->sequence, order) + (position & ring->mask);
+}
+
+static inline uint64_t emb_stored_sequence(emb_shared_ring_t *ring, uint64_t position, uint64_t sequence)
+{
+    return sequence - (position & ring->mask);
+}
+
+size_t emb_shared_ring_size(uint32_t slot_size, uint32_t slot_count)
+{
+    if (!emb_is_power_of_two(slot_size) || slot_size < 64 || !emb_is_power_of_two(slot_count)) {
+        return 0;
+    }
+    return sizeof(emb_shared_ring_header_t) + (size_t)slot_size * slot_count;
+}
+
+emb_shared_ring_t *emb_shared_ring_attach(void *memory, size_t size, uint32_t slot_size, uint32_t slot_count)
+{
+    size_t required = emb_shared_ring_size(slot_size, slot_count);
+    if (!memory || required == 0 || size < required || ((uintptr_t)memory % EMB_CACHE_LINE) != 0) {
+        return NULL;
+    }
+
+    emb_shared_ring_header_t *header = memory;
+    if (!atomic_is_lock_free(&header->format)) {
+        return NULL;
+    }
+
+    // A single word, so there's no window where another process sees a half written header.
+    uint64_t format = ((uint64_t)EMB_SHARED_RING_MAGIC << 32) | (EMB_SHARED_RING_VERSION << 16) |
+                      (emb_log2(slot_size) << 8) | emb_log2(slot_count);
+    uint64_t expected = 0;
+    if (!atomic_compare_exchange_strong_explicit(&header->format, &expected, format, memory_order_acq_rel,
+                                                 memory_order_acquire) &&
+        expected != format) {
+        return NULL;
+    }
+
+    emb_shared_ring_t *ring = calloc(1, sizeof(emb_shared_ring_t));
+    if (ring) {
+        ring->header = header;
+        ring->slots = (unsigned char *)memory + sizeof(emb_shared_ring_header_t);
+        ring->mask = slot_count - 1;
+        ring->slotSize = slot_size;
+    }
+    return ring;
+}
+
+void emb_shared_ring_detach(emb_shared_ring_t *ring) { free(ring); }
+
+uint32_t emb_shared_ring_max_record_size(emb_shared_ring_t *ring)
+{
+    return ring->slotSize - (uint32_t)sizeof(emb_shared_ring_slot_t);
+}
+
+bool emb_shared_ring_push(emb_shared_ring_t *ring, const void *data, uint32_t length)
+{
+    if (length > emb_shared_ring_max_record_size(ring)) {
+        return false;
+    }
+
+    emb_shared_ring_header_t *header = ring->header;
+    uint64_t tail = atomic_load_explicit(&header->tail, memory_order_relaxed);
+    emb_shared_ring_slot_t *slot;
+
+    for (;;) {
+        slot = emb_slot(ring, tail);
+        uint64_t sequence = emb_slot_sequence(ring, slot, tail, memory_order_acquire);
+        int64_t difference = (int64_t)(sequence - tail);
+
+        if (difference == 0) {
+            if (atomic_compare_exchange_weak_explicit(&header->tail, &tail, tail + 1, memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // The slot still holds the record from a lap ago.
+            return false;
+        } else {
+            // Another producer took this position.
+            tail = atomic_load_explicit(&header->tail, memory_order_relaxed);
+        }
+    }
+
+    memcpy(slot->data, data, length);
+    slot->length = length;
+    slot->checksum = emb_checksum(slot->data, length);
+
+    // Not a plain store: the consumer may have given up on this slot while we were writing it.
+    uint64_t reserved = emb_stored_sequence(ring, tail, tail);
+    return atomic_compare_exchange_strong_explicit(&slot->sequence, &reserved, emb_stored_sequence(ring, tail, tail + 1),
+                                                   memory_order_release, memory_order_relaxed);
+}
+
+bool emb_shared_ring_peek(emb_shared_ring_t *ring, uint64_t now, uint64_t abandon_after, uint64_t *position)
+{
+    emb_shared_ring_header_t *header = ring->header;
+
+    for (;;) {
+        uint64_t head = atomic_load_explicit(&header->head, memory_order_relaxed);
+        emb_shared_ring_slot_t *slot = emb_slot(ring, head);
+        uint64_t sequence = emb_slot_sequence(ring, slot, head, memory_order_acquire);
+
+        if (sequence == head + 1) {
+            atomic_store_explicit(&header->stalledPosition, 0, memory_order_relaxed);
+            *position = head;
+            return true;
+        }
+
+        uint64_t tail = atomic_load_explicit(&header->tail, memory_order_relaxed);
+        if (sequence != head || tail <= head) {
+            return false;
+        }
+
+        // Reserved but not committed yet. Start the clock the first time we see it.
+        if (atomic_load_explicit(&header->stalledPosition, memory_order_relaxed) != head + 1) {
+            atomic_store_explicit(&header->stalledSince, now, memory_order_relaxed);
+            atomic_store_explicit(&header->stalledPosition, head + 1, memory_order_relaxed);
+            return false;
+        }
+
+        uint64_t since = atomic_load_explicit(&header->stalledSince, memory_order_relaxed);
+        if (now >= since && now - since < abandon_after) {
+            return false;
+        }
+
+        // The producer most likely died. Skip the slot, unless it commits right now.
+        uint64_t reserved = emb_stored_sequence(ring, head, head);
+        if (atomic_compare_exchange_strong_explicit(&slot->sequence, &reserved,
+                                                    emb_stored_sequence(ring, head, head + ring->mask + 1),
+                                                    memory_order_release, memory_order_acquire)) {
+            atomic_store_explicit(&header->stalledPosition, 0, memory_order_relaxed);
+            atomic_store_explicit(&header->head, head + 1, memory_order_relaxed);
+        }
+    }
+}
+
+bool emb_shared_ring_read(emb_shared_ring_t *ring, uint64_t position, void *buffer, uint32_t capacity,
+                          uint32_t *length)
+{
+    emb_shared_ring_slot_t *slot = emb_slot(ring, position);
+    uint32_t recordLength = slot->length;
+
+    if (recordLength > emb_shared_ring_max_record_size(ring) || recordLength > capacity) {
+        return false;
+    }
+
+    memcpy(buffer, slot->data, recordLength);
+    if (emb_checksum(buffer, recordLength) != slot->checksum) {
+        return false;
+    }
+
+    *length = recordLength;
+    return true;
+}
+
+void emb_shared_ring_release(emb_shared_ring_t *ring, uint64_t position)
+{
+    emb_shared_ring_slot_t *slot = emb_slot(ring, position);
+    atomic_store_explicit(&slot->sequence, emb_stored_sequence(ring, position, position + ring->mask + 1),
+                          memory_order_release);
+    atomic_store_explicit(&ring->header->head, position + 1, memory_order_relaxed);
+}
+
+uint64_t emb_shared_ring_count(emb_shared_ring_t *ring)
+{
+    uint64_t head = atomic_load_explicit(&ring->header->head, memory_order_acquire);
+    uint64_t tail = atomic_load_explicit(&ring->header->tail, memory_order_acquire);
+    return tail > head ? tail - head : 0;
+}
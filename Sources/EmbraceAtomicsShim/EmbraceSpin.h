@@ -0,0 +1,18 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+#ifndef EMBRACE_SPIN_H
+#define EMBRACE_SPIN_H
+
+// Hint to the CPU that we're in a spin-wait loop.
+static inline void emb_cpu_relax(void)
+{
+#if defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#elif defined(__x86_64__) || defined(__i386__)
+    __asm__ __volatile__("pause");
+#endif
+}
+
+#endif  // EMBRACE_SPIN_H
@@ -0,0 +1,43 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+// Mutex that spins briefly before parking the thread.
+//
+// Critical sections in the SDK are usually a handful of instructions, so a
+// waiter that spins for a moment typically gets the lock without a trip to the
+// kernel. How long to spin adapts per lock: it tracks a moving average of the
+// spins that paid off and gives up at twice that (bounded). Every time spinning
+// doesn't pay off the average decays, so locks with long critical sections
+// quickly stop wasting cycles.
+//
+// Parking uses `os_unfair_lock` on Apple platforms (keeping its priority
+// inheritance) and a futex on Linux.
+
+#ifndef EMBRACE_ADAPTIVE_LOCK_H
+#define EMBRACE_ADAPTIVE_LOCK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct emb_adaptive_lock emb_adaptive_lock_t;
+
+emb_adaptive_lock_t *emb_adaptive_lock_create(void);
+void emb_adaptive_lock_destroy(emb_adaptive_lock_t *lock);
+
+void emb_adaptive_lock_lock(emb_adaptive_lock_t *lock);
+bool emb_adaptive_lock_trylock(emb_adaptive_lock_t *lock);
+void emb_adaptive_lock_unlock(emb_adaptive_lock_t *lock);
+
+// Current moving average of the spins, for tests.
+int32_t emb_adaptive_lock_spin_average(emb_adaptive_lock_t *lock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // EMBRACE_ADAPTIVE_LOCK_H
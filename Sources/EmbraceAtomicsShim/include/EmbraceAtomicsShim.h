@@ -7,6 +7,10 @@
 #import <stdbool.h>
 #import <stdint.h>
 
+#import "EmbraceAdaptiveLock.h"
+#import "EmbraceLockFree.h"
+#import "EmbraceSharedRing.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -50,6 +54,41 @@ EMB_DECLARE_ATOMIC_TYPE(double, double)
 
 EMB_DECLARE_ATOMIC_TYPE(bool, bool)
 
+// Pointers get no arithmetic.
+typedef struct {
+    _Atomic(void *) v;
+} emb_atomic_ptr_t;
+
+void emb_atomic_ptr_init(emb_atomic_ptr_t *a, void *value);
+void *emb_atomic_ptr_load(const emb_atomic_ptr_t *a, EMBAtomicMemoryOrder order);
+void emb_atomic_ptr_store(emb_atomic_ptr_t *a, void *value, EMBAtomicMemoryOrder order);
+void *emb_atomic_ptr_exchange(emb_atomic_ptr_t *a, void *value, EMBAtomicMemoryOrder order);
+bool emb_atomic_ptr_compare_exchange(emb_atomic_ptr_t *a, void **expected, void *desired,
+                                     EMBAtomicMemoryOrder successOrder, EMBAtomicMemoryOrder failureOrder);
+
+// A pointer paired with a generation tag, swapped as one double-width value.
+// Bumping the tag on every update defeats ABA.
+typedef struct {
+    void *pointer;
+    uintptr_t tag;
+} emb_tagged_ptr_t;
+
+typedef struct {
+    _Alignas(2 * sizeof(void *)) _Atomic(emb_tagged_ptr_t) v;
+} emb_atomic_tagged_ptr_t;
+
+void emb_atomic_tagged_ptr_init(emb_atomic_tagged_ptr_t *a, emb_tagged_ptr_t value);
+emb_tagged_ptr_t emb_atomic_tagged_ptr_load(emb_atomic_tagged_ptr_t *a, EMBAtomicMemoryOrder order);
+bool emb_atomic_tagged_ptr_compare_exchange(emb_atomic_tagged_ptr_t *a, emb_tagged_ptr_t *expected,
+                                            emb_tagged_ptr_t desired, EMBAtomicMemoryOrder successOrder,
+                                            EMBAtomicMemoryOrder failureOrder);
+
+// Whether double-width compare-and-swap is native on this target. It is on arm64;
+// on x86_64 it needs `cmpxchg16b`, otherwise the compiler runtime falls back to a lock.
+// The structures in `EmbraceLockFree.h` pack their tags into 64 bits instead, so they
+// stay lock-free either way.
+bool emb_atomic_tagged_ptr_is_lock_free(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,134 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+// Lock-free building blocks on top of C11 atomics.
+//
+// Everything in here is plain C11 (no Foundation), so it can be compiled and
+// exercised on any platform with <stdatomic.h>. Pointer atomics live next to the
+// scalar ones in `EmbraceAtomicsShim.h`.
+//
+// The queues don't store elements themselves: they hand out slot positions and
+// the caller keeps elements in its own typed buffer, indexed by `position & mask`.
+// Producing is `reserve` -> write slot -> `commit`, consuming is
+// `peek` -> read slot -> `release`. The commit/peek pair is a release/acquire
+// handoff, so the slot contents are visible to the consumer without extra fences.
+
+#ifndef EMBRACE_LOCK_FREE_H
+#define EMBRACE_LOCK_FREE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// MARK: - SPSC ring
+
+// Single producer, single consumer ring of `capacity` slots (a power of two).
+typedef struct emb_spsc_ring emb_spsc_ring_t;
+
+emb_spsc_ring_t *emb_spsc_ring_create(size_t capacity);
+void emb_spsc_ring_destroy(emb_spsc_ring_t *ring);
+
+// Producer side. Returns false when the ring is full.
+bool emb_spsc_ring_reserve(emb_spsc_ring_t *ring, size_t *position);
+void emb_spsc_ring_commit(emb_spsc_ring_t *ring, size_t position);
+
+// Consumer side. Returns false when the ring is empty.
+bool emb_spsc_ring_peek(emb_spsc_ring_t *ring, size_t *position);
+void emb_spsc_ring_release(emb_spsc_ring_t *ring, size_t position);
+
+// Approximate when called concurrently with either side.
+size_t emb_spsc_ring_count(emb_spsc_ring_t *ring);
+
+// MARK: - Bounded MPSC queue
+
+// Multiple producer, single consumer bounded queue of `capacity` slots (a power
+// of two). Every slot carries a sequence number, so producers only contend on
+// the tail index and never on each other's slots.
+//
+// A producer that reserved a slot and hasn't committed it yet holds back the
+// consumer (but not other producers) until it does.
+typedef struct emb_mpsc_queue emb_mpsc_queue_t;
+
+emb_mpsc_queue_t *emb_mpsc_queue_create(size_t capacity);
+void emb_mpsc_queue_destroy(emb_mpsc_queue_t *queue);
+
+// Producer side, safe from any thread. Returns false when the queue is full.
+bool emb_mpsc_queue_reserve(emb_mpsc_queue_t *queue, size_t *position);
+void emb_mpsc_queue_commit(emb_mpsc_queue_t *queue, size_t position);
+
+// Consumer side, one thread at a time. Returns false when the next slot isn't committed yet.
+bool emb_mpsc_queue_peek(emb_mpsc_queue_t *queue, size_t *position);
+void emb_mpsc_queue_release(emb_mpsc_queue_t *queue, size_t position);
+
+// Approximate when called concurrently with either side.
+size_t emb_mpsc_queue_count(emb_mpsc_queue_t *queue);
+
+// MARK: - Free-list
+
+// Treiber stack of the indices `0..<capacity`, all free after creation.
+// The head packs a 32-bit generation tag with the top index, so it only needs
+// single-width compare-and-swap.
+typedef struct emb_free_list emb_free_list_t;
+
+emb_free_list_t *emb_free_list_create(uint32_t capacity);
+void emb_free_list_destroy(emb_free_list_t *list);
+
+// Returns false when every index is in use.
+bool emb_free_list_pop(emb_free_list_t *list, uint32_t *index);
+void emb_free_list_push(emb_free_list_t *list, uint32_t index);
+
+// MARK: - Seqlock
+
+// Sequence lock over `size` bytes of plain data. Readers never block writers and
+// retry when they raced one; writers are serialized among themselves.
+// The payload is copied word by word with relaxed atomics, so readers racing a
+// writer are well defined (and silent under ThreadSanitizer).
+typedef struct emb_seqlock emb_seqlock_t;
+
+emb_seqlock_t *emb_seqlock_create(const void *initial, size_t size);
+void emb_seqlock_destroy(emb_seqlock_t *lock);
+
+void emb_seqlock_read(emb_seqlock_t *lock, void *destination);
+void emb_seqlock_write(emb_seqlock_t *lock, const void *source);
+
+// Number of completed writes.
+uint32_t emb_seqlock_version(emb_seqlock_t *lock);
+
+// MARK: - Snapshot publishing (RCU)
+
+// A published pointer that readers load without locking, and that writers
+// replace and get back only once no reader can still be using it.
+//
+// Readers bracket their use of the pointer with `read_lock`/`read_unlock`,
+// which bump a per-thread counter cell for the current epoch (uncontended
+// atomic adds, no shared cache line). `replace` swaps the pointer, then flips
+// the epoch twice, each time waiting for the cells of the previous epoch to
+// drain, so every reader that might have loaded the old pointer is done.
+//
+// Writers must be serialized by the caller, and must not call `replace` from
+// inside a read section on the same thread, or they'd wait for themselves.
+typedef struct emb_rcu emb_rcu_t;
+
+emb_rcu_t *emb_rcu_create(void *initial);
+
+// Doesn't free the published pointer.
+void emb_rcu_destroy(emb_rcu_t *rcu);
+
+uint32_t emb_rcu_read_lock(emb_rcu_t *rcu);
+void *emb_rcu_dereference(emb_rcu_t *rcu);
+void emb_rcu_read_unlock(emb_rcu_t *rcu, uint32_t token);
+
+// Publishes `value` and returns the previous pointer once it's safe to free.
+void *emb_rcu_replace(emb_rcu_t *rcu, void *value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // EMBRACE_LOCK_FREE_H
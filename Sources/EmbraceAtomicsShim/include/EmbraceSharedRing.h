@@ -0,0 +1,80 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+// Multi-producer, single-consumer ring that lives in shared memory, so several
+// processes can use it at once (an app and its extensions, through a file in the
+// app group container mapped with `MAP_SHARED`).
+//
+// Like the rest of the lock-free building blocks this is plain C11, and only
+// needs lock-free 64-bit atomics, which are address-free and so work across
+// processes. The caller maps the memory; the ring keeps no pointers in it.
+//
+// Records are copied into fixed size slots, each with a sequence number like
+// `emb_mpsc_queue_t`. All zeroes is a valid empty ring, so a freshly truncated
+// file needs no initialization.
+//
+// Processes can die at any point:
+// - A producer that reserved a slot and died before committing it holds back the
+//   consumer. Once the consumer has been waiting on that slot for `abandon_after`
+//   it skips it. A producer that was only slow and commits afterwards finds out
+//   and drops its record.
+// - Every record has a checksum, so a slot written by a skipped producer after
+//   it was reused is detected and dropped instead of returning garbage.
+// - A consumer that dies between reading and releasing a record reads it again
+//   next time, so records are delivered at least once.
+
+#ifndef EMBRACE_SHARED_RING_H
+#define EMBRACE_SHARED_RING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct emb_shared_ring emb_shared_ring_t;
+
+// Bytes of shared memory needed for `slot_count` slots (a power of two) of
+// `slot_size` bytes (a power of two, at least 64). Returns 0 for invalid sizes.
+size_t emb_shared_ring_size(uint32_t slot_size, uint32_t slot_count);
+
+// Attaches to a ring in `memory`, which must be aligned to 128 bytes and zero
+// filled the first time. Returns NULL if `size` is too small, or if the memory
+// holds a ring with another format (another version, or other slot sizes).
+// The returned handle is local to the process.
+emb_shared_ring_t *emb_shared_ring_attach(void *memory, size_t size, uint32_t slot_size, uint32_t slot_count);
+
+// Frees the handle. Doesn't touch the shared memory.
+void emb_shared_ring_detach(emb_shared_ring_t *ring);
+
+// Largest record that fits in a slot.
+uint32_t emb_shared_ring_max_record_size(emb_shared_ring_t *ring);
+
+// Producer side, safe from any thread of any process. Returns false when the ring
+// is full, the record is too large, or the consumer gave up on the slot.
+bool emb_shared_ring_push(emb_shared_ring_t *ring, const void *data, uint32_t length);
+
+// Consumer side, one thread of one process at a time. Returns false when the next
+// record isn't committed yet. `now` is any clock that's shared by every process
+// that consumes the ring, including across launches (like wall-clock nanoseconds),
+// and `abandon_after` is in the same unit.
+bool emb_shared_ring_peek(emb_shared_ring_t *ring, uint64_t now, uint64_t abandon_after, uint64_t *position);
+
+// Copies the record at `position` into `buffer`. Returns false if it's corrupt or
+// doesn't fit, the record still has to be released either way.
+bool emb_shared_ring_read(emb_shared_ring_t *ring, uint64_t position, void *buffer, uint32_t capacity,
+                          uint32_t *length);
+
+void emb_shared_ring_release(emb_shared_ring_t *ring, uint64_t position);
+
+// Approximate when called concurrently with either side.
+uint64_t emb_shared_ring_count(emb_shared_ring_t *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // EMBRACE_SHARED_RING_H
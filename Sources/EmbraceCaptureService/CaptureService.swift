@@ -34,6 +34,13 @@ open class CaptureService: NSObject {
     /// Getter for the state of the capture service.
     public let state: EmbraceAtomic<CaptureServiceState> = EmbraceAtomic(.uninstalled)
 
+    /// When the SDK installs and starts this service while the app launches.
+    /// Defaults to `.critical`. Override it for services that don't need to be running before the
+    /// first frame, so they stay out of the app's launch time.
+    @objc open var startupPhase: EmbraceStartupPhase {
+        .critical
+    }
+
     public func install(otel: EmbraceOpenTelemetry?, logger: InternalLogger? = nil) {
 
         guard
@@ -0,0 +1,25 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+/// When a piece of SDK startup work runs, relative to the app's launch.
+@objc(EMBStartupPhase)
+public enum EmbraceStartupPhase: Int, Comparable {
+    /// Runs synchronously in `Embrace.start()`, before the first frame.
+    ///
+    /// Only for work that must be in place before the app does anything else,
+    /// like crash reporting or swizzling the APIs the app uses during launch.
+    case critical
+
+    /// Runs on the main thread once the first frame has been committed and the main run loop goes idle.
+    case deferred
+
+    /// Runs on a background queue after the deferred phase.
+    case background
+
+    public static func < (lhs: EmbraceStartupPhase, rhs: EmbraceStartupPhase) -> Bool {
+        lhs.rawValue < rhs.rawValue
+    }
+}
@@ -0,0 +1,137 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceAtomicsShim
+#endif
+
+/// An atomic, optional pointer.
+///
+/// Ownership of the pointee is up to the caller: the atomic only swaps addresses.
+public final class EmbraceAtomicPointer<Pointee> {
+
+    private let storage: UnsafeMutablePointer<emb_atomic_ptr_t>
+
+    public init(_ initial: UnsafeMutablePointer<Pointee>? = nil) {
+        storage = UnsafeMutablePointer<emb_atomic_ptr_t>.allocate(capacity: 1)
+        emb_atomic_ptr_init(storage, initial.map { UnsafeMutableRawPointer($0) })
+    }
+
+    deinit {
+        storage.deallocate()
+    }
+
+    public func load(order: MemoryOrder = .sequencialConsistency) -> UnsafeMutablePointer<Pointee>? {
+        emb_atomic_ptr_load(storage, order.atomicOrder)?.assumingMemoryBound(to: Pointee.self)
+    }
+
+    public func store(_ value: UnsafeMutablePointer<Pointee>?, order: MemoryOrder = .sequencialConsistency) {
+        emb_atomic_ptr_store(storage, value.map { UnsafeMutableRawPointer($0) }, order.atomicOrder)
+    }
+
+    /// Atomically replace the current pointer, returning the previous one.
+    @discardableResult
+    public func exchange(
+        _ value: UnsafeMutablePointer<Pointee>?,
+        order: MemoryOrder = .sequencialConsistency
+    ) -> UnsafeMutablePointer<Pointee>? {
+        emb_atomic_ptr_exchange(storage, value.map { UnsafeMutableRawPointer($0) }, order.atomicOrder)?
+            .assumingMemoryBound(to: Pointee.self)
+    }
+
+    /// Compare-and-swap. On failure, `expected` is updated to the current pointer.
+    @discardableResult
+    public func compareExchange(
+        expected: inout UnsafeMutablePointer<Pointee>?,
+        desired: UnsafeMutablePointer<Pointee>?,
+        successOrder: MemoryOrder = .sequencialConsistency
+    ) -> Bool {
+        var raw = expected.map { UnsafeMutableRawPointer($0) }
+        let result = emb_atomic_ptr_compare_exchange(
+            storage,
+            &raw,
+            desired.map { UnsafeMutableRawPointer($0) },
+            successOrder.atomicOrder,
+            successOrder.failureOrdering().atomicOrder
+        )
+        expected = raw?.assumingMemoryBound(to: Pointee.self)
+        return result
+    }
+}
+
+extension EmbraceAtomicPointer: @unchecked Sendable {}
+
+/// A pointer paired with a generation tag.
+public struct EmbraceTaggedPointer<Pointee>: Equatable {
+    public var pointer: UnsafeMutablePointer<Pointee>?
+    public var tag: UInt
+
+    public init(pointer: UnsafeMutablePointer<Pointee>?, tag: UInt = 0) {
+        self.pointer = pointer
+        self.tag = tag
+    }
+
+    /// This pointer with the next tag, for the `desired` side of a compare-and-swap.
+    public func next(pointer: UnsafeMutablePointer<Pointee>?) -> EmbraceTaggedPointer {
+        EmbraceTaggedPointer(pointer: pointer, tag: tag &+ 1)
+    }
+}
+
+/// An atomic pointer and generation tag, swapped together with a double-width compare-and-swap.
+///
+/// Bumping the tag on every update (see `EmbraceTaggedPointer.next(pointer:)`) makes a compare-and-swap
+/// fail if the pointer was changed and changed back in between, which plain pointer atomics can't tell.
+/// Check `isLockFree` before using it on a hot path: on x86_64 without `cmpxchg16b` it falls back to a lock.
+public final class EmbraceAtomicTaggedPointer<Pointee> {
+
+    public static var isLockFree: Bool {
+        emb_atomic_tagged_ptr_is_lock_free()
+    }
+
+    private let storage: UnsafeMutablePointer<emb_atomic_tagged_ptr_t>
+
+    public init(_ initial: EmbraceTaggedPointer<Pointee> = EmbraceTaggedPointer(pointer: nil)) {
+        storage = UnsafeMutablePointer<emb_atomic_tagged_ptr_t>.allocate(capacity: 1)
+        emb_atomic_tagged_ptr_init(storage, Self.cValue(initial))
+    }
+
+    deinit {
+        storage.deallocate()
+    }
+
+    public func load(order: MemoryOrder = .sequencialConsistency) -> EmbraceTaggedPointer<Pointee> {
+        Self.swiftValue(emb_atomic_tagged_ptr_load(storage, order.atomicOrder))
+    }
+
+    /// Compare-and-swap of both the pointer and the tag. On failure, `expected` is updated to the current value.
+    @discardableResult
+    public func compareExchange(
+        expected: inout EmbraceTaggedPointer<Pointee>,
+        desired: EmbraceTaggedPointer<Pointee>,
+        successOrder: MemoryOrder = .sequencialConsistency
+    ) -> Bool {
+        var value = Self.cValue(expected)
+        let result = emb_atomic_tagged_ptr_compare_exchange(
+            storage,
+            &value,
+            Self.cValue(desired),
+            successOrder.atomicOrder,
+            successOrder.failureOrdering().atomicOrder
+        )
+        expected = Self.swiftValue(value)
+        return result
+    }
+
+    private static func cValue(_ value: EmbraceTaggedPointer<Pointee>) -> emb_tagged_ptr_t {
+        emb_tagged_ptr_t(pointer: value.pointer.map { UnsafeMutableRawPointer($0) }, tag: value.tag)
+    }
+
+    private static func swiftValue(_ value: emb_tagged_ptr_t) -> EmbraceTaggedPointer<Pointee> {
+        EmbraceTaggedPointer(pointer: value.pointer?.assumingMemoryBound(to: Pointee.self), tag: value.tag)
+    }
+}
+
+extension EmbraceAtomicTaggedPointer: @unchecked Sendable {}
@@ -0,0 +1,49 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceAtomicsShim
+#endif
+
+/// Lock-free pool of the indices `0..<capacity`, backed by a Treiber stack.
+///
+/// Pair it with a preallocated array to hand out reusable slots without a lock:
+/// `pop` an index to take a slot, `push` it back when done. All indices are free after init.
+/// Indices are reused most recently released first, which keeps their slots warm in cache.
+public final class EmbraceFreeList {
+
+    public let capacity: Int
+
+    private let list: OpaquePointer
+
+    public init(capacity: Int) {
+        precondition(capacity > 0 && capacity < Int(UInt32.max), "EmbraceFreeList capacity out of range")
+
+        self.capacity = capacity
+        guard let list = emb_free_list_create(UInt32(capacity)) else {
+            fatalError("EmbraceFreeList failed to allocate \(capacity) indices")
+        }
+        self.list = list
+    }
+
+    deinit {
+        emb_free_list_destroy(list)
+    }
+
+    /// Takes a free index, or returns nil if all of them are in use.
+    public func pop() -> Int? {
+        var index: UInt32 = 0
+        return emb_free_list_pop(list, &index) ? Int(index) : nil
+    }
+
+    /// Returns `index` to the list. It must have come from `pop` and not been pushed back already.
+    public func push(_ index: Int) {
+        precondition(index >= 0 && index < capacity, "EmbraceFreeList index out of range")
+        emb_free_list_push(list, UInt32(index))
+    }
+}
+
+extension EmbraceFreeList: @unchecked Sendable {}
@@ -0,0 +1,87 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceAtomicsShim
+#endif
+
+/// Lock-free, bounded, multiple producer single consumer queue.
+///
+/// `push` can be called from any thread. `pop` and `drain` must only be called from one thread at a time.
+/// Elements from the same producer come out in the order they were pushed.
+///
+/// Producers claim a slot and then fill it, so a producer that's preempted in between holds back the
+/// consumer until it resumes; `pop` returns nil meanwhile even if later slots are filled.
+public final class EmbraceMPSCQueue<Element> {
+
+    /// Number of elements the queue holds, the requested capacity rounded up to a power of two.
+    public let capacity: Int
+
+    private let queue: OpaquePointer
+    private let buffer: UnsafeMutablePointer<Element>
+    private let mask: Int
+
+    public init(capacity: Int) {
+        precondition(capacity > 0, "EmbraceMPSCQueue capacity must be positive")
+
+        self.capacity = lockFreeCapacity(for: capacity)
+        mask = self.capacity - 1
+        guard let queue = emb_mpsc_queue_create(self.capacity) else {
+            fatalError("EmbraceMPSCQueue failed to allocate \(self.capacity) slots")
+        }
+        self.queue = queue
+        buffer = UnsafeMutablePointer<Element>.allocate(capacity: self.capacity)
+    }
+
+    deinit {
+        while pop() != nil {}
+        buffer.deallocate()
+        emb_mpsc_queue_destroy(queue)
+    }
+
+    /// Appends `element`, or returns false if the queue is full.
+    @discardableResult
+    public func push(_ element: Element) -> Bool {
+        var position = 0
+        guard emb_mpsc_queue_reserve(queue, &position) else {
+            return false
+        }
+
+        (buffer + (position & mask)).initialize(to: element)
+        emb_mpsc_queue_commit(queue, position)
+        return true
+    }
+
+    /// Removes the oldest element, or returns nil if there's none ready.
+    public func pop() -> Element? {
+        var position = 0
+        guard emb_mpsc_queue_peek(queue, &position) else {
+            return nil
+        }
+
+        let element = (buffer + (position & mask)).move()
+        emb_mpsc_queue_release(queue, position)
+        return element
+    }
+
+    /// Pops up to `maxCount` elements, passing each to `body`. Returns how many were popped.
+    @discardableResult
+    public func drain(maxCount: Int = .max, _ body: (Element) throws -> Void) rethrows -> Int {
+        var popped = 0
+        while popped < maxCount, let element = pop() {
+            popped += 1
+            try body(element)
+        }
+        return popped
+    }
+
+    /// Approximate while producers or the consumer are running.
+    public var count: Int {
+        emb_mpsc_queue_count(queue)
+    }
+}
+
+extension EmbraceMPSCQueue: @unchecked Sendable {}
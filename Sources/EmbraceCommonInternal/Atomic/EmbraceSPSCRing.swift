@@ -0,0 +1,78 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceAtomicsShim
+#endif
+
+/// Lock-free, bounded, single producer single consumer ring.
+///
+/// `push` must only be called from one thread at a time, and so must `pop`; they can run concurrently
+/// with each other. Use `EmbraceMPSCQueue` when several threads produce.
+public final class EmbraceSPSCRing<Element> {
+
+    /// Number of elements the ring holds, the requested capacity rounded up to a power of two.
+    public let capacity: Int
+
+    private let ring: OpaquePointer
+    private let buffer: UnsafeMutablePointer<Element>
+    private let mask: Int
+
+    public init(capacity: Int) {
+        precondition(capacity > 0, "EmbraceSPSCRing capacity must be positive")
+
+        self.capacity = lockFreeCapacity(for: capacity)
+        mask = self.capacity - 1
+        guard let ring = emb_spsc_ring_create(self.capacity) else {
+            fatalError("EmbraceSPSCRing failed to allocate \(self.capacity) slots")
+        }
+        self.ring = ring
+        buffer = UnsafeMutablePointer<Element>.allocate(capacity: self.capacity)
+    }
+
+    deinit {
+        while pop() != nil {}
+        buffer.deallocate()
+        emb_spsc_ring_destroy(ring)
+    }
+
+    /// Appends `element`, or returns false if the ring is full.
+    @discardableResult
+    public func push(_ element: Element) -> Bool {
+        var position = 0
+        guard emb_spsc_ring_reserve(ring, &position) else {
+            return false
+        }
+
+        (buffer + (position & mask)).initialize(to: element)
+        emb_spsc_ring_commit(ring, position)
+        return true
+    }
+
+    /// Removes the oldest element, or returns nil if the ring is empty.
+    public func pop() -> Element? {
+        var position = 0
+        guard emb_spsc_ring_peek(ring, &position) else {
+            return nil
+        }
+
+        let element = (buffer + (position & mask)).move()
+        emb_spsc_ring_release(ring, position)
+        return element
+    }
+
+    /// Approximate while the other side is running.
+    public var count: Int {
+        emb_spsc_ring_count(ring)
+    }
+}
+
+extension EmbraceSPSCRing: @unchecked Sendable {}
+
+/// The ring and queue index slots with a mask, so capacities are rounded up to a power of two.
+func lockFreeCapacity(for capacity: Int) -> Int {
+    capacity <= 1 ? 1 : 1 << (Int.bitWidth - (capacity - 1).leadingZeroBitCount)
+}
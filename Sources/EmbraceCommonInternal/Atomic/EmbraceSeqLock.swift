@@ -0,0 +1,57 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceAtomicsShim
+#endif
+
+/// Sequence lock for small, trivial values (structs of numbers, flags and the like) that are read
+/// far more often than written.
+///
+/// Readers never block and never write shared memory, so they don't bounce cache lines between cores;
+/// they retry if a write lands while they copy. Writers are serialized among themselves.
+/// `Value` can't hold references or other types that need retain/release.
+public final class EmbraceSeqLock<Value> {
+
+    private let lock: OpaquePointer
+
+    public init(_ initial: Value) {
+        precondition(_isPOD(Value.self), "EmbraceSeqLock only supports trivial types")
+
+        var initial = initial
+        guard let lock = withUnsafeBytes(of: &initial, { emb_seqlock_create($0.baseAddress, $0.count) }) else {
+            fatalError("EmbraceSeqLock failed to allocate")
+        }
+        self.lock = lock
+    }
+
+    deinit {
+        emb_seqlock_destroy(lock)
+    }
+
+    /// A consistent copy of the current value.
+    public func load() -> Value {
+        withUnsafeTemporaryAllocation(of: Value.self, capacity: 1) { buffer in
+            let pointer = buffer.baseAddress!
+            emb_seqlock_read(lock, pointer)
+            return pointer.move()
+        }
+    }
+
+    public func store(_ value: Value) {
+        var value = value
+        withUnsafeBytes(of: &value) {
+            emb_seqlock_write(lock, $0.baseAddress)
+        }
+    }
+
+    /// Number of stores so far. A reader can compare versions to skip work when nothing changed.
+    public var version: UInt32 {
+        emb_seqlock_version(lock)
+    }
+}
+
+extension EmbraceSeqLock: @unchecked Sendable {}
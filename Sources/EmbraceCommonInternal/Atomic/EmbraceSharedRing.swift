@@ -0,0 +1,151 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceAtomicsShim
+#endif
+
+/// Bounded queue of byte records in a memory-mapped file, shared by every process that maps the same file.
+///
+/// Meant for app extensions handing data to their host app through the app group container: `push` can be
+/// called from any thread of any process, with no locks, syscalls or file I/O beyond page faults.
+/// `drain` must only be called from one thread of one process at a time.
+///
+/// Records are copied into fixed size slots, so records larger than `maxRecordSize` are rejected.
+/// See `EmbraceSharedRing.h` for how processes that die half way are handled.
+public final class EmbraceSharedRing {
+
+    public let url: URL
+
+    private let ring: OpaquePointer
+    private let memory: UnsafeMutableRawPointer
+    private let size: Int
+
+    /// Maps the ring in the file at `url`, creating it if needed.
+    ///
+    /// - Parameters:
+    ///   - slotSize: Bytes per slot, a power of two. Every process sharing the file must use the same value.
+    ///   - slotCount: Number of slots, a power of two. Every process sharing the file must use the same value.
+    ///   - resetIfIncompatible: Whether to start over when the file holds a ring with another format, like one written
+    ///     by another SDK version. Only the consumer should do this.
+    /// - Returns: `nil` if the file can't be created or mapped, or holds an incompatible ring that wasn't reset.
+    public init?(url: URL, slotSize: Int = 1024, slotCount: Int = 256, resetIfIncompatible: Bool = false) {
+        let size = emb_shared_ring_size(UInt32(slotSize), UInt32(slotCount))
+        guard size > 0 else {
+            return nil
+        }
+
+        try? FileManager.default.createDirectory(at: url.deletingLastPathComponent(), withIntermediateDirectories: true)
+
+        let fd = open(url.path, O_RDWR | O_CREAT, 0o644)
+        guard fd >= 0 else {
+            return nil
+        }
+        defer { close(fd) }
+
+        guard let memory = Self.map(fd: fd, size: size) else {
+            return nil
+        }
+
+        var ring = emb_shared_ring_attach(memory, size, UInt32(slotSize), UInt32(slotCount))
+        if ring == nil && resetIfIncompatible {
+            // zero filled is an empty ring
+            memset(memory, 0, size)
+            ring = emb_shared_ring_attach(memory, size, UInt32(slotSize), UInt32(slotCount))
+        }
+
+        guard let ring else {
+            munmap(memory, size)
+            return nil
+        }
+
+        self.url = url
+        self.ring = ring
+        self.memory = memory
+        self.size = size
+    }
+
+    deinit {
+        emb_shared_ring_detach(ring)
+        munmap(memory, size)
+    }
+
+    /// Largest record `push` accepts.
+    public var maxRecordSize: Int {
+        Int(emb_shared_ring_max_record_size(ring))
+    }
+
+    /// Appends a record, or returns false if the ring is full or the record is too large.
+    @discardableResult
+    public func push(_ record: Data) -> Bool {
+        guard record.count <= maxRecordSize else {
+            return false
+        }
+
+        return record.withUnsafeBytes {
+            emb_shared_ring_push(ring, $0.baseAddress, UInt32($0.count))
+        }
+    }
+
+    /// Removes up to `maxCount` records, passing each to `body`. Corrupt records are skipped.
+    /// If `body` throws, the record is removed anyway and the error is rethrown.
+    ///
+    /// A record whose producer reserved its slot but never filled it holds back the ones after it,
+    /// until it has been waiting for `abandonAfter`, measured across calls and launches.
+    /// Returns how many records were passed to `body`.
+    @discardableResult
+    public func drain(
+        maxCount: Int = .max,
+        abandonAfter: TimeInterval = 30,
+        now: Date = Date(),
+        _ body: (Data) throws -> Void
+    ) rethrows -> Int {
+        let clock = UInt64(now.nanosecondsSince1970Truncated)
+        let timeout = UInt64(max(abandonAfter, 0) * 1_000_000_000)
+        var buffer = [UInt8](repeating: 0, count: maxRecordSize)
+
+        var drained = 0
+        var position: UInt64 = 0
+        while drained < maxCount, emb_shared_ring_peek(ring, clock, timeout, &position) {
+            var length: UInt32 = 0
+            let valid = buffer.withUnsafeMutableBytes {
+                emb_shared_ring_read(ring, position, $0.baseAddress, UInt32($0.count), &length)
+            }
+
+            // released after `body`, so a consumer that dies in between gets the record again next time
+            defer { emb_shared_ring_release(ring, position) }
+            if valid {
+                drained += 1
+                try body(Data(buffer[0..<Int(length)]))
+            }
+        }
+        return drained
+    }
+
+    /// Approximate while producers or the consumer are running.
+    public var count: Int {
+        Int(emb_shared_ring_count(ring))
+    }
+
+    private static func map(fd: Int32, size: Int) -> UnsafeMutableRawPointer? {
+        var info = stat()
+        guard fstat(fd, &info) == 0 else {
+            return nil
+        }
+        if info.st_size < off_t(size) && ftruncate(fd, off_t(size)) != 0 {
+            return nil
+        }
+
+        // `MAP_FAILED` is a C macro Swift can't import
+        let address = mmap(nil, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+        guard let address, address != UnsafeMutableRawPointer(bitPattern: -1) else {
+            return nil
+        }
+        return address
+    }
+}
+
+extension EmbraceSharedRing: @unchecked Sendable {}
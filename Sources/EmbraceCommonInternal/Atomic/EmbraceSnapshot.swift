@@ -0,0 +1,77 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceAtomicsShim
+#endif
+
+/// Holds an immutable value that's read on hot paths and replaced rarely, like remote config limits.
+///
+/// Readers load the current snapshot without taking a lock, so they never wait on a writer (or on
+/// each other), which matters for reads on the main thread. Writers publish a whole new value; the
+/// previous one is released once no reader can still be using it (read-copy-update).
+///
+/// Publishing waits for in-flight reads to finish, so it's meant for config updates, not per-event
+/// state. Don't publish from inside a `read` closure.
+public final class EmbraceSnapshot<Value> {
+
+    private final class Box {
+        let value: Value
+        init(_ value: Value) { self.value = value }
+    }
+
+    private let rcu: OpaquePointer
+    private let writeLock = UnfairLock()
+
+    public init(_ initial: Value) {
+        guard let rcu = emb_rcu_create(Unmanaged.passRetained(Box(initial)).toOpaque()) else {
+            fatalError("EmbraceSnapshot failed to allocate")
+        }
+        self.rcu = rcu
+    }
+
+    deinit {
+        Unmanaged<Box>.fromOpaque(emb_rcu_dereference(rcu)).release()
+        emb_rcu_destroy(rcu)
+    }
+
+    /// The current value.
+    public func load() -> Value {
+        read { $0 }
+    }
+
+    /// Runs `body` with the current value, without copying it out.
+    public func read<T>(_ body: (Value) throws -> T) rethrows -> T {
+        let token = emb_rcu_read_lock(rcu)
+        defer { emb_rcu_read_unlock(rcu, token) }
+        return try body(Unmanaged<Box>.fromOpaque(emb_rcu_dereference(rcu)).takeUnretainedValue().value)
+    }
+
+    /// Replaces the current value. Readers see either the old value or the new one, never a mix.
+    public func publish(_ value: Value) {
+        writeLock.locked {
+            replace(with: value)
+        }
+    }
+
+    /// Publishes `transform` applied to the current value. Concurrent updates don't overwrite each other.
+    @discardableResult
+    public func update(_ transform: (Value) throws -> Value) rethrows -> Value {
+        try writeLock.locked {
+            let value = try transform(load())
+            replace(with: value)
+            return value
+        }
+    }
+
+    private func replace(with value: Value) {
+        // `replace` only returns once no reader can still see the previous box
+        let previous = emb_rcu_replace(rcu, Unmanaged.passRetained(Box(value)).toOpaque())
+        Unmanaged<Box>.fromOpaque(previous).release()
+    }
+}
+
+extension EmbraceSnapshot: @unchecked Sendable where Value: Sendable {}
@@ -0,0 +1,413 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+/// A type that writes itself straight into an `EmbraceJSONWriter`, without going through `Encodable`.
+public protocol EmbraceJSONWritable {
+    func writeJSON(to writer: inout EmbraceJSONWriter) throws
+}
+
+extension EmbraceJSONWritable {
+
+    /// The compact JSON representation of this value.
+    public func jsonData(capacity: Int = EmbraceJSONWriter.defaultCapacity) throws -> Data {
+        var writer = EmbraceJSONWriter(capacity: capacity)
+        try writeJSON(to: &writer)
+        return writer.data
+    }
+}
+
+/// Streaming JSON writer for payloads.
+///
+/// Values are written as UTF-8 straight into a growable byte buffer, with no intermediate container
+/// tree like `JSONEncoder` builds. The buffer keeps its capacity across `reset()`, so a writer can be
+/// reused for many payloads. When created with a `sink`, the buffer is handed over in pieces as it
+/// fills up (for example to a compression stream) instead of growing to the whole payload.
+///
+/// Commas and colons are handled by the writer; callers only open and close containers, write keys
+/// and write values. Output is compact and forward slashes aren't escaped.
+public struct EmbraceJSONWriter {
+
+    public static let defaultCapacity = 4096
+
+    private var buffer: [UInt8]
+
+    /// One entry per open container: whether it already has an element, so the next one needs a comma.
+    private var containers: [Bool] = []
+    private var expectsValue = false
+
+    private let flushThreshold: Int
+    private let sink: ((UnsafeRawBufferPointer) throws -> Void)?
+    private var sinkError: Error?
+
+    public init(capacity: Int = defaultCapacity) {
+        buffer = []
+        buffer.reserveCapacity(capacity)
+        flushThreshold = .max
+        sink = nil
+        containers.reserveCapacity(8)
+    }
+
+    /// Creates a writer that passes its output to `sink` whenever more than `flushThreshold` bytes
+    /// are buffered. Call `finish()` once done to pass the rest and surface errors thrown by `sink`.
+    public init(flushThreshold: Int = defaultCapacity, sink: @escaping (UnsafeRawBufferPointer) throws -> Void) {
+        buffer = []
+        buffer.reserveCapacity(flushThreshold + flushThreshold / 4)
+        self.flushThreshold = flushThreshold
+        self.sink = sink
+        containers.reserveCapacity(8)
+    }
+
+    /// Bytes written so far (or since the last flush, when writing to a sink).
+    public var data: Data {
+        Data(buffer)
+    }
+
+    public func withBytes<T>(_ body: (UnsafeRawBufferPointer) throws -> T) rethrows -> T {
+        try buffer.withUnsafeBytes(body)
+    }
+
+    /// Clears the output so the writer can be reused, keeping the buffer's capacity.
+    public mutating func reset() {
+        buffer.removeAll(keepingCapacity: true)
+        containers.removeAll(keepingCapacity: true)
+        expectsValue = false
+        sinkError = nil
+    }
+
+    /// Passes any buffered output to the sink and rethrows the first error the sink threw.
+    public mutating func finish() throws {
+        flush()
+        if let sinkError {
+            throw sinkError
+        }
+    }
+
+    // MARK: - Structure
+
+    public mutating func beginObject() {
+        beginValue()
+        buffer.append(UInt8(ascii: "{"))
+        containers.append(false)
+    }
+
+    public mutating func endObject() {
+        containers.removeLast()
+        buffer.append(UInt8(ascii: "}"))
+    }
+
+    public mutating func beginArray() {
+        beginValue()
+        buffer.append(UInt8(ascii: "["))
+        containers.append(false)
+    }
+
+    public mutating func endArray() {
+        containers.removeLast()
+        buffer.append(UInt8(ascii: "]"))
+    }
+
+    /// Writes an object key known at compile time. It's copied as is, so it can't need escaping.
+    public mutating func key(_ key: StaticString) {
+        beginValue()
+        buffer.append(UInt8(ascii: "\""))
+        key.withUTF8Buffer { buffer.append(contentsOf: $0) }
+        buffer.append(UInt8(ascii: "\""))
+        buffer.append(UInt8(ascii: ":"))
+        expectsValue = true
+    }
+
+    public mutating func key(_ key: String) {
+        beginValue()
+        appendString(key)
+        buffer.append(UInt8(ascii: ":"))
+        expectsValue = true
+    }
+
+    // MARK: - Values
+
+    public mutating func value(_ string: String) {
+        beginValue()
+        appendString(string)
+    }
+
+    public mutating func value(_ bool: Bool) {
+        beginValue()
+        if bool {
+            buffer.append(contentsOf: [UInt8(ascii: "t"), UInt8(ascii: "r"), UInt8(ascii: "u"), UInt8(ascii: "e")])
+        } else {
+            buffer.append(
+                contentsOf: [UInt8(ascii: "f"), UInt8(ascii: "a"), UInt8(ascii: "l"), UInt8(ascii: "s"), UInt8(ascii: "e")])
+        }
+    }
+
+    public mutating func value(_ number: Int) {
+        value(Int64(number))
+    }
+
+    public mutating func value(_ number: Int64) {
+        beginValue()
+        if number < 0 {
+            buffer.append(UInt8(ascii: "-"))
+        }
+        appendDigits(number.magnitude)
+    }
+
+    public mutating func value(_ number: UInt64) {
+        beginValue()
+        appendDigits(number)
+    }
+
+    /// Integral values are written without a fractional part, others with the shortest digits that
+    /// round-trip. Like `JSONEncoder`, throws for infinities and NaN.
+    public mutating func value(_ number: Double) throws {
+        guard number.isFinite else {
+            throw EncodingError.invalidValue(
+                number,
+                EncodingError.Context(codingPath: [], debugDescription: "Unable to encode \(number) directly in JSON.")
+            )
+        }
+
+        // 2^53, past which not every integer is representable
+        if number.magnitude < 9_007_199_254_740_992, number.rounded(.towardZero) == number {
+            value(Int64(number))
+        } else {
+            // short enough to stay in `String`'s inline storage, so this doesn't allocate
+            beginValue()
+            var description = number.description
+            description.withUTF8 { buffer.append(contentsOf: $0) }
+        }
+    }
+
+    public mutating func value(_ number: Float) throws {
+        guard number.isFinite else {
+            throw EncodingError.invalidValue(
+                number,
+                EncodingError.Context(codingPath: [], debugDescription: "Unable to encode \(number) directly in JSON.")
+            )
+        }
+
+        beginValue()
+        var description = number.description
+        if description.hasSuffix(".0") {
+            description.removeLast(2)
+        }
+        description.withUTF8 { buffer.append(contentsOf: $0) }
+    }
+
+    public mutating func null() {
+        beginValue()
+        buffer.append(contentsOf: [UInt8(ascii: "n"), UInt8(ascii: "u"), UInt8(ascii: "l"), UInt8(ascii: "l")])
+    }
+
+    public mutating func value<T: EmbraceJSONWritable>(_ value: T) throws {
+        try value.writeJSON(to: &self)
+    }
+
+    // MARK: - Fields
+
+    public mutating func field<T: EmbraceJSONWritable>(_ key: StaticString, _ value: T) throws {
+        self.key(key)
+        try value.writeJSON(to: &self)
+    }
+
+    /// Writes the field only when `value` isn't nil, like `encodeIfPresent`.
+    public mutating func field<T: EmbraceJSONWritable>(_ key: StaticString, ifPresent value: T?) throws {
+        guard let value else {
+            return
+        }
+        self.key(key)
+        try value.writeJSON(to: &self)
+    }
+
+    // MARK: - Internals
+
+    private mutating func beginValue() {
+        if buffer.count >= flushThreshold {
+            flush()
+        }
+
+        if expectsValue {
+            expectsValue = false
+        } else if let last = containers.indices.last {
+            if containers[last] {
+                buffer.append(UInt8(ascii: ","))
+            } else {
+                containers[last] = true
+            }
+        }
+    }
+
+    private mutating func flush() {
+        guard let sink, !buffer.isEmpty else {
+            return
+        }
+
+        if sinkError == nil {
+            do {
+                try buffer.withUnsafeBytes(sink)
+            } catch {
+                sinkError = error
+            }
+        }
+        buffer.removeAll(keepingCapacity: true)
+    }
+
+    private mutating func appendDigits(_ number: UInt64) {
+        var number = number
+        withUnsafeTemporaryAllocation(of: UInt8.self, capacity: 20) { digits in
+            var index = digits.count
+            repeat {
+                index -= 1
+                digits[index] = UInt8(ascii: "0") &+ UInt8(truncatingIfNeeded: number % 10)
+                number /= 10
+            } while number != 0
+            buffer.append(contentsOf: UnsafeBufferPointer(rebasing: digits[index...]))
+        }
+    }
+
+    private mutating func appendString(_ string: String) {
+        // Swift strings are always valid UTF-8 (bridged strings with broken surrogates are repaired
+        // when transcoded), so the bytes only need escaping, not validating.
+        var string = string
+        buffer.append(UInt8(ascii: "\""))
+        string.withUTF8 { appendEscaped($0) }
+        buffer.append(UInt8(ascii: "\""))
+    }
+
+    /// Copies `utf8`, escaping quotes, backslashes and control characters. Runs of bytes that don't
+    /// need escaping are found 16 at a time and copied in bulk.
+    private mutating func appendEscaped(_ utf8: UnsafeBufferPointer<UInt8>) {
+        guard let base = utf8.baseAddress else {
+            return
+        }
+
+        let count = utf8.count
+        var index = 0
+        var pending = 0  // start of the bytes read but not copied yet
+
+        while index < count {
+            if count &- index >= 16,
+                !Self.needsEscaping(UnsafeRawPointer(base + index).loadUnaligned(as: SIMD16<UInt8>.self))
+            {
+                index &+= 16
+                continue
+            }
+
+            // something in the next 16 bytes (or the tail) needs escaping, find it byte by byte
+            let end = Swift.min(index &+ 16, count)
+            while index < end {
+                let byte = base[index]
+                if byte < 0x20 || byte == UInt8(ascii: "\"") || byte == UInt8(ascii: "\\") {
+                    buffer.append(contentsOf: UnsafeBufferPointer(start: base + pending, count: index &- pending))
+                    appendEscape(for: byte)
+                    pending = index &+ 1
+                }
+                index &+= 1
+            }
+        }
+
+        buffer.append(contentsOf: UnsafeBufferPointer(start: base + pending, count: count &- pending))
+    }
+
+    @inline(__always)
+    private static func needsEscaping(_ chunk: SIMD16<UInt8>) -> Bool {
+        any((chunk .< 0x20) .| (chunk .== UInt8(ascii: "\"")) .| (chunk .== UInt8(ascii: "\\")))
+    }
+
+    private mutating func appendEscape(for byte: UInt8) {
+        buffer.append(UInt8(ascii: "\\"))
+        switch byte {
+        case UInt8(ascii: "\""), UInt8(ascii: "\\"):
+            buffer.append(byte)
+        case 0x08:
+            buffer.append(UInt8(ascii: "b"))
+        case 0x09:
+            buffer.append(UInt8(ascii: "t"))
+        case 0x0A:
+            buffer.append(UInt8(ascii: "n"))
+        case 0x0C:
+            buffer.append(UInt8(ascii: "f"))
+        case 0x0D:
+            buffer.append(UInt8(ascii: "r"))
+        default:
+            let hex: StaticString = "0123456789abcdef"
+            buffer.append(contentsOf: [UInt8(ascii: "u"), UInt8(ascii: "0"), UInt8(ascii: "0")])
+            buffer.append(hex.utf8Start[Int(byte >> 4)])
+            buffer.append(hex.utf8Start[Int(byte & 0x0F)])
+        }
+    }
+}
+
+// MARK: - Standard types
+
+extension String: EmbraceJSONWritable {
+    public func writeJSON(to writer: inout EmbraceJSONWriter) {
+        writer.value(self)
+    }
+}
+
+extension Bool: EmbraceJSONWritable {
+    public func writeJSON(to writer: inout EmbraceJSONWriter) {
+        writer.value(self)
+    }
+}
+
+extension Int: EmbraceJSONWritable {
+    public func writeJSON(to writer: inout EmbraceJSONWriter) {
+        writer.value(self)
+    }
+}
+
+extension Int64: EmbraceJSONWritable {
+    public func writeJSON(to writer: inout EmbraceJSONWriter) {
+        writer.value(self)
+    }
+}
+
+extension UInt64: EmbraceJSONWritable {
+    public func writeJSON(to writer: inout EmbraceJSONWriter) {
+        writer.value(self)
+    }
+}
+
+extension Double: EmbraceJSONWritable {
+    public func writeJSON(to writer: inout EmbraceJSONWriter) throws {
+        try writer.value(self)
+    }
+}
+
+extension Optional: EmbraceJSONWritable where Wrapped: EmbraceJSONWritable {
+    /// Writes `null` for nil, like `encode(_:forKey:)` does with optionals.
+    public func writeJSON(to writer: inout EmbraceJSONWriter) throws {
+        switch self {
+        case .some(let wrapped):
+            try wrapped.writeJSON(to: &writer)
+        case .none:
+            writer.null()
+        }
+    }
+}
+
+extension Array: EmbraceJSONWritable where Element: EmbraceJSONWritable {
+    public func writeJSON(to writer: inout EmbraceJSONWriter) throws {
+        writer.beginArray()
+        for element in self {
+            try element.writeJSON(to: &writer)
+        }
+        writer.endArray()
+    }
+}
+
+extension Dictionary: EmbraceJSONWritable where Key == String, Value: EmbraceJSONWritable {
+    public func writeJSON(to writer: inout EmbraceJSONWriter) throws {
+        writer.beginObject()
+        for (key, value) in self {
+            writer.key(key)
+            try value.writeJSON(to: &writer)
+        }
+        writer.endObject()
+    }
+}
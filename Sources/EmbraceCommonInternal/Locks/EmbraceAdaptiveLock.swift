@@ -0,0 +1,58 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceAtomicsShim
+#endif
+
+/// Mutex that spins briefly before parking the waiting thread.
+///
+/// Same API as `UnfairLock`, for short critical sections that many threads hit at once (logging, span
+/// creation). Waiters spin for about twice as long as spinning recently took to get this lock, so it
+/// adapts to how long the lock is usually held, and then park on an `os_unfair_lock`.
+final public class EmbraceAdaptiveLock {
+    private let _lock: OpaquePointer
+
+    public init() {
+        guard let lock = emb_adaptive_lock_create() else {
+            fatalError("EmbraceAdaptiveLock failed to allocate")
+        }
+        _lock = lock
+    }
+
+    deinit {
+        emb_adaptive_lock_destroy(_lock)
+    }
+
+    public func locked<ReturnValue>(_ f: () throws -> ReturnValue) rethrows -> ReturnValue {
+        emb_adaptive_lock_lock(_lock)
+        defer { emb_adaptive_lock_unlock(_lock) }
+        return try f()
+    }
+}
+
+extension EmbraceAdaptiveLock {
+
+    public func lock() {
+        emb_adaptive_lock_lock(_lock)
+    }
+
+    /// Takes the lock if it's free, without waiting.
+    public func tryLock() -> Bool {
+        emb_adaptive_lock_trylock(_lock)
+    }
+
+    public func unlock() {
+        emb_adaptive_lock_unlock(_lock)
+    }
+
+    /// Moving average of the spins that got the lock, which sizes how long waiters spin.
+    var spinAverage: Int {
+        Int(emb_adaptive_lock_spin_average(_lock))
+    }
+}
+
+extension EmbraceAdaptiveLock: @unchecked Sendable {}
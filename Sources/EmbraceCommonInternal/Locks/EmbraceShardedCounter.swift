@@ -0,0 +1,79 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceAtomicsShim
+#endif
+
+/// Counter for values bumped from many threads and read rarely, like stats.
+///
+/// A single atomic counter bounces its cache line between every core that bumps it. This one spreads
+/// the count over cells on separate cache lines, picked by hashing the calling thread, and sums them
+/// on read. Adding is a relaxed atomic add on a cell that's usually only touched by one thread.
+///
+/// Reads aren't a snapshot: adds that race a read may or may not be included, but none are lost.
+public final class EmbraceShardedCounter {
+
+    /// Bytes between cells, the cache line size on Apple silicon.
+    private static let cellStride = 128
+
+    private let cells: UnsafeMutableRawPointer
+    private let mask: Int
+
+    /// - Parameter shards: Number of cells, rounded up to a power of two. Defaults to one per active core.
+    public init(shards: Int = ProcessInfo.processInfo.activeProcessorCount) {
+        let count = lockFreeCapacity(for: min(max(shards, 1), 64))
+        mask = count - 1
+        cells = UnsafeMutableRawPointer.allocate(byteCount: count * Self.cellStride, alignment: Self.cellStride)
+        for index in 0..<count {
+            Int64._init(cell(index), 0)
+        }
+    }
+
+    deinit {
+        cells.deallocate()
+    }
+
+    public var shards: Int {
+        mask + 1
+    }
+
+    public func add(_ delta: Int64) {
+        _ = Int64._fetchAdd(cell(currentShard), delta, .relaxed)
+    }
+
+    public func increment() {
+        add(1)
+    }
+
+    public func decrement() {
+        add(-1)
+    }
+
+    /// Sum of all the cells.
+    public func load() -> Int64 {
+        (0...mask).reduce(0) { $0 &+ Int64._load(cell($1), .relaxed) }
+    }
+
+    /// Returns the sum and sets the counter back to zero. Adds that race it are kept for the next read.
+    @discardableResult
+    public func reset() -> Int64 {
+        (0...mask).reduce(0) { $0 &+ Int64._exchange(cell($1), 0, .relaxed) }
+    }
+
+    private func cell(_ index: Int) -> UnsafeMutablePointer<emb_atomic_int64_t> {
+        (cells + index * Self.cellStride).assumingMemoryBound(to: emb_atomic_int64_t.self)
+    }
+
+    /// There's no public API for the current core on Apple platforms, so threads are spread by hashing
+    /// their `pthread_t`. Threads that land on the same cell still count correctly, they just share it.
+    private var currentShard: Int {
+        let thread = UInt64(UInt(bitPattern: pthread_self()))
+        return Int(truncatingIfNeeded: (thread &* 0x9E37_79B9_7F4A_7C15) >> 40) & mask
+    }
+}
+
+extension EmbraceShardedCounter: @unchecked Sendable {}
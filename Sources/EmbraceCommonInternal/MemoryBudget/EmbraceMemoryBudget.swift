@@ -0,0 +1,422 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if canImport(os)
+    import os
+#endif
+
+/// Memory budget shared by every telemetry producer in the SDK.
+///
+/// Producers track the bytes they hold in memory (queued spans, logs waiting to be stored, network bodies,
+/// upload payloads) so the SDK as a whole stays under `ceiling`. On top of that, the budget picks a `Level`
+/// from how close the SDK is to the ceiling, how much memory the app has left, memory pressure notifications
+/// and how long uploads have been failing. Each level turns on one more degradation, and every time one of them
+/// drops data it's counted, so it can be reported in the session:
+///
+/// | Level | Degradation |
+/// |---|---|
+/// | `elevated` | Trace and debug logs are dropped |
+/// | `high` | Network spans are sampled, network bodies aren't captured |
+/// | `critical` | Info logs are dropped, attachment uploads are shed |
+///
+/// Reading the level is a few atomic loads, so it can be checked on every log and request.
+/// Nothing is degraded until `bootstrap(enabled: true)` is called, but bytes are tracked either way.
+public final class EmbraceMemoryBudget {
+
+    public static let shared = EmbraceMemoryBudget()
+
+    public static let defaultCeiling = 16 * 1024 * 1024
+
+    public enum Producer: Int, CaseIterable {
+        case spanProcessor
+        case logBatcher
+        case networkBodies
+        case uploads
+
+        public var name: String {
+            switch self {
+            case .spanProcessor: "spans"
+            case .logBatcher: "logs"
+            case .networkBodies: "network_bodies"
+            case .uploads: "uploads"
+            }
+        }
+    }
+
+    public enum Level: Int, Comparable, CaseIterable {
+        case normal
+        case elevated
+        case high
+        case critical
+
+        public var name: String {
+            switch self {
+            case .normal: "normal"
+            case .elevated: "elevated"
+            case .high: "high"
+            case .critical: "critical"
+            }
+        }
+
+        public static func < (lhs: Level, rhs: Level) -> Bool {
+            lhs.rawValue < rhs.rawValue
+        }
+    }
+
+    /// Data dropped by a degradation.
+    public enum Drop: Int, CaseIterable {
+        case debugLogs
+        case infoLogs
+        case networkSpans
+        case networkBodies
+        case uploads
+
+        public var name: String {
+            switch self {
+            case .debugLogs: "debug_logs"
+            case .infoLogs: "info_logs"
+            case .networkSpans: "network_spans"
+            case .networkBodies: "network_bodies"
+            case .uploads: "uploads"
+            }
+        }
+    }
+
+    /// One network span is kept out of this many when they're sampled.
+    static let networkSpanSampleRate: Int64 = 10
+
+    /// How long a memory pressure notification keeps the level up.
+    static let pressureDuration: UInt64 = 60 * 1_000_000_000
+
+    /// How often the memory available to the app is checked.
+    static let availableMemoryInterval: UInt64 = 500_000_000
+
+    /// How long uploads have to fail before the budget treats the backend as unreachable.
+    static let unreachableElevatedAfter: UInt64 = 15 * 60 * 1_000_000_000
+    static let unreachableHighAfter: UInt64 = 60 * 60 * 1_000_000_000
+
+    private let _enabled = EmbraceAtomic<Bool>(false)
+    private let _ceiling: EmbraceAtomic<Int64>
+
+    private let total = EmbraceAtomic<Int64>(0)
+    private let peak = EmbraceAtomic<Int64>(0)
+    private let maxLevel = EmbraceAtomic<Int64>(0)
+    private let bytes = Producer.allCases.map { _ in EmbraceAtomic<Int64>(0) }
+    private let depths = Producer.allCases.map { _ in EmbraceAtomic<Int64>(0) }
+    private let drops = Drop.allCases.map { _ in EmbraceAtomic<Int64>(0) }
+    private let networkSpans = EmbraceAtomic<Int64>(0)
+
+    private let appLevel = EmbraceAtomic<Int64>(0)
+    private let appLevelCheckedAt = EmbraceAtomic<UInt64>(0)
+    private let pressure = EmbraceAtomic<Int64>(0)
+    private let pressureUntil = EmbraceAtomic<UInt64>(0)
+    private let failingSince = EmbraceAtomic<UInt64>(0)
+
+    private let clock: () -> UInt64
+    private let availableMemory: () -> UInt64?
+
+    #if canImport(Darwin)
+        private let pressureSource = EmbraceMutex<DispatchSourceMemoryPressure?>(nil)
+    #endif
+
+    init(
+        ceiling: Int = EmbraceMemoryBudget.defaultCeiling,
+        clock: @escaping () -> UInt64 = { DispatchTime.now().uptimeNanoseconds },
+        availableMemory: @escaping () -> UInt64? = EmbraceMemoryBudget.processAvailableMemory
+    ) {
+        self._ceiling = EmbraceAtomic(Int64(ceiling))
+        self.clock = clock
+        self.availableMemory = availableMemory
+    }
+
+    package func bootstrap(enabled: Bool, ceiling: Int = EmbraceMemoryBudget.defaultCeiling) {
+        _ceiling.store(Int64(ceiling))
+        _enabled.store(enabled)
+
+        #if canImport(Darwin)
+            pressureSource.withLock { source in
+                if enabled && source == nil {
+                    let newSource = DispatchSource.makeMemoryPressureSource(
+                        eventMask: [.warning, .critical],
+                        queue: .global(qos: .utility)
+                    )
+                    newSource.setEventHandler { [weak self, weak newSource] in
+                        guard let event = newSource?.data else {
+                            return
+                        }
+                        self?.reportMemoryPressure(critical: event.contains(.critical))
+                    }
+                    newSource.resume()
+                    source = newSource
+                } else if !enabled, let existing = source {
+                    existing.cancel()
+                    source = nil
+                }
+            }
+        #endif
+    }
+
+    public var isEnabled: Bool {
+        _enabled.load()
+    }
+
+    public var ceiling: Int {
+        Int(_ceiling.load())
+    }
+
+    // MARK: - Tracking
+
+    /// Tracks `bytes` held by `producer` if they fit under the ceiling.
+    /// Returns `false`, without tracking anything, when they don't and the budget is enabled.
+    @discardableResult
+    public func reserve(_ bytes: Int, for producer: Producer) -> Bool {
+        let amount = Int64(bytes)
+        let previous = total.fetchAdd(amount)
+
+        if isEnabled && previous + amount > _ceiling.load() {
+            total.fetchSub(amount)
+            return false
+        }
+
+        self.bytes[producer.rawValue].fetchAdd(amount)
+        depths[producer.rawValue].fetchAdd(1)
+        updatePeak(previous + amount)
+        return true
+    }
+
+    /// Tracks `bytes` held by `producer` that can't be refused, like data that's already in memory.
+    public func track(_ bytes: Int, for producer: Producer) {
+        let amount = Int64(bytes)
+        let previous = total.fetchAdd(amount)
+        self.bytes[producer.rawValue].fetchAdd(amount)
+        depths[producer.rawValue].fetchAdd(1)
+        updatePeak(previous + amount)
+    }
+
+    /// Stops tracking bytes passed to `reserve` or `track`, in `count` calls.
+    public func release(_ bytes: Int, count: Int = 1, for producer: Producer) {
+        let amount = Int64(bytes)
+        total.fetchSub(amount)
+        self.bytes[producer.rawValue].fetchSub(amount)
+        depths[producer.rawValue].fetchSub(Int64(count))
+    }
+
+    /// Bytes currently tracked for every producer.
+    public var trackedBytes: Int {
+        Int(total.load())
+    }
+
+    private func updatePeak(_ value: Int64) {
+        var current = peak.load(order: .relaxed)
+        while value > current && !peak.compareExchange(expected: &current, desired: value) {}
+    }
+
+    // MARK: - Signals
+
+    /// Raises the level for a while, like when the system reports memory pressure.
+    public func reportMemoryPressure(critical: Bool) {
+        pressure.store(Int64(critical ? Level.critical.rawValue : Level.high.rawValue))
+        pressureUntil.store(clock() + Self.pressureDuration)
+    }
+
+    /// Lets the budget know whether uploads reach the backend.
+    public func reportUpload(succeeded: Bool) {
+        if succeeded {
+            failingSince.store(0)
+        } else {
+            failingSince.compareExchange(expected: 0, desired: max(clock(), 1))
+        }
+    }
+
+    // MARK: - Level
+
+    /// The current level, always `normal` when disabled.
+    public var level: Level {
+        guard isEnabled else {
+            return .normal
+        }
+
+        let now = clock()
+        let current = max(ceilingLevel(), appMemoryLevel(now: now), pressureLevel(now: now), backendLevel(now: now))
+
+        let reached = Int64(current.rawValue)
+        var previous = maxLevel.load(order: .relaxed)
+        while reached > previous && !maxLevel.compareExchange(expected: &previous, desired: reached) {}
+
+        return current
+    }
+
+    private func ceilingLevel() -> Level {
+        let ceiling = max(_ceiling.load(), 1)
+        let used = total.load() * 100 / ceiling
+
+        switch used {
+        case ..<50: return .normal
+        case ..<75: return .elevated
+        case ..<90: return .high
+        default: return .critical
+        }
+    }
+
+    /// Same thresholds used to size log batches.
+    private func appMemoryLevel(now: UInt64) -> Level {
+        let checkedAt = appLevelCheckedAt.load(order: .relaxed)
+        if checkedAt == 0 || now &- checkedAt >= Self.availableMemoryInterval {
+            appLevelCheckedAt.store(max(now, 1), order: .relaxed)
+
+            var level = Level.normal
+            if let available = availableMemory() {
+                switch available {
+                case ..<(15 * 1024 * 1024): level = .critical
+                case ..<(30 * 1024 * 1024): level = .high
+                case ..<(50 * 1024 * 1024): level = .elevated
+                default: level = .normal
+                }
+            }
+            appLevel.store(Int64(level.rawValue), order: .relaxed)
+            return level
+        }
+
+        return Level(rawValue: Int(appLevel.load(order: .relaxed))) ?? .normal
+    }
+
+    private func pressureLevel(now: UInt64) -> Level {
+        guard now < pressureUntil.load(order: .relaxed) else {
+            return .normal
+        }
+        return Level(rawValue: Int(pressure.load(order: .relaxed))) ?? .normal
+    }
+
+    /// Data piles up in the upload cache while the backend can't be reached, so slow down what's produced.
+    private func backendLevel(now: UInt64) -> Level {
+        let since = failingSince.load(order: .relaxed)
+        guard since > 0, now > since else {
+            return .normal
+        }
+
+        switch now - since {
+        case Self.unreachableHighAfter...: return .high
+        case Self.unreachableElevatedAfter...: return .elevated
+        default: return .normal
+        }
+    }
+
+    // MARK: - Degradations
+
+    /// Whether a log with `severity` should be kept. Counts it as dropped when it isn't.
+    public func admitsLog(severity: LogSeverity) -> Bool {
+        guard severity.rawValue < LogSeverity.warn.rawValue else {
+            return true
+        }
+
+        let level = self.level
+        if severity.rawValue < LogSeverity.info.rawValue && level >= .elevated {
+            recordDrop(.debugLogs)
+            return false
+        }
+        if level >= .critical {
+            recordDrop(.infoLogs)
+            return false
+        }
+        return true
+    }
+
+    /// Whether a span should be created for a network request. Counts it as dropped when it isn't.
+    public func admitsNetworkSpan() -> Bool {
+        guard level >= .high else {
+            return true
+        }
+
+        if networkSpans.fetchAdd(1) % Self.networkSpanSampleRate == 0 {
+            return true
+        }
+
+        recordDrop(.networkSpans)
+        return false
+    }
+
+    /// Whether network bodies should be captured. Counts a dropped body when they aren't.
+    public func admitsNetworkBody() -> Bool {
+        guard level >= .high else {
+            return true
+        }
+
+        recordDrop(.networkBodies)
+        return false
+    }
+
+    /// Whether low priority uploads, like attachments, should be kept.
+    public var admitsLowPriorityUploads: Bool {
+        level < .critical
+    }
+
+    public func recordDrop(_ drop: Drop, _ count: Int = 1) {
+        drops[drop.rawValue].fetchAdd(Int64(count))
+    }
+
+    // MARK: - Reporting
+
+    public struct Snapshot {
+        /// Bytes tracked and outstanding reservations, by producer.
+        public let bytes: [Producer: Int]
+        public let depths: [Producer: Int]
+        /// Most bytes tracked at once since the last reset.
+        public let peakBytes: Int
+        /// Highest level seen since the last reset.
+        public let maxLevel: Level
+        /// Data dropped since the last reset. Drops that didn't happen are left out.
+        public let drops: [Drop: Int]
+
+        /// Whether the budget had to step in.
+        public var isDegraded: Bool {
+            maxLevel > .normal || !drops.isEmpty
+        }
+    }
+
+    /// The tracked bytes, plus the peak, level and drops since the last reset.
+    /// When `reset` is `true`, the peak, level and drops start over.
+    public func snapshot(reset: Bool = false) -> Snapshot {
+        var bytes: [Producer: Int] = [:]
+        var depths: [Producer: Int] = [:]
+        for producer in Producer.allCases {
+            bytes[producer] = Int(self.bytes[producer.rawValue].load())
+            depths[producer] = Int(self.depths[producer.rawValue].load())
+        }
+
+        var drops: [Drop: Int] = [:]
+        for drop in Drop.allCases {
+            let value = reset ? self.drops[drop.rawValue].exchange(0) : self.drops[drop.rawValue].load()
+            if value > 0 {
+                drops[drop] = Int(value)
+            }
+        }
+
+        let peakBytes = reset ? peak.exchange(total.load()) : peak.load()
+        let maxLevel = reset ? self.maxLevel.exchange(0) : self.maxLevel.load()
+
+        return Snapshot(
+            bytes: bytes,
+            depths: depths,
+            peakBytes: Int(peakBytes),
+            maxLevel: Level(rawValue: Int(maxLevel)) ?? .normal,
+            drops: drops
+        )
+    }
+
+    // MARK: - Available memory
+
+    /// `nil` where the process has no memory limit, like on macOS and in the simulator.
+    static func processAvailableMemory() -> UInt64? {
+        #if os(iOS) || os(tvOS) || os(watchOS)
+            let available = os_proc_available_memory()
+            return available > 0 ? UInt64(available) : nil
+        #else
+            return nil
+        #endif
+    }
+}
+
+extension EmbraceMemoryBudget: @unchecked Sendable {}
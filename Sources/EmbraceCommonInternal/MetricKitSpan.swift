@@ -10,6 +10,7 @@ import os
 
     /// Represents a MetricKit signpost interval for SDK performance monitoring
     /// Signposts are automatically collected by MetricKit and included in MXMetricPayload
+    /// The duration is also recorded in `EmbraceSelfMetrics` when it's enabled
     @available(iOS 13.0, macOS 12.0, *)
     public class EmbraceMetricKitSpan {
 
@@ -21,15 +22,18 @@ import os
         public static func begin(name: StaticString, force: Bool = false) -> EmbraceMetricKitSpan {
             let logged = force || enabled
             let id: OSSignpostID? = logged ? OSSignpostID(log: Self.log) : nil
-            return EmbraceMetricKitSpan(name: name, signpostId: id)
+            return EmbraceMetricKitSpan(name: name, signpostId: id, histogram: EmbraceSelfMetrics.shared.histogram(name))
         }
 
         /// Ends the signpost interval
         public func end() {
-            guard let signpostId, hasEnded.compareExchange(expected: false, desired: true) else {
+            guard signpostId != nil || histogram != nil, hasEnded.compareExchange(expected: false, desired: true) else {
                 return
             }
-            os_signpost(.end, log: Self.log, name: name, signpostID: signpostId)
+            histogram?.record(since: start)
+            if let signpostId {
+                os_signpost(.end, log: Self.log, name: name, signpostID: signpostId)
+            }
         }
 
         // MARK: - Private
@@ -48,10 +52,14 @@ import os
         private let name: StaticString
         private let hasEnded = EmbraceAtomic<Bool>(false)
         private let signpostId: OSSignpostID?
+        private let histogram: EmbraceLatencyHistogram?
+        private let start: UInt64
 
-        private init(name: StaticString, signpostId: OSSignpostID?) {
+        private init(name: StaticString, signpostId: OSSignpostID?, histogram: EmbraceLatencyHistogram?) {
             self.name = name
             self.signpostId = signpostId
+            self.histogram = histogram
+            self.start = histogram != nil ? EmbraceLatencyHistogram.now() : 0
             if let signpostId {
                 os_signpost(.begin, log: Self.log, name: name, signpostID: signpostId)
             }
@@ -64,12 +72,33 @@ import os
 
 #else
 
+    /// No signposts outside of iOS, only the duration recorded in `EmbraceSelfMetrics` when it's enabled
     public class EmbraceMetricKitSpan {
         public static func begin(name: StaticString, force: Bool = false) -> EmbraceMetricKitSpan {
-            EmbraceMetricKitSpan()
+            EmbraceMetricKitSpan(histogram: EmbraceSelfMetrics.shared.histogram(name))
+        }
+
+        public func end() {
+            guard let histogram, hasEnded.compareExchange(expected: false, desired: true) else {
+                return
+            }
+            histogram.record(since: start)
         }
-        public func end() {}
+
         package static func bootstrap(enabled: Bool) {}
+
+        private let hasEnded = EmbraceAtomic<Bool>(false)
+        private let histogram: EmbraceLatencyHistogram?
+        private let start: UInt64
+
+        private init(histogram: EmbraceLatencyHistogram?) {
+            self.histogram = histogram
+            self.start = histogram != nil ? EmbraceLatencyHistogram.now() : 0
+        }
+
+        deinit {
+            end()
+        }
     }
 
 #endif
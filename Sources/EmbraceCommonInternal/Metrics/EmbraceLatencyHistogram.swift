@@ -0,0 +1,201 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceAtomicsShim
+#endif
+
+/// Latency histogram for durations recorded from many threads, in the style of HdrHistogram.
+///
+/// Values are nanoseconds. Below 32ns every value has its own bucket. Above that, every power of two is
+/// split in 16 buckets, so a reported value is never more than 1/16 away from the recorded one.
+/// Values of 2^37ns (about two minutes) or more are counted in the last bucket.
+///
+/// Like `EmbraceShardedCounter`, the counts are spread over shards picked by hashing the calling thread,
+/// so recording is a few relaxed atomic adds on memory that's usually only touched by one thread.
+/// Snapshots aren't atomic: values recorded while one is taken may or may not be included, but none are lost.
+public final class EmbraceLatencyHistogram {
+
+    static let linearBuckets = 32
+    static let subBuckets = 16
+    static let maxMagnitude = 36
+    static let bucketCount = linearBuckets + (maxMagnitude - 4) * subBuckets
+
+    /// count, sum and max, then the bucket counts.
+    private static let headerSize = 3 * MemoryLayout<Int64>.stride
+    private static let shardStride: Int = {
+        let size = headerSize + bucketCount * MemoryLayout<UInt32>.stride
+        return (size + 127) / 128 * 128
+    }()
+
+    public let name: String
+    private let shards: UnsafeMutableRawPointer
+    private let mask: Int
+
+    /// - Parameters:
+    ///   - name: Name the values are reported with.
+    ///   - shards: Number of shards, rounded up to a power of two. Each one takes about 2KB.
+    public init(name: String, shards: Int = min(ProcessInfo.processInfo.activeProcessorCount, 4)) {
+        self.name = name
+
+        let count = lockFreeCapacity(for: min(max(shards, 1), 16))
+        mask = count - 1
+        self.shards = UnsafeMutableRawPointer.allocate(byteCount: count * Self.shardStride, alignment: 128)
+        for shard in 0..<count {
+            Int64._init(cell(shard, 0), 0)
+            Int64._init(cell(shard, 1), 0)
+            Int64._init(cell(shard, 2), 0)
+            for index in 0..<Self.bucketCount {
+                UInt32._init(bucket(shard, index), 0)
+            }
+        }
+    }
+
+    deinit {
+        shards.deallocate()
+    }
+
+    /// Records a duration in nanoseconds.
+    public func record(nanoseconds: UInt64) {
+        let shard = currentShard
+        let value = Int64(clamping: nanoseconds)
+
+        _ = Int64._fetchAdd(cell(shard, 0), 1, .relaxed)
+        _ = Int64._fetchAdd(cell(shard, 1), value, .relaxed)
+        _ = UInt32._fetchAdd(bucket(shard, Self.index(of: nanoseconds)), 1, .relaxed)
+
+        var max = Int64._load(cell(shard, 2), .relaxed)
+        while value > max && !Int64._compareExchange(cell(shard, 2), &max, value, .relaxed, .relaxed) {}
+    }
+
+    /// Records the time elapsed since `start`, a value from `EmbraceLatencyHistogram.now()`.
+    public func record(since start: UInt64) {
+        let end = Self.now()
+        record(nanoseconds: end > start ? end - start : 0)
+    }
+
+    /// Monotonic timestamp in nanoseconds, to measure durations with.
+    @inline(__always)
+    public static func now() -> UInt64 {
+        DispatchTime.now().uptimeNanoseconds
+    }
+
+    /// Adds up the shards. When `reset` is `true`, the histogram starts over from zero.
+    public func snapshot(reset: Bool = false) -> Snapshot {
+        var snapshot = Snapshot(name: name)
+        snapshot.buckets.reserveCapacity(Self.bucketCount)
+        snapshot.buckets = [UInt64](repeating: 0, count: Self.bucketCount)
+
+        for shard in 0...mask {
+            if reset {
+                snapshot.count += UInt64(Int64._exchange(cell(shard, 0), 0, .relaxed))
+                snapshot.sum += UInt64(Int64._exchange(cell(shard, 1), 0, .relaxed))
+                snapshot.max = Swift.max(snapshot.max, UInt64(Int64._exchange(cell(shard, 2), 0, .relaxed)))
+            } else {
+                snapshot.count += UInt64(Int64._load(cell(shard, 0), .relaxed))
+                snapshot.sum += UInt64(Int64._load(cell(shard, 1), .relaxed))
+                snapshot.max = Swift.max(snapshot.max, UInt64(Int64._load(cell(shard, 2), .relaxed)))
+            }
+
+            for index in 0..<Self.bucketCount {
+                let count = reset ? UInt32._exchange(bucket(shard, index), 0, .relaxed) : UInt32._load(bucket(shard, index), .relaxed)
+                snapshot.buckets[index] += UInt64(count)
+            }
+        }
+
+        return snapshot
+    }
+
+    public struct Snapshot {
+        public let name: String
+        public internal(set) var count: UInt64 = 0
+        public internal(set) var sum: UInt64 = 0
+        public internal(set) var max: UInt64 = 0
+        var buckets: [UInt64] = []
+
+        init(name: String) {
+            self.name = name
+        }
+
+        public var mean: UInt64 {
+            count == 0 ? 0 : sum / count
+        }
+
+        /// The highest value that `percentile` percent of the recorded values are equal to or below of,
+        /// within the precision of the buckets. Never more than the max recorded value.
+        public func value(atPercentile percentile: Double) -> UInt64 {
+            let total = buckets.reduce(0, +)
+            guard total > 0 else {
+                return 0
+            }
+
+            let target = Swift.max(1, UInt64((Swift.min(Swift.max(percentile, 0), 100) / 100 * Double(total)).rounded(.up)))
+            var seen: UInt64 = 0
+            for (index, count) in buckets.enumerated() {
+                seen += count
+                if seen >= target {
+                    return Swift.min(EmbraceLatencyHistogram.highestValue(inBucket: index), max)
+                }
+            }
+            return max
+        }
+    }
+
+    // MARK: - Buckets
+
+    static func index(of value: UInt64) -> Int {
+        guard value >= UInt64(linearBuckets) else {
+            return Int(value)
+        }
+
+        let magnitude = UInt64.bitWidth - 1 - value.leadingZeroBitCount
+        guard magnitude <= maxMagnitude else {
+            return bucketCount - 1
+        }
+
+        // the top five bits of the value, the first one always set
+        let subBucket = Int(value >> (magnitude - 4)) - subBuckets
+        return linearBuckets + (magnitude - 5) * subBuckets + subBucket
+    }
+
+    static func lowestValue(inBucket index: Int) -> UInt64 {
+        guard index >= linearBuckets else {
+            return UInt64(index)
+        }
+
+        let magnitude = (index - linearBuckets) / subBuckets + 5
+        let subBucket = (index - linearBuckets) % subBuckets + subBuckets
+        return UInt64(subBucket) << (magnitude - 4)
+    }
+
+    static func highestValue(inBucket index: Int) -> UInt64 {
+        guard index >= linearBuckets else {
+            return UInt64(index)
+        }
+
+        let magnitude = (index - linearBuckets) / subBuckets + 5
+        return lowestValue(inBucket: index) + (1 << (magnitude - 4)) - 1
+    }
+
+    // MARK: - Shards
+
+    private func cell(_ shard: Int, _ index: Int) -> UnsafeMutablePointer<emb_atomic_int64_t> {
+        (shards + shard * Self.shardStride + index * MemoryLayout<Int64>.stride).assumingMemoryBound(to: emb_atomic_int64_t.self)
+    }
+
+    private func bucket(_ shard: Int, _ index: Int) -> UnsafeMutablePointer<emb_atomic_uint32_t> {
+        (shards + shard * Self.shardStride + Self.headerSize + index * MemoryLayout<UInt32>.stride)
+            .assumingMemoryBound(to: emb_atomic_uint32_t.self)
+    }
+
+    /// Same spreading as `EmbraceShardedCounter`.
+    private var currentShard: Int {
+        let thread = UInt64(UInt(bitPattern: pthread_self()))
+        return Int(truncatingIfNeeded: (thread &* 0x9E37_79B9_7F4A_7C15) >> 40) & mask
+    }
+}
+
+extension EmbraceLatencyHistogram: @unchecked Sendable {}
@@ -0,0 +1,134 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+/// Latency histograms and counters for the SDK's own hot paths.
+///
+/// Durations of `EmbraceMetricKitSpan` intervals are recorded here by name, so they're available on every
+/// platform and not only in MetricKit payloads. The values are reported, and reset, when a session ends.
+/// Nothing is recorded until `bootstrap(enabled: true)` is called.
+public final class EmbraceSelfMetrics {
+
+    public static let shared = EmbraceSelfMetrics()
+
+    private let _enabled = EmbraceAtomic<Bool>(false)
+    private let histograms = EmbraceSnapshot<[String: EmbraceLatencyHistogram]>([:])
+    private let staticHistograms = EmbraceSnapshot<[UnsafeRawPointer: EmbraceLatencyHistogram]>([:])
+    private let counters = EmbraceSnapshot<[String: EmbraceShardedCounter]>([:])
+
+    init() {}
+
+    package func bootstrap(enabled: Bool) {
+        _enabled.store(enabled)
+    }
+
+    public var isEnabled: Bool {
+        _enabled.load()
+    }
+
+    /// The histogram for `name`, created on first use. `nil` when disabled.
+    public func histogram(_ name: String) -> EmbraceLatencyHistogram? {
+        guard isEnabled else {
+            return nil
+        }
+
+        if let histogram = histograms.read({ $0[name] }) {
+            return histogram
+        }
+
+        return histograms.update { current in
+            guard current[name] == nil else {
+                return current
+            }
+            var updated = current
+            updated[name] = EmbraceLatencyHistogram(name: name)
+            return updated
+        }[name]
+    }
+
+    /// Same as `histogram(_:)` for names known at compile time, looked up by the address of the literal
+    /// so it doesn't build a `String` on every call. Shares histograms with the `String` lookup.
+    public func histogram(_ name: StaticString) -> EmbraceLatencyHistogram? {
+        guard isEnabled else {
+            return nil
+        }
+
+        guard name.hasPointerRepresentation else {
+            return histogram(name.description)
+        }
+
+        let key = UnsafeRawPointer(name.utf8Start)
+        if let histogram = staticHistograms.read({ $0[key] }) {
+            return histogram
+        }
+
+        guard let histogram = histogram(name.description) else {
+            return nil
+        }
+
+        staticHistograms.update { current in
+            var updated = current
+            updated[key] = histogram
+            return updated
+        }
+        return histogram
+    }
+
+    /// Records a duration in the histogram for `name`.
+    public func record(_ name: String, nanoseconds: UInt64) {
+        histogram(name)?.record(nanoseconds: nanoseconds)
+    }
+
+    /// Adds to the counter for `name`.
+    public func count(_ name: String, _ delta: Int64 = 1) {
+        guard isEnabled else {
+            return
+        }
+
+        if let counter = counters.read({ $0[name] }) {
+            counter.add(delta)
+            return
+        }
+
+        counters.update { current in
+            guard current[name] == nil else {
+                return current
+            }
+            var updated = current
+            updated[name] = EmbraceShardedCounter(shards: 4)
+            return updated
+        }[name]?.add(delta)
+    }
+
+    /// Everything recorded so far. Histograms and counters with no values are left out.
+    /// When `reset` is `true`, everything starts over from zero.
+    public func snapshot(reset: Bool = false) -> Snapshot {
+        let histograms = histograms.load().values
+            .map { $0.snapshot(reset: reset) }
+            .filter { $0.count > 0 }
+            .sorted { $0.name < $1.name }
+
+        var counters: [String: Int64] = [:]
+        for (name, counter) in self.counters.load() {
+            let value = reset ? counter.reset() : counter.load()
+            if value != 0 {
+                counters[name] = value
+            }
+        }
+
+        return Snapshot(histograms: histograms, counters: counters)
+    }
+
+    public struct Snapshot {
+        public let histograms: [EmbraceLatencyHistogram.Snapshot]
+        public let counters: [String: Int64]
+
+        public var isEmpty: Bool {
+            histograms.isEmpty && counters.isEmpty
+        }
+    }
+}
+
+extension EmbraceSelfMetrics: @unchecked Sendable {}
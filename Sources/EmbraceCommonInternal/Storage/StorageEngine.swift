@@ -0,0 +1,27 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+/// Database engine backing the SDK storage and upload cache.
+public enum StorageEngine {
+    /// Core Data store.
+    case coreData
+
+    /// SQLite store with write-ahead logging and cached prepared statements.
+    case sqlite
+}
+
+extension StorageMechanism {
+
+    /// URL of the SQLite engine's database file, if the storage is on disk.
+    public var sqliteFileURL: URL? {
+        switch self {
+        case .onDisk(let name, let url, _):
+            return url.appendingPathComponent(name + ".db")
+
+        default: return nil
+        }
+    }
+}
@@ -163,4 +163,12 @@ extension EmbraceConfig /* EmbraceConfigurable delegation */ {
     public var useNewStorageForSpanEvents: Bool {
         configurable.useNewStorageForSpanEvents
     }
+
+    public var isSpanSnapshotDiffingEnabled: Bool {
+        configurable.isSpanSnapshotDiffingEnabled
+    }
+
+    public var isMemoryBudgetEnabled: Bool {
+        configurable.isMemoryBudgetEnabled
+    }
 }
@@ -163,6 +163,10 @@ extension RemoteConfig: EmbraceConfigurable {
 
     public var useNewStorageForSpanEvents: Bool { payload.useNewStorageForSpanEvents }
 
+    public var isSpanSnapshotDiffingEnabled: Bool { payload.spanSnapshotDiffingEnabled }
+
+    public var isMemoryBudgetEnabled: Bool { payload.memoryBudgetEnabled }
+
     public func update(completion: @escaping (Bool, (any Error)?) -> Void) {
         guard updating == false else {
             completion(false, nil)
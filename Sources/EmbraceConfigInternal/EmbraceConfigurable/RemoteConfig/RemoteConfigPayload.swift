@@ -54,6 +54,10 @@ public struct RemoteConfigPayload: Decodable, Equatable {
 
     var useNewStorageForSpanEvents: Bool
 
+    var spanSnapshotDiffingEnabled: Bool
+
+    var memoryBudgetEnabled: Bool
+
     enum CodingKeys: String, CodingKey {
         case sdkEnabledThreshold = "threshold"
 
@@ -110,6 +114,8 @@ public struct RemoteConfigPayload: Decodable, Equatable {
         case networkPayLoadCapture = "network_capture"
         case useLegacyUrlSessionProxy = "use_legacy_urlsession_proxy"
         case useNewStorageForSpanEvents = "use_new_storage_for_span_events"
+        case spanSnapshotDiffingEnabled = "span_snapshot_diffing_enabled"
+        case memoryBudgetEnabled = "memory_budget_enabled"
     }
 
     public init(from decoder: Decoder) throws {
@@ -376,6 +382,20 @@ public struct RemoteConfigPayload: Decodable, Equatable {
                 Bool.self,
                 forKey: .useNewStorageForSpanEvents
             ) ?? defaultPayload.useNewStorageForSpanEvents
+
+        // only send span snapshots that changed
+        spanSnapshotDiffingEnabled =
+            try rootContainer.decodeIfPresent(
+                Bool.self,
+                forKey: .spanSnapshotDiffingEnabled
+            ) ?? defaultPayload.spanSnapshotDiffingEnabled
+
+        // degrade telemetry under memory pressure
+        memoryBudgetEnabled =
+            try rootContainer.decodeIfPresent(
+                Bool.self,
+                forKey: .memoryBudgetEnabled
+            ) ?? defaultPayload.memoryBudgetEnabled
     }
 
     // defaults
@@ -419,6 +439,8 @@ public struct RemoteConfigPayload: Decodable, Equatable {
         networkPayloadCaptureRules = []
         useLegacyUrlSessionProxy = false
         useNewStorageForSpanEvents = false
+        spanSnapshotDiffingEnabled = false
+        memoryBudgetEnabled = true
     }
 }
 
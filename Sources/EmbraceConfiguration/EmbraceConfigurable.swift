@@ -49,6 +49,10 @@ import Foundation
 
     var traceparentInjectionEnabled: Bool { get }
 
+    var isSpanSnapshotDiffingEnabled: Bool { get }
+
+    var isMemoryBudgetEnabled: Bool { get }
+
     /// Tell the configurable implementation it should update if possible.
     /// - Parameters:
     ///     - completion: A completion block that takes two parameters (didChange, error). Completion block should pass `true`
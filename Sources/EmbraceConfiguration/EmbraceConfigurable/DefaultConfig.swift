@@ -47,6 +47,10 @@ public class DefaultConfig: EmbraceConfigurable {
 
     public let traceparentInjectionEnabled: Bool = false
 
+    public let isSpanSnapshotDiffingEnabled: Bool = false
+
+    public let isMemoryBudgetEnabled: Bool = true
+
     public func update(completion: (Bool, (any Error)?) -> Void) {
         completion(false, nil)
     }
@@ -13,6 +13,9 @@ public final class NetworkPayloadCaptureRule: NSObject, Decodable {
     public let expiration: Double
     public let publicKey: String
 
+    /// Maximum number of response body bytes to capture, if the rule sets one.
+    public let maxBodySize: Int?
+
     public var expirationDate: Date {
         return creationDate.addingTimeInterval(expiration)
     }
@@ -25,7 +28,8 @@ public final class NetworkPayloadCaptureRule: NSObject, Decodable {
         statusCodes: [Int]?,
         method: String?,
         expiration: Double,
-        publicKey: String
+        publicKey: String,
+        maxBodySize: Int? = nil
     ) {
         self.id = id
         self.urlRegex = urlRegex
@@ -33,6 +37,7 @@ public final class NetworkPayloadCaptureRule: NSObject, Decodable {
         self.method = method
         self.expiration = expiration
         self.publicKey = publicKey
+        self.maxBodySize = maxBodySize
     }
 }
 
@@ -44,6 +49,7 @@ extension NetworkPayloadCaptureRule {
         case method
         case expiration = "expires_in"
         case publicKey = "public_key"
+        case maxBodySize = "max_body_size"
     }
 }
 
@@ -242,8 +242,6 @@ extension EmbraceBacktrace {
             return []
         }
 
-        // get the mach thread to take the snapshot of
-        let machThread = pthread_mach_thread_np(thread)
         let canSuspend = pthread_self() != thread
 
         // Drop the SDK's own capture frames (present only on self-capture; see `selfCaptureFrameSkip`).
@@ -254,25 +252,14 @@ extension EmbraceBacktrace {
         if canSuspend {
             // Deadlock hazard: if the suspended thread holds the allocator lock, any `malloc` in the
             // suspend window hangs the process. So allocate the buffer before the suspend and do all
-            // heap work (copy/slice) after the resume — only the alloc-free
-            // `backtrace(of:into:capacity:)` runs in the window.
+            // heap work (copy/slice) after the resume — only `walkSuspended` runs in the window.
             let buffer = UnsafeMutablePointer<FrameAddress>.allocate(capacity: entries)
             defer { buffer.deallocate() }
 
-            guard emb_thread_suspend(machThread) == KERN_SUCCESS else {
+            guard let count = walkSuspended(thread, with: backtracer, into: buffer, capacity: entries) else {
                 Embrace.logger.warning("[EmbraceBacktrace] error suspending thread")
                 return []
             }
-            // ───── SUSPEND WINDOW: allocation-free / async-signal-safe only ─────
-            #if DEBUG
-                EmbraceBacktraceSuspendWindowProbe.willEnter?()
-            #endif
-            let count = backtracer.backtrace(of: thread, into: buffer, capacity: entries)
-            #if DEBUG
-                EmbraceBacktraceSuspendWindowProbe.didExit?()
-            #endif
-            // ───── END SUSPEND WINDOW ─────
-            emb_thread_resume(machThread)
 
             addresses =
                 Array(UnsafeBufferPointer(start: buffer, count: max(0, count)))
@@ -301,6 +288,45 @@ extension EmbraceBacktrace {
     }
 }
 
+extension EmbraceBacktrace {
+
+    /// Suspends `thread`, walks its stack into caller-owned `buffer`, and resumes it.
+    ///
+    /// Performs **no heap allocation** end to end, so callers that preallocate `buffer` (e.g. the
+    /// hang sampler's slot ring) get a completely allocation-free capture. Logging is left to the
+    /// caller, outside any window it cares about.
+    ///
+    /// - Returns: the number of frames written (≤ `capacity`), or `nil` if `thread` is the calling
+    ///   thread (it can't suspend itself) or it could not be suspended.
+    static func walkSuspended(
+        _ thread: pthread_t,
+        with backtracer: Backtracer,
+        into buffer: UnsafeMutablePointer<FrameAddress>,
+        capacity: Int
+    ) -> Int? {
+        guard pthread_self() != thread else {
+            return nil
+        }
+
+        let machThread = pthread_mach_thread_np(thread)
+        guard emb_thread_suspend(machThread) == KERN_SUCCESS else {
+            return nil
+        }
+        // ───── SUSPEND WINDOW: allocation-free / async-signal-safe only ─────
+        #if DEBUG
+            EmbraceBacktraceSuspendWindowProbe.willEnter?()
+        #endif
+        let count = backtracer.backtrace(of: thread, into: buffer, capacity: capacity)
+        #if DEBUG
+            EmbraceBacktraceSuspendWindowProbe.didExit?()
+        #endif
+        // ───── END SUSPEND WINDOW ─────
+        emb_thread_resume(machThread)
+
+        return Swift.min(Swift.max(0, count), capacity)
+    }
+}
+
 extension EmbraceBacktraceFrame {
 
     static let moduleNameKey = "m"
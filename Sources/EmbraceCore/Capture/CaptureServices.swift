@@ -158,6 +158,24 @@ final class CaptureServices {
         }
     }
 
+    /// Installs and starts the services that belong to the given startup phase.
+    /// The crash reporter is installed with the critical phase.
+    func installAndStart(phase: EmbraceStartupPhase) {
+        if phase == .critical {
+            crashReporter?.install(context: context)
+        }
+
+        let services = services.filter { $0.startupPhase == phase }
+
+        for service in services {
+            service.install(otel: Embrace.client, logger: Embrace.logger)
+        }
+
+        for service in services {
+            service.start()
+        }
+    }
+
     func stop() {
         for service in services {
             service.stop()
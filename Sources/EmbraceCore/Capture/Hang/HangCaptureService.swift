@@ -27,7 +27,7 @@ import OpenTelemetryApi
         public init(
             limits: HangLimits = HangLimits()
         ) {
-            self.limitData = EmbraceMutex(MutableLimitData(limits: limits))
+            self.limitsSnapshot = EmbraceSnapshot(limits)
             super.init()
         }
 
@@ -108,14 +108,14 @@ import OpenTelemetryApi
 
         public override func onConfigUpdated(_ config: any EmbraceConfigurable) {
             let newLimits = config.hangLimits
-            let monitorNeedsUpdate = limitData.withLock {
-                let changed =
-                    $0.limits.hangThreshold != newLimits.hangThreshold
-                    || ($0.limits.hangPerSession == 0) != (newLimits.hangPerSession == 0)
-                    || $0.limits.sampleTriggerThreshold != newLimits.sampleTriggerThreshold
-                    || $0.limits.samplePollInterval != newLimits.samplePollInterval
-                $0.limits = newLimits
-                return changed
+            var monitorNeedsUpdate = false
+            limitsSnapshot.update { oldLimits in
+                monitorNeedsUpdate =
+                    oldLimits.hangThreshold != newLimits.hangThreshold
+                    || (oldLimits.hangPerSession == 0) != (newLimits.hangPerSession == 0)
+                    || oldLimits.sampleTriggerThreshold != newLimits.sampleTriggerThreshold
+                    || oldLimits.samplePollInterval != newLimits.samplePollInterval
+                return newLimits
             }
             // Only rebuild the live detector/sampler while active. If the service isn't running the
             // new limits are stored above and applied the next time `onStart()` runs — a config
@@ -125,22 +125,24 @@ import OpenTelemetryApi
         }
 
         struct MutableLimitData {
-            var limits: HangLimits = HangLimits()
             var hangsInSessionCount: UInt = 0
             var watchdog: FrameRateMonitor?
             var sampler: MainThreadStackSampler?
         }
-        let limitData: EmbraceMutex<MutableLimitData>
+        let limitData = EmbraceMutex(MutableLimitData())
+
+        /// Read on the main thread for every hang, so readers shouldn't wait on a config update.
+        private let limitsSnapshot: EmbraceSnapshot<HangLimits>
 
         private let spanQueue = DispatchQueue(label: "io.embrace.hang.service")
         private var span: OpenTelemetryApi.Span?
 
         public var limits: HangLimits {
             get {
-                limitData.withLock { $0.limits }
+                limitsSnapshot.load()
             }
             set {
-                limitData.withLock { $0.limits = newValue }
+                limitsSnapshot.publish(newValue)
             }
         }
     }
@@ -154,6 +156,7 @@ import OpenTelemetryApi
 
             logger?.debug("[FrameRateMonitor] Hang started, at \(at) after \(Int(duration * 1000)) ms")
 
+            let limits = self.limits
             if limits.reportsWatchdogEvents {
                 NotificationCenter.default.post(
                     name: .hangEventStarted,
@@ -162,16 +165,16 @@ import OpenTelemetryApi
             }
 
             let canStart = limitData.withLock {
-                guard $0.hangsInSessionCount < $0.limits.hangPerSession else {
+                guard $0.hangsInSessionCount < limits.hangPerSession else {
                     return false
                 }
                 $0.hangsInSessionCount += 1
                 return true
             }
             guard canStart else {
-                let limitData = limitData.withLock { $0 }
+                let hangsInSessionCount = limitData.withLock { $0.hangsInSessionCount }
                 logger?.warning(
-                    "[FrameRateMonitor] Dropping hang due to surpassing limit, \(limitData.hangsInSessionCount) of \(limitData.limits.hangPerSession)")
+                    "[FrameRateMonitor] Dropping hang due to surpassing limit, \(hangsInSessionCount) of \(limits.hangPerSession)")
                 return
             }
 
@@ -292,8 +295,9 @@ import OpenTelemetryApi
             let frameCount: Int
             let stackString: String
             do {
-                let jsonData = try JSONSerialization.data(withJSONObject: frames, options: [])
-                stackString = jsonData.base64EncodedString()
+                var writer = EmbraceJSONWriter()
+                try writer.value(jsonObject: frames)
+                stackString = writer.data.base64EncodedString()
                 frameCount = frames.count
             } catch let exception {
                 stackString = ""
@@ -0,0 +1,167 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+#if !os(watchOS) && !os(macOS)
+
+    import Foundation
+
+    #if !EMBRACE_COCOAPOD_BUILDING_SDK
+        import EmbraceCommonInternal
+    #endif
+
+    /// Fixed-capacity ring of preallocated, fixed-size frame slots backing `StallTriggeredSampler`.
+    ///
+    /// All memory — the frame slots and the per-slot metadata — is allocated once in `init`. After
+    /// that, `write(_:)` performs **no heap allocation**, so the stack walk can write directly into
+    /// slot memory while the main thread is suspended (and possibly holding the malloc lock).
+    ///
+    /// Concurrency model:
+    /// - **Single writer.** Only the sampler's poll thread calls `write(_:)`.
+    /// - **Lock-free readers.** Each slot is guarded by a sequence counter (a seqlock): the writer
+    ///   makes it odd while the slot is being filled and even again once it is consistent. Readers
+    ///   copy a slot out and retry-or-skip if the counter moved underneath them, so they never block
+    ///   the writer and the writer never waits on them.
+    /// - Each slot also records the ordinal of the sample it holds, so a reader that races a full
+    ///   wrap-around can tell a slot was reused and drop it instead of returning samples out of order.
+    final class MainThreadSampleRing {
+
+        /// What the writer's fill closure reports back once it has written frames into a slot.
+        typealias Capture = (timestamp: UInt64, overhead: UInt64, count: Int)
+
+        /// Number of slots in the ring.
+        let capacity: Int
+
+        /// Frames each slot can hold.
+        let framesPerSlot: Int
+
+        /// Total samples ever committed. Slot for ordinal `n` is `n % capacity`.
+        private let written = EmbraceAtomic<UInt64>(0)
+
+        /// Per-slot seqlock counters. Odd while the writer owns the slot.
+        private let sequences: [EmbraceAtomic<UInt64>]
+
+        // Slot payload. Plain memory, published through `sequences`.
+        private let ordinals: UnsafeMutablePointer<UInt64>
+        private let timestamps: UnsafeMutablePointer<UInt64>
+        private let overheads: UnsafeMutablePointer<UInt64>
+        private let counts: UnsafeMutablePointer<Int>
+        private let frames: UnsafeMutablePointer<FrameAddress>
+
+        /// - Parameters:
+        ///   - capacity: number of samples retained; older ones are overwritten. Clamped to at least 1.
+        ///   - framesPerSlot: max frames stored per sample. Clamped to at least 1.
+        init(capacity: Int, framesPerSlot: Int = EmbraceBacktrace.maxCapturedFrames) {
+            self.capacity = Swift.max(1, capacity)
+            self.framesPerSlot = Swift.max(1, framesPerSlot)
+
+            sequences = (0..<self.capacity).map { _ in EmbraceAtomic<UInt64>(0) }
+
+            ordinals = .allocate(capacity: self.capacity)
+            ordinals.initialize(repeating: 0, count: self.capacity)
+            timestamps = .allocate(capacity: self.capacity)
+            timestamps.initialize(repeating: 0, count: self.capacity)
+            overheads = .allocate(capacity: self.capacity)
+            overheads.initialize(repeating: 0, count: self.capacity)
+            counts = .allocate(capacity: self.capacity)
+            counts.initialize(repeating: 0, count: self.capacity)
+            frames = .allocate(capacity: self.capacity * self.framesPerSlot)
+            frames.initialize(repeating: 0, count: self.capacity * self.framesPerSlot)
+        }
+
+        deinit {
+            ordinals.deallocate()
+            timestamps.deallocate()
+            overheads.deallocate()
+            counts.deallocate()
+            frames.deallocate()
+        }
+
+        // MARK: - Writer
+
+        /// Fills the next slot in place. **Single writer only.** Allocation-free.
+        ///
+        /// `fill` receives the slot's frame storage and its capacity, writes the stack straight into
+        /// it, and returns the capture metadata — or `nil` if nothing was captured, in which case the
+        /// slot is left empty and the sample count does not advance.
+        func write(_ fill: (_ frames: UnsafeMutablePointer<FrameAddress>, _ capacity: Int) -> Capture?) {
+            let ordinal = written.load(order: .relaxed)
+            let slot = Int(ordinal % UInt64(capacity))
+            let sequence = sequences[slot]
+
+            // → odd: readers skip this slot until we're done. The acquire half keeps the payload
+            // writes below from being hoisted above it.
+            sequence.fetchAdd(1, order: .acquireAndRelease)
+
+            let captured = fill(frames + slot * framesPerSlot, framesPerSlot)
+            if let captured {
+                ordinals[slot] = ordinal + 1
+                timestamps[slot] = captured.timestamp
+                overheads[slot] = captured.overhead
+                counts[slot] = Swift.min(Swift.max(0, captured.count), framesPerSlot)
+            } else {
+                // the walk may have scribbled over the previous sample's frames; retire the slot.
+                ordinals[slot] = 0
+                timestamps[slot] = 0
+                counts[slot] = 0
+            }
+
+            // → even: slot is consistent again.
+            sequence.fetchAdd(1, order: .release)
+
+            if captured != nil {
+                written.store(ordinal + 1, order: .release)
+            }
+        }
+
+        // MARK: - Readers
+
+        /// Buffered samples whose `timestamp` falls within `range`, ordered oldest to newest.
+        /// Lock-free: a slot that is being rewritten while it is copied is skipped.
+        func samples(in range: ClosedRange<UInt64>) -> [MainThreadStackSample] {
+            let end = written.load(order: .acquire)
+            let start = end > UInt64(capacity) ? end - UInt64(capacity) : 0
+
+            var result: [MainThreadStackSample] = []
+            for ordinal in start..<end {
+                let slot = Int(ordinal % UInt64(capacity))
+                let sequence = sequences[slot]
+
+                let before = sequence.load(order: .acquire)
+                guard before & 1 == 0 else { continue }  // writer owns it
+
+                let slotOrdinal = ordinals[slot]
+                let timestamp = timestamps[slot]
+                let overhead = overheads[slot]
+                let count = Swift.min(Swift.max(0, counts[slot]), framesPerSlot)
+                let addresses = Array(UnsafeBufferPointer(start: frames + slot * framesPerSlot, count: count))
+
+                // A read-modify-write (rather than a load) so the copies above can't sink below it.
+                guard sequence.fetchAdd(0, order: .acquireAndRelease) == before else { continue }
+                guard slotOrdinal == ordinal + 1, timestamp != 0, range.contains(timestamp) else { continue }
+
+                result.append(
+                    MainThreadStackSample(
+                        timestamp: timestamp,
+                        overhead: overhead,
+                        backtrace: EmbraceBacktrace(
+                            timestampUnits: .nanoseconds,
+                            timestamp: timestamp,
+                            threads: [
+                                EmbraceBacktraceThread(
+                                    index: 0,
+                                    callstack: EmbraceBacktraceThread.Callstack(
+                                        addresses: addresses,
+                                        count: addresses.count
+                                    )
+                                )
+                            ]
+                        )
+                    )
+                )
+            }
+            return result
+        }
+    }
+
+#endif
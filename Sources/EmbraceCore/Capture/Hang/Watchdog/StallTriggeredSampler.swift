@@ -23,7 +23,12 @@
         let busySince = EmbraceAtomic<UInt64>(0)
         let paused = EmbraceAtomic<Bool>(false)
         let running = EmbraceAtomic<Bool>(false)
-        let buffer = EmbraceMutex<[MainThreadStackSample]>([])
+        /// Preallocated sample slots. Written only by the poll loop, read lock-free by `samples(in:)`.
+        let ring: MainThreadSampleRing
+
+        init(bufferCap: Int) {
+            ring = MainThreadSampleRing(capacity: bufferCap)
+        }
     }
 
     /// Immutable poll-loop configuration. All value types, safe to copy into the worker.
@@ -54,7 +59,7 @@
     /// window that CADisplayLink later confirms.
     final class StallTriggeredSampler: MainThreadStackSampler {
 
-        private let shared = SharedPollState()
+        private let shared: SharedPollState
         private let config: PollConfig
         private weak var logger: InternalLogger?
 
@@ -76,7 +81,8 @@
         ///     Clamped into `HangLimits.min/maxSampleTriggerThreshold`.
         ///   - pollInterval: how often the background thread checks liveness. Clamped into
         ///     `HangLimits.min/maxSamplePollInterval`.
-        ///   - bufferCap: max buffered samples (small ring; one per stall episode).
+        ///   - bufferCap: max buffered samples (small ring; one per stall episode). All slots are
+        ///     preallocated here so capture never touches the heap.
         init(
             mainThread: pthread_t = EmbraceGetMainThread(),
             triggerThreshold: TimeInterval,
@@ -98,9 +104,10 @@
                     min: HangLimits.minSamplePollInterval,
                     max: HangLimits.maxSamplePollInterval
                 ),
-                // a cap < 1 would defeat buffering: 0 clears the ring every append, negative traps the trim.
+                // a cap < 1 would defeat buffering: the ring needs at least one slot.
                 bufferCap: Swift.max(1, bufferCap)
             )
+            self.shared = SharedPollState(bufferCap: config.bufferCap)
             self.logger = logger
         }
 
@@ -185,7 +192,7 @@
         }
 
         func samples(in range: ClosedRange<UInt64>) -> [MainThreadStackSample] {
-            shared.buffer.withLock { $0.filter { range.contains($0.timestamp) } }
+            shared.ring.samples(in: range)
         }
 
         // MARK: - Main-thread liveness beacon
@@ -253,23 +260,26 @@
             }
         }
 
+        /// Allocation-free end to end: main may be suspended while holding the malloc lock, so the
+        /// walk writes straight into a preallocated ring slot and nothing here touches the heap.
         private func captureSample() {
-            guard EmbraceBacktrace.isAvailable else { return }
-
-            let pre = clock_gettime_nsec_np(CLOCK_MONOTONIC_RAW)
-            let backtrace = EmbraceBacktrace.backtrace(of: config.mainThread, threadIndex: 0)  // suspends main; alloc-free
-            let post = clock_gettime_nsec_np(CLOCK_MONOTONIC_RAW)
-
-            let sample = MainThreadStackSample(
-                timestamp: backtrace.timestamp,
-                overhead: post &- pre,
-                backtrace: backtrace
-            )
-            shared.buffer.withLock {
-                $0.append(sample)
-                if $0.count > config.bufferCap {
-                    $0.removeFirst($0.count - config.bufferCap)
+            #if DEBUG
+                StallTriggeredSamplerCaptureProbe.willEnter?()
+                defer { StallTriggeredSamplerCaptureProbe.didExit?() }
+            #endif
+
+            guard let backtracer = Embrace.client?.options.backtracer else { return }
+
+            shared.ring.write { frames, capacity in
+                let pre = clock_gettime_nsec_np(CLOCK_MONOTONIC_RAW)
+                guard
+                    let count = EmbraceBacktrace.walkSuspended(
+                        config.mainThread, with: backtracer, into: frames, capacity: capacity)
+                else {
+                    return nil
                 }
+                let post = clock_gettime_nsec_np(CLOCK_MONOTONIC_RAW)
+                return (timestamp: pre, overhead: post &- pre, count: count)
             }
         }
 
@@ -282,4 +292,15 @@
         }
     }
 
+    #if DEBUG
+        /// Test-only seam bracketing the poll loop's whole capture path (backtracer lookup, suspend,
+        /// walk, ring commit). `nil` in normal use and stripped from Release. The allocation test sets
+        /// them to open a sentinel window on the poll thread, proving the path never allocates.
+        /// The hooks themselves MUST be allocation-free.
+        enum StallTriggeredSamplerCaptureProbe {
+            static var willEnter: (() -> Void)?
+            static var didExit: (() -> Void)?
+        }
+    #endif
+
 #endif
@@ -4,24 +4,191 @@
 
 import Foundation
 
-internal enum HostAllowlistMatcher {
+/// Host allowlist compiled into a trie over reversed DNS labels.
+///
+/// `"api.test.com"` is looked up as `com` → `test` → `api`, so a host is checked against every
+/// entry in a single right-to-left pass over its bytes, instead of building and comparing a
+/// `"." + entry` suffix per entry. Build it once when the allowlist is set and reuse it for every request.
+///
+/// Edges are keyed by the parent node and a hash of the (ASCII-lowercased) label, and the label bytes
+/// are compared on a hit, so a lookup doesn't allocate. Hosts with non-ASCII characters are lowercased
+/// with `String.lowercased()` first, matching the entries' normalization.
+internal struct HostAllowlistMatcher {
+
+    private struct Edge: Hashable {
+        let parent: Int32
+        let hash: UInt64
+    }
+
+    private struct Node {
+        let label: [UInt8]
+
+        /// Index of the entry ending at this node, or -1.
+        var rule: Int32 = -1
+
+        /// Next node under the same parent whose label has the same hash, or -1.
+        var collision: Int32 = -1
+    }
+
+    private static let root: Int32 = 0
+    private static let dot = UInt8(ascii: ".")
+
+    /// The allowlist entries, in the order they were given.
+    let rules: [String]
+
+    private var nodes: [Node] = [Node(label: [])]
+    private var edges: [Edge: Int32] = [:]
+
+    /// Compiles `allowlist`. Entries are expected to be lowercase-normalized at Options-init time.
+    init(allowlist: [String]) {
+        self.rules = allowlist
+
+        for (index, entry) in allowlist.enumerated() {
+            var node = Self.root
+            let labels = entry.lowercased().utf8.split(separator: Self.dot, omittingEmptySubsequences: false)
+
+            for label in labels.reversed() {
+                node = insert(Array(label), under: node)
+            }
+
+            // the first of several equal entries wins
+            if nodes[Int(node)].rule < 0 {
+                nodes[Int(node)].rule = Int32(index)
+            }
+        }
+    }
 
     /// Returns whether `host` is permitted by `allowlist`.
     ///
     /// - `allowlist` Empty -> false (ignore all requests).
     /// - `host` nil → false.
     /// - Otherwise: case-insensitive match on equality (`"test.com"`) or subdomain
-    ///   (`"api.test.com"` for entry `"test.com"`). Entries are expected to be
-    ///   lowercase-normalized at Options-init time.
+    ///   (`"api.test.com"` for entry `"test.com"`).
+    ///
+    /// - Note: Compiles `allowlist` on every call; keep a `HostAllowlistMatcher` around for repeated checks.
     static func matches(host: String?, allowlist: [String]) -> Bool {
         guard !allowlist.isEmpty else { return false }
-        guard let host else { return false }
+        return HostAllowlistMatcher(allowlist: allowlist).matches(host: host)
+    }
+
+    /// Returns whether `host` equals one of the entries or is a subdomain of one.
+    func matches(host: String?) -> Bool {
+        return match(host: host) != nil
+    }
+
+    /// Returns the entry that permits `host`, or nil.
+    /// When several entries match (`"test.com"` and `"api.test.com"`), the most specific one is returned.
+    func match(host: String?) -> String? {
+        guard let host, nodes.count > 1 else { return nil }
+
+        var host = host
+        if host.utf8.contains(where: { $0 >= 0x80 }) {
+            host = host.lowercased()
+        }
+
+        var rule = host.utf8.withContiguousStorageIfAvailable { match(bytes: $0) }
+        if rule == nil {
+            // bridged strings may not be contiguous
+            rule = host.withUTF8 { match(bytes: $0) }
+        }
+
+        guard let rule, rule >= 0 else {
+            return nil
+        }
+        return rules[Int(rule)]
+    }
+
+    // MARK: - Private
+
+    private func match(bytes: UnsafeBufferPointer<UInt8>) -> Int32 {
+        var node = Self.root
+        var rule: Int32 = -1
+        var end = bytes.count
+
+        while true {
+            var start = end
+            while start > 0 && bytes[start - 1] != Self.dot {
+                start -= 1
+            }
+
+            var hash = Self.hashSeed
+            for i in start..<end {
+                hash = Self.hash(hash, Self.lowercased(bytes[i]))
+            }
+
+            guard let child = child(of: node, hash: hash, matching: bytes, start..<end) else {
+                break
+            }
+            node = child
+
+            if nodes[Int(node)].rule >= 0 {
+                rule = nodes[Int(node)].rule
+            }
+
+            guard start > 0 else {
+                break
+            }
+            end = start - 1
+        }
+
+        return rule
+    }
+
+    private func child(
+        of parent: Int32,
+        hash: UInt64,
+        matching bytes: UnsafeBufferPointer<UInt8>,
+        _ range: Range<Int>
+    ) -> Int32? {
+        var candidate = edges[Edge(parent: parent, hash: hash)] ?? -1
+
+        while candidate >= 0 {
+            let label = nodes[Int(candidate)].label
+            if label.count == range.count
+                && zip(label, range).allSatisfy({ $0 == Self.lowercased(bytes[$1]) }) {
+                return candidate
+            }
+            candidate = nodes[Int(candidate)].collision
+        }
+
+        return nil
+    }
+
+    private mutating func insert(_ label: [UInt8], under parent: Int32) -> Int32 {
+        let label = label.map(Self.lowercased)
+        let edge = Edge(parent: parent, hash: label.reduce(Self.hashSeed, Self.hash))
+
+        // existing child?
+        var last: Int32 = -1
+        var candidate = edges[edge] ?? -1
+        while candidate >= 0 {
+            if nodes[Int(candidate)].label == label {
+                return candidate
+            }
+            last = candidate
+            candidate = nodes[Int(candidate)].collision
+        }
+
+        let node = Int32(nodes.count)
+        nodes.append(Node(label: label))
 
-        let lowerHost = host.lowercased()
-        for entry in allowlist {
-            if lowerHost == entry { return true }
-            if lowerHost.hasSuffix("." + entry) { return true }
+        if last >= 0 {
+            nodes[Int(last)].collision = node
+        } else {
+            edges[edge] = node
         }
-        return false
+
+        return node
+    }
+
+    // FNV-1a
+    private static let hashSeed: UInt64 = 0xcbf2_9ce4_8422_2325
+
+    private static func hash(_ hash: UInt64, _ byte: UInt8) -> UInt64 {
+        return (hash ^ UInt64(byte)) &* 0x0000_0100_0000_01B3
+    }
+
+    private static func lowercased(_ byte: UInt8) -> UInt8 {
+        return byte >= UInt8(ascii: "A") && byte <= UInt8(ascii: "Z") ? byte | 0x20 : byte
     }
 }
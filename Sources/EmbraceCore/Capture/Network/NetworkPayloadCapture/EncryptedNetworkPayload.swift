@@ -27,7 +27,12 @@ struct EncryptedNetworkPayload: Encodable {
     let requestQuery: String?
     let requestHeaders: [String: String]
 
-    let responseBody: String?
+    /// Response body, encoded up to `responseBodyLength` bytes.
+    let responseBodyBuffer: NetworkBodyBuffer?
+
+    /// Number of leading body bytes that are captured, or nil if the body isn't UTF-8.
+    let responseBodyLength: Int?
+
     let responseBodySize: Int?
     let responseHeaders: [String: String]?
     let responseStatus: Int?
@@ -66,6 +71,33 @@ struct EncryptedNetworkPayload: Encodable {
         endTime: Date?,
         matchedUrl: String,
         sessionId: EmbraceIdentifier?
+    ) {
+        self.init(
+            request: request,
+            response: response,
+            body: data.map { NetworkBodyBuffer(data: $0) },
+            bodyLimit: .max,
+            error: error,
+            startTime: startTime,
+            endTime: endTime,
+            matchedUrl: matchedUrl,
+            sessionId: sessionId
+        )
+    }
+
+    /// - Parameters:
+    ///   - body: Response body, possibly truncated already while it was being received.
+    ///   - bodyLimit: Maximum number of body bytes to include.
+    init?(
+        request: URLRequest?,
+        response: URLResponse?,
+        body: NetworkBodyBuffer?,
+        bodyLimit: Int,
+        error: Error?,
+        startTime: Date?,
+        endTime: Date?,
+        matchedUrl: String,
+        sessionId: EmbraceIdentifier?
     ) {
         guard let request = request,
             let url = request.url,
@@ -94,11 +126,13 @@ struct EncryptedNetworkPayload: Encodable {
         self.requestQuery = url.query
         self.requestHeaders = request.allHTTPHeaderFields ?? [:]
 
-        if let data = data {
-            self.responseBody = String(data: data, encoding: .utf8)
-            self.responseBodySize = data.count
+        if let body = body {
+            self.responseBodyBuffer = body
+            self.responseBodyLength = body.utf8Length(prefix: bodyLimit)
+            self.responseBodySize = body.totalBytes
         } else {
-            self.responseBody = nil
+            self.responseBodyBuffer = nil
+            self.responseBodyLength = nil
             self.responseBodySize = nil
         }
 
@@ -117,6 +151,41 @@ struct EncryptedNetworkPayload: Encodable {
         }
     }
 
+    var responseBody: String? {
+        guard let buffer = responseBodyBuffer, let length = responseBodyLength else {
+            return nil
+        }
+
+        return String(decoding: buffer.data.prefix(length), as: UTF8.self)
+    }
+
+    func encode(to encoder: Encoder) throws {
+        var container = encoder.container(keyedBy: CodingKeys.self)
+
+        try container.encode(url, forKey: .url)
+        try container.encode(httpMethod, forKey: .httpMethod)
+
+        try container.encodeIfPresent(startTime, forKey: .startTime)
+        try container.encodeIfPresent(endTime, forKey: .endTime)
+
+        try container.encode(matchedUrl, forKey: .matchedUrl)
+        try container.encodeIfPresent(sessionId, forKey: .sessionId)
+
+        try container.encodeIfPresent(requestBody, forKey: .requestBody)
+        try container.encodeIfPresent(requestBodySize, forKey: .requestBodySize)
+        try container.encodeIfPresent(requestQuery, forKey: .requestQuery)
+        try container.encode(requestHeaders, forKey: .requestHeaders)
+
+        if encoder.userInfo[.omittingResponseBody] as? Bool != true {
+            try container.encodeIfPresent(responseBody, forKey: .responseBody)
+        }
+        try container.encodeIfPresent(responseBodySize, forKey: .responseBodySize)
+        try container.encodeIfPresent(responseHeaders, forKey: .responseHeaders)
+        try container.encodeIfPresent(responseStatus, forKey: .responseStatus)
+
+        try container.encodeIfPresent(errorMessage, forKey: .errorMessage)
+    }
+
     /// Returns the encrypted json representation of this object, along with the necessary things to decrypt the data.
     /// We are use hybrid encryption with AES and RSA.
     /// First we encrypt the payload using aes-256-cbc with a randomly generated symmetric key and iv.
@@ -124,21 +193,22 @@ struct EncryptedNetworkPayload: Encodable {
     /// In order to decrypt the data, the user will have to first decrypt the symmetric key using their private key with RSA.
     /// After that they'll have the symmetric key to decrypt the data using aes-256-cbc.
     /// Note: Both the symmetric key and iv are converted into hex strings for easier use with openssl commands during decryption.
+    ///
+    /// The json is fed to the cipher as it's written, and the response body goes straight from its buffer,
+    /// so the only full size copy is the encrypted output.
     func encrypted(withKey key: String) -> EncryptedPayloadResult? {
 
-        // encode json payload
-        var data: Data?
-        do {
-            data = try JSONEncoder().encode(self)
-        } catch {
-            Embrace.logger.debug("Error encoding `EncryptedNetworkPayload`:\n\(error.localizedDescription)")
-        }
-        guard let data = data else {
+        // encode json payload, minus the response body
+        guard let envelope = encodedEnvelope() else {
             return nil
         }
 
         // encrypt payload
-        guard let aesResult = EncryptionHelper.aesEncrypt(data: data) else {
+        let expectedLength = envelope.count + (responseBodyLength ?? 0)
+        guard let encryptor = EncryptionHelper.aesStreamEncryptor(expectedLength: expectedLength),
+            writeJSON(envelope: envelope, to: encryptor.update),
+            let aesResult = encryptor.finish()
+        else {
             Embrace.logger.debug("Error with AES encryption!")
             return nil
         }
@@ -160,6 +230,109 @@ struct EncryptedNetworkPayload: Encodable {
             iv: aesResult.iv.hexString
         )
     }
+
+    /// The json that `encrypted(withKey:)` encrypts.
+    func jsonData() -> Data? {
+        guard let envelope = encodedEnvelope() else {
+            return nil
+        }
+
+        var result = Data()
+        writeJSON(envelope: envelope) {
+            result.append(contentsOf: $0)
+            return true
+        }
+        return result
+    }
+
+    // MARK: - Streaming
+
+    /// Staging buffer size for the escaped response body.
+    private static let escapeBufferSize = 16 * 1024
+
+    private func encodedEnvelope() -> Data? {
+        let encoder = JSONEncoder()
+        encoder.userInfo[.omittingResponseBody] = true
+
+        do {
+            return try encoder.encode(self)
+        } catch {
+            Embrace.logger.debug("Error encoding `EncryptedNetworkPayload`:\n\(error.localizedDescription)")
+            return nil
+        }
+    }
+
+    /// Writes `{"response-body":"<escaped body>",` followed by the rest of `envelope`.
+    @discardableResult
+    private func writeJSON(envelope: Data, to sink: (UnsafeRawBufferPointer) -> Bool) -> Bool {
+        guard let buffer = responseBodyBuffer, let length = responseBodyLength else {
+            return envelope.withUnsafeBytes(sink)
+        }
+
+        let opening = Array("{\"\(CodingKeys.responseBody.rawValue)\":\"".utf8)
+        guard opening.withUnsafeBytes(sink),
+            Self.writeEscaped(buffer, prefix: length, to: sink),
+            Array("\",".utf8).withUnsafeBytes(sink)
+        else {
+            return false
+        }
+
+        // the envelope always has other keys after its opening brace
+        return envelope.withUnsafeBytes { sink(UnsafeRawBufferPointer(rebasing: $0.dropFirst())) }
+    }
+
+    /// Writes the contents of a json string for a body that was validated as UTF-8.
+    private static func writeEscaped(
+        _ buffer: NetworkBodyBuffer,
+        prefix: Int,
+        to sink: (UnsafeRawBufferPointer) -> Bool
+    ) -> Bool {
+        let hex = Array("0123456789abcdef".utf8)
+
+        var staging: [UInt8] = []
+        staging.reserveCapacity(escapeBufferSize + 6)
+
+        func flush() -> Bool {
+            defer { staging.removeAll(keepingCapacity: true) }
+            return staging.withUnsafeBytes(sink)
+        }
+
+        let written = buffer.forEachChunk(prefix: prefix) { chunk in
+            for byte in chunk {
+                switch byte {
+                case UInt8(ascii: "\""), UInt8(ascii: "\\"):
+                    staging.append(UInt8(ascii: "\\"))
+                    staging.append(byte)
+                case UInt8(ascii: "\n"):
+                    staging.append(contentsOf: [UInt8(ascii: "\\"), UInt8(ascii: "n")])
+                case UInt8(ascii: "\r"):
+                    staging.append(contentsOf: [UInt8(ascii: "\\"), UInt8(ascii: "r")])
+                case UInt8(ascii: "\t"):
+                    staging.append(contentsOf: [UInt8(ascii: "\\"), UInt8(ascii: "t")])
+                case 0x00..<0x20:
+                    staging.append(contentsOf: Array("\\u00".utf8))
+                    staging.append(hex[Int(byte >> 4)])
+                    staging.append(hex[Int(byte & 0x0F)])
+                default:
+                    staging.append(byte)
+                }
+
+                if staging.count >= escapeBufferSize {
+                    guard flush() else {
+                        return false
+                    }
+                }
+            }
+            return true
+        }
+
+        return written && flush()
+    }
+}
+
+extension CodingUserInfoKey {
+    /// Set on the encoder when the response body is written separately, see `EncryptedNetworkPayload`.
+    static let omittingResponseBody = CodingUserInfoKey(rawValue: "io.embrace.omittingResponseBody")!
 }
 
 struct EncryptedPayloadResult {
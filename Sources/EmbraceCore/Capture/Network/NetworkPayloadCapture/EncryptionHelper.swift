@@ -28,6 +28,16 @@ class EncryptionHelper {
 
         return AES.encrypt(data: data, key: key, iv: iv)
     }
+
+    class func aesStreamEncryptor(expectedLength: Int) -> AES.StreamEncryptor? {
+        guard let key = AES.createRandomKey(),
+            let iv = AES.createRandomIv()
+        else {
+            return nil
+        }
+
+        return AES.StreamEncryptor(key: key, iv: iv, expectedLength: expectedLength)
+    }
 }
 
 struct RSA {
@@ -167,6 +177,101 @@ struct AES {
         )
     }
 
+    /// Encrypts input handed over in pieces, with the same output as `encrypt(data:key:iv:)` on the
+    /// concatenated input, so large payloads don't need to be in memory twice.
+    final class StreamEncryptor {
+        let key: Data
+        let iv: Data
+
+        private var cryptor: CCCryptorRef?
+        private var output = Data()
+
+        init?(key: Data, iv: Data, expectedLength: Int = 0) {
+            self.key = key
+            self.iv = iv
+
+            var ref: CCCryptorRef?
+            let status = key.withUnsafeBytes { keyBytes in
+                iv.withUnsafeBytes { ivBytes in
+                    CCCryptorCreate(
+                        CCOperation(kCCEncrypt),
+                        CCAlgorithm(kCCAlgorithmAES128),
+                        CCOptions(kCCOptionPKCS7Padding),
+                        keyBytes.baseAddress,
+                        key.count,
+                        ivBytes.baseAddress,
+                        &ref
+                    )
+                }
+            }
+
+            guard status == kCCSuccess, let ref else {
+                return nil
+            }
+
+            cryptor = ref
+
+            output.reserveCapacity(expectedLength + kCCBlockSizeAES128)
+        }
+
+        deinit {
+            if let cryptor {
+                CCCryptorRelease(cryptor)
+            }
+        }
+
+        /// Encrypts the next piece of input. Returns `false` on failure.
+        func update(_ bytes: UnsafeRawBufferPointer) -> Bool {
+            guard let cryptor else {
+                return false
+            }
+            guard bytes.count > 0 else {
+                return true
+            }
+
+            return write(capacity: CCCryptorGetOutputLength(cryptor, bytes.count, false)) { out, capacity, moved in
+                CCCryptorUpdate(cryptor, bytes.baseAddress, bytes.count, out, capacity, &moved)
+            }
+        }
+
+        /// Adds the padding and returns the encrypted data. The encryptor can't be used afterwards.
+        func finish() -> Result? {
+            guard let cryptor else {
+                return nil
+            }
+
+            let finished = write(capacity: CCCryptorGetOutputLength(cryptor, 0, true)) { out, capacity, moved in
+                CCCryptorFinal(cryptor, out, capacity, &moved)
+            }
+
+            CCCryptorRelease(cryptor)
+            self.cryptor = nil
+
+            guard finished else {
+                return nil
+            }
+
+            defer { output = Data() }
+            return Result(data: output, key: key, iv: iv)
+        }
+
+        private func write(
+            capacity: Int,
+            _ body: (UnsafeMutableRawPointer, Int, inout Int) -> CCCryptorStatus
+        ) -> Bool {
+            let start = output.count
+            output.count += capacity
+
+            var moved = 0
+            let status = output.withUnsafeMutableBytes { out in
+                body(out.baseAddress! + start, capacity, &moved)
+            }
+
+            output.count = start + moved
+            return status == kCCSuccess
+        }
+    }
+
     static func randomData(length: Int) -> Data? {
         var data = Data(count: length)
         let status: Int32 = data.withUnsafeMutableBytes { (mutableBytes: UnsafeMutableRawBufferPointer) in
@@ -0,0 +1,299 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCommonInternal
+#endif
+
+/// Response body kept for network payload capture, up to a byte limit.
+///
+/// Streamed bodies are copied once, into fixed-size chunks taken from `NetworkBodyBuffer.Pool`, instead
+/// of being appended to a `Data` that gets reallocated (and, as an associated object, copied) on every
+/// chunk. Bytes past `limit` are only counted, so a large download costs at most `limit` bytes of memory.
+///
+/// Bodies that are already in memory (completion handler tasks) are wrapped without copying.
+///
+/// Chunks count against the SDK's memory budget. When the budget refuses one, the body is cut short there.
+final class NetworkBodyBuffer {
+
+    private struct Storage {
+        var chunks: [UnsafeMutableRawPointer] = []
+        var wrapped: Data?
+        var count: Int = 0
+        var totalBytes: Int = 0
+        /// Set once the memory budget refused a chunk, nothing else is kept after that.
+        var capped = false
+    }
+
+    /// Maximum number of bytes kept.
+    let limit: Int
+
+    private let storage: EmbraceMutex<Storage>
+    private let pool: Pool
+
+    init(limit: Int, pool: Pool = .shared) {
+        self.limit = max(limit, 0)
+        self.pool = pool
+        self.storage = EmbraceMutex(Storage())
+    }
+
+    /// Wraps a body that is already in memory.
+    init(data: Data, limit: Int = .max) {
+        self.limit = max(limit, 0)
+        self.pool = .shared
+        self.storage = EmbraceMutex(Storage(wrapped: data, count: min(data.count, max(limit, 0)), totalBytes: data.count))
+    }
+
+    deinit {
+        let chunks = storage.withLock { $0.chunks }
+        if !chunks.isEmpty {
+            EmbraceMemoryBudget.shared.release(chunks.count * Pool.chunkSize, count: chunks.count, for: .networkBodies)
+        }
+        pool.recycle(chunks)
+    }
+
+    /// Number of bytes received, including the ones past `limit`.
+    var totalBytes: Int {
+        storage.withLock { $0.totalBytes }
+    }
+
+    /// Number of bytes kept.
+    var count: Int {
+        storage.withLock { $0.count }
+    }
+
+    var isTruncated: Bool {
+        storage.withLock { $0.totalBytes > $0.count }
+    }
+
+    func append(_ data: Data) {
+        storage.withLock { storage in
+            if let wrapped = storage.wrapped {
+                // move the wrapped body into chunks before adding to it
+                storage.wrapped = nil
+                storage.count = 0
+                copy(wrapped, into: &storage)
+            }
+
+            storage.totalBytes += data.count
+            copy(data, into: &storage)
+        }
+    }
+
+    /// Calls `body` with consecutive pieces of the first `prefix` bytes kept, with no copies.
+    /// Stops early when `body` returns `false`; returns whether every piece was consumed.
+    @discardableResult
+    func forEachChunk(prefix: Int = .max, _ body: (UnsafeRawBufferPointer) -> Bool) -> Bool {
+        storage.withLock { storage in
+            let total = min(prefix, storage.count)
+
+            if let wrapped = storage.wrapped {
+                return wrapped.withUnsafeBytes { body(UnsafeRawBufferPointer(rebasing: $0.prefix(total))) }
+            }
+
+            var remaining = total
+            for chunk in storage.chunks where remaining > 0 {
+                let length = min(remaining, Pool.chunkSize)
+                guard body(UnsafeRawBufferPointer(start: chunk, count: length)) else {
+                    return false
+                }
+                remaining -= length
+            }
+
+            return true
+        }
+    }
+
+    /// The bytes kept, in a single `Data`.
+    var data: Data {
+        let whole: Data? = storage.withLock { $0.wrapped?.count == $0.count ? $0.wrapped : nil }
+        if let whole {
+            return whole
+        }
+
+        var result = Data(capacity: count)
+        forEachChunk {
+            result.append(contentsOf: $0)
+            return true
+        }
+        return result
+    }
+
+    /// Number of leading bytes (up to `prefix`) that form complete UTF-8, or nil if the body isn't UTF-8.
+    ///
+    /// A multi-byte character cut in half at the end is tolerated when the body was truncated, and the
+    /// returned length excludes it. Mirrors the validation done by `String(data:encoding: .utf8)`.
+    func utf8Length(prefix: Int = .max) -> Int? {
+        var validator = UTF8Validator()
+        let cut = isTruncated || prefix < count
+
+        let consumed = forEachChunk(prefix: prefix) { validator.consume($0) }
+        guard consumed else {
+            return nil
+        }
+
+        if validator.isComplete {
+            return validator.validLength
+        }
+
+        return cut ? validator.validLength : nil
+    }
+
+    /// Copies as much of `data` as fits under `limit` to the end of the chunks.
+    private func copy(_ data: Data, into storage: inout Storage) {
+        let accepted = storage.capped ? 0 : min(data.count, limit - storage.count)
+        guard accepted > 0 else {
+            return
+        }
+
+        data.withUnsafeBytes { bytes in
+            guard let source = bytes.baseAddress else {
+                return
+            }
+
+            var copied = 0
+            while copied < accepted {
+                let offset = storage.count % Pool.chunkSize
+                if offset == 0 {
+                    guard EmbraceMemoryBudget.shared.reserve(Pool.chunkSize, for: .networkBodies) else {
+                        EmbraceMemoryBudget.shared.recordDrop(.networkBodies)
+                        storage.capped = true
+                        return
+                    }
+                    storage.chunks.append(pool.take())
+                }
+
+                let length = min(accepted - copied, Pool.chunkSize - offset)
+                storage.chunks[storage.chunks.count - 1].advanced(by: offset)
+                    .copyMemory(from: source + copied, byteCount: length)
+
+                copied += length
+                storage.count += length
+            }
+        }
+    }
+}
+
+// MARK: - Pool
+
+extension NetworkBodyBuffer {
+
+    /// Free list of body chunks, so capturing bodies back to back doesn't allocate every time.
+    final class Pool {
+        static let chunkSize = 64 * 1024
+
+        static let shared = Pool(capacity: 32)
+
+        /// Maximum number of free chunks kept.
+        let capacity: Int
+
+        private let free = EmbraceMutex<[UnsafeMutableRawPointer]>([])
+
+        init(capacity: Int) {
+            self.capacity = capacity
+        }
+
+        deinit {
+            free.withLock { $0.forEach { $0.deallocate() } }
+        }
+
+        var freeCount: Int {
+            free.withLock { $0.count }
+        }
+
+        func take() -> UnsafeMutableRawPointer {
+            if let chunk = free.withLock({ $0.popLast() }) {
+                return chunk
+            }
+            return UnsafeMutableRawPointer.allocate(byteCount: Self.chunkSize, alignment: 16)
+        }
+
+        func recycle(_ chunks: [UnsafeMutableRawPointer]) {
+            guard !chunks.isEmpty else {
+                return
+            }
+
+            // don't hold on to free chunks when memory is short
+            guard EmbraceMemoryBudget.shared.level < .high else {
+                chunks.forEach { $0.deallocate() }
+                return
+            }
+
+            let excess: ArraySlice<UnsafeMutableRawPointer> = free.withLock {
+                let kept = min(capacity - $0.count, chunks.count)
+                $0.append(contentsOf: chunks.prefix(max(kept, 0)))
+                return chunks.dropFirst(max(kept, 0))
+            }
+            excess.forEach { $0.deallocate() }
+        }
+    }
+}
+
+// MARK: - UTF-8 validation
+
+/// Incremental UTF-8 validator, following the well-formed byte sequences table of the Unicode standard.
+struct UTF8Validator {
+
+    /// Bytes consumed that end on a character boundary.
+    private(set) var validLength = 0
+
+    private var consumed = 0
+    private var pending = 0
+    private var lower: UInt8 = 0x80
+    private var upper: UInt8 = 0xBF
+
+    /// Whether the input so far doesn't end in the middle of a character.
+    var isComplete: Bool {
+        return pending == 0
+    }
+
+    /// Returns `false` as soon as an invalid sequence is found.
+    mutating func consume(_ bytes: UnsafeRawBufferPointer) -> Bool {
+        for byte in bytes {
+            consumed += 1
+
+            if pending > 0 {
+                guard byte >= lower && byte <= upper else {
+                    return false
+                }
+                pending -= 1
+                lower = 0x80
+                upper = 0xBF
+                if pending == 0 {
+                    validLength = consumed
+                }
+                continue
+            }
+
+            switch byte {
+            case 0x00...0x7F:
+                validLength = consumed
+            case 0xC2...0xDF:
+                pending = 1
+            case 0xE0:
+                pending = 2
+                lower = 0xA0
+            case 0xE1...0xEC, 0xEE...0xEF:
+                pending = 2
+            case 0xED:
+                pending = 2
+                upper = 0x9F
+            case 0xF0:
+                pending = 3
+                lower = 0x90
+            case 0xF1...0xF3:
+                pending = 3
+            case 0xF4:
+                pending = 3
+                upper = 0x8F
+            default:
+                return false
+            }
+        }
+
+        return true
+    }
+}
@@ -15,31 +15,60 @@ import Foundation
 
 protocol NetworkPayloadCaptureHandler {
     func isEnabled() -> Bool
+
+    /// Number of response body bytes worth keeping for a task that's still receiving its body:
+    /// the largest body limit of the rules that could still capture it, or 0 if none can.
+    func bodyCaptureLimit(request: URLRequest?, response: URLResponse?) -> Int
+
     func process(
         request: URLRequest?,
         response: URLResponse?,
-        data: Data?,
+        body: NetworkBodyBuffer?,
         error: Error?,
         startTime: Date?,
         endTime: Date?
     )
 }
 
+extension NetworkPayloadCaptureHandler {
+    func process(
+        request: URLRequest?,
+        response: URLResponse?,
+        data: Data?,
+        error: Error?,
+        startTime: Date?,
+        endTime: Date?
+    ) {
+        process(
+            request: request,
+            response: response,
+            body: data.map { NetworkBodyBuffer(data: $0) },
+            error: error,
+            startTime: startTime,
+            endTime: endTime
+        )
+    }
+}
+
 class DefaultNetworkPayloadCaptureHandler: NetworkPayloadCaptureHandler {
 
-    struct MutableState {
+    struct State {
         var active: Bool = false
         var rules: [URLSessionTaskCaptureRule] = []
+        var matcher = URLCaptureRuleMatcher(rules: [])
         var rulesTriggeredMap: [String: Bool] = [:]
         var currentSessionId: EmbraceIdentifier?
     }
-    internal var state: EmbraceMutex<MutableState>
+
+    /// Loaded once for every request, so the rules and the ones that already triggered
+    /// always come from the same value. Replaced on config updates, session changes
+    /// and when a rule triggers.
+    internal let state = EmbraceSnapshot(State())
 
     private var otel: EmbraceOpenTelemetry?
 
     init(otel: EmbraceOpenTelemetry?) {
         self.otel = otel
-        self.state = EmbraceMutex(MutableState())
 
         Embrace.notificationCenter.addObserver(
             self,
@@ -64,9 +93,11 @@ class DefaultNetworkPayloadCaptureHandler: NetworkPayloadCaptureHandler {
 
         // check if a session is already started
         if let sessionId = Embrace.client?.currentSessionId() {
-            state.withLock {
-                $0.active = true
-                $0.currentSessionId = EmbraceIdentifier(stringValue: sessionId)
+            state.update {
+                var state = $0
+                state.active = true
+                state.currentSessionId = EmbraceIdentifier(stringValue: sessionId)
+                return state
             }
         }
     }
@@ -82,8 +113,12 @@ class DefaultNetworkPayloadCaptureHandler: NetworkPayloadCaptureHandler {
         }
 
         let newRules = rules.map { URLSessionTaskCaptureRule(rule: $0) }
-        state.withLock {
-            $0.rules = newRules
+        let matcher = URLCaptureRuleMatcher(rules: newRules)
+        state.update {
+            var state = $0
+            state.rules = newRules
+            state.matcher = matcher
+            return state
         }
     }
 
@@ -93,42 +128,66 @@ class DefaultNetworkPayloadCaptureHandler: NetworkPayloadCaptureHandler {
     }
 
     @objc func onSessionStart(_ notification: Notification) {
-        state.withLock {
-            $0.active = true
-            $0.rulesTriggeredMap.removeAll()
-            $0.currentSessionId = (notification.object as? EmbraceSession)?.id
+        state.update {
+            var state = $0
+            state.active = true
+            state.rulesTriggeredMap.removeAll()
+            state.currentSessionId = (notification.object as? EmbraceSession)?.id
+            return state
         }
     }
 
     @objc func onSessionEnd() {
-        state.withLock {
-            $0.active = false
-            $0.currentSessionId = nil
+        state.update {
+            var state = $0
+            state.active = false
+            state.currentSessionId = nil
+            return state
         }
     }
 
-    public func process(
+    func bodyCaptureLimit(request: URLRequest?, response: URLResponse?) -> Int {
+        let state = self.state.load()
+
+        guard state.active, let url = request?.url else {
+            return 0
+        }
+
+        return state.matcher.matchingRules(for: url.absoluteString)
+            .filter {
+                state.rulesTriggeredMap[$0.id] == nil && $0.mayMatch(request: request, response: response)
+            }
+            .map { $0.bodyLimit }
+            .max() ?? 0
+    }
+
+    func process(
         request: URLRequest?,
         response: URLResponse?,
-        data: Data?,
+        body: NetworkBodyBuffer?,
         error: Error?,
         startTime: Date?,
         endTime: Date?
     ) {
-        var protectedDataCopy = state.safeValue
+        let state = self.state.load()
 
-        guard protectedDataCopy.active else {
+        guard state.active, let url = request?.url else {
             return
         }
 
-        for rule in protectedDataCopy.rules {
+        // rules whose url regex matches, found in a single pass
+        let matchingRules = state.matcher.matchingRules(for: url.absoluteString)
+        var triggered: [String] = []
+        defer { markTriggered(triggered, sessionId: state.currentSessionId) }
+
+        for rule in matchingRules {
             // check if rule was already triggered
-            guard protectedDataCopy.rulesTriggeredMap[rule.id] == nil else {
+            guard state.rulesTriggeredMap[rule.id] == nil else {
                 continue
             }
 
             // check if rule applies for this task
-            guard rule.shouldTriggerFor(request: request, response: response, error: error) else {
+            guard rule.conditionsMatch(request: request, response: response, error: error) else {
                 continue
             }
 
@@ -137,12 +196,13 @@ class DefaultNetworkPayloadCaptureHandler: NetworkPayloadCaptureHandler {
                 let payload = EncryptedNetworkPayload(
                     request: request,
                     response: response,
-                    data: data,
+                    body: body,
+                    bodyLimit: rule.bodyLimit,
                     error: error,
                     startTime: startTime,
                     endTime: endTime,
                     matchedUrl: rule.urlRegex,
-                    sessionId: protectedDataCopy.currentSessionId
+                    sessionId: state.currentSessionId
                 )
             else {
                 Embrace.logger.debug("Couldn't generate payload for task \(rule.urlRegex)!")
@@ -173,18 +233,30 @@ class DefaultNetworkPayloadCaptureHandler: NetworkPayloadCaptureHandler {
             )
 
             // flag rule as triggered
-            protectedDataCopy.rulesTriggeredMap[rule.id] = true
+            triggered.append(rule.id)
+        }
+    }
+
+    /// Flags rules as triggered, unless a new session started since they were checked.
+    private func markTriggered(_ ruleIds: [String], sessionId: EmbraceIdentifier?) {
+        guard !ruleIds.isEmpty else {
+            return
         }
 
-        // udpate all mutations to protected data
-        state.withLock {
-            $0.rulesTriggeredMap = protectedDataCopy.rulesTriggeredMap
+        state.update {
+            guard $0.currentSessionId == sessionId else {
+                return $0
+            }
+
+            var state = $0
+            for id in ruleIds {
+                state.rulesTriggeredMap[id] = true
+            }
+            return state
         }
     }
 
     func isEnabled() -> Bool {
-        state.withLock {
-            $0.active && $0.rules.isEmpty == false
-        }
+        state.read { $0.active && !$0.rules.isEmpty }
     }
 }
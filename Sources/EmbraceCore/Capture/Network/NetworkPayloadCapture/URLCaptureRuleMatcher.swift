@@ -0,0 +1,134 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCommonInternal
+#endif
+
+/// Finds every network capture rule whose url regex matches a url, for the whole rule set at once.
+///
+/// Rules whose regex fits `URLPattern` are compiled into a `URLPatternAutomaton` and matched in a
+/// single pass over the url; the rest keep using their `NSRegularExpression`.
+///
+/// Rules that can't tell numbers apart (`URLPattern.isDigitRunInvariant`) are matched against the url's
+/// template instead, with every run of digits collapsed, and the result is cached per template. With
+/// typical rules that's one match per host and path template: `/users/12` and `/users/345` share it.
+///
+/// Built once per rule set and shared by every task, so it's safe to call from any thread.
+final class URLCaptureRuleMatcher {
+
+    private struct Group {
+        let automaton: URLPatternAutomaton
+
+        /// Rule index for each automaton pattern.
+        let rules: [Int]
+
+        func matches(_ bytes: [UInt8]) -> [Int] {
+            var result: [Int] = []
+            bytes.withUnsafeBufferPointer {
+                automaton.matches($0).forEach { result.append(rules[$0]) }
+            }
+            return result
+        }
+    }
+
+    static let cacheLimit = 256
+
+    let rules: [URLSessionTaskCaptureRule]
+
+    /// Digit-run invariant rules, matched against templates.
+    private let templated: Group?
+
+    /// Other compiled rules, matched against the url itself.
+    private let exact: Group?
+
+    /// Rules matched with their `NSRegularExpression`.
+    private let fallback: [Int]
+
+    /// Matched templated rules, keyed by url template.
+    private let cache = EmbraceMutex([[UInt8]: [Int]]())
+
+    init(rules: [URLSessionTaskCaptureRule]) {
+        self.rules = rules
+
+        var templated: [(index: Int, pattern: URLPattern)] = []
+        var exact: [(index: Int, pattern: URLPattern)] = []
+        var fallback: [Int] = []
+
+        for (index, rule) in rules.enumerated() where rule.isRegexValid {
+            guard let pattern = URLPattern(rule.pattern) else {
+                fallback.append(index)
+                continue
+            }
+
+            if pattern.isDigitRunInvariant {
+                templated.append((index, pattern))
+            } else {
+                exact.append((index, pattern))
+            }
+        }
+
+        self.templated = Self.group(templated)
+        self.exact = Self.group(exact)
+        self.fallback = fallback
+    }
+
+    /// Returns the rules whose url regex matches `url`, in rule order.
+    /// Only the url is checked; see `URLSessionTaskCaptureRule.conditionsMatch`.
+    func matchingRules(for url: String) -> [URLSessionTaskCaptureRule] {
+        guard !rules.isEmpty else {
+            return []
+        }
+
+        let normalized = url.removingHttpPrefix()
+        let bytes = Array(normalized.utf8)
+
+        // the automata work on ASCII; percent-encoded urls always are
+        guard !bytes.contains(where: { $0 >= 0x80 }) else {
+            return rules.filter { $0.urlMatches(normalizedURL: normalized) }
+        }
+
+        var matched = Array(repeating: false, count: rules.count)
+
+        if let templated {
+            let template = URLPattern.digitRunTemplate(of: bytes)
+
+            let indices: [Int]
+            if let cached = cache.withLock({ $0[template] }) {
+                indices = cached
+            } else {
+                indices = templated.matches(template)
+                cache.withLock {
+                    if $0.count >= Self.cacheLimit {
+                        $0.removeAll()
+                    }
+                    $0[template] = indices
+                }
+            }
+
+            indices.forEach { matched[$0] = true }
+        }
+
+        exact?.matches(bytes).forEach { matched[$0] = true }
+
+        for index in fallback where rules[index].urlMatches(normalizedURL: normalized) {
+            matched[index] = true
+        }
+
+        return rules.indices.filter { matched[$0] }.map { rules[$0] }
+    }
+
+    private static func group(_ patterns: [(index: Int, pattern: URLPattern)]) -> Group? {
+        guard !patterns.isEmpty else {
+            return nil
+        }
+
+        return Group(
+            automaton: URLPatternAutomaton(patterns: patterns.map { $0.pattern }),
+            rules: patterns.map { $0.index }
+        )
+    }
+}
@@ -0,0 +1,373 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+/// A network capture rule's url regex, parsed into a sequence of single-character atoms.
+///
+/// Only the subset of the ICU syntax that rules use in practice is supported: literals, escapes, `.`,
+/// `\d`, `\w`, bracket classes and the `*`, `+`, `?` and `{m,n}` quantifiers, with optional `^` and `$`
+/// anchors. Patterns are matched case-insensitively against ASCII input, like the
+/// `NSRegularExpression` built by `URLSessionTaskCaptureRule`.
+///
+/// `init` fails for anything else (groups, alternation, look-arounds, non-ASCII), and the rule keeps
+/// using its `NSRegularExpression`.
+struct URLPattern {
+
+    /// Set of ASCII bytes.
+    struct ByteSet: Equatable {
+        private(set) var low: UInt64 = 0
+        private(set) var high: UInt64 = 0
+
+        static let digits = ByteSet(UInt8(ascii: "0")...UInt8(ascii: "9"))
+        static let word =
+            ByteSet(UInt8(ascii: "a")...UInt8(ascii: "z"))
+            .union(ByteSet(UInt8(ascii: "A")...UInt8(ascii: "Z")))
+            .union(.digits)
+            .union(ByteSet(UInt8(ascii: "_")...UInt8(ascii: "_")))
+
+        /// `.` matches everything but line terminators.
+        static let any = ByteSet(0...127).subtracting(ByteSet(0x0A...0x0D))
+
+        init() {}
+
+        init(_ range: ClosedRange<UInt8>) {
+            for byte in range {
+                insert(byte)
+            }
+        }
+
+        func contains(_ byte: UInt8) -> Bool {
+            switch byte {
+            case 0..<64: return low & (1 << UInt64(byte)) != 0
+            case 64..<128: return high & (1 << UInt64(byte - 64)) != 0
+            default: return false
+            }
+        }
+
+        mutating func insert(_ byte: UInt8) {
+            switch byte {
+            case 0..<64: low |= 1 << UInt64(byte)
+            case 64..<128: high |= 1 << UInt64(byte - 64)
+            default: break
+            }
+        }
+
+        func union(_ other: ByteSet) -> ByteSet {
+            var result = self
+            result.low |= other.low
+            result.high |= other.high
+            return result
+        }
+
+        func subtracting(_ other: ByteSet) -> ByteSet {
+            var result = self
+            result.low &= ~other.low
+            result.high &= ~other.high
+            return result
+        }
+
+        func isSuperset(of other: ByteSet) -> Bool {
+            return other.subtracting(self) == ByteSet()
+        }
+
+        var isDisjointFromDigits: Bool {
+            return subtracting(ByteSet.digits) == self
+        }
+
+        /// Adds the other case of every ASCII letter in the set.
+        func caseFolded() -> ByteSet {
+            var result = self
+            for byte in UInt8(ascii: "A")...UInt8(ascii: "Z") where contains(byte) || contains(byte | 0x20) {
+                result.insert(byte)
+                result.insert(byte | 0x20)
+            }
+            return result
+        }
+    }
+
+    enum Quantifier {
+        case one
+        case optional
+        case star
+        case plus
+
+        var isOptional: Bool { self == .optional || self == .star }
+        var isRepeatable: Bool { self == .star || self == .plus }
+    }
+
+    struct Atom {
+        let bytes: ByteSet
+        let quantifier: Quantifier
+    }
+
+    let atoms: [Atom]
+    let anchoredStart: Bool
+    let anchoredEnd: Bool
+
+    /// Stand-in for a run of digits in `digitRunTemplate(of:)`; never part of an atom that doesn't also match digits.
+    static let digitRunPlaceholder: UInt8 = 0
+
+    /// Whether the pattern matches the same inputs as their digit-run templates.
+    ///
+    /// True when every atom either never matches a digit, or is a `*` that matches every digit and the
+    /// placeholder: such a pattern can't tell `/user/12/` from `/user/345/`, so its result can be
+    /// cached for the template.
+    var isDigitRunInvariant: Bool {
+        let digitsAndPlaceholder = ByteSet.digits.union(ByteSet(Self.digitRunPlaceholder...Self.digitRunPlaceholder))
+        return atoms.allSatisfy {
+            if $0.quantifier == .star && $0.bytes.isSuperset(of: digitsAndPlaceholder) {
+                return true
+            }
+            return $0.bytes.isDisjointFromDigits && !$0.bytes.contains(Self.digitRunPlaceholder)
+        }
+    }
+
+    /// Whether the pattern matches the empty string.
+    var isNullable: Bool {
+        return atoms.allSatisfy { $0.quantifier.isOptional }
+    }
+
+    /// Replaces every run of ASCII digits in `bytes` with a single `digitRunPlaceholder`.
+    static func digitRunTemplate<S: Sequence>(of bytes: S) -> [UInt8] where S.Element == UInt8 {
+        var result: [UInt8] = []
+        var inRun = false
+        for byte in bytes {
+            if ByteSet.digits.contains(byte) {
+                if !inRun {
+                    result.append(digitRunPlaceholder)
+                }
+                inRun = true
+            } else {
+                result.append(byte)
+                inRun = false
+            }
+        }
+        return result
+    }
+
+    // MARK: - Parsing
+
+    /// Largest `{m,n}` bound that is expanded into atoms.
+    private static let repetitionLimit = 32
+
+    init?(_ pattern: String) {
+        let p = Array(pattern.utf8)
+        guard !p.contains(where: { $0 >= 0x80 }) else {
+            return nil
+        }
+
+        var atoms: [Atom] = []
+        var anchoredStart = false
+        var anchoredEnd = false
+        var i = 0
+
+        if p.first == UInt8(ascii: "^") {
+            anchoredStart = true
+            i = 1
+        }
+
+        while i < p.count {
+            let c = p[i]
+
+            if c == UInt8(ascii: "$") && i == p.count - 1 {
+                anchoredEnd = true
+                break
+            }
+
+            // atom
+            var bytes: ByteSet
+            switch c {
+            case UInt8(ascii: "\\"):
+                guard i + 1 < p.count, let escaped = Self.escape(p[i + 1]) else {
+                    return nil
+                }
+                bytes = escaped
+                i += 2
+
+            case UInt8(ascii: "."):
+                bytes = .any
+                i += 1
+
+            case UInt8(ascii: "["):
+                guard let parsed = Self.parseClass(p, from: i) else {
+                    return nil
+                }
+                bytes = parsed.set
+                i = parsed.end
+
+            case UInt8(ascii: "("), UInt8(ascii: ")"), UInt8(ascii: "|"), UInt8(ascii: "*"), UInt8(ascii: "+"),
+                UInt8(ascii: "?"), UInt8(ascii: "{"), UInt8(ascii: "}"), UInt8(ascii: "]"), UInt8(ascii: "^"),
+                UInt8(ascii: "$"):
+                return nil
+
+            default:
+                bytes = ByteSet(c...c)
+                i += 1
+            }
+
+            // quantifier
+            var repetition: (min: Int, max: Int?) = (1, 1)
+            var isQuantified = false
+            if i < p.count {
+                isQuantified = true
+                switch p[i] {
+                case UInt8(ascii: "*"):
+                    repetition = (0, nil)
+                    i += 1
+                case UInt8(ascii: "+"):
+                    repetition = (1, nil)
+                    i += 1
+                case UInt8(ascii: "?"):
+                    repetition = (0, 1)
+                    i += 1
+                case UInt8(ascii: "{"):
+                    guard let parsed = Self.parseRepetition(p, from: i) else {
+                        return nil
+                    }
+                    repetition = parsed.bounds
+                    i = parsed.end
+                default:
+                    isQuantified = false
+                }
+
+                if isQuantified && i < p.count {
+                    // lazy quantifiers match the same inputs, possessive ones don't
+                    if p[i] == UInt8(ascii: "?") {
+                        i += 1
+                    } else if p[i] == UInt8(ascii: "+") {
+                        return nil
+                    }
+                }
+            }
+
+            bytes = bytes.caseFolded()
+            atoms.append(contentsOf: Self.expand(bytes, repetition))
+        }
+
+        self.atoms = atoms
+        self.anchoredStart = anchoredStart
+        self.anchoredEnd = anchoredEnd
+    }
+
+    private static func expand(_ bytes: ByteSet, _ repetition: (min: Int, max: Int?)) -> [Atom] {
+        switch repetition {
+        case (0, nil): return [Atom(bytes: bytes, quantifier: .star)]
+        case (1, nil): return [Atom(bytes: bytes, quantifier: .plus)]
+        case (0, 1): return [Atom(bytes: bytes, quantifier: .optional)]
+        case (1, 1): return [Atom(bytes: bytes, quantifier: .one)]
+        case let (min, nil):
+            return Array(repeating: Atom(bytes: bytes, quantifier: .one), count: min - 1)
+                + [Atom(bytes: bytes, quantifier: .plus)]
+        case let (min, max?):
+            return Array(repeating: Atom(bytes: bytes, quantifier: .one), count: min)
+                + Array(repeating: Atom(bytes: bytes, quantifier: .optional), count: max - min)
+        }
+    }
+
+    /// Set for the escape sequence `\c`, or nil if it isn't supported.
+    private static func escape(_ c: UInt8) -> ByteSet? {
+        switch c {
+        case UInt8(ascii: "d"): return .digits
+        case UInt8(ascii: "w"): return .word
+        case UInt8(ascii: "0")...UInt8(ascii: "9"), UInt8(ascii: "a")...UInt8(ascii: "z"),
+            UInt8(ascii: "A")...UInt8(ascii: "Z"):
+            return nil
+        default:
+            // escaped punctuation is literal
+            return ByteSet(c...c)
+        }
+    }
+
+    /// Parses `[...]` starting at `start`. Returns the set and the index after `]`.
+    private static func parseClass(_ p: [UInt8], from start: Int) -> (set: ByteSet, end: Int)? {
+        var i = start + 1
+        var negated = false
+        if i < p.count && p[i] == UInt8(ascii: "^") {
+            negated = true
+            i += 1
+        }
+
+        var set = ByteSet()
+        var isFirst = true
+
+        while i < p.count {
+            let c = p[i]
+
+            if c == UInt8(ascii: "]") && !isFirst {
+                set = set.caseFolded()
+                return (negated ? ByteSet(0...127).subtracting(set) : set, i + 1)
+            }
+            isFirst = false
+
+            // nested sets, set operations and a leading `]` have ICU-specific meanings
+            if c == UInt8(ascii: "[") || c == UInt8(ascii: "]") {
+                return nil
+            }
+            if (c == UInt8(ascii: "&") || c == UInt8(ascii: "-")) && i + 1 < p.count && p[i + 1] == c {
+                return nil
+            }
+
+            var lower: UInt8
+            if c == UInt8(ascii: "\\") {
+                guard i + 1 < p.count, let escaped = escape(p[i + 1]) else {
+                    return nil
+                }
+                i += 2
+                guard escaped == ByteSet(p[i - 1]...p[i - 1]) else {
+                    // \d, \w
+                    set = set.union(escaped)
+                    continue
+                }
+                lower = p[i - 1]
+            } else {
+                lower = c
+                i += 1
+            }
+
+            // range
+            if i + 1 < p.count && p[i] == UInt8(ascii: "-") && p[i + 1] != UInt8(ascii: "]") {
+                let upper = p[i + 1]
+                guard upper != UInt8(ascii: "\\") && upper != UInt8(ascii: "[") && lower <= upper else {
+                    return nil
+                }
+                set = set.union(ByteSet(lower...upper))
+                i += 2
+            } else {
+                set.insert(lower)
+            }
+        }
+
+        // unterminated
+        return nil
+    }
+
+    /// Parses `{m}`, `{m,}` or `{m,n}` starting at `start`. Returns the bounds and the index after `}`.
+    private static func parseRepetition(_ p: [UInt8], from start: Int) -> (bounds: (min: Int, max: Int?), end: Int)? {
+        guard let close = p[start...].firstIndex(of: UInt8(ascii: "}")),
+            let body = String(bytes: p[(start + 1)..<close], encoding: .ascii)
+        else {
+            return nil
+        }
+
+        let parts = body.split(separator: ",", omittingEmptySubsequences: false)
+        guard let min = parts.first.flatMap({ Int($0) }), min <= repetitionLimit else {
+            return nil
+        }
+
+        switch parts.count {
+        case 1:
+            return ((min, min), close + 1)
+        case 2 where parts[1].isEmpty:
+            return min == 0 ? ((0, nil), close + 1) : ((min, nil), close + 1)
+        case 2:
+            guard let max = Int(parts[1]), max >= min, max <= repetitionLimit, max > 0 else {
+                return nil
+            }
+            return ((min, max), close + 1)
+        default:
+            return nil
+        }
+    }
+}
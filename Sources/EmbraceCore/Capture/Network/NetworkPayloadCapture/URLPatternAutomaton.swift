@@ -0,0 +1,276 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCommonInternal
+#endif
+
+/// Matches a set of `URLPattern`s at once, in a single pass over the input.
+///
+/// The patterns are combined into one position automaton (a state per atom), which is turned into a
+/// DFA lazily: a DFA state is created the first time the set of live positions is reached, and each
+/// transition is computed once and then reused, so a warm automaton costs one table lookup per byte
+/// regardless of the number of patterns. The DFA is dropped and rebuilt if it grows past `stateLimit`.
+///
+/// Every pattern that matches somewhere in the input is reported, not just the first one.
+final class URLPatternAutomaton {
+
+    /// Fixed-size set of small integers.
+    struct Bitset: Hashable {
+        private(set) var words: [UInt64]
+
+        init(count: Int) {
+            words = Array(repeating: 0, count: (count + 63) / 64)
+        }
+
+        var isEmpty: Bool {
+            return words.allSatisfy { $0 == 0 }
+        }
+
+        func contains(_ i: Int) -> Bool {
+            return words[i / 64] & (1 << UInt64(i % 64)) != 0
+        }
+
+        mutating func insert(_ i: Int) {
+            words[i / 64] |= 1 << UInt64(i % 64)
+        }
+
+        mutating func formUnion(_ other: Bitset) {
+            for i in words.indices {
+                words[i] |= other.words[i]
+            }
+        }
+
+        func intersection(_ other: Bitset) -> Bitset {
+            var result = self
+            for i in words.indices {
+                result.words[i] &= other.words[i]
+            }
+            return result
+        }
+
+        func forEach(_ body: (Int) -> Void) {
+            for (index, word) in words.enumerated() {
+                var word = word
+                while word != 0 {
+                    body(index * 64 + word.trailingZeroBitCount)
+                    word &= word - 1
+                }
+            }
+        }
+    }
+
+    private struct State {
+        let positions: Bitset
+        let isInitial: Bool
+
+        /// DFA state reached on each byte, or -1 if not computed yet.
+        var next: [Int32] = Array(repeating: -1, count: 256)
+
+        /// Patterns that have matched once this state is reached.
+        let matches: Bitset
+
+        /// `$`-anchored patterns that match if the input ends in this state.
+        let matchesAtEnd: Bitset
+    }
+
+    private struct DFA {
+        var states: [State]
+        var index: [Bitset: Int32] = [:]
+    }
+
+    static let stateLimit = 512
+
+    let patternCount: Int
+    private let positionCount: Int
+
+    /// Positions that can follow each position.
+    private let follow: [Bitset]
+
+    /// First positions of unanchored patterns, live at every offset.
+    private let startFollow: Bitset
+
+    /// First positions of `^`-anchored patterns, only live at offset 0.
+    private let anchoredStartFollow: Bitset
+
+    /// Positions whose atom matches each byte.
+    private let bytePositions: [Bitset]
+
+    /// Pattern completed by each position, or -1.
+    private let acceptedPattern: [Int32]
+    private let anchoredEndPatterns: Bitset
+
+    private let dfa: EmbraceMutex<DFA>
+
+    init(patterns: [URLPattern]) {
+        let positionCount = patterns.reduce(0) { $0 + $1.atoms.count }
+
+        var follow = Array(repeating: Bitset(count: positionCount), count: positionCount)
+        var startFollow = Bitset(count: positionCount)
+        var anchoredStartFollow = Bitset(count: positionCount)
+        var bytePositions = Array(repeating: Bitset(count: positionCount), count: 256)
+        var acceptedPattern = Array(repeating: Int32(-1), count: positionCount)
+        var anchoredEndPatterns = Bitset(count: patterns.count)
+        var alwaysMatching = Bitset(count: patterns.count)
+        var emptyMatching = Bitset(count: patterns.count)
+
+        var offset = 0
+        for (index, pattern) in patterns.enumerated() {
+            let atoms = pattern.atoms
+
+            // positions reachable before consuming atom `j`: `j` and every atom after a run of optional ones
+            func reach(_ j: Int) -> Bitset {
+                var result = Bitset(count: positionCount)
+                var t = j
+                while t < atoms.count {
+                    result.insert(offset + t)
+                    guard atoms[t].quantifier.isOptional else {
+                        break
+                    }
+                    t += 1
+                }
+                return result
+            }
+
+            if pattern.anchoredStart {
+                anchoredStartFollow.formUnion(reach(0))
+            } else {
+                startFollow.formUnion(reach(0))
+            }
+
+            for (i, atom) in atoms.enumerated() {
+                let position = offset + i
+
+                follow[position] = reach(i + 1)
+                if atom.quantifier.isRepeatable {
+                    follow[position].insert(position)
+                }
+
+                if atoms[(i + 1)...].allSatisfy({ $0.quantifier.isOptional }) {
+                    acceptedPattern[position] = Int32(index)
+                }
+
+                for byte in 0..<128 where atom.bytes.contains(UInt8(byte)) {
+                    bytePositions[byte].insert(position)
+                }
+            }
+
+            if pattern.anchoredEnd {
+                anchoredEndPatterns.insert(index)
+            }
+
+            if pattern.isNullable {
+                if pattern.anchoredStart && pattern.anchoredEnd {
+                    emptyMatching.insert(index)
+                } else {
+                    alwaysMatching.insert(index)
+                }
+            }
+
+            offset += atoms.count
+        }
+
+        self.patternCount = patterns.count
+        self.positionCount = positionCount
+        self.follow = follow
+        self.startFollow = startFollow
+        self.anchoredStartFollow = anchoredStartFollow
+        self.bytePositions = bytePositions
+        self.acceptedPattern = acceptedPattern
+        self.anchoredEndPatterns = anchoredEndPatterns
+
+        let initial = State(
+            positions: Bitset(count: positionCount),
+            isInitial: true,
+            matches: alwaysMatching,
+            matchesAtEnd: emptyMatching
+        )
+        self.dfa = EmbraceMutex(DFA(states: [initial]))
+    }
+
+    /// Returns the indices of the patterns that match somewhere in `bytes`.
+    func matches(_ bytes: UnsafeBufferPointer<UInt8>) -> Bitset {
+        dfa.withLock { dfa in
+            var current = 0
+            var matched = dfa.states[current].matches
+
+            for byte in bytes {
+                var next = dfa.states[current].next[Int(byte)]
+                if next < 0 {
+                    next = transition(from: current, on: byte, in: &dfa)
+                }
+                current = Int(next)
+
+                if !dfa.states[current].matches.isEmpty {
+                    matched.formUnion(dfa.states[current].matches)
+                }
+            }
+
+            matched.formUnion(dfa.states[current].matchesAtEnd)
+            return matched
+        }
+    }
+
+    /// Number of DFA states built so far.
+    var stateCount: Int {
+        dfa.withLock { $0.states.count }
+    }
+
+    // MARK: - Private
+
+    private func transition(from source: Int, on byte: UInt8, in dfa: inout DFA) -> Int32 {
+        var candidates = startFollow
+        if dfa.states[source].isInitial {
+            candidates.formUnion(anchoredStartFollow)
+        }
+        dfa.states[source].positions.forEach {
+            candidates.formUnion(follow[$0])
+        }
+        let positions = candidates.intersection(bytePositions[Int(byte)])
+
+        if let target = dfa.index[positions] {
+            dfa.states[source].next[Int(byte)] = target
+            return target
+        }
+
+        var source = source
+        if dfa.states.count >= Self.stateLimit {
+            // start over, keeping only the initial state
+            var initial = dfa.states[0]
+            initial.next = Array(repeating: -1, count: 256)
+            dfa.states = [initial]
+            dfa.index.removeAll()
+
+            if source != 0 {
+                source = -1
+            }
+        }
+
+        var matches = Bitset(count: patternCount)
+        var matchesAtEnd = Bitset(count: patternCount)
+        positions.forEach {
+            let pattern = Int(acceptedPattern[$0])
+            guard pattern >= 0 else {
+                return
+            }
+            if anchoredEndPatterns.contains(pattern) {
+                matchesAtEnd.insert(pattern)
+            } else {
+                matches.insert(pattern)
+            }
+        }
+
+        let target = Int32(dfa.states.count)
+        dfa.states.append(State(positions: positions, isInitial: false, matches: matches, matchesAtEnd: matchesAtEnd))
+        dfa.index[positions] = target
+
+        if source >= 0 {
+            dfa.states[source].next[Int(byte)] = target
+        }
+
+        return target
+    }
+}
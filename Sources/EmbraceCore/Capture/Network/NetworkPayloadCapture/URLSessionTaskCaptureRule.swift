@@ -10,10 +10,16 @@ import Foundation
 
 class URLSessionTaskCaptureRule {
 
+    /// Response body bytes captured for rules that don't set `maxBodySize`.
+    static let defaultBodyLimit = 1024 * 1024
+
     private var rule: NetworkPayloadCaptureRule
     private let regex: NSRegularExpression?
     let publicKey: String
 
+    /// `urlRegex` without its `http(s)://` prefix, as matched against urls.
+    let pattern: String
+
     var id: String {
         return rule.id
     }
@@ -23,12 +29,19 @@ class URLSessionTaskCaptureRule {
     var expirationDate: Date {
         return rule.expirationDate
     }
+    var isRegexValid: Bool {
+        return regex != nil
+    }
+    var bodyLimit: Int {
+        return max(rule.maxBodySize ?? Self.defaultBodyLimit, 0)
+    }
 
     init(rule: NetworkPayloadCaptureRule) {
         self.rule = rule
+        self.pattern = rule.urlRegex.removingHttpPrefix()
 
         do {
-            regex = try NSRegularExpression(pattern: rule.urlRegex.removingHttpPrefix(), options: .caseInsensitive)
+            regex = try NSRegularExpression(pattern: pattern, options: .caseInsensitive)
         } catch {
             Embrace.logger.error(
                 "Error trying to create regex \"\(rule.urlRegex)\" for rule \(rule.id)!\n\(error.localizedDescription)")
@@ -40,28 +53,17 @@ class URLSessionTaskCaptureRule {
 
     func shouldTriggerFor(request: URLRequest?, response: URLResponse?, error: Error?) -> Bool {
 
-        guard let request = request,
-            let url = request.url,
-            let method = request.httpMethod,
-            expirationDate > Date()
-        else {
-            return false
-        }
-
-        // ignore requests to Embrace's back end
-        if let endpoints = Embrace.client?.options.endpoints {
-            guard !url.absoluteString.contains(endpoints.baseURL) else {
-                return false
-            }
-        }
-
         // check that the url matches
-        guard urlMatches(url.absoluteString) else {
+        guard let url = request?.url, urlMatches(normalizedURL: url.absoluteString.removingHttpPrefix()) else {
             return false
         }
 
-        // check that the method matches
-        guard let ruleMethod = rule.method, ruleMethod == method else {
+        return conditionsMatch(request: request, response: response, error: error)
+    }
+
+    /// Checks everything but the url, for callers that matched it already (see `URLCaptureRuleMatcher`).
+    func conditionsMatch(request: URLRequest?, response: URLResponse?, error: Error?) -> Bool {
+        guard requestMatches(request) else {
             return false
         }
 
@@ -87,14 +89,56 @@ class URLSessionTaskCaptureRule {
         return true
     }
 
-    private func urlMatches(_ url: String) -> Bool {
+    /// Whether `conditionsMatch` can still pass once the task finishes, checked while the body is received
+    /// so tasks that can't be captured don't buffer it. The url must have been matched already.
+    func mayMatch(request: URLRequest?, response: URLResponse?) -> Bool {
+        guard requestMatches(request) else {
+            return false
+        }
+
+        // the task could still fail, or the status code isn't known yet
+        guard let statusCodes = rule.statusCodes,
+            !statusCodes.contains(-1),
+            let statusCode = (response as? HTTPURLResponse)?.statusCode
+        else {
+            return true
+        }
+
+        return statusCodes.contains(statusCode)
+    }
+
+    /// Checks the expiration, the Embrace endpoints and the method.
+    private func requestMatches(_ request: URLRequest?) -> Bool {
+        guard let request = request,
+            let url = request.url,
+            let method = request.httpMethod,
+            expirationDate > Date()
+        else {
+            return false
+        }
+
+        // ignore requests to Embrace's back end
+        if let endpoints = Embrace.client?.options.endpoints {
+            guard !url.absoluteString.contains(endpoints.baseURL) else {
+                return false
+            }
+        }
+
+        // check that the method matches
+        guard let ruleMethod = rule.method, ruleMethod == method else {
+            return false
+        }
+
+        return true
+    }
+
+    /// Whether the url regex matches `url`, which must already have its `http(s)://` prefix removed.
+    func urlMatches(normalizedURL url: String) -> Bool {
         guard let regex = regex else {
             return false
         }
 
-        let string = url.removingHttpPrefix()
-        let matches = regex.matches(in: string, range: NSRange(location: 0, length: string.count))
-        return matches.isEmpty == false
+        return regex.firstMatch(in: url, range: NSRange(location: 0, length: url.utf16.count)) != nil
     }
 
     static private func sanitize(_ key: String) -> String {
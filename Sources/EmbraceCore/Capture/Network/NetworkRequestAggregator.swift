@@ -0,0 +1,175 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCommonInternal
+#endif
+
+/// Rolls requests matching the configured url templates into per-session summaries.
+/// See `URLSessionCaptureService.Aggregation`.
+final class NetworkRequestAggregator {
+
+    struct Key: Hashable {
+        let method: String
+        let template: String
+    }
+
+    struct Summary: Encodable {
+        let method: String
+        let template: String
+
+        var count: Int = 0
+        var errorCount: Int = 0
+        var statusCodes: [Int: Int] = [:]
+        var durationMs = NetworkAggregateHistogram()
+        var responseBytes = NetworkAggregateHistogram()
+
+        enum CodingKeys: String, CodingKey {
+            case method
+            case template
+            case count
+            case errorCount = "error_count"
+            case statusCodes = "status_codes"
+            case durationMs = "duration_ms"
+            case responseBytes = "response_bytes"
+        }
+
+        func encode(to encoder: Encoder) throws {
+            var container = encoder.container(keyedBy: CodingKeys.self)
+            try container.encode(method, forKey: .method)
+            try container.encode(template, forKey: .template)
+            try container.encode(count, forKey: .count)
+            try container.encode(errorCount, forKey: .errorCount)
+            try container.encode(
+                Dictionary(uniqueKeysWithValues: statusCodes.map { (String($0.key), $0.value) }),
+                forKey: .statusCodes
+            )
+            try container.encode(durationMs, forKey: .durationMs)
+            try container.encode(responseBytes, forKey: .responseBytes)
+        }
+    }
+
+    /// Templates with a query, matched as they are.
+    private let templates: Set<String>
+
+    /// Templates without a query, matched against the request's template minus its query.
+    private let pathTemplates: Set<Substring>
+
+    let slowRequestThreshold: TimeInterval
+
+    private let summaries = EmbraceMutex([Key: Summary]())
+
+    init?(options: URLSessionCaptureService.Aggregation) {
+        guard !options.templates.isEmpty else {
+            return nil
+        }
+
+        templates = Set(options.templates.filter { $0.contains("?") })
+        pathTemplates = Set(options.templates.filter { !$0.contains("?") }.map { Substring($0) })
+        slowRequestThreshold = options.slowRequestThreshold
+    }
+
+    /// Returns the key to aggregate a request under, or nil if it doesn't match any template.
+    func key(for url: URL, method: String) -> Key? {
+        let template = URLTemplate.template(for: url)
+
+        if templates.contains(template) {
+            return Key(method: method, template: template)
+        }
+
+        let path = URLTemplate.removingQuery(template)
+        if pathTemplates.contains(path) {
+            return Key(method: method, template: String(path))
+        }
+
+        return nil
+    }
+
+    /// Whether a finished request should be captured as an individual span instead of aggregated.
+    func keepsIndividually(duration: TimeInterval, statusCode: Int?, error: Error?) -> Bool {
+        guard error == nil, let statusCode, statusCode < 400 else {
+            return true
+        }
+
+        return duration >= slowRequestThreshold
+    }
+
+    func record(_ key: Key, duration: TimeInterval, responseBytes: Int, statusCode: Int?, failed: Bool = false) {
+        summaries.withLock {
+            var summary = $0[key] ?? Summary(method: key.method, template: key.template)
+
+            summary.count += 1
+            if failed {
+                summary.errorCount += 1
+            }
+            if let statusCode {
+                summary.statusCodes[statusCode, default: 0] += 1
+            }
+            summary.durationMs.record(Int((duration * 1000).rounded()))
+            summary.responseBytes.record(responseBytes)
+
+            $0[key] = summary
+        }
+    }
+
+    /// Returns the summaries recorded since the last call, sorted by method and template.
+    func flush() -> [Summary] {
+        let flushed = summaries.withLock {
+            defer { $0.removeAll() }
+            return $0
+        }
+
+        return flushed.values.sorted { ($0.method, $0.template) < ($1.method, $1.template) }
+    }
+}
+
+/// Histogram with power of two buckets: bucket `i` counts values in `[2^(i-1), 2^i)`, and bucket 0 counts
+/// values below 1. Relative error is at most 2x, which is plenty for spotting latency and size shifts.
+struct NetworkAggregateHistogram: Encodable {
+    private(set) var count = 0
+    private(set) var sum = 0
+    private(set) var min = Int.max
+    private(set) var max = Int.min
+    private(set) var buckets: [Int] = []
+
+    mutating func record(_ value: Int) {
+        let index = value <= 0 ? 0 : Int.bitWidth - value.leadingZeroBitCount
+        if index >= buckets.count {
+            buckets.append(contentsOf: repeatElement(0, count: index - buckets.count + 1))
+        }
+
+        buckets[index] += 1
+        count += 1
+        sum += value
+        min = Swift.min(min, value)
+        max = Swift.max(max, value)
+    }
+
+    enum CodingKeys: String, CodingKey {
+        case count
+        case sum
+        case min
+        case max
+        case buckets
+    }
+
+    /// Buckets are encoded as `[upper bound, count]` pairs, skipping empty ones.
+    func encode(to encoder: Encoder) throws {
+        var container = encoder.container(keyedBy: CodingKeys.self)
+        try container.encode(count, forKey: .count)
+        try container.encode(sum, forKey: .sum)
+
+        guard count > 0 else {
+            return
+        }
+
+        try container.encode(min, forKey: .min)
+        try container.encode(max, forKey: .max)
+
+        let nonEmpty = buckets.enumerated().filter { $0.element > 0 }.map { [1 << $0.offset, $0.element] }
+        try container.encode(nonEmpty, forKey: .buckets)
+    }
+}
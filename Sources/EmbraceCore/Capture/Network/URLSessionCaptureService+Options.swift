@@ -24,8 +24,12 @@ extension URLSessionCaptureService {
         /// An empty list means no domains should be captured.
         @objc public let onlyAllowDomains: [String]?
 
+        /// `onlyAllowDomains` compiled for matching on every captured request.
+        let onlyAllowDomainsMatcher: HostAllowlistMatcher?
+
         @objc public init(onlyAllowDomains: [String]? = nil) {
             self.onlyAllowDomains = Traceparent.validated(onlyAllowDomains)
+            self.onlyAllowDomainsMatcher = self.onlyAllowDomains.map { HostAllowlistMatcher(allowlist: $0) }
 
             super.init()
         }
@@ -64,6 +68,32 @@ extension URLSessionCaptureService {
         }
     }
 
+    /// Configuration for aggregating high frequency network requests, like polling or analytics beacons.
+    ///
+    /// Requests whose url matches one of the `templates` aren't captured as individual spans. Instead, they're
+    /// rolled into a summary per method and template (request count, status codes and latency and response
+    /// size histograms) that's logged once per session. Failed and slow requests are still captured as spans.
+    @objc(EMBURLSessionCaptureServiceAggregationOptions)
+    public final class Aggregation: NSObject {
+        /// Url templates of the requests to aggregate.
+        ///
+        /// Templates are written the way `URLTemplate` normalizes urls: lowercased host followed by the path,
+        /// with numeric path segments replaced by `{int}` and UUID segments by `{uuid}`, and the query reduced
+        /// to its sorted keys. For example `"api.test.com/v1/users/{int}/feed?cursor&limit"`.
+        /// A template without a query matches requests with any query.
+        @objc public let templates: [String]
+
+        /// Requests that take at least this long are captured as individual spans.
+        @objc public let slowRequestThreshold: TimeInterval
+
+        @objc public init(templates: [String] = [], slowRequestThreshold: TimeInterval = 1) {
+            self.templates = templates
+            self.slowRequestThreshold = slowRequestThreshold
+
+            super.init()
+        }
+    }
+
     /// Class used to setup a URLSessionCaptureService.
     @objc(EMBURLSessionCaptureServiceOptions)
     public final class Options: NSObject {
@@ -79,14 +109,32 @@ extension URLSessionCaptureService {
         /// Options for W3C `traceparent` header propagation.
         @objc public let traceparent: Traceparent
 
+        /// Options for aggregating high frequency requests.
+        @objc public let aggregation: Aggregation
+
         @objc public init(
             requestsDataSource: URLSessionRequestsDataSource? = nil,
             ignoredURLs: [String] = [],
-            traceparent: Traceparent = Traceparent()
+            traceparent: Traceparent = Traceparent(),
+            aggregation: Aggregation
         ) {
             self.requestsDataSource = requestsDataSource
             self.ignoredURLs = ignoredURLs
             self.traceparent = traceparent
+            self.aggregation = aggregation
+        }
+
+        @objc public convenience init(
+            requestsDataSource: URLSessionRequestsDataSource? = nil,
+            ignoredURLs: [String] = [],
+            traceparent: Traceparent = Traceparent()
+        ) {
+            self.init(
+                requestsDataSource: requestsDataSource,
+                ignoredURLs: ignoredURLs,
+                traceparent: traceparent,
+                aggregation: Aggregation()
+            )
         }
 
         /// - Note: `injectTracingHeader` is ignored. Injection rate is now controlled by remote
@@ -106,6 +154,7 @@ extension URLSessionCaptureService {
             self.requestsDataSource = requestsDataSource
             self.ignoredURLs = ignoredURLs
             self.traceparent = traceparent
+            self.aggregation = Aggregation()
             Options.logDeprecatedInjectTracingHeaderOnce()
         }
 
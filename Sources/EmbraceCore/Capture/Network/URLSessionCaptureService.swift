@@ -10,6 +10,7 @@ import OpenTelemetryApi
     import EmbraceCommonInternal
     import EmbraceObjCUtilsInternal
     import EmbraceConfiguration
+    import EmbraceSemantics
 #endif
 
 typealias URLSessionCompletion = (Data?, URLResponse?, Error?) -> Void
@@ -26,6 +27,7 @@ class EmbraceDummyURLSessionDelegate: NSObject, URLSessionDelegate {}
 public final class URLSessionCaptureService: CaptureService, URLSessionTaskHandlerDataSource {
 
     public let options: URLSessionCaptureService.Options
+    let aggregator: NetworkRequestAggregator?
     private let lock: NSLocking
     private let swizzlerProvider: URLSessionSwizzlerProvider
     private(set) var swizzlers: [any URLSessionSwizzler] = []
@@ -45,6 +47,7 @@ public final class URLSessionCaptureService: CaptureService, URLSessionTaskHandl
         swizzlerProvider: URLSessionSwizzlerProvider
     ) {
         self.options = options
+        self.aggregator = NetworkRequestAggregator(options: options.aggregation)
         self.lock = lock
         self.swizzlerProvider = swizzlerProvider
     }
@@ -80,6 +83,35 @@ public final class URLSessionCaptureService: CaptureService, URLSessionTaskHandl
         }
     }
 
+    public override func onSessionWillEnd(_ session: any EmbraceSession) {
+        logAggregatedRequests()
+    }
+
+    /// Logs the summaries of the aggregated requests of the session that's ending, in a single log.
+    func logAggregatedRequests() {
+        guard let summaries = aggregator?.flush(), !summaries.isEmpty else {
+            return
+        }
+
+        guard let payload = try? JSONEncoder().encode(summaries),
+            let json = String(data: payload, encoding: .utf8)
+        else {
+            Embrace.logger.debug("Couldn't encode aggregated network requests!")
+            return
+        }
+
+        otel?.log(
+            "",
+            severity: .info,
+            type: .networkAggregate,
+            attributes: [
+                LogSemantics.NetworkAggregate.keyPayload: json,
+                LogSemantics.NetworkAggregate.keyRequestCount: String(summaries.reduce(0) { $0 + $1.count })
+            ],
+            stackTraceBehavior: .notIncluded
+        )
+    }
+
     func shouldInjectHeader(for request: URLRequest) -> Bool {
         let injectionEnabled = Embrace.client?.config.traceparentInjectionEnabled ?? false
 
@@ -87,15 +119,10 @@ public final class URLSessionCaptureService: CaptureService, URLSessionTaskHandl
         guard injectionEnabled else { return false }
 
         /// If the allowedDomains list is nil, all requests should be injected.
-        guard let allowedDomains = options.traceparent.onlyAllowDomains else { return true }
+        guard let allowedDomains = options.traceparent.onlyAllowDomainsMatcher else { return true }
 
         /// If the list is not-nil, apply filtering.
-        guard
-            HostAllowlistMatcher.matches(
-                host: request.url?.host,
-                allowlist: allowedDomains
-            )
-        else { return false }
+        guard allowedDomains.matches(host: request.url?.host) else { return false }
 
         return true
     }
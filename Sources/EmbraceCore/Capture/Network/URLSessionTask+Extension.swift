@@ -30,24 +30,36 @@ extension URLSessionTask {
         }
     }
 
-    /// Stores the accumulated response body data for a `URLSessionTask`.
+    /// Stores the response body received so far for a `URLSessionTask`, up to the payload capture limit.
     ///
     /// This is primarily used when network body capture is enabled.
     ///
     /// - Warning: Access to this property must be synchronized externally (e.g., using `DispatchQueue` or `UnfairLock`)
     /// to ensure thread safety, since `URLSessionTask` is shared across threads.
-    var embraceData: Data? {
+    var embraceBodyBuffer: NetworkBodyBuffer? {
         get {
             return objc_getAssociatedObject(
                 self,
-                &AssociatedKeys.embraceData) as? Data
+                &AssociatedKeys.embraceData) as? NetworkBodyBuffer
         }
         set {
             objc_setAssociatedObject(
                 self,
                 &AssociatedKeys.embraceData,
                 newValue,
-                .OBJC_ASSOCIATION_COPY)
+                .OBJC_ASSOCIATION_RETAIN)
+        }
+    }
+
+    /// The bytes kept in `embraceBodyBuffer`, copied into a single `Data`.
+    ///
+    /// - Warning: Same synchronization requirements as `embraceBodyBuffer`.
+    var embraceData: Data? {
+        get {
+            return embraceBodyBuffer?.data
+        }
+        set {
+            embraceBodyBuffer = newValue.map { NetworkBodyBuffer(data: $0) }
         }
     }
 
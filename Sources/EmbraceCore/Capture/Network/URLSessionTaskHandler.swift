@@ -27,10 +27,23 @@ protocol URLSessionTaskHandlerDataSource: AnyObject {
     var ignoredURLs: [String] { get }
 
     var ignoredTaskTypes: [AnyClass] { get }
+
+    var aggregator: NetworkRequestAggregator? { get }
 }
 
 final class DefaultURLSessionTaskHandler: NSObject, URLSessionTaskHandler {
+
+    /// Task whose request matched an aggregation template, so it has no span unless it turns out slow or failed.
+    private struct AggregatedRequest {
+        let key: NetworkRequestAggregator.Key
+        let aggregator: NetworkRequestAggregator
+        let request: URLRequest
+        let url: URL
+        let startTime: Date
+    }
+
     private var spans: [URLSessionTask: Span] = [:]
+    private var aggregatedRequests: [URLSessionTask: AggregatedRequest] = [:]
     private let queue: DispatchableQueue
     private let capturedDataQueue: DispatchableQueue
     private let payloadCaptureHandler: NetworkPayloadCaptureHandler
@@ -101,44 +114,28 @@ final class DefaultURLSessionTaskHandler: NSObject, URLSessionTaskHandler {
             // flag as captured
             task.embraceCaptured = true
 
-            // Probably this could be moved to a separate class
-            var attributes: [String: String] = [:]
-            attributes[SpanSemantics.NetworkRequest.keyUrl] = request.url?.absoluteString ?? "N/A"
-
+            // requests matching an aggregation template only get a span if they turn out slow or failed
             let httpMethod = request.httpMethod?.uppercased() ?? ""
-            if !httpMethod.isEmpty {
-                attributes[SpanSemantics.NetworkRequest.keyMethod] = httpMethod
+            if let aggregator = self.dataSource?.aggregator,
+                let key = aggregator.key(for: request.url ?? url, method: httpMethod)
+            {
+                self.aggregatedRequests[task] = AggregatedRequest(
+                    key: key,
+                    aggregator: aggregator,
+                    request: request,
+                    url: url,
+                    startTime: task.embraceStartTime ?? Date()
+                )
+                handled = true
+                return
             }
 
-            /*
-             Note: According to the OpenTelemetry specification, the attribute name should be ' {method} {http.route}.
-             The `{http.route}` corresponds to the template of the path so it's necessary to understand the templating system being employed.
-             For instance, a template for a request such as http://embrace.io/users/12345?hello=world
-             would be reported as /users/:userId (or /users/:userId? in other templating system).
-            
-             Until a decision is made regarding the method to convey this information and the heuristics to extract it,
-             the `.path` method will be utilized temporarily. This approach may introduce higher cardinality on the backend,
-             which is less than optimal.
-             It will be important to address this in the near future to enhance performance for the backend.
-            
-             Additional information can be found at:
-             - HTTP Name attribute: https://opentelemetry.io/docs/specs/semconv/http/http-spans/#name
-             - HTTP Attributes: https://opentelemetry.io/docs/specs/semconv/attributes-registry/http/
-             */
-            let name = httpMethod.isEmpty ? url.path : "\(httpMethod) \(url.path)"
-            let networkSpan = otel.buildSpan(
-                name: name,
-                type: .networkRequest,
-                attributes: attributes,
-                autoTerminationCode: nil
-            )
-
-            // This should be modified if we start doing this for streaming tasks.
-            if let bodySize = request.httpBody {
-                networkSpan.setAttribute(key: SpanSemantics.NetworkRequest.keyBodySize, value: bodySize.count)
+            // under memory pressure only a sample of the requests get a span
+            guard EmbraceMemoryBudget.shared.admitsNetworkSpan() else {
+                return
             }
 
-            let span = networkSpan.startSpan()
+            let span = self.buildSpan(otel: otel, request: request, url: url).startSpan()
             self.spans[task] = span
 
             // tracing header
@@ -154,6 +151,47 @@ final class DefaultURLSessionTaskHandler: NSObject, URLSessionTaskHandler {
         return handled
     }
 
+    private func buildSpan(otel: EmbraceOpenTelemetry, request: URLRequest, url: URL) -> SpanBuilder {
+        // Probably this could be moved to a separate class
+        var attributes: [String: String] = [:]
+        attributes[SpanSemantics.NetworkRequest.keyUrl] = request.url?.absoluteString ?? "N/A"
+
+        let httpMethod = request.httpMethod?.uppercased() ?? ""
+        if !httpMethod.isEmpty {
+            attributes[SpanSemantics.NetworkRequest.keyMethod] = httpMethod
+        }
+
+        /*
+         Note: According to the OpenTelemetry specification, the attribute name should be ' {method} {http.route}.
+         The `{http.route}` corresponds to the template of the path so it's necessary to understand the templating system being employed.
+         For instance, a template for a request such as http://embrace.io/users/12345?hello=world
+         would be reported as /users/:userId (or /users/:userId? in other templating system).
+        
+         Until a decision is made regarding the method to convey this information and the heuristics to extract it,
+         the `.path` method will be utilized temporarily. This approach may introduce higher cardinality on the backend,
+         which is less than optimal.
+         It will be important to address this in the near future to enhance performance for the backend.
+        
+         Additional information can be found at:
+         - HTTP Name attribute: https://opentelemetry.io/docs/specs/semconv/http/http-spans/#name
+         - HTTP Attributes: https://opentelemetry.io/docs/specs/semconv/attributes-registry/http/
+         */
+        let name = httpMethod.isEmpty ? url.path : "\(httpMethod) \(url.path)"
+        let networkSpan = otel.buildSpan(
+            name: name,
+            type: .networkRequest,
+            attributes: attributes,
+            autoTerminationCode: nil
+        )
+
+        // This should be modified if we start doing this for streaming tasks.
+        if let bodySize = request.httpBody {
+            networkSpan.setAttribute(key: SpanSemantics.NetworkRequest.keyBodySize, value: bodySize.count)
+        }
+
+        return networkSpan
+    }
+
     private func finish(task: URLSessionTask, data: Data?, bodySize: Int, error: (any Error)?) {
 
         // check for ignored task types
@@ -169,30 +207,39 @@ final class DefaultURLSessionTaskHandler: NSObject, URLSessionTaskHandler {
         // save end time for payload capture
         let embraceEndTime = Date()
 
+        // take the streamed body, the task won't receive more data
+        var streamedBody: NetworkBodyBuffer?
+        if data == nil {
+            capturedDataQueue.sync {
+                streamedBody = task.embraceBodyBuffer
+                task.embraceBodyBuffer = nil
+            }
+        }
+
         queue.async {
             var capturedBodySize = data?.count ?? bodySize
 
             // process payload capture
             if self.payloadCaptureHandler.isEnabled() {
-                var capturedData = data
-                if capturedData == nil {
-                    self.capturedDataQueue.sync {
-                        capturedData = taskCopy.embraceData
-                    }
+                var body = data.map { NetworkBodyBuffer(data: $0) } ?? streamedBody
+                capturedBodySize = body?.totalBytes ?? bodySize
+
+                // streamed bodies were already left out in `addData`
+                if data != nil && !self.admitsBody(for: taskCopy) {
+                    body = nil
                 }
-                capturedBodySize = capturedData?.count ?? bodySize
 
                 self.payloadCaptureHandler.process(
                     request: taskCopy.currentRequest ?? taskCopy.originalRequest,
                     response: taskCopy.response,
-                    data: data,
+                    body: body,
                     error: error,
                     startTime: taskCopy.embraceStartTime,
                     endTime: embraceEndTime
                 )
             }
 
-            self.handleTaskFinished(taskCopy, bodySize: capturedBodySize, error: error)
+            self.handleTaskFinished(taskCopy, bodySize: capturedBodySize, error: error, endTime: embraceEndTime)
         }
     }
 
@@ -204,17 +251,66 @@ final class DefaultURLSessionTaskHandler: NSObject, URLSessionTaskHandler {
         finish(task: task, data: data, bodySize: 0, error: error)
     }
 
-    private func handleTaskFinished(_ task: URLSessionTask, bodySize: Int?, error: (any Error)?) {
+    private func handleTaskFinished(_ task: URLSessionTask, bodySize: Int?, error: (any Error)?, endTime: Date) {
         // stop if the service is disabled
         guard self.dataSource?.serviceState == .active else {
             return
         }
 
+        if let aggregated = self.aggregatedRequests.removeValue(forKey: task) {
+            handleAggregatedTaskFinished(task, aggregated, bodySize: bodySize, error: error, endTime: endTime)
+            return
+        }
+
         // stop if there was no span for this task
         guard let span = self.spans.removeValue(forKey: task) else {
             return
         }
 
+        setResultAttributes(on: span, task: task, bodySize: bodySize, error: error)
+        span.end()
+
+        // internal notification with the captured request
+        Embrace.notificationCenter.post(name: .networkRequestCaptured, object: task)
+
+    }
+
+    private func handleAggregatedTaskFinished(
+        _ task: URLSessionTask,
+        _ aggregated: AggregatedRequest,
+        bodySize: Int?,
+        error: (any Error)?,
+        endTime: Date
+    ) {
+        let error = error ?? task.error
+        let statusCode = (task.response as? HTTPURLResponse)?.statusCode
+        let duration = endTime.timeIntervalSince(aggregated.startTime)
+
+        // every request counts towards the summary, even the ones that also get a span
+        aggregated.aggregator.record(
+            aggregated.key,
+            duration: duration,
+            responseBytes: bodySize ?? 0,
+            statusCode: statusCode,
+            failed: error != nil
+        )
+
+        if aggregated.aggregator.keepsIndividually(duration: duration, statusCode: statusCode, error: error),
+            let otel = self.dataSource?.otel
+        {
+            let builder = buildSpan(otel: otel, request: aggregated.request, url: aggregated.url)
+            builder.setStartTime(time: aggregated.startTime)
+
+            let span = builder.startSpan()
+            setResultAttributes(on: span, task: task, bodySize: bodySize, error: error)
+            span.end(time: endTime)
+        }
+
+        // internal notification with the captured request
+        Embrace.notificationCenter.post(name: .networkRequestCaptured, object: task)
+    }
+
+    private func setResultAttributes(on span: Span, task: URLSessionTask, bodySize: Int?, error: (any Error)?) {
         // generate attributes from response
         if let response = task.response as? HTTPURLResponse {
             span.setAttribute(
@@ -246,25 +342,46 @@ final class DefaultURLSessionTaskHandler: NSObject, URLSessionTaskHandler {
                 value: error.localizedDescription
             )
         }
+    }
 
-        span.end()
+    func addData(_ data: Data, dataTask: URLSessionDataTask) {
+        guard payloadCaptureHandler.isEnabled() else {
+            return
+        }
 
-        // internal notification with the captured request
-        Embrace.notificationCenter.post(name: .networkRequestCaptured, object: task)
+        capturedDataQueue.sync {
+            if let buffer = dataTask.embraceBodyBuffer {
+                buffer.append(data)
+                return
+            }
 
+            // first chunk: only keep as much as the rules that could still capture this task want.
+            // the buffer is created either way so the body size is still counted.
+            // under memory pressure nothing is kept.
+            var limit = payloadCaptureHandler.bodyCaptureLimit(
+                request: dataTask.currentRequest ?? dataTask.originalRequest,
+                response: dataTask.response
+            )
+            if limit > 0 && !EmbraceMemoryBudget.shared.admitsNetworkBody() {
+                limit = 0
+            }
+            let buffer = NetworkBodyBuffer(limit: limit)
+            buffer.append(data)
+            dataTask.embraceBodyBuffer = buffer
+        }
     }
 
-    func addData(_ data: Data, dataTask: URLSessionDataTask) {
-        if payloadCaptureHandler.isEnabled() {
-            capturedDataQueue.sync {
-                if var previousData = dataTask.embraceData {
-                    previousData.append(data)
-                    dataTask.embraceData = previousData
-                } else {
-                    dataTask.embraceData = data
-                }
-            }
+    /// Bodies aren't captured under memory pressure. Only bodies a rule wants are counted as dropped.
+    private func admitsBody(for task: URLSessionTask) -> Bool {
+        guard EmbraceMemoryBudget.shared.level >= .high else {
+            return true
         }
+
+        let limit = payloadCaptureHandler.bodyCaptureLimit(
+            request: task.currentRequest ?? task.originalRequest,
+            response: task.response
+        )
+        return limit == 0 || EmbraceMemoryBudget.shared.admitsNetworkBody()
     }
 
     func addTracingHeader(task: URLSessionTask, span: Span) -> String? {
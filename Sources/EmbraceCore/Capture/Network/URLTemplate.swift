@@ -0,0 +1,87 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+/// Normalizes urls into templates, so requests that only differ in ids or query values share one.
+///
+/// The template is the lowercased host (and port) followed by the path, with numeric path segments
+/// replaced by `{int}` and UUID segments by `{uuid}`, and the query reduced to its sorted, unique keys:
+/// `https://API.test.com/v1/users/12/feed?limit=10&cursor=abc` becomes
+/// `api.test.com/v1/users/{int}/feed?cursor&limit`.
+enum URLTemplate {
+
+    static let intPlaceholder = "{int}"
+    static let uuidPlaceholder = "{uuid}"
+
+    static func template(for url: URL) -> String {
+        var result = url.host?.lowercased() ?? ""
+        if let port = url.port {
+            result += ":\(port)"
+        }
+
+        result +=
+            url.path
+            .split(separator: "/", omittingEmptySubsequences: false)
+            .map(normalized)
+            .joined(separator: "/")
+
+        if let query = url.query {
+            let keys = Set(
+                query.split(separator: "&").compactMap { item -> Substring? in
+                    let key = item.prefix { $0 != "=" }
+                    return key.isEmpty ? nil : key
+                }
+            )
+
+            if !keys.isEmpty {
+                result += "?" + keys.sorted().joined(separator: "&")
+            }
+        }
+
+        return result
+    }
+
+    /// `template` without its query, if it has one.
+    static func removingQuery(_ template: String) -> Substring {
+        return template.prefix { $0 != "?" }
+    }
+
+    private static func normalized(_ segment: Substring) -> String {
+        if !segment.isEmpty && segment.utf8.allSatisfy({ $0 >= UInt8(ascii: "0") && $0 <= UInt8(ascii: "9") }) {
+            return intPlaceholder
+        }
+
+        if isUUID(segment) {
+            return uuidPlaceholder
+        }
+
+        return String(segment)
+    }
+
+    private static func isUUID(_ segment: Substring) -> Bool {
+        guard segment.utf8.count == 36 else {
+            return false
+        }
+
+        for (index, byte) in segment.utf8.enumerated() {
+            switch index {
+            case 8, 13, 18, 23:
+                guard byte == UInt8(ascii: "-") else {
+                    return false
+                }
+            default:
+                switch byte {
+                case UInt8(ascii: "0")...UInt8(ascii: "9"), UInt8(ascii: "a")...UInt8(ascii: "f"),
+                    UInt8(ascii: "A")...UInt8(ascii: "F"):
+                    continue
+                default:
+                    return false
+                }
+            }
+        }
+
+        return true
+    }
+}
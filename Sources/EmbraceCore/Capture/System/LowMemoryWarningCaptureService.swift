@@ -22,6 +22,10 @@ public class LowMemoryWarningCaptureService: CaptureService {
         NotificationCenter.default.removeObserver(self)
     }
 
+    public override var startupPhase: EmbraceStartupPhase {
+        .deferred
+    }
+
     public override func onInstall() {
         // hardcoded string so we don't have to use UIApplication
         NotificationCenter.default.addObserver(
@@ -30,6 +30,11 @@
             self.lock = lock
         }
 
+        /// There's nothing to tap before the first frame.
+        public override var startupPhase: EmbraceStartupPhase {
+            .deferred
+        }
+
         override public func onInstall() {
             lock.lock()
             defer {
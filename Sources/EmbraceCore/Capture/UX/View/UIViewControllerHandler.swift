@@ -19,6 +19,9 @@
         var instrumentVisibility: Bool { get }
         var instrumentFirstRender: Bool { get }
 
+        var consolidateLifecycleSpans: Bool { get }
+        var lifecyclePhaseSpanThreshold: TimeInterval { get }
+
         func isViewControllerBlocked(_ vc: UIViewController) -> Bool
     }
 
@@ -36,6 +39,10 @@
             var visibilitySpans: [String: Span] = [:]
             var uiReadySpans: [String: Span] = [:]
             var alreadyFinishedUiReadyIds: Set<String> = []
+
+            /// Phases of the view controllers that use a single span, in place of the per phase spans above.
+            /// Entries are removed keeping the capacity, so navigating doesn't keep reallocating it.
+            var lifecyclePhases: [String: ViewLifecyclePhases] = Dictionary(minimumCapacity: 16)
         }
         internal let data = EmbraceMutex(ViewControllerHandlerMutableData())
 
@@ -84,6 +91,7 @@
                     $0.visibilitySpans.removeAll()
                     $0.uiReadySpans.removeAll()
                     $0.alreadyFinishedUiReadyIds.removeAll()
+                    $0.lifecyclePhases.removeAll(keepingCapacity: true)
                 }
 
             }
@@ -111,6 +119,8 @@
 
             let className = vc.className
             let viewName = vc.emb_viewName
+            let consolidate = dataSource?.consolidateLifecycleSpans == true
+            let phaseSpanThreshold = dataSource?.lifecyclePhaseSpanThreshold ?? 0
 
             // check if with need to measure time-to-render or time-to-interactive
             let nameFormat =
@@ -130,6 +140,18 @@
                     startTime: now
                 )
 
+                // record the phases instead of creating a span for each one
+                if consolidate {
+                    var phases = ViewLifecyclePhases(viewName: viewName, className: className, spanThreshold: phaseSpanThreshold)
+                    phases[.viewDidLoad].start = now
+
+                    self.data.withLock {
+                        $0.parentSpans[id] = parentSpan
+                        $0.lifecyclePhases[id] = phases
+                    }
+                    return
+                }
+
                 // generate view did load span
                 let viewDidLoadSpan = self.createSpan(
                     with: otel,
@@ -152,6 +174,10 @@
                 return
             }
             queue.async {
+                if self.endPhase(.viewDidLoad, id: id, time: now) {
+                    return
+                }
+
                 guard let span = self.data.withLock({ $0.viewDidLoadSpans.removeValue(forKey: id) }) else {
                     return
                 }
@@ -177,6 +203,10 @@
                     return
                 }
 
+                if self.startPhase(.viewWillAppear, id: id, time: now) {
+                    return
+                }
+
                 // generate view will appear span
                 let span = self.createSpan(
                     with: otel,
@@ -198,6 +228,10 @@
                 return
             }
             queue.async {
+                if self.endPhase(.viewWillAppear, id: id, time: now) {
+                    return
+                }
+
                 guard let span = self.data.withLock({ $0.viewWillAppearSpans.removeValue(forKey: id) }) else {
                     return
                 }
@@ -223,6 +257,10 @@
                     return
                 }
 
+                if self.startPhase(.viewIsAppearing, id: id, time: now) {
+                    return
+                }
+
                 // generate view is appearing span
                 let span = self.createSpan(
                     with: otel,
@@ -241,9 +279,15 @@
 
         func onViewIsAppearingEnd(_ vc: UIViewController, now: Date = Date()) {
             queue.async {
-                guard let id = vc.emb_instrumentation_state?.identifier,
-                    let span = self.data.withLock({ $0.viewIsAppearingSpans.removeValue(forKey: id) })
-                else {
+                guard let id = vc.emb_instrumentation_state?.identifier else {
+                    return
+                }
+
+                if self.endPhase(.viewIsAppearing, id: id, time: now) {
+                    return
+                }
+
+                guard let span = self.data.withLock({ $0.viewIsAppearingSpans.removeValue(forKey: id) }) else {
                     return
                 }
 
@@ -268,6 +312,10 @@
                     return
                 }
 
+                if self.startPhase(.viewDidAppear, id: id, time: now) {
+                    return
+                }
+
                 // generate view did appear span
                 let span = self.createSpan(
                     with: otel,
@@ -329,6 +377,22 @@
                     return
                 }
 
+                if self.endPhase(.viewDidAppear, id: id, time: now) {
+                    if parentSpan.isTimeToFirstRender {
+                        self.endConsolidatedSpan(id: id, time: now)
+                    } else {
+                        self.startPhase(.uiReady, id: id, time: now)
+
+                        // if the view controller was already flagged as ready to interact
+                        // we end the span right away
+                        if self.data.withLock({ $0.alreadyFinishedUiReadyIds.contains(id) }) {
+                            self.endPhase(.uiReady, id: id, time: now)
+                            self.endConsolidatedSpan(id: id, time: now)
+                        }
+                    }
+                    return
+                }
+
                 // end time to first render span
                 if parentSpan.isTimeToFirstRender {
                     parentSpan.end(time: now)
@@ -392,6 +456,19 @@
                     return
                 }
 
+                // same as below, for view controllers using a single span
+                let uiReadyStarted = self.data.withLock { $0.lifecyclePhases[id].map { $0[.uiReady].start != nil } }
+                if let uiReadyStarted {
+                    if uiReadyStarted {
+                        let now = Date()
+                        self.endPhase(.uiReady, id: id, time: now)
+                        self.endConsolidatedSpan(id: id, time: now)
+                    } else {
+                        self.data.withLock { $0.alreadyFinishedUiReadyIds.insert(id) }
+                    }
+                    return
+                }
+
                 // if we have a ui ready span it means that viewDidAppear already happened
                 // in this case we close the spans
                 if let span = self.data.withLock({ $0.uiReadySpans[id] }) {
@@ -411,6 +488,10 @@
 
         private func forcefullyEndSpans(id: String, time: Date) {
 
+            if endConsolidatedSpan(id: id, time: time, errorCode: .userAbandon) {
+                return
+            }
+
             data.withLock {
 
                 if let viewDidLoadSpan = $0.viewDidLoadSpans[id] {
@@ -449,6 +530,89 @@
             }
         }
 
+        /// Records the start of a phase for a view controller that uses a single span.
+        /// Returns `false` if the view controller uses a span per phase.
+        @discardableResult
+        private func startPhase(_ phase: ViewLifecyclePhases.Phase, id: String, time: Date) -> Bool {
+            return data.withLock {
+                guard $0.lifecyclePhases[id] != nil else {
+                    return false
+                }
+                $0.lifecyclePhases[id]?[phase].start = time
+                return true
+            }
+        }
+
+        /// Records the end of a phase for a view controller that uses a single span,
+        /// and creates a span for it if it was too slow.
+        /// Returns `false` if the view controller uses a span per phase.
+        @discardableResult
+        private func endPhase(_ phase: ViewLifecyclePhases.Phase, id: String, time: Date) -> Bool {
+            let phases = data.withLock { state -> ViewLifecyclePhases? in
+                state.lifecyclePhases[id]?[phase].end = time
+                return state.lifecyclePhases[id]
+            }
+
+            guard let phases else {
+                return false
+            }
+
+            createSlowPhaseSpan(phase, of: phases, id: id, endTime: time)
+            return true
+        }
+
+        /// Adds the phase durations to the parent span of a view controller that uses a single span and ends it.
+        /// Phases that didn't end get a span if they were already too slow.
+        /// Returns `false` if the view controller uses a span per phase.
+        @discardableResult
+        private func endConsolidatedSpan(id: String, time: Date, errorCode: SpanErrorCode? = nil) -> Bool {
+            let (phases, parentSpan) = data.withLock {
+                ($0.lifecyclePhases[id], $0.parentSpans[id])
+            }
+
+            guard let phases else {
+                return false
+            }
+
+            for phase in ViewLifecyclePhases.Phase.allCases {
+                if let duration = phases[phase].duration {
+                    parentSpan?.setAttribute(key: phase.durationKey, value: .int(Int((duration * 1000).rounded())))
+                } else if phases[phase].start != nil {
+                    createSlowPhaseSpan(phase, of: phases, id: id, endTime: time, errorCode: errorCode)
+                }
+            }
+
+            parentSpan?.end(errorCode: errorCode, time: time)
+            clear(id: id)
+            return true
+        }
+
+        private func createSlowPhaseSpan(
+            _ phase: ViewLifecyclePhases.Phase,
+            of phases: ViewLifecyclePhases,
+            id: String,
+            endTime: Date,
+            errorCode: SpanErrorCode? = nil
+        ) {
+            guard let start = phases[phase].start,
+                endTime.timeIntervalSince(start) >= phases.spanThreshold,
+                let otel = dataSource?.otel,
+                let parentSpan = data.withLock({ $0.parentSpans[id] })
+            else {
+                return
+            }
+
+            let span = createSpan(
+                with: otel,
+                viewName: phases.viewName,
+                className: phases.className,
+                name: phase.spanName,
+                startTime: start,
+                parent: parentSpan
+            )
+            span.end(errorCode: errorCode, time: endTime)
+        }
+
         private func createSpan(
             with otel: EmbraceOpenTelemetry,
             viewName: String,
@@ -486,6 +650,7 @@
                 $0.viewDidAppearSpans[id] = nil
                 $0.uiReadySpans[id] = nil
                 $0.alreadyFinishedUiReadyIds.remove(id)
+                $0.lifecyclePhases[id] = nil
             }
         }
     }
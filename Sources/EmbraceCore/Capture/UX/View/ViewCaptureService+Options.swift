@@ -31,14 +31,26 @@
             /// Use the `blockHostingControllers` paramenter to determine if `UIHostingControllers` and their child controllers should be captured.
             @objc public var viewControllerBlockList: ViewControllerBlockList
 
+            /// When enabled, the steps measured by `instrumentFirstRender` are recorded as attributes of the parent span
+            /// (`view.did_load_ms`, `view.will_appear_ms`, ...) instead of each getting its own child span.
+            /// Only steps that take `lifecyclePhaseSpanThreshold` or longer get a child span.
+            @objc public var consolidateLifecycleSpans: Bool
+
+            /// Minimum duration of a step for it to get a child span when `consolidateLifecycleSpans` is enabled.
+            @objc public var lifecyclePhaseSpanThreshold: TimeInterval
+
             @objc public init(
                 instrumentVisibility: Bool,
                 instrumentFirstRender: Bool,
-                viewControllerBlockList: ViewControllerBlockList = ViewControllerBlockList()
+                viewControllerBlockList: ViewControllerBlockList = ViewControllerBlockList(),
+                consolidateLifecycleSpans: Bool = false,
+                lifecyclePhaseSpanThreshold: TimeInterval = 0.1
             ) {
                 self.instrumentVisibility = instrumentVisibility
                 self.instrumentFirstRender = instrumentFirstRender
                 self.viewControllerBlockList = viewControllerBlockList
+                self.consolidateLifecycleSpans = consolidateLifecycleSpans
+                self.lifecyclePhaseSpanThreshold = lifecyclePhaseSpanThreshold
             }
 
             @objc public convenience override init() {
@@ -35,6 +35,14 @@
             return options.instrumentFirstRender && Embrace.client?.config.isUiLoadInstrumentationEnabled == true
         }
 
+        var consolidateLifecycleSpans: Bool {
+            return options.consolidateLifecycleSpans
+        }
+
+        var lifecyclePhaseSpanThreshold: TimeInterval {
+            return options.lifecyclePhaseSpanThreshold
+        }
+
         var blockList = EmbraceMutex(ViewControllerBlockList())
 
         @objc public convenience init(options: ViewCaptureService.Options) {
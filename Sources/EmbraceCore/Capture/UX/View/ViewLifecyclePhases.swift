@@ -0,0 +1,93 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceSemantics
+#endif
+
+/// Start and end times of the steps a view controller goes through until it renders or becomes interactive.
+///
+/// Used instead of a child span per step when `consolidateLifecycleSpans` is enabled. The durations are added
+/// to the parent span as attributes when it ends, and only steps that take `spanThreshold` or longer get a span.
+struct ViewLifecyclePhases {
+
+    enum Phase: CaseIterable {
+        case viewDidLoad
+        case viewWillAppear
+        case viewIsAppearing
+        case viewDidAppear
+        case uiReady
+
+        var spanName: String {
+            switch self {
+            case .viewDidLoad: return SpanSemantics.View.viewDidLoadName
+            case .viewWillAppear: return SpanSemantics.View.viewWillAppearName
+            case .viewIsAppearing: return SpanSemantics.View.viewIsAppearingName
+            case .viewDidAppear: return SpanSemantics.View.viewDidAppearName
+            case .uiReady: return SpanSemantics.View.uiReadyName
+            }
+        }
+
+        var durationKey: String {
+            switch self {
+            case .viewDidLoad: return SpanSemantics.View.keyViewDidLoadDuration
+            case .viewWillAppear: return SpanSemantics.View.keyViewWillAppearDuration
+            case .viewIsAppearing: return SpanSemantics.View.keyViewIsAppearingDuration
+            case .viewDidAppear: return SpanSemantics.View.keyViewDidAppearDuration
+            case .uiReady: return SpanSemantics.View.keyUiReadyDuration
+            }
+        }
+    }
+
+    struct Interval {
+        var start: Date?
+        var end: Date?
+
+        var duration: TimeInterval? {
+            guard let start, let end else {
+                return nil
+            }
+            return end.timeIntervalSince(start)
+        }
+    }
+
+    let viewName: String
+    let className: String
+    let spanThreshold: TimeInterval
+
+    private var viewDidLoad = Interval()
+    private var viewWillAppear = Interval()
+    private var viewIsAppearing = Interval()
+    private var viewDidAppear = Interval()
+    private var uiReady = Interval()
+
+    init(viewName: String, className: String, spanThreshold: TimeInterval) {
+        self.viewName = viewName
+        self.className = className
+        self.spanThreshold = spanThreshold
+    }
+
+    subscript(phase: Phase) -> Interval {
+        get {
+            switch phase {
+            case .viewDidLoad: return viewDidLoad
+            case .viewWillAppear: return viewWillAppear
+            case .viewIsAppearing: return viewIsAppearing
+            case .viewDidAppear: return viewDidAppear
+            case .uiReady: return uiReady
+            }
+        }
+        set {
+            switch phase {
+            case .viewDidLoad: viewDidLoad = newValue
+            case .viewWillAppear: viewWillAppear = newValue
+            case .viewIsAppearing: viewIsAppearing = newValue
+            case .viewDidAppear: viewDidAppear = newValue
+            case .uiReady: uiReady = newValue
+            }
+        }
+    }
+}
@@ -85,6 +85,9 @@ import OpenTelemetrySdk
     let captureServices: CaptureServices
     let captureServicesGroup: DispatchGroup
 
+    /// Runs the SDK setup that can wait until after the first frame.
+    lazy var startupScheduler = StartupScheduler(backgroundQueue: processingQueue)
+
     let logController: LogControllable
 
     let sessionController: SessionController
@@ -212,7 +215,12 @@ import OpenTelemetrySdk
         )
 
         // initialize session controller
-        self.sessionController = SessionController(storage: storage, upload: upload, config: config)
+        self.sessionController = SessionController(
+            storage: storage,
+            upload: upload,
+            config: config,
+            heartbeatSlot: EmbraceFileSystem.sessionHeartbeatURL.flatMap { SessionHeartbeatSlot(url: $0) }
+        )
         self.sessionLifecycle = Embrace.createSessionLifecycle(controller: sessionController)
 
         // initialize span events limiter
@@ -292,6 +300,15 @@ import OpenTelemetrySdk
         // startup tracking
         startupInstrumentation.otel = self
 
+        // sdk hot path latencies
+        EmbraceSelfMetrics.shared.bootstrap(enabled: config.isMetricKitInternalMetricsCaptureEnabled)
+
+        // only send span snapshots that changed
+        SpanSnapshotTracker.shared.bootstrap(enabled: config.isSpanSnapshotDiffingEnabled)
+
+        // shared memory budget for every telemetry producer
+        EmbraceMemoryBudget.shared.bootstrap(enabled: config.isMemoryBudgetEnabled)
+
         // config update event
         Embrace.notificationCenter.addObserver(
             self,
@@ -352,43 +369,85 @@ import OpenTelemetrySdk
 
                 startupInstrumentation.buildMainSpans()
                 sessionLifecycle.startSession()
-                captureServices.install()
 
-                // save latest session in memory before its sent and deleted
-                // this will be used to link metric kit payloads to the session
-                storage.fetchLatestSession { [self] session in
-                    metricKit.lastSession = session
-                    metricKit.install()
+                startupScheduler.onPhaseFinished = { [weak self] report in
+                    self?.startupInstrumentation.recordOverruns(report)
                 }
 
                 // WARNING: This is dangerous as it calls out to external code.
-                self.captureServices.start()
+                startupScheduler.add("capture-services.critical", phase: .critical) { [self] in
+                    captureServices.installAndStart(phase: .critical)
+                }
+
+                // save latest session in memory before its sent and deleted
+                // this will be used to link metric kit payloads to the session
+                startupScheduler.add("metrickit", phase: .critical, dependencies: ["capture-services.critical"]) { [self] in
+                    storage.fetchLatestSession { [self] session in
+                        metricKit.lastSession = session
+                        metricKit.install()
+                    }
+                }
 
-                // now that services are started, and critical pieces are in place,
+                // now that the critical services are started, and critical pieces are in place,
                 // notify anyone who cares.
-                self.captureServicesGroup.leave()
+                startupScheduler.add("capture-services.ready", phase: .critical, dependencies: ["capture-services.critical"]) { [self] in
+                    captureServicesGroup.leave()
+                }
+
+                startupScheduler.add("capture-services.deferred", phase: .deferred) { [weak self] in
+                    self?.captureServices.installAndStart(phase: .deferred)
+                }
 
-                self.processingQueue.async { [weak self] in
-                    // fetch crash reports and link them to sessions
-                    // then upload them
+                // retry any remaining cached upload data
+                startupScheduler.add("upload.retry", phase: .deferred) { [weak self] in
+                    self?.upload?.retryCachedData()
+                }
+
+                startupScheduler.add("capture-services.background", phase: .background) { [weak self] in
+                    self?.captureServices.installAndStart(phase: .background)
+                }
+
+                // import what app extensions recorded since the last launch
+                // before sending unsent data, so their logs go out with it
+                var unsentDataDependencies: [String] = []
+                if let appGroupId = options.appGroupId {
+                    let partitionId = options.appId ?? EmbraceFileSystem.defaultPartitionId
+                    startupScheduler.add("extension-events", phase: .background) { [weak self] in
+                        ExtensionRecordImporter.importRecords(
+                            appGroupId: appGroupId,
+                            partitionId: partitionId,
+                            storage: self?.storage,
+                            otel: self
+                        )
+                    }
+                    unsentDataDependencies.append("extension-events")
+                }
+
+                // fetch crash reports and link them to sessions
+                // then upload them
+                startupScheduler.add("unsent-data", phase: .background, dependencies: unsentDataDependencies) { [weak self] in
                     UnsentDataHandler.sendUnsentData(
                         storage: self?.storage,
                         upload: self?.upload,
                         otel: self,
                         logController: self?.logController,
                         currentSessionId: self?.sessionController.currentSession?.id,
-                        crashReporter: self?.captureServices.crashReporter
+                        crashReporter: self?.captureServices.crashReporter,
+                        recoveredHeartbeat: self?.sessionController.heartbeatSlot?.recovered
                     )
+                }
 
-                    // remove old versions data
+                // remove old versions data
+                startupScheduler.add("cleanup", phase: .background) { [weak self] in
                     self?.cleanUpOldVersionsData()
+                }
 
-                    // add otel resources as metadata
+                // add otel resources as metadata
+                startupScheduler.add("otel-resources", phase: .background) { [weak self] in
                     self?.addOtelResources()
                 }
 
-                // retry any remaining cached upload data
-                self.upload?.retryCachedData()
+                startupScheduler.runCriticalPhase()
 
                 if let appId = options.appId {
                     Embrace.logger.startup("Embrace SDK started successfully with key: \(appId)")
@@ -427,6 +486,7 @@ import OpenTelemetrySdk
 
             state = .stopped
 
+            startupScheduler.cancel()
             sessionLifecycle.stop()
             sessionController.clear()
             captureServices.stop()
@@ -486,6 +546,9 @@ import OpenTelemetrySdk
     @objc private func onConfigUpdated() {
         Embrace.logger.limits = config.internalLogLimits
         Embrace.client?.logController.limits = config.logsLimits
+        EmbraceSelfMetrics.shared.bootstrap(enabled: config.isMetricKitInternalMetricsCaptureEnabled)
+        SpanSnapshotTracker.shared.bootstrap(enabled: config.isSpanSnapshotDiffingEnabled)
+        EmbraceMemoryBudget.shared.bootstrap(enabled: config.isMemoryBudgetEnabled)
 
         if !config.isSDKEnabled {
             Embrace.logger.debug("SDK was disabled")
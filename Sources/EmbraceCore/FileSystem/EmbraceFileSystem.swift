@@ -16,6 +16,8 @@ public struct EmbraceFileSystem {
     static let deviceIdName = "device-identifier"
     static let criticalLogsName = "critical-logs"
     static let pendingLogsName = "pending-logs"
+    static let sessionHeartbeatName = "session-heartbeat"
+    static let extensionEventsName = "extension-events"
 
     static let defaultPartitionId = "default"
 
@@ -131,6 +133,18 @@ public struct EmbraceFileSystem {
         rootURL()?.appendingPathComponent(deviceIdName)
     }
 
+    /// Returns the fileURL for the ring app extensions write their logs and spans to, in the app group container
+    /// ```
+    /// io.embrace.data/<version>/<partition-id>/extension-events
+    /// ```
+    static func extensionEventsURL(partitionIdentifier: String, appGroupId: String) -> URL? {
+        return directoryURL(
+            name: extensionEventsName,
+            partitionId: partitionIdentifier,
+            appGroupId: appGroupId
+        )
+    }
+
     /// Returns the fileURL for the critical logs file
     /// ```
     /// io.embrace.data/critical-logs
@@ -149,6 +163,14 @@ public struct EmbraceFileSystem {
         rootURL()?.appendingPathComponent(pendingLogsName)
     }
 
+    /// Returns the fileURL for the memory-mapped session heartbeat slot
+    /// ```
+    /// io.embrace.data/session-heartbeat
+    /// ```
+    static var sessionHeartbeatURL: URL? {
+        rootURL()?.appendingPathComponent(sessionHeartbeatName)
+    }
+
     /// Returns the possible subdirectories for data from old version that can be safely removed
     /// ```
     /// [
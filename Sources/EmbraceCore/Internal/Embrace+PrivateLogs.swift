@@ -51,7 +51,7 @@ extension Embrace: EmbracePrivateLogger {
                 storage: storage,
                 sessionId: session?.id
             )
-            let payloadData = try JSONEncoder().encode(payload).gzipped()
+            let payloadData = try payload.gzippedJSON()
 
             upload.uploadLog(id: id, data: payloadData, payloadTypes: LogType.internal.rawValue) { result in
                 if case .failure(let error) = result {
@@ -0,0 +1,99 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCommonInternal
+#endif
+
+/// A log or span recorded by an app extension, as written to the shared ring.
+/// Keys are kept short since every record has to fit in a ring slot.
+struct ExtensionRecord: Codable, Equatable {
+
+    enum Kind: String, Codable {
+        case log
+        case span
+    }
+
+    let kind: Kind
+    let processId: String
+    let bundleId: String?
+
+    /// Log message or span name.
+    var name: String
+    let severity: Int?
+    let startTime: Int64
+    let endTime: Int64?
+    var attributes: [String: String]
+
+    enum CodingKeys: String, CodingKey {
+        case kind = "k"
+        case processId = "p"
+        case bundleId = "b"
+        case name = "n"
+        case severity = "s"
+        case startTime = "t"
+        case endTime = "e"
+        case attributes = "a"
+    }
+
+    static func log(_ message: String, severity: LogSeverity, timestamp: Date, attributes: [String: String]) -> ExtensionRecord {
+        ExtensionRecord(
+            kind: .log,
+            processId: ProcessIdentifier.current.stringValue,
+            bundleId: Bundle.main.bundleIdentifier,
+            name: message,
+            severity: severity.rawValue,
+            startTime: Int64(timestamp.nanosecondsSince1970Truncated),
+            endTime: nil,
+            attributes: attributes
+        )
+    }
+
+    static func span(_ name: String, startTime: Date, endTime: Date, attributes: [String: String]) -> ExtensionRecord {
+        ExtensionRecord(
+            kind: .span,
+            processId: ProcessIdentifier.current.stringValue,
+            bundleId: Bundle.main.bundleIdentifier,
+            name: name,
+            severity: nil,
+            startTime: Int64(startTime.nanosecondsSince1970Truncated),
+            endTime: Int64(endTime.nanosecondsSince1970Truncated),
+            attributes: attributes
+        )
+    }
+
+    var startDate: Date {
+        Date(timeIntervalSince1970: TimeInterval(startTime) / 1_000_000_000)
+    }
+
+    var endDate: Date? {
+        endTime.map { Date(timeIntervalSince1970: TimeInterval($0) / 1_000_000_000) }
+    }
+
+    /// Encodes the record so it fits in `maxSize` bytes, cutting the message or name short if needed.
+    func encoded(maxSize: Int) -> Data? {
+        let encoder = JSONEncoder()
+        guard var data = try? encoder.encode(self) else {
+            return nil
+        }
+
+        if data.count > maxSize {
+            var truncated = self
+            let excess = data.count - maxSize
+            guard excess < name.utf8.count else {
+                return nil
+            }
+            // escaped characters take more than one byte, so cut a bit more than needed
+            truncated.name = String(name.prefix(max(name.count - excess * 2, 0)))
+            guard let shorter = try? encoder.encode(truncated), shorter.count <= maxSize else {
+                return nil
+            }
+            data = shorter
+        }
+
+        return data
+    }
+}
@@ -0,0 +1,144 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+import OpenTelemetryApi
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCommonInternal
+    import EmbraceOTelInternal
+    import EmbraceSemantics
+    import EmbraceStorageInternal
+#endif
+
+/// Moves the logs and spans written by app extensions through `EmbraceExtension` into the host app.
+///
+/// Logs are stored with the process identifier of the extension, so they're uploaded along with the logs
+/// of previous processes. Spans are recreated through `otel`, so they end up in the current session.
+enum ExtensionRecordImporter {
+
+    /// Upper bound per import, so a ring filled by a chatty extension doesn't delay startup work.
+    static let maxRecordsPerImport = 1024
+
+    /// How long a slot reserved by an extension that died before filling it holds back the records after it.
+    static let abandonAfter: TimeInterval = 30
+
+    /// Imports after the one at startup, for records that were held back or over `maxRecordsPerImport`.
+    static let maxRetries = 3
+
+    static let queue = DispatchQueue(label: "com.embrace.extension_records", qos: .utility)
+
+    /// Records are removed from the ring as they're read, so nothing is imported unless both logs and spans
+    /// can be handled. They stay in the ring for a later import instead.
+    @discardableResult
+    static func importRecords(
+        from ring: EmbraceSharedRing,
+        storage: LogRepository?,
+        otel: EmbraceOpenTelemetry?,
+        maxCount: Int = maxRecordsPerImport
+    ) -> Int {
+        guard let storage, let otel else {
+            return 0
+        }
+
+        let decoder = JSONDecoder()
+
+        return ring.drain(maxCount: maxCount, abandonAfter: abandonAfter) { data in
+            guard let record = try? decoder.decode(ExtensionRecord.self, from: data) else {
+                Embrace.logger.debug("Dropping an app extension record that couldn't be decoded")
+                return
+            }
+
+            switch record.kind {
+            case .log:
+                importLog(record, storage: storage)
+            case .span:
+                importSpan(record, otel: otel)
+            }
+        }
+    }
+
+    /// Opens the ring in the app group container and imports what's in it.
+    static func importRecords(
+        appGroupId: String,
+        partitionId: String,
+        storage: LogRepository?,
+        otel: EmbraceOpenTelemetry?
+    ) {
+        guard
+            let url = EmbraceFileSystem.extensionEventsURL(partitionIdentifier: partitionId, appGroupId: appGroupId),
+            FileManager.default.fileExists(atPath: url.path)
+        else {
+            return
+        }
+
+        guard let ring = EmbraceSharedRing(url: url, resetIfIncompatible: true) else {
+            Embrace.logger.warning("Couldn't open the app extension events at \(url.path)")
+            return
+        }
+
+        importRecords(from: ring, storage: storage, otel: otel, retries: maxRetries)
+    }
+
+    /// Imports what's in `ring`, then polls it again later in the session while records are left.
+    ///
+    /// A slot reserved by an extension that died is only skipped once it's been waited on for `abandonAfter`,
+    /// and the clock starts at the first import that finds it. Without polling again, the records behind it
+    /// would wait for a launch at least that much later.
+    static func importRecords(
+        from ring: EmbraceSharedRing,
+        storage: LogRepository?,
+        otel: EmbraceOpenTelemetry?,
+        retries: Int
+    ) {
+        let count = importRecords(from: ring, storage: storage, otel: otel)
+        if count > 0 {
+            Embrace.logger.debug("Imported \(count) app extension records")
+        }
+
+        guard retries > 0, ring.count > 0, storage != nil, otel != nil else {
+            return
+        }
+
+        queue.asyncAfter(deadline: .now() + abandonAfter + 1) {
+            importRecords(from: ring, storage: storage, otel: otel, retries: retries - 1)
+        }
+    }
+
+    static func importLog(_ record: ExtensionRecord, storage: LogRepository) {
+        var attributes: [String: AttributeValue] = record.attributes.mapValues { .string($0) }
+        attributes[LogSemantics.keyEmbraceType] = .string(LogType.message.rawValue)
+        attributes[LogSemantics.keyState] = .string(SessionState.unknown.rawValue)
+        if let bundleId = record.bundleId {
+            attributes[LogSemantics.keyExtensionBundleId] = .string(bundleId)
+        }
+
+        _ = storage.createLog(
+            id: .random,
+            processId: EmbraceIdentifier(stringValue: record.processId),
+            severity: record.severity.flatMap(LogSeverity.init(rawValue:)) ?? .info,
+            body: record.name,
+            timestamp: record.startDate,
+            attributes: attributes
+        )
+    }
+
+    static func importSpan(_ record: ExtensionRecord, otel: EmbraceOpenTelemetry) {
+        var attributes = record.attributes
+        if let bundleId = record.bundleId {
+            attributes[SpanSemantics.keyExtensionBundleId] = bundleId
+        }
+
+        otel.recordCompletedSpan(
+            name: record.name,
+            type: .performance,
+            parent: nil,
+            startTime: record.startDate,
+            endTime: record.endDate ?? record.startDate,
+            attributes: attributes,
+            events: [],
+            errorCode: nil
+        )
+    }
+}
@@ -44,8 +44,9 @@ class EmbraceLogAttributesBuilder {
 
     private func serializeProcessedStackTrace(_ processedStackTrace: [[String: Any]]) {
         do {
-            let jsonData = try JSONSerialization.data(withJSONObject: processedStackTrace, options: [])
-            let stackTraceInBase64 = jsonData.base64EncodedString()
+            var writer = EmbraceJSONWriter()
+            try writer.value(jsonObject: processedStackTrace)
+            let stackTraceInBase64 = writer.data.base64EncodedString()
             attributes[LogSemantics.keyStackTrace] = stackTraceInBase64
         } catch let exception {
             Embrace.logger.error("Couldn't convert stack trace to json string: \(exception.localizedDescription)")
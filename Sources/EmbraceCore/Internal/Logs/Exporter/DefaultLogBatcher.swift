@@ -50,7 +50,14 @@ class DefaultLogBatcher: LogBatcher {
     }
 
     func addLogRecord(logRecord: ReadableLogRecord) {
+        let mkSpan = EmbraceMetricKitSpan.begin(name: "log-add")
+        let size = Self.estimatedSize(of: logRecord)
+        EmbraceMemoryBudget.shared.track(size, for: .logBatcher)
         processorQueue.async {
+            defer {
+                EmbraceMemoryBudget.shared.release(size, for: .logBatcher)
+                mkSpan.end()
+            }
             if let record = self.repository.createLog(
                 id: EmbraceIdentifier.random,
                 processId: ProcessIdentifier.current,
@@ -63,6 +70,12 @@ class DefaultLogBatcher: LogBatcher {
             }
         }
     }
+
+    /// Rough size of a log waiting to be stored, for the memory budget.
+    static func estimatedSize(of logRecord: ReadableLogRecord) -> Int {
+        let body = logRecord.body?.description.utf8.count ?? 0
+        return 256 + body + logRecord.attributes.count * 64
+    }
 }
 
 extension DefaultLogBatcher {
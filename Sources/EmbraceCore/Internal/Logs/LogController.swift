@@ -51,14 +51,12 @@ class LogController: LogControllable {
     /// Can be overridden in tests to use a fixed value.
     var maxLogsPerBatchProvider: () -> Int = { LogController.adaptiveMaxLogsPerBatch() }
 
-    struct MutableState {
-        var limits: LogsLimits = LogsLimits()
-    }
-    private let state = EmbraceMutex(MutableState())
+    /// Read by the exporter for every log, replaced only on config updates.
+    private let limitsSnapshot = EmbraceSnapshot(LogsLimits())
 
     var limits: LogsLimits {
-        get { state.withLock { $0.limits } }
-        set { state.withLock { $0.limits = newValue } }
+        get { limitsSnapshot.load() }
+        set { limitsSnapshot.publish(newValue) }
     }
 
     static let attachmentLimit: Int = 5
@@ -109,6 +107,11 @@ class LogController: LogControllable {
             return
         }
 
+        // low severity logs are dropped first when the SDK or the app are short on memory
+        guard EmbraceMemoryBudget.shared.admitsLog(severity: severity) else {
+            return
+        }
+
         guard let sessionController = sessionController else {
             return
         }
@@ -329,7 +332,7 @@ extension LogController {
         )
 
         do {
-            let envelopeData = try JSONEncoder().encode(envelope).gzipped()
+            let envelopeData = try envelope.gzippedJSON()
             let payloadTypes = logsPayloadTypes(logs)
 
             upload.uploadLog(id: UUID().uuidString, data: envelopeData, payloadTypes: payloadTypes) { [weak self] result in
@@ -6,6 +6,7 @@ import Foundation
 import OpenTelemetryApi
 
 #if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCaptureService
     import EmbraceCommonInternal
     import EmbraceOTelInternal
     import EmbraceSemantics
@@ -164,4 +165,55 @@ public class StartupInstrumentation: NSObject {
             }
         }
     }
+
+    /// Records the SDK startup phases that went over budget, with a child span for each task that finished late.
+    func recordOverruns(_ report: StartupScheduler.PhaseReport) {
+        let overruns = report.overruns
+        guard let otel = otel, !overruns.isEmpty else {
+            return
+        }
+
+        let rootSpan = state.withLock { $0.rootSpan }
+        let attributes = [
+            SpanSemantics.Startup.keyStartupPhase: report.phase.name,
+            SpanSemantics.Startup.keyStartupBudget: String(Int(report.budget * 1000))
+        ]
+
+        let builder = otel.buildSpan(
+            name: SpanSemantics.Startup.sdkStartupPhaseName,
+            type: .startup,
+            attributes: attributes,
+            autoTerminationCode: nil
+        )
+        builder.setStartTime(time: report.startTime)
+        if let rootSpan {
+            builder.setParent(rootSpan)
+        }
+        let phaseSpan = builder.startSpan()
+
+        for task in overruns {
+            otel.recordCompletedSpan(
+                name: SpanSemantics.Startup.sdkStartupTaskName,
+                type: .startup,
+                parent: phaseSpan,
+                startTime: task.startTime,
+                endTime: task.endTime,
+                attributes: attributes.merging([SpanSemantics.Startup.keyStartupTask: task.name]) { $1 },
+                events: [],
+                errorCode: nil
+            )
+        }
+
+        phaseSpan.end(time: report.endTime)
+    }
+}
+
+extension EmbraceStartupPhase {
+    var name: String {
+        switch self {
+        case .critical: return "critical"
+        case .deferred: return "deferred"
+        case .background: return "background"
+        }
+    }
 }
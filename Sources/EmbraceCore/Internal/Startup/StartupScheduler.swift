@@ -0,0 +1,317 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCaptureService
+    import EmbraceCommonInternal
+#endif
+
+/// Runs the SDK's startup work in phases, so only what has to be in place before the first frame
+/// runs while the app is launching.
+///
+/// - `critical` tasks run synchronously in `runCriticalPhase()`.
+/// - `deferred` tasks run on the main thread the first time the main run loop goes idle afterwards,
+///   which is after the first frame is committed.
+/// - `background` tasks run on `backgroundQueue` once the deferred ones are done. If the main thread
+///   is still too busy to get to the deferred tasks after `backgroundDelayLimit`, both phases run
+///   on `backgroundQueue` instead, deferred first.
+///
+/// Within a phase, tasks run in the order they were added, after the tasks they depend on.
+/// A task that depends on a task from a later phase runs in that later phase.
+///
+/// Each phase has a time budget. When a phase is done, `onPhaseFinished` gets its timings,
+/// including the tasks that finished past the budget.
+final class StartupScheduler {
+
+    struct Budgets {
+        var critical: TimeInterval = 0.1
+        var deferred: TimeInterval = 0.05
+        var background: TimeInterval = 5
+
+        func budget(for phase: EmbraceStartupPhase) -> TimeInterval {
+            switch phase {
+            case .critical: return critical
+            case .deferred: return deferred
+            case .background: return background
+            }
+        }
+    }
+
+    struct TaskTiming: Equatable {
+        let name: String
+        let startTime: Date
+        let endTime: Date
+    }
+
+    struct PhaseReport {
+        let phase: EmbraceStartupPhase
+        let budget: TimeInterval
+        let startTime: Date
+        let endTime: Date
+        let tasks: [TaskTiming]
+
+        /// Tasks that finished after the phase ran out of budget.
+        var overruns: [TaskTiming] {
+            let deadline = startTime.addingTimeInterval(budget)
+            return tasks.filter { $0.endTime > deadline }
+        }
+    }
+
+    private struct Task {
+        let name: String
+        let phase: EmbraceStartupPhase
+        let dependencies: [String]
+        let work: () -> Void
+    }
+
+    private struct MutableState {
+        var tasks: [Task] = []
+        var scheduled = false
+        var cancelled = false
+        var deferredStarted = false
+        var backgroundStarted = false
+    }
+
+    private let state = EmbraceMutex(MutableState())
+
+    let budgets: Budgets
+    let backgroundQueue: DispatchQueue
+    let backgroundDelayLimit: TimeInterval
+    private let whenMainThreadIdle: (@escaping () -> Void) -> Void
+
+    /// Called on the queue that ran the phase.
+    var onPhaseFinished: ((PhaseReport) -> Void)?
+
+    init(
+        budgets: Budgets = Budgets(),
+        backgroundQueue: DispatchQueue,
+        backgroundDelayLimit: TimeInterval = 5,
+        whenMainThreadIdle: @escaping (@escaping () -> Void) -> Void = StartupScheduler.afterFirstFrame
+    ) {
+        self.budgets = budgets
+        self.backgroundQueue = backgroundQueue
+        self.backgroundDelayLimit = backgroundDelayLimit
+        self.whenMainThreadIdle = whenMainThreadIdle
+    }
+
+    /// Adds a task. Tasks must be added before `runCriticalPhase()`.
+    func add(_ name: String, phase: EmbraceStartupPhase, dependencies: [String] = [], work: @escaping () -> Void) {
+        let added = state.withLock {
+            guard !$0.scheduled else {
+                return false
+            }
+            $0.tasks.append(Task(name: name, phase: phase, dependencies: dependencies, work: work))
+            return true
+        }
+
+        // too late to schedule it, but the work still needs to happen
+        if !added {
+            Embrace.logger.warning("Startup task \(name) added after startup was scheduled, running it now.")
+            work()
+        }
+    }
+
+    /// Runs the critical tasks right away and schedules the rest.
+    func runCriticalPhase() {
+        let phases = state.withLock { state -> [EmbraceStartupPhase: [Task]] in
+            state.scheduled = true
+            return Self.resolve(state.tasks)
+        }
+
+        run(phases[.critical] ?? [], phase: .critical)
+
+        let deferred = phases[.deferred] ?? []
+        let background = phases[.background] ?? []
+
+        whenMainThreadIdle { [weak self] in
+            self?.runDeferredAndBackgroundPhases(deferred, background)
+        }
+
+        // background tasks can depend on deferred ones, so those have to run first here too
+        backgroundQueue.asyncAfter(deadline: .now() + backgroundDelayLimit) { [weak self] in
+            self?.runDeferredAndBackgroundPhases(deferred, background)
+        }
+    }
+
+    /// Drops the tasks that haven't run yet, for when the SDK stops during launch.
+    func cancel() {
+        state.withLock { $0.cancelled = true }
+    }
+
+    private var isCancelled: Bool {
+        state.withLock { $0.cancelled }
+    }
+
+    /// Runs the deferred tasks on the calling queue, then schedules the background ones.
+    /// Only the first call does anything, whichever of the main thread or the delay limit gets there first.
+    private func runDeferredAndBackgroundPhases(_ deferred: [Task], _ background: [Task]) {
+        let shouldRun = state.withLock {
+            guard !$0.cancelled, !$0.deferredStarted else {
+                return false
+            }
+            $0.deferredStarted = true
+            return true
+        }
+
+        guard shouldRun else {
+            return
+        }
+
+        run(deferred, phase: .deferred)
+        runBackgroundPhase(background)
+    }
+
+    private func runBackgroundPhase(_ tasks: [Task]) {
+        let shouldRun = state.withLock {
+            guard !$0.backgroundStarted else {
+                return false
+            }
+            $0.backgroundStarted = true
+            return true
+        }
+
+        guard shouldRun else {
+            return
+        }
+
+        backgroundQueue.async { [weak self] in
+            guard let self, !self.isCancelled else {
+                return
+            }
+            self.run(tasks, phase: .background)
+        }
+    }
+
+    private func run(_ tasks: [Task], phase: EmbraceStartupPhase) {
+        guard !tasks.isEmpty else {
+            return
+        }
+
+        let startTime = Date()
+        var timings: [TaskTiming] = []
+        timings.reserveCapacity(tasks.count)
+
+        for task in tasks {
+            let taskStart = Date()
+            task.work()
+            timings.append(TaskTiming(name: task.name, startTime: taskStart, endTime: Date()))
+        }
+
+        onPhaseFinished?(
+            PhaseReport(
+                phase: phase,
+                budget: budgets.budget(for: phase),
+                startTime: startTime,
+                endTime: Date(),
+                tasks: timings
+            ))
+    }
+
+    /// Groups the tasks by the phase they'll actually run in, each group in running order.
+    private static func resolve(_ tasks: [Task]) -> [EmbraceStartupPhase: [Task]] {
+        var indexByName: [String: Int] = [:]
+        for (index, task) in tasks.enumerated() where indexByName[task.name] == nil {
+            indexByName[task.name] = index
+        }
+
+        // a task can't run before its dependencies, so it moves to their phase if that's later
+        var phases: [EmbraceStartupPhase?] = Array(repeating: nil, count: tasks.count)
+        var visiting = Set<Int>()
+        func phase(of index: Int) -> EmbraceStartupPhase {
+            if let phase = phases[index] {
+                return phase
+            }
+
+            // dependency cycles are broken at the task that closes them
+            guard visiting.insert(index).inserted else {
+                return tasks[index].phase
+            }
+            defer { visiting.remove(index) }
+
+            var result = tasks[index].phase
+            for dependency in tasks[index].dependencies {
+                if let dependencyIndex = indexByName[dependency] {
+                    result = max(result, phase(of: dependencyIndex))
+                }
+            }
+            phases[index] = result
+            return result
+        }
+
+        // dependencies first, otherwise in the order tasks were added
+        var ordered: [Int] = []
+        var done = Set<Int>()
+        func visit(_ index: Int) {
+            guard !done.contains(index), visiting.insert(index).inserted else {
+                return
+            }
+            defer { visiting.remove(index) }
+
+            for dependency in tasks[index].dependencies {
+                if let dependencyIndex = indexByName[dependency] {
+                    visit(dependencyIndex)
+                }
+            }
+            done.insert(index)
+            ordered.append(index)
+        }
+
+        for index in tasks.indices {
+            _ = phase(of: index)
+        }
+        for index in tasks.indices {
+            visit(index)
+        }
+
+        var result: [EmbraceStartupPhase: [Task]] = [:]
+        for index in ordered {
+            result[phases[index] ?? tasks[index].phase, default: []].append(tasks[index])
+        }
+        return result
+    }
+}
+
+extension StartupScheduler {
+
+    /// Calls `block` on the main thread the first time the main run loop is about to sleep, right
+    /// after Core Animation commits the first frame, or after `timeout` if that doesn't happen first.
+    static func afterFirstFrame(_ block: @escaping () -> Void) {
+        afterFirstFrame(timeout: 2, block)
+    }
+
+    static func afterFirstFrame(timeout: TimeInterval, _ block: @escaping () -> Void) {
+        var fired = false
+        var observer: CFRunLoopObserver?
+
+        // only ever called on the main thread
+        let fire = {
+            guard !fired else {
+                return
+            }
+            fired = true
+            if let observer {
+                CFRunLoopObserverInvalidate(observer)
+            }
+            block()
+        }
+
+        // Core Animation commits its transaction from a `beforeWaiting` observer with order 2000000,
+        // a higher order runs after it
+        observer = CFRunLoopObserverCreateWithHandler(
+            kCFAllocatorDefault,
+            CFRunLoopActivity.beforeWaiting.rawValue,
+            false,
+            2_000_001
+        ) { _, _ in
+            fire()
+        }
+        CFRunLoopAddObserver(CFRunLoopGetMain(), observer, .commonModes)
+
+        DispatchQueue.main.asyncAfter(deadline: .now() + timeout) {
+            fire()
+        }
+    }
+}
@@ -4,7 +4,22 @@
 
 import Foundation
 
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCommonInternal
+#endif
+
 struct Attribute: Codable {
     var key: String
     var value: String
 }
+
+extension Attribute: EmbraceJSONWritable {
+    func writeJSON(to writer: inout EmbraceJSONWriter) {
+        writer.beginObject()
+        writer.key("key")
+        writer.value(key)
+        writer.key("value")
+        writer.value(value)
+        writer.endObject()
+    }
+}
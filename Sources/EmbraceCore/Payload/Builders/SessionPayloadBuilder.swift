@@ -11,7 +11,13 @@ import Foundation
 
 class SessionPayloadBuilder {
 
-    class func build(for session: EmbraceSession, storage: EmbraceStorage) -> PayloadEnvelope<[SpanPayload]>? {
+    class func build(
+        for session: EmbraceSession,
+        storage: EmbraceStorage,
+        snapshotTracker: SpanSnapshotTracker? = nil
+    ) -> PayloadEnvelope<[SpanPayload]>? {
+        let mkSpan = EmbraceMetricKitSpan.begin(name: "payload-build")
+        defer { mkSpan.end() }
 
         // fetch properties
         let properties = storage.fetchCustomProperties(sessionId: session.idRaw, processId: session.processIdRaw)
@@ -20,7 +26,8 @@ class SessionPayloadBuilder {
         let (spans, spanSnapshots) = SpansPayloadBuilder.build(
             for: session,
             storage: storage,
-            customProperties: properties
+            customProperties: properties,
+            snapshotTracker: snapshotTracker
         )
 
         // build resources payload
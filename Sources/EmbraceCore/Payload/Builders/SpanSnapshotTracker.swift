@@ -0,0 +1,112 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCommonInternal
+#endif
+
+/// Remembers the snapshots of open spans that were already uploaded, so session payloads don't repeat them.
+///
+/// Long running spans are sent as a snapshot in every session payload until they end. When enabled, a snapshot
+/// is only sent if the span changed since the last payload that included it was delivered by the upload module.
+/// Payloads that aren't delivered forget the spans they included, so the next payload sends them in full.
+///
+/// Only snapshots built in this process are tracked, so payloads of previous processes are always complete.
+class SpanSnapshotTracker {
+
+    static let shared = SpanSnapshotTracker()
+
+    struct State {
+        /// Hash of the last uploaded snapshot of each span.
+        var uploaded: [String: Int] = [:]
+        /// Hashes of the snapshots included in payloads that are being uploaded, by payload.
+        var pending: [String: [String: Int]] = [:]
+    }
+
+    private let _enabled = EmbraceAtomic<Bool>(false)
+    let state = EmbraceMutex(State())
+
+    func bootstrap(enabled: Bool) {
+        _enabled.store(enabled)
+        if !enabled {
+            state.withLock { $0 = State() }
+        }
+    }
+
+    var isEnabled: Bool {
+        _enabled.load()
+    }
+
+    /// Whether the snapshot of an open span has to be included in the payload `batch`.
+    /// When it does, it's remembered as uploaded once `uploadSucceeded(batch:)` is called.
+    func shouldSend(_ record: EmbraceSpan, batch: String) -> Bool {
+        guard isEnabled else {
+            return true
+        }
+
+        let key = Self.key(for: record)
+        let hash = Self.hash(of: record)
+
+        return state.withLock {
+            if $0.uploaded[key] == hash {
+                return false
+            }
+            $0.pending[batch, default: [:]][key] = hash
+            return true
+        }
+    }
+
+    /// Forgets a span that ended, it's included in full in `batch`.
+    func spanEnded(_ record: EmbraceSpan, batch: String) {
+        guard isEnabled else {
+            return
+        }
+
+        let key = Self.key(for: record)
+        state.withLock {
+            _ = $0.uploaded.removeValue(forKey: key)
+            _ = $0.pending[batch]?.removeValue(forKey: key)
+        }
+    }
+
+    /// Remembers the snapshots of the payload `batch` as uploaded, once it was delivered.
+    func uploadSucceeded(batch: String) {
+        state.withLock {
+            guard let snapshots = $0.pending.removeValue(forKey: batch) else {
+                return
+            }
+            $0.uploaded.merge(snapshots) { _, new in new }
+        }
+    }
+
+    /// Falls back to full snapshots for every span in the payload, in case an earlier copy was lost too.
+    func uploadFailed(batch: String) {
+        state.withLock {
+            guard let snapshots = $0.pending.removeValue(forKey: batch) else {
+                return
+            }
+            for key in snapshots.keys {
+                $0.uploaded.removeValue(forKey: key)
+            }
+        }
+    }
+
+    static func key(for record: EmbraceSpan) -> String {
+        "\(record.traceId)-\(record.id)"
+    }
+
+    /// Span events are only ever appended, so the count and the last one are enough to know if they changed.
+    static func hash(of record: EmbraceSpan) -> Int {
+        var hasher = Hasher()
+        record.data.withUnsafeBytes { hasher.combine(bytes: $0) }
+        hasher.combine(record.events.count)
+        if let last = record.events.last {
+            hasher.combine(last.name)
+            hasher.combine(last.timestamp)
+        }
+        return hasher.finalize()
+    }
+}
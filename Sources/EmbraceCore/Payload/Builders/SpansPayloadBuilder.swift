@@ -20,7 +20,8 @@ class SpansPayloadBuilder {
     class func build(
         for session: EmbraceSession,
         storage: EmbraceStorage,
-        customProperties: [EmbraceMetadata] = []
+        customProperties: [EmbraceMetadata] = [],
+        snapshotTracker: SpanSnapshotTracker? = nil
     ) -> (spans: [SpanPayload], spanSnapshots: [SpanPayload]) {
 
         let endTime = session.endTime ?? session.lastHeartbeatTime
@@ -61,6 +62,14 @@ class SpansPayloadBuilder {
                 /// The nil check is just a sanity check to cover all bases.
                 let failed = session.crashReportId != nil && (record.endTime == nil || record.endTime == endTime)
 
+                // skip open spans that didn't change since they were last uploaded, before decoding them
+                if !failed && record.endTime == nil,
+                    let snapshotTracker,
+                    !snapshotTracker.shouldSend(record, batch: session.idRaw)
+                {
+                    continue
+                }
+
                 let span = try JSONDecoder().decode(SpanData.self, from: record.data)
 
                 // drop startup span?
@@ -72,6 +81,7 @@ class SpansPayloadBuilder {
                 let payload = SpanPayload(from: adjustedSpan, endTime: failed ? endTime : record.endTime, failed: failed)
 
                 if failed || span.hasEnded {
+                    snapshotTracker?.spanEnded(record, batch: session.idRaw)
                     spans.append(payload)
                 } else {
                     spanSnapshots.append(payload)
@@ -27,3 +27,17 @@ struct LogPayload: Codable {
         case spanId = "span_id"
     }
 }
+
+extension LogPayload: EmbraceJSONWritable {
+    func writeJSON(to writer: inout EmbraceJSONWriter) throws {
+        writer.beginObject()
+        try writer.field("time_unix_nano", timeUnixNano)
+        try writer.field("severity_number", severityNumber)
+        try writer.field("severity_text", severityText)
+        try writer.field("body", body)
+        try writer.field("attributes", attributes)
+        try writer.field("trace_id", ifPresent: traceId)
+        try writer.field("span_id", ifPresent: spanId)
+        writer.endObject()
+    }
+}
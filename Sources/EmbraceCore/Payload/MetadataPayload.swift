@@ -52,3 +52,16 @@ struct MetadataPayload: Codable {
         }
     }
 }
+
+extension MetadataPayload: EmbraceJSONWritable {
+    func writeJSON(to writer: inout EmbraceJSONWriter) throws {
+        writer.beginObject()
+        try writer.field("locale", ifPresent: locale)
+        try writer.field("timezone_description", ifPresent: timezoneDescription)
+        try writer.field("personas", personas)
+        try writer.field("username", ifPresent: username)
+        try writer.field("email", ifPresent: email)
+        try writer.field("user_id", ifPresent: userId)
+        writer.endObject()
+    }
+}
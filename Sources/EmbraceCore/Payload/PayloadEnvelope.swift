@@ -4,6 +4,10 @@
 
 import Foundation
 
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCommonInternal
+#endif
+
 struct PayloadEnvelope<T: Encodable>: Encodable {
     var resource: ResourcePayload
     var metadata: MetadataPayload
@@ -30,3 +34,15 @@ extension PayloadEnvelope<[SpanPayload]> {
         self.metadata = metadata
     }
 }
+
+extension PayloadEnvelope: EmbraceJSONWritable where T: EmbraceJSONWritable {
+    func writeJSON(to writer: inout EmbraceJSONWriter) throws {
+        writer.beginObject()
+        try writer.field("resource", resource)
+        try writer.field("metadata", metadata)
+        try writer.field("version", version)
+        try writer.field("type", type)
+        try writer.field("data", data)
+        writer.endObject()
+    }
+}
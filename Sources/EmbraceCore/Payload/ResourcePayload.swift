@@ -220,3 +220,72 @@ extension ResourcePayload {
         }
     }
 }
+
+extension ResourcePayload: EmbraceJSONWritable {
+    func writeJSON(to writer: inout EmbraceJSONWriter) throws {
+        writer.beginObject()
+
+        // Missing values are written as `null`, like `encode(to:)` does. An additional resource
+        // with the same name as a field replaces it, as it did when it overwrote it in the container.
+        for key in CodingKeys.allCases where additionalResources.isEmpty || additionalResources[key.stringValue] == nil {
+            writer.key(key.stringValue)
+            switch key {
+            case .jailbroken:
+                try writer.value(jailbroken)
+            case .environment:
+                try writer.value(environment)
+            case .diskTotalCapacity:
+                try writer.value(diskTotalCapacity)
+            case .osVersion:
+                try writer.value(osVersion)
+            case .osBuild:
+                try writer.value(osBuild)
+            case .osName:
+                try writer.value(osName)
+            case .osType:
+                try writer.value(osType)
+            case .osAlternateType:
+                try writer.value(osAlternateType)
+            case .deviceArchitecture:
+                try writer.value(deviceArchitecture)
+            case .deviceModel:
+                try writer.value(deviceModel)
+            case .deviceManufacturer:
+                try writer.value(deviceManufacturer)
+            case .screenResolution:
+                try writer.value(screenResolution)
+            case .buildId:
+                try writer.value(buildId)
+            case .bundleVersion:
+                try writer.value(bundleVersion)
+            case .environmentDetail:
+                try writer.value(environmentDetail)
+            case .appFramework:
+                try writer.value(appFramework)
+            case .launchCount:
+                try writer.value(launchCount)
+            case .sdkVersion:
+                try writer.value(sdkVersion)
+            case .sdkPlatform:
+                try writer.value(sdkPlatform)
+            case .appVersion:
+                try writer.value(appVersion)
+            case .appBundleId:
+                try writer.value(appBundleId)
+            case .processIdentifier:
+                try writer.value(processIdentifier)
+            case .processStartTime:
+                try writer.value(processStartTime)
+            case .processPreWarm:
+                try writer.value(processPreWarm)
+            }
+        }
+
+        for (key, value) in additionalResources {
+            writer.key(key)
+            writer.value(value)
+        }
+
+        writer.endObject()
+    }
+}
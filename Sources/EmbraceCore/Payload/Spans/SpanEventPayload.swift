@@ -40,6 +40,16 @@ struct SpanEventPayload: Encodable {
     }
 }
 
+extension SpanEventPayload: EmbraceJSONWritable {
+    func writeJSON(to writer: inout EmbraceJSONWriter) throws {
+        writer.beginObject()
+        try writer.field("name", name)
+        try writer.field("time_unix_nano", timestamp)
+        try writer.field("attributes", attributes)
+        writer.endObject()
+    }
+}
+
 extension SpanEventPayload: Equatable {
     public static func == (lhs: SpanEventPayload, rhs: SpanEventPayload) -> Bool {
         return
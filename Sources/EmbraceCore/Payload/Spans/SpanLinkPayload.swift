@@ -4,6 +4,7 @@
 
 #if !EMBRACE_COCOAPOD_BUILDING_SDK
     import EmbraceOTelInternal
+    import EmbraceCommonInternal
 #endif
 
 struct SpanLinkPayload: Encodable {
@@ -31,6 +32,16 @@ struct SpanLinkPayload: Encodable {
     }
 }
 
+extension SpanLinkPayload: EmbraceJSONWritable {
+    func writeJSON(to writer: inout EmbraceJSONWriter) throws {
+        writer.beginObject()
+        try writer.field("trace_id", traceId)
+        try writer.field("span_id", spanId)
+        try writer.field("attributes", attributes)
+        writer.endObject()
+    }
+}
+
 extension SpanLinkPayload: Equatable {
     public static func == (lhs: SpanLinkPayload, rhs: SpanLinkPayload) -> Bool {
         return
@@ -83,6 +83,23 @@ struct SpanPayload: Encodable {
     }
 }
 
+extension SpanPayload: EmbraceJSONWritable {
+    func writeJSON(to writer: inout EmbraceJSONWriter) throws {
+        writer.beginObject()
+        try writer.field("trace_id", traceId)
+        try writer.field("span_id", spanId)
+        try writer.field("parent_span_id", ifPresent: parentSpanId)
+        try writer.field("name", name)
+        try writer.field("status", status)
+        try writer.field("start_time_unix_nano", startTime)
+        try writer.field("end_time_unix_nano", ifPresent: endTime)
+        try writer.field("attributes", attributes)
+        try writer.field("events", events)
+        try writer.field("links", links)
+        writer.endObject()
+    }
+}
+
 extension SpanPayload: Equatable {
     public static func == (lhs: SpanPayload, rhs: SpanPayload) -> Bool {
         return
@@ -0,0 +1,109 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCommonInternal
+#endif
+
+/// Lightweight logging for app extensions, like widgets and notification service extensions.
+///
+/// Setting up the full SDK in an extension opens its own storage and upload pipeline, which is a lot for a process
+/// that often lives for less than a second. `EmbraceExtension` doesn't start any of that: logs and spans are written
+/// to a memory-mapped ring in the app group container, and the host app imports them into its own storage the next
+/// time it starts the SDK with the same `appGroupId`.
+///
+/// Spans are added to the host app's first session after the import, and logs are uploaded with the logs of
+/// previous processes.
+///
+/// ```swift
+/// // in the extension
+/// EmbraceExtension.setup(appGroupId: "group.com.example.app", appId: "myApp")
+/// EmbraceExtension.shared?.log("Widget timeline reloaded", severity: .info)
+///
+/// // in the host app
+/// try Embrace.setup(options: Embrace.Options(appId: "myApp", appGroupId: "group.com.example.app"))
+/// ```
+///
+/// Records that don't fit in the ring, because it's full or the host app didn't run for a while, are dropped.
+public final class EmbraceExtension {
+
+    /// The instance created by `setup`, `nil` until then.
+    public private(set) static var shared: EmbraceExtension? {
+        get { _shared.safeValue }
+        set { _shared.withLock { $0 = newValue } }
+    }
+    private static let _shared = EmbraceMutex<EmbraceExtension?>(nil)
+
+    let ring: EmbraceSharedRing
+
+    /// Opens the ring shared with the host app. Calling it again returns the existing instance.
+    ///
+    /// - Parameters:
+    ///   - appGroupId: The app group shared by the extension and the host app.
+    ///   - appId: The app identifier the host app uses, if any.
+    /// - Returns: `nil` if the ring can't be opened, like when the app group isn't set up.
+    @discardableResult
+    public static func setup(appGroupId: String, appId: String? = nil) -> EmbraceExtension? {
+        _shared.withLock {
+            if let existing = $0 {
+                return existing
+            }
+
+            guard
+                let url = EmbraceFileSystem.extensionEventsURL(
+                    partitionIdentifier: appId ?? EmbraceFileSystem.defaultPartitionId,
+                    appGroupId: appGroupId
+                ),
+                let ring = EmbraceSharedRing(url: url)
+            else {
+                return nil
+            }
+
+            $0 = EmbraceExtension(ring: ring)
+            return $0
+        }
+    }
+
+    init(ring: EmbraceSharedRing) {
+        self.ring = ring
+    }
+
+    /// Records a log. Returns `false` if it was dropped.
+    @discardableResult
+    public func log(
+        _ message: String,
+        severity: LogSeverity = .info,
+        timestamp: Date = Date(),
+        attributes: [String: String] = [:]
+    ) -> Bool {
+        push(.log(message, severity: severity, timestamp: timestamp, attributes: attributes))
+    }
+
+    /// Records a span that already ended. Returns `false` if it was dropped.
+    @discardableResult
+    public func recordSpan(
+        name: String,
+        startTime: Date,
+        endTime: Date = Date(),
+        attributes: [String: String] = [:]
+    ) -> Bool {
+        push(.span(name, startTime: startTime, endTime: endTime, attributes: attributes))
+    }
+
+    /// Runs `block` and records a span for it.
+    public func recordSpan<T>(name: String, attributes: [String: String] = [:], _ block: () throws -> T) rethrows -> T {
+        let startTime = Date()
+        defer { recordSpan(name: name, startTime: startTime, attributes: attributes) }
+        return try block()
+    }
+
+    private func push(_ record: ExtensionRecord) -> Bool {
+        guard let data = record.encoded(maxSize: ring.maxRecordSize) else {
+            return false
+        }
+        return ring.push(data)
+    }
+}
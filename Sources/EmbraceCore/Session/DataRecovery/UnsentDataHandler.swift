@@ -16,6 +16,8 @@ typealias UnsentDataHandlerCompletion = () -> Void
 
 class UnsentDataHandler {
 
+    /// Recovers the data left behind by previous processes. See `UnsentDataRecovery`.
+    @discardableResult
     static func sendUnsentData(
         storage: EmbraceStorage?,
         upload: EmbraceUpload?,
@@ -23,133 +25,83 @@ class UnsentDataHandler {
         logController: LogControllable? = nil,
         currentSessionId: EmbraceIdentifier? = nil,
         crashReporter: EmbraceCrashReporter? = nil,
+        recoveredHeartbeat: SessionHeartbeatSlot.Snapshot? = nil,
         completion: UnsentDataHandlerCompletion? = nil
-    ) {
+    ) -> UnsentDataRecovery? {
 
         guard let storage = storage
         else {
             completion?()
-            return
+            return nil
         }
 
-        // this queue will live for as long as it has any running blocks
-        let reportQueue: DispatchQueue = DispatchQueue(label: "io.embrace.report.queue", qos: .utility)
-
-        let group = DispatchGroup()
-        group.enter()
-
-        reportQueue.async {
-
-            // send any logs in storage first before we clean up the resources
-            if let logController {
-                group.enter()
-                logController.uploadAllPersistedLogs {
-                    group.leave()
-                }
-            }
-
-            // if we have a crash reporter, we fetch the unsent crash reports first
-            // and save their identifiers to the corresponding sessions
-            if let crashReporter = crashReporter {
-                group.enter()
-                crashReporter.fetchUnsentCrashReports { reports in
-                    sendCrashReports(
-                        storage: storage,
-                        upload: upload,
-                        otel: otel,
-                        currentSessionId: currentSessionId,
-                        crashReporter: crashReporter,
-                        crashReports: reports,
-                        completion: {
-                            group.leave()
-                        }
-                    )
-                }
-            } else {
-                group.enter()
-                sendSessions(
-                    storage: storage,
-                    upload: upload,
-                    currentSessionId: currentSessionId,
-                    completion: {
-                        group.leave()
-                    }
-                )
-            }
+        let recovery = UnsentDataRecovery()
+        recovery.run(
+            storage: storage,
+            upload: upload,
+            otel: otel,
+            logController: logController,
+            currentSessionId: currentSessionId,
+            crashReporter: crashReporter,
+            recoveredHeartbeat: recoveredHeartbeat,
+            completion: completion
+        )
+        return recovery
+    }
 
-            group.leave()
+    /// Applies the heartbeat recorded in the slot by the previous process to its unfinished session.
+    static func recoverHeartbeat(_ snapshot: SessionHeartbeatSlot.Snapshot?, storage: EmbraceStorage) {
+        guard let snapshot,
+            let session = storage.fetchSession(id: snapshot.sessionId),
+            session.endTime == nil,
+            snapshot.lastHeartbeat > session.lastHeartbeatTime
+        else {
+            return
         }
 
-        group.notify(queue: reportQueue) {
-            completion?()
-        }
+        storage.updateSession(
+            session: session,
+            lastHeartbeatTime: snapshot.lastHeartbeat,
+            appTerminated: snapshot.appTerminated ? true : nil
+        )
+        storage.flush()
     }
 
-    static private func sendCrashReports(
-        storage: EmbraceStorage,
-        upload: EmbraceUpload?,
-        otel: EmbraceOpenTelemetry?,
-        currentSessionId: EmbraceIdentifier?,
-        crashReporter: EmbraceCrashReporter,
-        crashReports: [EmbraceCrashReport],
-        completion: UnsentDataHandlerCompletion? = nil
-    ) {
-
-        let group = DispatchGroup()
-        group.enter()
-
-        // send crash reports
-        for report in crashReports {
-
-            var session: EmbraceSession?
-
-            // link session with crash report if possible
-            if let sessionId = report.sessionId {
-                if let fetchedSession = storage.fetchSession(id: EmbraceIdentifier(stringValue: sessionId)) {
-                    session = storage.updateSession(
-                        session: fetchedSession,
-                        endTime: report.timestamp,
-                        crashReportId: report.id.uuidString
-                    )
-                }
-            }
+    /// Saves the crash report identifiers in the sessions they happened in.
+    /// Returns the updated sessions by crash report id.
+    static func linkCrashReports(_ reports: [EmbraceCrashReport], storage: EmbraceStorage) -> [UUID: EmbraceSession] {
+        let sessionIds = Set(reports.compactMap(\.sessionId))
+        guard !sessionIds.isEmpty else {
+            return [:]
+        }
 
-            // send crash log
-            group.enter()
-            sendCrashLog(
-                report: report,
-                reporter: crashReporter,
-                session: session,
-                storage: storage,
-                upload: upload,
-                otel: otel
-            ) {
-                group.leave()
+        // one fetch for all the reports instead of one per report
+        var sessions: [String: EmbraceSession] = [:]
+        if sessionIds.count == 1, let sessionId = sessionIds.first {
+            sessions[sessionId] = storage.fetchSession(id: EmbraceIdentifier(stringValue: sessionId))
+        } else {
+            for session in storage.fetchAllSessions() where sessionIds.contains(session.idRaw) {
+                sessions[session.idRaw] = session
             }
         }
 
-        // Send the crash reports notification
-        let reports = crashReports.compactMap { $0 }
-        if !reports.isEmpty {
-            DispatchQueue.main.async {
-                NotificationCenter.default.post(name: .embraceDidSendCrashReports, object: reports)
+        var linked: [UUID: EmbraceSession] = [:]
+        for report in reports {
+            guard let sessionId = report.sessionId, let session = sessions[sessionId] else {
+                continue
             }
-        }
 
-        // send sessions
-        group.enter()
-        sendSessions(
-            storage: storage,
-            upload: upload,
-            currentSessionId: currentSessionId
-        ) {
-            group.leave()
+            linked[report.id] = storage.updateSession(
+                session: session,
+                endTime: report.timestamp,
+                crashReportId: report.id.uuidString
+            )
         }
 
-        group.leave()
-        group.notify(queue: .global(qos: .utility)) {
-            completion?()
-        }
+        // the links must be on disk before the crash reports can be handed off and deleted
+        storage.flush()
+
+        return linked
     }
 
     static public func sendCrashLog(
@@ -188,7 +140,7 @@ class UnsentDataHandler {
                 storage: storage,
                 sessionId: session?.id
             )
-            let payloadData = try JSONEncoder().encode(payload).gzipped()
+            let payloadData = try payload.gzippedJSON()
 
             upload.uploadLog(id: report.id.uuidString, data: payloadData, payloadTypes: LogType.crash.rawValue) { result in
                 switch result {
@@ -249,72 +201,29 @@ class UnsentDataHandler {
         return attributes
     }
 
-    static private func sendSessions(
-        storage: EmbraceStorage,
-        upload: EmbraceUpload?,
-        currentSessionId: EmbraceIdentifier?,
-        completion: UnsentDataHandlerCompletion? = nil
-    ) {
-
-        // clean up old spans + close open spans
-        cleanOldSpans(storage: storage, currentSessionId: currentSessionId)
-        closeOpenSpans(storage: storage, currentSessionId: currentSessionId)
-
-        // fetch all sessions in the storage
-        let sessions: [EmbraceSession] = storage.fetchAllSessions()
-
-        let group = DispatchGroup()
-        group.enter()
-
-        for session in sessions {
-            // ignore current session
-            if let currentSessionId = currentSessionId,
-                currentSessionId == session.id
-            {
-                continue
-            }
-
-            group.enter()
-            sendSession(
-                session,
-                storage: storage,
-                upload: upload,
-                performCleanUp: false,
-                completion: {
-                    group.leave()
-                }
-            )
-        }
-
-        // remove old metadata
-        cleanMetadata(storage: storage)
-
-        group.leave()
-        group.notify(queue: .global(qos: .utility)) {
-            completion?()
-        }
-    }
-
     static public func sendSession(
         _ session: EmbraceSession,
         storage: EmbraceStorage,
         upload: EmbraceUpload?,
         performCleanUp: Bool = true,
+        snapshotTracker: SpanSnapshotTracker? = nil,
         completion: UnsentDataHandlerCompletion? = nil
     ) {
         // create payload
-        let payload = SessionPayloadBuilder.build(for: session, storage: storage)
+        let payload = SessionPayloadBuilder.build(for: session, storage: storage, snapshotTracker: snapshotTracker)
         var payloadData: Data?
 
         do {
-            payloadData = try JSONEncoder().encode(payload).gzipped()
+            payloadData = try payload.gzippedJSON()
         } catch {
             Embrace.logger.warning("Error encoding session \(session.idRaw):\n" + error.localizedDescription)
+            snapshotTracker?.uploadFailed(batch: session.idRaw)
             completion?()
             return
         }
 
         guard let payloadData = payloadData else {
+            snapshotTracker?.uploadFailed(batch: session.idRaw)
             completion?()
             return
         }
@@ -326,31 +235,50 @@ class UnsentDataHandler {
 
         // upload session spans
         guard let upload = upload else {
+            snapshotTracker?.uploadFailed(batch: session.idRaw)
             if let sessionId = session.id {
                 storage.deleteSession(id: sessionId)
             }
             completion?()
             return
         }
-        upload.uploadSpans(id: session.idRaw, data: payloadData) { result in
-            switch result {
-            case .success:
-                // remove session from storage
-                // we can remove this immediately because the upload module will cache it until the upload succeeds
-                if let sessionId = session.id {
-                    storage.deleteSession(id: sessionId)
+        // snapshots only count as uploaded once the payload was sent.
+        // caching it isn't enough, the upload module drops it if the request fails or the cache is full
+        let deliveryCompletion: ((Bool) -> Void)? = snapshotTracker.map { tracker in
+            { delivered in
+                if delivered {
+                    tracker.uploadSucceeded(batch: session.idRaw)
+                } else {
+                    tracker.uploadFailed(batch: session.idRaw)
                 }
-
-            case .failure(let error):
-                Embrace.logger.warning(
-                    "Error trying to upload session \(session.idRaw):\n\(error.localizedDescription)")
             }
-
-            completion?()
         }
+
+        upload.uploadSpans(
+            id: session.idRaw,
+            data: payloadData,
+            completion: { result in
+                switch result {
+                case .success:
+                    // remove session from storage
+                    // we can remove this immediately because the upload module will cache it until the upload succeeds
+                    if let sessionId = session.id {
+                        storage.deleteSession(id: sessionId)
+                    }
+
+                case .failure(let error):
+                    snapshotTracker?.uploadFailed(batch: session.idRaw)
+                    Embrace.logger.warning(
+                        "Error trying to upload session \(session.idRaw):\n\(error.localizedDescription)")
+                }
+
+                completion?()
+            },
+            deliveryCompletion: deliveryCompletion
+        )
     }
 
-    static private func cleanOldSpans(storage: EmbraceStorage, currentSessionId: EmbraceIdentifier? = nil) {
+    static func cleanOldSpans(storage: EmbraceStorage, currentSessionId: EmbraceIdentifier? = nil) {
         // first we delete any span record that is closed and its older
         // than the oldest session we have on storage
         // since spans are only sent when included in a session
@@ -361,7 +289,7 @@ class UnsentDataHandler {
         storage.cleanUpSpans(date: oldestSession?.startTime)
     }
 
-    static private func closeOpenSpans(storage: EmbraceStorage, currentSessionId: EmbraceIdentifier? = nil) {
+    static func closeOpenSpans(storage: EmbraceStorage, currentSessionId: EmbraceIdentifier? = nil) {
         // then we need to close any remaining open spans
         // we use the latest session on storage to determine the `endTime`
         // since we need to have a valid `endTime` for these spans, we default
@@ -371,7 +299,7 @@ class UnsentDataHandler {
         storage.closeOpenSpans(endTime: endTime)
     }
 
-    static private func cleanMetadata(storage: EmbraceStorage) {
+    static func cleanMetadata(storage: EmbraceStorage) {
         storage.cleanMetadata()
     }
 
@@ -420,7 +348,7 @@ class UnsentDataHandler {
 
         // send log
         do {
-            let payloadData = try JSONEncoder().encode(payload).gzipped()
+            let payloadData = try payload.gzippedJSON()
             upload.uploadLog(id: id, data: payloadData, payloadTypes: LogType.internal.rawValue) { _ in
                 completion?()
             }
@@ -439,7 +367,8 @@ extension UnsentDataHandler {
         otel: EmbraceOpenTelemetry?,
         logController: LogControllable? = nil,
         currentSessionId: EmbraceIdentifier? = nil,
-        crashReporter: EmbraceCrashReporter? = nil
+        crashReporter: EmbraceCrashReporter? = nil,
+        recoveredHeartbeat: SessionHeartbeatSlot.Snapshot? = nil
     ) async {
         await withCheckedContinuation { continuation in
             sendUnsentData(
@@ -448,7 +377,8 @@ extension UnsentDataHandler {
                 otel: otel,
                 logController: logController,
                 currentSessionId: currentSessionId,
-                crashReporter: crashReporter
+                crashReporter: crashReporter,
+                recoveredHeartbeat: recoveredHeartbeat
             ) {
                 continuation.resume()
             }
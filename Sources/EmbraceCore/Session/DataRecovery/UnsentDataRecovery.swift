@@ -0,0 +1,286 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if canImport(UIKit) && !os(watchOS)
+    import UIKit
+#endif
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCommonInternal
+    import EmbraceStorageInternal
+    import EmbraceUploadInternal
+    import EmbraceOTelInternal
+#endif
+
+/// Recovers the data left behind by previous processes: crash reports, persisted logs and unfinished sessions.
+///
+/// The work is split in stages that run on a bounded operation queue as soon as the stages they depend on are done:
+///
+///     heartbeat ──> crash reports ──> crash log (one per report)
+///         │               │
+///         └───────────────┴──> sessions ──> session (one per session) ──> metadata cleanup
+///                                                                               ^
+///     persisted logs ───────────────────────────────────────────────────────────┘
+///
+/// Crash logs have the highest priority, so they're handed to the upload module before any session.
+/// If the app goes to the background, the stages that didn't start yet are cancelled. Whatever they would
+/// have sent stays in storage and is recovered on the next launch.
+final class UnsentDataRecovery {
+
+    static let defaultMaxConcurrentStages = 4
+
+    private let queue: OperationQueue
+    private let group = DispatchGroup()
+    private let cancelled = EmbraceMutex(false)
+    private var backgroundObserver: NSObjectProtocol?
+
+    init(maxConcurrentStages: Int = UnsentDataRecovery.defaultMaxConcurrentStages, cancelWhenBackgrounded: Bool = true) {
+        queue = OperationQueue()
+        queue.name = "io.embrace.report.queue"
+        queue.qualityOfService = .utility
+        queue.maxConcurrentOperationCount = maxConcurrentStages
+
+        #if canImport(UIKit) && !os(watchOS)
+            if cancelWhenBackgrounded {
+                backgroundObserver = NotificationCenter.default.addObserver(
+                    forName: UIApplication.didEnterBackgroundNotification,
+                    object: nil,
+                    queue: nil
+                ) { [weak self] _ in
+                    self?.cancel()
+                }
+            }
+        #endif
+    }
+
+    deinit {
+        if let backgroundObserver {
+            NotificationCenter.default.removeObserver(backgroundObserver)
+        }
+    }
+
+    /// Cancels the stages that haven't started yet.
+    func cancel() {
+        cancelled.withLock { $0 = true }
+        queue.cancelAllOperations()
+    }
+
+    func run(
+        storage: EmbraceStorage,
+        upload: EmbraceUpload?,
+        otel: EmbraceOpenTelemetry?,
+        logController: LogControllable?,
+        currentSessionId: EmbraceIdentifier?,
+        crashReporter: EmbraceCrashReporter?,
+        recoveredHeartbeat: SessionHeartbeatSlot.Snapshot?,
+        completion: UnsentDataHandlerCompletion?
+    ) {
+        // sessions only persist heartbeats at transitions, restore the last one
+        // from the slot before anything reads their end time
+        let heartbeat = stage(priority: .veryHigh) { done in
+            UnsentDataHandler.recoverHeartbeat(recoveredHeartbeat, storage: storage)
+            done()
+        }
+        var sessionsDependencies = [heartbeat]
+
+        // if we have a crash reporter, we fetch the unsent crash reports first
+        // and save their identifiers to the corresponding sessions
+        if let crashReporter {
+            let crashReports = stage(priority: .veryHigh, after: [heartbeat]) { [weak self] done in
+                crashReporter.fetchUnsentCrashReports { reports in
+                    self?.sendCrashReports(
+                        reports,
+                        storage: storage,
+                        upload: upload,
+                        otel: otel,
+                        crashReporter: crashReporter
+                    )
+                    done()
+                }
+            }
+            sessionsDependencies.append(crashReports)
+        }
+
+        // persisted logs don't depend on anything else,
+        // but they need the metadata that gets cleaned up at the end
+        var logs: Operation?
+        if let logController {
+            logs = stage(priority: .high) { done in
+                logController.uploadAllPersistedLogs {
+                    done()
+                }
+            }
+        }
+
+        stage(priority: .normal, after: sessionsDependencies) { [weak self] done in
+            self?.sendSessions(
+                storage: storage,
+                upload: upload,
+                currentSessionId: currentSessionId,
+                waitingFor: logs
+            )
+            done()
+        }
+
+        // keeps the recovery alive until everything is done
+        group.notify(queue: .global(qos: .utility)) {
+            withExtendedLifetime(self) {
+                completion?()
+            }
+        }
+    }
+
+    private func sendCrashReports(
+        _ reports: [EmbraceCrashReport],
+        storage: EmbraceStorage,
+        upload: EmbraceUpload?,
+        otel: EmbraceOpenTelemetry?,
+        crashReporter: EmbraceCrashReporter
+    ) {
+        guard !reports.isEmpty else {
+            return
+        }
+
+        let sessions = UnsentDataHandler.linkCrashReports(reports, storage: storage)
+
+        for report in reports {
+            stage(priority: .veryHigh) { done in
+                UnsentDataHandler.sendCrashLog(
+                    report: report,
+                    reporter: crashReporter,
+                    session: sessions[report.id],
+                    storage: storage,
+                    upload: upload,
+                    otel: otel
+                ) {
+                    done()
+                }
+            }
+        }
+
+        // Send the crash reports notification
+        DispatchQueue.main.async {
+            NotificationCenter.default.post(name: .embraceDidSendCrashReports, object: reports)
+        }
+    }
+
+    private func sendSessions(
+        storage: EmbraceStorage,
+        upload: EmbraceUpload?,
+        currentSessionId: EmbraceIdentifier?,
+        waitingFor logs: Operation?
+    ) {
+        // clean up old spans + close open spans
+        UnsentDataHandler.cleanOldSpans(storage: storage, currentSessionId: currentSessionId)
+        UnsentDataHandler.closeOpenSpans(storage: storage, currentSessionId: currentSessionId)
+
+        // each session payload is built and sent on its own
+        var sessions = storage.fetchAllSessions()
+        if let currentSessionId {
+            sessions.removeAll { $0.id == currentSessionId }
+        }
+        let sends = sessions.map { session in
+            stage(priority: .normal) { done in
+                UnsentDataHandler.sendSession(
+                    session,
+                    storage: storage,
+                    upload: upload,
+                    performCleanUp: false
+                ) {
+                    done()
+                }
+            }
+        }
+
+        // remove old metadata once nothing else needs it
+        stage(priority: .low, after: sends + [logs].compactMap { $0 }) { done in
+            UnsentDataHandler.cleanMetadata(storage: storage)
+            done()
+        }
+    }
+
+    @discardableResult
+    private func stage(
+        priority: Operation.QueuePriority,
+        after dependencies: [Operation] = [],
+        work: @escaping (_ done: @escaping () -> Void) -> Void
+    ) -> Operation {
+        let operation = RecoveryStage(group: group, work: work)
+        operation.queuePriority = priority
+        dependencies.forEach(operation.addDependency)
+
+        // stages added by a stage that was already running when the recovery got cancelled
+        if cancelled.safeValue {
+            operation.cancel()
+        }
+
+        queue.addOperation(operation)
+        return operation
+    }
+}
+
+/// An operation that's done when its work calls `done`, or right away if it's cancelled before starting.
+private final class RecoveryStage: Operation, @unchecked Sendable {
+
+    private struct State {
+        var isExecuting = false
+        var isFinished = false
+        var isFinishing = false
+    }
+
+    private let state = EmbraceMutex(State())
+    private let group: DispatchGroup
+    private let work: (_ done: @escaping () -> Void) -> Void
+
+    init(group: DispatchGroup, work: @escaping (_ done: @escaping () -> Void) -> Void) {
+        self.group = group
+        self.work = work
+        group.enter()
+    }
+
+    override var isAsynchronous: Bool { true }
+    override var isExecuting: Bool { state.withLock { $0.isExecuting } }
+    override var isFinished: Bool { state.withLock { $0.isFinished } }
+
+    override func start() {
+        guard !isCancelled else {
+            finish()
+            return
+        }
+
+        willChangeValue(forKey: "isExecuting")
+        state.withLock { $0.isExecuting = true }
+        didChangeValue(forKey: "isExecuting")
+
+        work { [weak self] in
+            self?.finish()
+        }
+    }
+
+    private func finish() {
+        let shouldFinish = state.withLock {
+            guard !$0.isFinishing else {
+                return false
+            }
+            $0.isFinishing = true
+            return true
+        }
+        guard shouldFinish else {
+            return
+        }
+
+        willChangeValue(forKey: "isExecuting")
+        willChangeValue(forKey: "isFinished")
+        state.withLock {
+            $0.isExecuting = false
+            $0.isFinished = true
+        }
+        didChangeValue(forKey: "isFinished")
+        didChangeValue(forKey: "isExecuting")
+
+        group.leave()
+    }
+}
@@ -59,6 +59,7 @@ class SessionController: SessionControllable {
     }
 
     let heartbeat: SessionHeartbeat
+    let heartbeatSlot: SessionHeartbeatSlot?
     let queue: DispatchableQueue
     var firstSession = true
 
@@ -68,6 +69,7 @@ class SessionController: SessionControllable {
         uploader: SessionUploader = DefaultSessionUploader(),
         config: EmbraceConfig?,
         heartbeatInterval: TimeInterval = SessionHeartbeat.defaultInterval,
+        heartbeatSlot: SessionHeartbeatSlot? = nil,
         queue: DispatchableQueue = .with(label: "com.embrace.session_controller_upload"),
         heartbeatQueue: DispatchQueue = DispatchQueue(label: "com.embrace.session_heartbeat")
     ) {
@@ -77,6 +79,7 @@ class SessionController: SessionControllable {
         self.config = config
 
         self.heartbeat = SessionHeartbeat(queue: heartbeatQueue, interval: heartbeatInterval)
+        self.heartbeatSlot = heartbeatSlot
         self.queue = queue
 
         self.heartbeat.callback = { [weak self] in
@@ -160,6 +163,9 @@ class SessionController: SessionControllable {
             )
 
             // start heartbeat
+            if let session {
+                heartbeatSlot?.begin(sessionId: newId, state: state, heartbeat: session.lastHeartbeatTime)
+            }
             heartbeat.start()
 
             firstSession = false
@@ -191,6 +197,7 @@ class SessionController: SessionControllable {
 
         // stop heartbeat
         heartbeat.stop()
+        heartbeatSlot?.end()
         let now = Date()
 
         guard sdkStateProvider?.isEnabled == true else {
@@ -228,6 +235,18 @@ class SessionController: SessionControllable {
             // Ending span for otel processors
             // Note: our exporter wont trigger an update on the stored span
             // to prevent race conditions.
+            setPendingHeartbeat(span: inProgressSessionSpan, session: inProgressSession)
+
+            let selfMetrics = EmbraceSelfMetrics.shared.snapshot(reset: true)
+            if !selfMetrics.isEmpty {
+                SessionSpanUtils.setSelfMetrics(span: inProgressSessionSpan, metrics: selfMetrics)
+            }
+
+            let memoryBudget = EmbraceMemoryBudget.shared.snapshot(reset: true)
+            if memoryBudget.isDegraded {
+                SessionSpanUtils.setMemoryBudget(span: inProgressSessionSpan, snapshot: memoryBudget)
+            }
+
             inProgressSessionSpan.end(time: now)
 
             storage?.endSpan(
@@ -240,9 +259,17 @@ class SessionController: SessionControllable {
         // update session end time and clean exit
         var sessionToUpload: EmbraceSession? = inProgressSession
         if inProgressSession.id != nil {
-            sessionToUpload = storage?.updateSession(session: inProgressSession, endTime: now, cleanExit: true)
+            sessionToUpload = storage?.updateSession(
+                session: inProgressSession,
+                lastHeartbeatTime: pendingHeartbeat(inProgressSession),
+                endTime: now,
+                cleanExit: true
+            )
         }
 
+        // persist everything written during the session before it's handed to the uploader
+        storage?.save()
+
         // post internal notification
         if inProgressSession.state == SessionState.foreground.rawValue {
             Embrace.notificationCenter.post(name: .embraceForegroundSessionDidEnd, object: now)
@@ -274,10 +301,13 @@ class SessionController: SessionControllable {
         let sessionInfo = _session.safeValue
         let spanToFlush: Span? = lock.locked {
             guard let session = sessionInfo.session else { return nil }
-            let updatedSession = storage?.updateSession(session: session, state: state)
+            heartbeatSlot?.update(state: state)
+            let updatedSession = storage?.updateSession(
+                session: session, state: state, lastHeartbeatTime: pendingHeartbeat(session))
             _session.withLock { $0.session = updatedSession }
             guard let span = sessionInfo.sessionSpan else { return nil }
             SessionSpanUtils.setState(span: span, state: state)
+            setPendingHeartbeat(span: span, session: session)
             return span
         }
         if let span = spanToFlush { Embrace.client?.flush(span) }
@@ -287,16 +317,34 @@ class SessionController: SessionControllable {
         let sessionInfo = _session.safeValue
         let spanToFlush: Span? = lock.locked {
             guard let session = sessionInfo.session else { return nil }
-            let updatedSession = storage?.updateSession(session: session, appTerminated: appTerminated)
+            heartbeatSlot?.update(appTerminated: appTerminated)
+            let updatedSession = storage?.updateSession(
+                session: session, lastHeartbeatTime: pendingHeartbeat(session), appTerminated: appTerminated)
             _session.withLock { $0.session = updatedSession }
             guard let span = sessionInfo.sessionSpan else { return nil }
             SessionSpanUtils.setTerminated(span: span, terminated: appTerminated)
+            setPendingHeartbeat(span: span, session: session)
             return span
         }
         if let span = spanToFlush { Embrace.client?.flush(span) }
     }
 
+    /// Records a heartbeat tick.
+    ///
+    /// With a heartbeat slot, a tick is one atomic store into the slot plus the in-memory session;
+    /// storage and the session span catch up at the next transition, or from the slot after a crash.
     func update(heartbeat: Date) {
+        if let heartbeatSlot {
+            lock.locked {
+                _session.withLock {
+                    guard let session = $0.session else { return }
+                    heartbeatSlot.beat(heartbeat)
+                    $0.session = session.updated(lastHeartbeatTime: heartbeat)
+                }
+            }
+            return
+        }
+
         let sessionInfo = _session.safeValue
         let spanToFlush: Span? = lock.locked {
             guard let session = sessionInfo.session else { return nil }
@@ -333,6 +381,17 @@ class SessionController: SessionControllable {
 }
 
 extension SessionController {
+    /// Heartbeat still to be persisted at a transition; only ticks recorded in the slot are deferred.
+    private func pendingHeartbeat(_ session: EmbraceSession) -> Date? {
+        heartbeatSlot == nil ? nil : session.lastHeartbeatTime
+    }
+
+    private func setPendingHeartbeat(span: Span, session: EmbraceSession) {
+        if let heartbeat = pendingHeartbeat(session) {
+            SessionSpanUtils.setHeartbeat(span: span, heartbeat: heartbeat)
+        }
+    }
+
     private func save() {
         storage?.save()
     }
@@ -350,6 +409,7 @@ extension SessionController {
         if let sessionId = session.id {
             storage?.deleteSession(id: sessionId)
         }
+        heartbeatSlot?.end()
 
         _session.withLock {
             $0.session = nil
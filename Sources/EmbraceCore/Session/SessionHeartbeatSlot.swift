@@ -0,0 +1,235 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCommonInternal
+#endif
+
+/// Crash-safe record of the running session's liveness, kept in a small memory-mapped file.
+///
+/// The file is mapped with `MAP_SHARED`, so every store lands in a kernel-owned page that outlives the
+/// process: a heartbeat is a single atomic 64-bit store, with no syscall and no database save, and the
+/// last value is still there on the next launch if the app crashes or gets killed.
+///
+/// The session identity and flags only change at session transitions. The identity spans several words,
+/// so it is written under a sequence counter (odd while the write is in progress); a slot left with an
+/// odd counter was torn by a crash and is ignored.
+///
+/// Writers are the `SessionController` (transitions, under its lock) and the heartbeat timer (`beat`).
+final class SessionHeartbeatSlot {
+
+    /// What the slot held for a session that was still running when its process went away.
+    struct Snapshot {
+        let sessionId: EmbraceIdentifier
+        let lastHeartbeat: Date
+        let state: SessionState
+        let appTerminated: Bool
+    }
+
+    /// 64-bit words of the slot file.
+    enum Word: Int, CaseIterable {
+        case magic
+        case sequence
+        case sessionIdHigh
+        case sessionIdLow
+        case heartbeat
+        case flags
+    }
+
+    struct Flags: OptionSet {
+        let rawValue: UInt64
+
+        static let active = Flags(rawValue: 1 << 0)
+        static let background = Flags(rawValue: 1 << 1)
+        static let appTerminated = Flags(rawValue: 1 << 2)
+    }
+
+    /// "EMBHB001"
+    static let magic: UInt64 = 0x454D_4248_4230_3031
+    static let size = 64
+
+    let url: URL
+
+    /// The session that was still active when the previous process stopped, read before this
+    /// instance writes anything. `nil` if that session ended cleanly or the slot is unusable.
+    let recovered: Snapshot?
+
+    private let words: UnsafeMutablePointer<UInt64.CType>
+
+    /// Maps the slot file at `url`, creating it if needed.
+    /// Returns `nil` if the file can't be created or mapped.
+    init?(url: URL) {
+        try? FileManager.default.createDirectory(at: url.deletingLastPathComponent(), withIntermediateDirectories: true)
+
+        let fd = open(url.path, O_RDWR | O_CREAT, 0o644)
+        guard fd >= 0 else {
+            return nil
+        }
+        defer { close(fd) }
+
+        var info = stat()
+        guard fstat(fd, &info) == 0 else {
+            return nil
+        }
+        let isNew = info.st_size < off_t(Self.size)
+        if isNew && ftruncate(fd, off_t(Self.size)) != 0 {
+            return nil
+        }
+
+        // `MAP_FAILED` is a C macro Swift can't import
+        let address = mmap(nil, Self.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+        guard let address, address != UnsafeMutableRawPointer(bitPattern: -1) else {
+            return nil
+        }
+
+        let words = address.bindMemory(to: UInt64.CType.self, capacity: Self.size / MemoryLayout<UInt64>.size)
+
+        if !isNew && UInt64._load(words + Word.magic.rawValue, .acquire) == Self.magic {
+            self.recovered = Self.readSnapshot(words)
+        } else {
+            self.recovered = nil
+        }
+
+        // start from a clean slot, this also drops a torn sequence counter
+        for word in Word.allCases {
+            UInt64._store(words + word.rawValue, 0, .relaxed)
+        }
+        UInt64._store(words + Word.magic.rawValue, Self.magic, .release)
+
+        self.url = url
+        self.words = words
+    }
+
+    deinit {
+        munmap(UnsafeMutableRawPointer(words), Self.size)
+    }
+
+    // MARK: - Transitions
+
+    /// Marks `sessionId` as the running session.
+    func begin(sessionId: EmbraceIdentifier, state: SessionState, heartbeat: Date) {
+        guard let uuid = UUID(withoutHyphen: sessionId.stringValue) else {
+            end()
+            return
+        }
+        let id = uuid.uuid
+        let high = withUnsafeBytes(of: (id.0, id.1, id.2, id.3, id.4, id.5, id.6, id.7)) { $0.loadUnaligned(as: UInt64.self) }
+        let low = withUnsafeBytes(of: (id.8, id.9, id.10, id.11, id.12, id.13, id.14, id.15)) { $0.loadUnaligned(as: UInt64.self) }
+
+        let flags: Flags = state == .background ? [.active, .background] : [.active]
+
+        // → odd: the identity is being rewritten
+        _ = UInt64._fetchAdd(words + Word.sequence.rawValue, 1, .acquireAndRelease)
+
+        store(.sessionIdHigh, high)
+        store(.sessionIdLow, low)
+        store(.heartbeat, UInt64(heartbeat.nanosecondsSince1970Truncated))
+        store(.flags, flags)
+
+        // → even: consistent again
+        _ = UInt64._fetchAdd(words + Word.sequence.rawValue, 1, .release)
+        sync()
+    }
+
+    /// Records a heartbeat for the running session. A single atomic store.
+    func beat(_ date: Date) {
+        UInt64._store(words + Word.heartbeat.rawValue, UInt64(date.nanosecondsSince1970Truncated), .release)
+    }
+
+    func update(state: SessionState) {
+        if state == .background {
+            update(inserting: .background)
+        } else {
+            update(removing: .background)
+        }
+    }
+
+    func update(appTerminated: Bool) {
+        if appTerminated {
+            update(inserting: .appTerminated)
+        } else {
+            update(removing: .appTerminated)
+        }
+    }
+
+    /// Marks the running session as finished; nothing is recovered from the slot afterwards.
+    func end() {
+        store(.flags, [])
+        sync()
+    }
+
+    // MARK: - Private
+
+    private func store(_ word: Word, _ value: UInt64) {
+        UInt64._store(words + word.rawValue, value, .release)
+    }
+
+    private func store(_ word: Word, _ flags: Flags) {
+        store(word, flags.rawValue)
+    }
+
+    private func update(inserting flags: Flags) {
+        modifyFlags { $0.union(flags) }
+    }
+
+    private func update(removing flags: Flags) {
+        modifyFlags { $0.subtracting(flags) }
+    }
+
+    private func modifyFlags(_ transform: (Flags) -> Flags) {
+        let address = words + Word.flags.rawValue
+        var expected = UInt64._load(address, .acquire)
+        while true {
+            let current = Flags(rawValue: expected)
+            guard current.contains(.active) else {
+                return
+            }
+            let desired = transform(current).rawValue
+            if UInt64._compareExchange(address, &expected, desired, .acquireAndRelease, .acquire) {
+                break
+            }
+        }
+        sync()
+    }
+
+    /// Schedules write-back of the page; it survives a process crash regardless, this covers the device going down.
+    private func sync() {
+        msync(UnsafeMutableRawPointer(words), Self.size, MS_ASYNC)
+    }
+
+    private static func readSnapshot(_ words: UnsafeMutablePointer<UInt64.CType>) -> Snapshot? {
+        let sequence = UInt64._load(words + Word.sequence.rawValue, .acquire)
+        guard sequence & 1 == 0 else {
+            // the previous process died while rewriting the identity
+            return nil
+        }
+
+        let flags = Flags(rawValue: UInt64._load(words + Word.flags.rawValue, .acquire))
+        guard flags.contains(.active) else {
+            return nil
+        }
+
+        let high = UInt64._load(words + Word.sessionIdHigh.rawValue, .acquire)
+        let low = UInt64._load(words + Word.sessionIdLow.rawValue, .acquire)
+        let heartbeat = UInt64._load(words + Word.heartbeat.rawValue, .acquire)
+
+        var bytes = [UInt8](repeating: 0, count: 16)
+        withUnsafeBytes(of: high) { bytes.replaceSubrange(0..<8, with: $0) }
+        withUnsafeBytes(of: low) { bytes.replaceSubrange(8..<16, with: $0) }
+        let uuid = UUID(
+            uuid: (
+                bytes[0], bytes[1], bytes[2], bytes[3], bytes[4], bytes[5], bytes[6], bytes[7],
+                bytes[8], bytes[9], bytes[10], bytes[11], bytes[12], bytes[13], bytes[14], bytes[15]
+            ))
+
+        return Snapshot(
+            sessionId: EmbraceIdentifier(value: uuid),
+            lastHeartbeat: Date(timeIntervalSince1970: TimeInterval(heartbeat) / 1_000_000_000),
+            state: flags.contains(.background) ? .background : .foreground,
+            appTerminated: flags.contains(.appTerminated)
+        )
+    }
+}
@@ -40,6 +40,34 @@ struct SessionSpanUtils {
         span?.setAttribute(key: SpanSemantics.Session.keyTerminated, value: terminated)
     }
 
+    /// Adds what `EmbraceSelfMetrics` recorded during the session, one attribute per histogram and counter.
+    static func setSelfMetrics(span: Span?, metrics: EmbraceSelfMetrics.Snapshot) {
+        for histogram in metrics.histograms {
+            let value = [
+                "count=\(histogram.count)",
+                "p50_us=\(histogram.value(atPercentile: 50) / 1000)",
+                "p90_us=\(histogram.value(atPercentile: 90) / 1000)",
+                "p99_us=\(histogram.value(atPercentile: 99) / 1000)",
+                "max_us=\(histogram.max / 1000)"
+            ]
+            span?.setAttribute(key: SpanSemantics.Session.keySdkLatencyPrefix + histogram.name, value: value.joined(separator: ","))
+        }
+
+        for (name, count) in metrics.counters {
+            span?.setAttribute(key: SpanSemantics.Session.keySdkCountPrefix + name, value: Int(count))
+        }
+    }
+
+    /// Adds the memory budget's peak and level during the session, and the data its degradations dropped.
+    static func setMemoryBudget(span: Span?, snapshot: EmbraceMemoryBudget.Snapshot) {
+        span?.setAttribute(key: SpanSemantics.Session.keySdkMemoryPeak, value: snapshot.peakBytes)
+        span?.setAttribute(key: SpanSemantics.Session.keySdkMemoryMaxLevel, value: snapshot.maxLevel.name)
+
+        for (drop, count) in snapshot.drops {
+            span?.setAttribute(key: SpanSemantics.Session.keySdkDroppedPrefix + drop.name, value: count)
+        }
+    }
+
     static func payload(
         from session: EmbraceSession,
         spanData: SpanData? = nil,
@@ -17,6 +17,6 @@ protocol SessionUploader {
 
 class DefaultSessionUploader: SessionUploader {
     func uploadSession(_ session: EmbraceSession, storage: EmbraceStorage, upload: EmbraceUpload) {
-        UnsentDataHandler.sendSession(session, storage: storage, upload: upload)
+        UnsentDataHandler.sendSession(session, storage: storage, upload: upload, snapshotTracker: .shared)
     }
 }
@@ -17,6 +17,10 @@ import SwiftUI
 ///  - Appear and disappear events (when the view enters or leaves the screen)
 ///  - A “RenderLoop” span that groups all child spans in a single render tick
 ///
+/// When given an `EmbraceTraceViewAggregate`, body evaluations, appears and disappears are counted
+/// in it instead, and only the evaluations slower than its outlier threshold get a span.
+/// Use it for views that are re-evaluated often, such as views driven by animations.
+///
 /// If tracing is disabled or the OTel client is unavailable, this view simply forwards
 /// to `content()` without additional overhead (only invokes an empty `onAppear`/`onDisappear`).
 ///
@@ -49,6 +53,7 @@ public struct EmbraceTraceView<Content: View, Value: Equatable>: View {
     private let name: String
     private let attributes: [String: String]?
     private let contentCompleteValue: Value?
+    private let aggregate: EmbraceTraceViewAggregate?
 
     /// Creates a new `EmbraceTraceView` that wraps the given content for tracing.
     ///
@@ -56,17 +61,20 @@ public struct EmbraceTraceView<Content: View, Value: Equatable>: View {
     ///   - viewName: The stable identifier used in trace dashboards (e.g., screen or component name).
     ///   - attributes: Optional metadata to associate with all spans created by this view.
     ///   - contentComplete: Optional value representing the "content complete" state.
+    ///   - aggregate: Optional aggregate to count body evaluations in, instead of creating a span for each one.
     ///   - content: A closure returning the view content to wrap.
     public init(
         _ viewName: String,
         attributes: [String: String]? = nil,
         contentComplete: Value? = nil,
+        aggregate: EmbraceTraceViewAggregate? = nil,
         content: @escaping () -> Content
     ) {
         self.name = viewName
         self.attributes = attributes
         self.content = content
         self.contentCompleteValue = contentComplete
+        self.aggregate = aggregate
 
         // Ensure counters are updated
         if self.state.initialize == 0 {
@@ -83,12 +91,14 @@ public struct EmbraceTraceView<Content: View, Value: Equatable>: View {
     public init(
         _ viewName: String,
         attributes: [String: String]? = nil,
+        aggregate: EmbraceTraceViewAggregate? = nil,
         content: @escaping () -> Content
     ) where Value == Never {
         self.init(
             viewName,
             attributes: attributes,
             contentComplete: nil,
+            aggregate: aggregate,
             content: content
         )
     }
@@ -110,7 +120,7 @@ public struct EmbraceTraceView<Content: View, Value: Equatable>: View {
         state.body += 1
 
         // If no _RenderLoop_ span exists for this render tick, create one.
-        if context.firstCycleSpan == nil {
+        if aggregate == nil && context.firstCycleSpan == nil {
             context.firstCycleSpan = logger.cycledSpan(
                 name,
                 semantics: SpanSemantics.SwiftUIView.renderLoopName,
@@ -123,16 +133,23 @@ public struct EmbraceTraceView<Content: View, Value: Equatable>: View {
             }
         }
 
-        // Start a span for this body evaluation
-        let bodySpan = logger.startSpan(
-            name,
-            semantics: SpanSemantics.SwiftUIView.bodyName,
-            time: startTime,
-            parent: context.firstCycleSpan,
-            attributes: attributes
-        )
+        // Start a span for this body evaluation, unless evaluations are aggregated
+        var bodySpan: Span?
+        if aggregate == nil {
+            bodySpan = logger.startSpan(
+                name,
+                semantics: SpanSemantics.SwiftUIView.bodyName,
+                time: startTime,
+                parent: context.firstCycleSpan,
+                attributes: attributes
+            )
+        }
         defer {
-            logger.endSpan(bodySpan)
+            if let aggregate {
+                recordBody(in: aggregate, startTime: startTime)
+            } else {
+                logger.endSpan(bodySpan)
+            }
         }
 
         // Check for a change in the content complete value
@@ -179,6 +196,11 @@ public struct EmbraceTraceView<Content: View, Value: Equatable>: View {
                     logger.endSpan(span, time: time)
                 }
 
+                if let aggregate {
+                    aggregate.recordAppear(time: time)
+                    return
+                }
+
                 // Create and end an “appear” span for this view
                 logger.cycledSpan(
                     name,
@@ -195,6 +217,11 @@ public struct EmbraceTraceView<Content: View, Value: Equatable>: View {
                 state.disappearTime = time
                 state.disappear += 1
 
+                if let aggregate {
+                    aggregate.recordDisappear(time: time)
+                    return
+                }
+
                 // Create and end a “disappear” span for this view
                 logger.cycledSpan(
                     name,
@@ -205,4 +232,21 @@ public struct EmbraceTraceView<Content: View, Value: Equatable>: View {
                 ) {}
             }
     }
+
+    /// Counts a body evaluation, and creates a span for it only if it's an outlier.
+    private func recordBody(in aggregate: EmbraceTraceViewAggregate, startTime: Date) {
+        let endTime = Date()
+        guard aggregate.recordBody(start: startTime, end: endTime, otel: logger.otel) else {
+            return
+        }
+
+        let span = logger.startSpan(
+            name,
+            semantics: SpanSemantics.SwiftUIView.bodyName,
+            time: startTime,
+            parent: nil,
+            attributes: attributes
+        )
+        logger.endSpan(span, time: endTime)
+    }
 }
@@ -0,0 +1,222 @@
+//
+//  EmbraceTraceViewAggregate.swift
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+import OpenTelemetryApi
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCommonInternal
+    import EmbraceOTelInternal
+    import EmbraceSemantics
+#endif
+
+/// Body evaluation metrics shared by every instance of a traced view.
+///
+/// When an `EmbraceTraceView` has an aggregate, it doesn't create a span per body evaluation, render loop,
+/// appear or disappear. It counts them here instead, along with a histogram of the body evaluation durations,
+/// and a single summary span is created per view when the session ends or every `window`.
+/// Evaluations that take `outlierThreshold` or longer still get their own body span.
+///
+/// `@EmbraceTrace(aggregated: true)` generates one as a static property of the view:
+/// ```swift
+/// @EmbraceTrace(aggregated: true)
+/// struct AnimatedBadge: View {
+///     var body: some View { ... }
+/// }
+/// ```
+///
+/// When wrapping views manually, keep the aggregate in a static property so it's created once:
+/// ```swift
+/// struct AnimatedBadge: View {
+///     static let traceAggregate = EmbraceTraceViewAggregate("AnimatedBadge")
+///
+///     var body: some View {
+///         EmbraceTraceView("AnimatedBadge", aggregate: Self.traceAggregate) { ... }
+///     }
+/// }
+/// ```
+@available(iOS 13, macOS 10.15, tvOS 13, watchOS 6.0, *)
+public final class EmbraceTraceViewAggregate {
+
+    /// Upper bounds of the histogram buckets, in milliseconds. The last bucket has no upper bound.
+    static let bucketBounds: [Double] = [0.25, 0.5, 1, 2, 4, 8, 16, 33, 66]
+
+    struct Counters {
+        var windowStart: Date?
+        var evaluations = 0
+        var totalDuration: TimeInterval = 0
+        var maxDuration: TimeInterval = 0
+        var outliers = 0
+        var appears = 0
+        var disappears = 0
+        var buckets = [Int](repeating: 0, count: EmbraceTraceViewAggregate.bucketBounds.count + 1)
+
+        var isEmpty: Bool {
+            evaluations == 0 && appears == 0 && disappears == 0
+        }
+
+        mutating func reset() {
+            windowStart = nil
+            evaluations = 0
+            totalDuration = 0
+            maxDuration = 0
+            outliers = 0
+            appears = 0
+            disappears = 0
+            for index in buckets.indices {
+                buckets[index] = 0
+            }
+        }
+    }
+
+    let name: String
+    let outlierThreshold: TimeInterval
+    let window: TimeInterval
+
+    let counters = EmbraceMutex(Counters())
+
+    /// Client used to create the summary spans, the last one body evaluations were recorded with.
+    /// Only accessed while holding the `counters` lock.
+    private weak var otel: EmbraceOpenTelemetry?
+
+    /// Creates the aggregate for a view.
+    ///
+    /// - Parameters:
+    ///   - viewName: The name of the view, same as passed to `EmbraceTraceView`.
+    ///   - outlierThreshold: Body evaluations that take this long or longer get their own span. Defaults to one frame at 60 Hz.
+    ///   - window: Maximum time covered by a summary span.
+    public init(_ viewName: String, outlierThreshold: TimeInterval = 0.016, window: TimeInterval = 60) {
+        self.name = viewName
+        self.outlierThreshold = outlierThreshold
+        self.window = window
+
+        EmbraceTraceViewAggregates.shared.register(self)
+    }
+
+    /// Records a body evaluation. Returns `true` if it's an outlier that should get its own span.
+    func recordBody(start: Date, end: Date, otel: EmbraceOpenTelemetry?) -> Bool {
+        let duration = end.timeIntervalSince(start)
+        let milliseconds = duration * 1000
+        let bucket = Self.bucketBounds.firstIndex { milliseconds <= $0 } ?? Self.bucketBounds.count
+
+        let windowEnded = counters.withLock {
+            if let otel {
+                self.otel = otel
+            }
+
+            $0.evaluations += 1
+            $0.totalDuration += duration
+            $0.maxDuration = max($0.maxDuration, duration)
+            $0.buckets[bucket] += 1
+            if duration >= outlierThreshold {
+                $0.outliers += 1
+            }
+
+            if let windowStart = $0.windowStart {
+                return end.timeIntervalSince(windowStart) >= window
+            }
+            $0.windowStart = start
+            return false
+        }
+
+        if windowEnded {
+            flush(time: end)
+        }
+
+        return duration >= outlierThreshold
+    }
+
+    func recordAppear(time: Date) {
+        counters.withLock {
+            $0.appears += 1
+            $0.windowStart = $0.windowStart ?? time
+        }
+    }
+
+    func recordDisappear(time: Date) {
+        counters.withLock {
+            $0.disappears += 1
+            $0.windowStart = $0.windowStart ?? time
+        }
+    }
+
+    /// Creates the summary span for what was recorded since the last flush, and starts over.
+    func flush(time: Date = Date()) {
+        let (snapshot, otel) = counters.withLock { counters -> (Counters?, EmbraceOpenTelemetry?) in
+            guard !counters.isEmpty else {
+                return (nil, nil)
+            }
+            let snapshot = counters
+            counters.reset()
+            return (snapshot, self.otel)
+        }
+
+        guard let snapshot, let otel else {
+            return
+        }
+
+        let histogram = snapshot.buckets.enumerated().map { index, count in
+            let bound = index < Self.bucketBounds.count ? "\(Self.bucketBounds[index])" : "inf"
+            return "\(bound)=\(count)"
+        }
+
+        let builder = otel.buildSpan(
+            name: "emb-swiftui.view.\(name).\(SpanSemantics.SwiftUIView.bodySummaryName)",
+            type: SpanType.viewLoad,
+            attributes: [
+                SpanSemantics.SwiftUIView.keyBodyCount: "\(snapshot.evaluations)",
+                SpanSemantics.SwiftUIView.keyBodyTotalDuration: "\(Int((snapshot.totalDuration * 1000).rounded()))",
+                SpanSemantics.SwiftUIView.keyBodyMaxDuration: String(format: "%.3f", snapshot.maxDuration * 1000),
+                SpanSemantics.SwiftUIView.keyBodyHistogram: histogram.joined(separator: ","),
+                SpanSemantics.SwiftUIView.keyBodyOutlierCount: "\(snapshot.outliers)",
+                SpanSemantics.SwiftUIView.keyAppearCount: "\(snapshot.appears)",
+                SpanSemantics.SwiftUIView.keyDisappearCount: "\(snapshot.disappears)"
+            ],
+            autoTerminationCode: nil
+        )
+        builder.setStartTime(time: snapshot.windowStart ?? time)
+        builder.startSpan().end(time: time)
+    }
+}
+
+/// Every aggregate created so far, so they can all be flushed before a session ends.
+@available(iOS 13, macOS 10.15, tvOS 13, watchOS 6.0, *)
+final class EmbraceTraceViewAggregates {
+
+    static let shared = EmbraceTraceViewAggregates()
+
+    private let aggregates = EmbraceMutex<[EmbraceTraceViewAggregate]>([])
+    private let notificationCenter: NotificationCenter
+    private var sessionObserver: NSObjectProtocol?
+
+    init(notificationCenter: NotificationCenter = .default) {
+        self.notificationCenter = notificationCenter
+
+        // flushed synchronously, so the summaries end up in the session that's ending
+        sessionObserver = notificationCenter.addObserver(
+            forName: .embraceSessionWillEnd,
+            object: nil,
+            queue: nil
+        ) { [weak self] _ in
+            self?.flushAll()
+        }
+    }
+
+    deinit {
+        if let sessionObserver {
+            notificationCenter.removeObserver(sessionObserver)
+        }
+    }
+
+    func register(_ aggregate: EmbraceTraceViewAggregate) {
+        aggregates.withLock { $0.append(aggregate) }
+    }
+
+    func flushAll(time: Date = Date()) {
+        for aggregate in aggregates.safeValue {
+            aggregate.flush(time: time)
+        }
+    }
+}
@@ -4,6 +4,10 @@
 
 import Foundation
 
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCommonInternal
+#endif
+
 struct JSONCodingKeys: CodingKey {
     var stringValue: String
     var intValue: Int?
@@ -163,3 +167,68 @@ extension UnkeyedEncodingContainer {
         try container.encode(value)
     }
 }
+
+extension EmbraceJSONWriter {
+
+    /// Writes a dictionary or array made of the same values `encode(_ value: [String: Any])` accepts.
+    mutating func value(jsonObject value: Any) throws {
+        // special case for booleans, bridged numbers can be cast to `Bool` too
+        if value is Bool, let number = value as? NSNumber, number === kCFBooleanTrue || number === kCFBooleanFalse {
+            self.value(number.boolValue)
+            return
+        }
+
+        switch value {
+        case let value as Int:
+            self.value(value)
+        case let value as Int8:
+            self.value(Int64(value))
+        case let value as Int16:
+            self.value(Int64(value))
+        case let value as Int32:
+            self.value(Int64(value))
+        case let value as Int64:
+            self.value(value)
+        case let value as UInt:
+            self.value(UInt64(value))
+        case let value as UInt8:
+            self.value(UInt64(value))
+        case let value as UInt16:
+            self.value(UInt64(value))
+        case let value as UInt32:
+            self.value(UInt64(value))
+        case let value as UInt64:
+            self.value(value)
+        case let value as Float:
+            try self.value(value)
+        case let value as Double:
+            try self.value(value)
+        case let value as Bool:
+            self.value(value)
+        case let value as String:
+            self.value(value)
+        case let value as [String: Any]:
+            beginObject()
+            for (key, element) in value {
+                self.key(key)
+                try self.value(jsonObject: element)
+            }
+            endObject()
+        case let value as [Any]:
+            beginArray()
+            for element in value {
+                try self.value(jsonObject: element)
+            }
+            endArray()
+        case is NSNull:
+            null()
+        case Optional<Any>.none:
+            null()
+        default:
+            throw EncodingError.invalidValue(
+                value,
+                EncodingError.Context(codingPath: [], debugDescription: "Invalid JSON value")
+            )
+        }
+    }
+}
@@ -0,0 +1,118 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+import zlib
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCommonInternal
+#endif
+
+/// Gzip compressor that takes its input in pieces, so the uncompressed data never has to be in
+/// memory all at once. Produces the same format as `Data.gzipped()`.
+final class GzipStream {
+
+    private static let chunkSize = 1 << 14
+
+    private var stream = z_stream()
+    private let scratch = UnsafeMutablePointer<Bytef>.allocate(capacity: GzipStream.chunkSize)
+    private var output = Data()
+    private var totalIn = 0
+    private let maxInputSize: Int
+
+    init(
+        level: CompressionLevel = .defaultCompression,
+        wBits: Int32 = Gzip.maxWindowBits + 16,
+        maxInputSize: Int = 50 * 1024 * 1024
+    ) throws {
+        self.maxInputSize = maxInputSize
+
+        let status = deflateInit2_(
+            &stream,
+            level.rawValue,
+            Z_DEFLATED,
+            wBits,
+            MAX_MEM_LEVEL,
+            Z_DEFAULT_STRATEGY,
+            ZLIB_VERSION,
+            Int32(MemoryLayout<z_stream>.size)
+        )
+
+        // deinit still runs if this throws, and releases the scratch buffer
+        guard status == Z_OK else {
+            throw GzipError(code: status, msg: stream.msg)
+        }
+    }
+
+    deinit {
+        deflateEnd(&stream)
+        scratch.deallocate()
+    }
+
+    /// Compresses `input`. Like `Data.gzipped()`, fails once the total input exceeds `maxInputSize`.
+    func write(_ input: UnsafeRawBufferPointer) throws {
+        guard !input.isEmpty else {
+            return
+        }
+
+        totalIn += input.count
+        guard totalIn <= maxInputSize else {
+            throw GzipError(code: Z_MEM_ERROR, msg: nil)
+        }
+
+        try compress(input, flush: Z_NO_FLUSH)
+    }
+
+    /// Flushes the remaining input and returns the whole gzip stream.
+    func finish() throws -> Data {
+        guard totalIn > 0 else {
+            return Data()  // same as gzipping empty data
+        }
+
+        let status = try compress(UnsafeRawBufferPointer(start: nil, count: 0), flush: Z_FINISH)
+        guard status == Z_STREAM_END else {
+            throw GzipError(code: status, msg: stream.msg)
+        }
+        return output
+    }
+
+    @discardableResult
+    private func compress(_ input: UnsafeRawBufferPointer, flush: Int32) throws -> Int32 {
+        stream.next_in = UnsafeMutablePointer(mutating: input.bindMemory(to: Bytef.self).baseAddress)
+        stream.avail_in = uInt(input.count)
+        defer { stream.next_in = nil }
+
+        var status: Int32
+        repeat {
+            stream.next_out = scratch
+            stream.avail_out = uInt(Self.chunkSize)
+
+            status = deflate(&stream, flush)
+
+            // Z_BUF_ERROR only means there was nothing to do this round
+            guard status == Z_OK || status == Z_STREAM_END || status == Z_BUF_ERROR else {
+                stream.next_out = nil
+                throw GzipError(code: status, msg: stream.msg)
+            }
+
+            output.append(scratch, count: Self.chunkSize - Int(stream.avail_out))
+        } while stream.avail_out == 0
+
+        stream.next_out = nil
+        return status
+    }
+}
+
+extension EmbraceJSONWritable {
+
+    /// The gzipped JSON representation of this value, compressed while it's being written instead
+    /// of after building the whole uncompressed payload.
+    func gzippedJSON() throws -> Data {
+        let gzip = try GzipStream()
+        var writer = EmbraceJSONWriter { try gzip.write($0) }
+        try writeJSON(to: &writer)
+        try writer.finish()
+        return try gzip.finish()
+    }
+}
@@ -0,0 +1,85 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+// The commit scheduler decides when mutations already applied to a
+// `CoreDataWrapper` context are written to disk. With `.immediate` every
+// mutation saves (one SQLite transaction + fsync each). With `.coalesced`
+// mutations stay in the context and one save covers a whole window or
+// batch of changes. Durability barriers (`CoreDataWrapper.flush`) bypass
+// the scheduler and write whatever is pending right away. The wrapper
+// flushes when the app is backgrounded or about to terminate, and
+// `EmbraceStorage` flushes after every session record change.
+
+extension CoreDataWrapper {
+
+    /// Controls how often changes made through a `CoreDataWrapper` are saved to disk.
+    public enum CommitPolicy: Equatable {
+        /// Every mutation saves its context before returning.
+        case immediate
+
+        /// Mutations are applied to the context immediately but saved in batches:
+        /// once `maxPendingChanges` mutations have accumulated, or `maxDelay` seconds
+        /// after the first unsaved mutation, whichever comes first.
+        case coalesced(maxPendingChanges: Int, maxDelay: TimeInterval)
+
+        /// Default write-behind policy used by the SDK storage.
+        public static let `default`: CommitPolicy = .coalesced(maxPendingChanges: 64, maxDelay: 1.0)
+    }
+}
+
+/// Tracks unsaved mutations for a `CoreDataWrapper` and decides when they must be saved.
+/// - Important: Not thread safe on its own. Every method must be called on the wrapper's context queue.
+final class CoreDataCommitScheduler {
+
+    let policy: CoreDataWrapper.CommitPolicy
+
+    /// Mutations applied to the context since the last save.
+    private(set) var pendingChanges: Int = 0
+
+    /// Whether a deferred commit is already scheduled.
+    private var isArmed: Bool = false
+
+    /// Schedules a deferred commit after the given delay.
+    private let arm: (TimeInterval) -> Void
+
+    init(policy: CoreDataWrapper.CommitPolicy, arm: @escaping (TimeInterval) -> Void) {
+        self.policy = policy
+        self.arm = arm
+    }
+
+    /// Records a mutation.
+    /// - Returns: `true` if the context should be saved right away.
+    func didChange() -> Bool {
+        pendingChanges += 1
+
+        switch policy {
+        case .immediate:
+            return true
+
+        case let .coalesced(maxPendingChanges, maxDelay):
+            if pendingChanges >= max(1, maxPendingChanges) || maxDelay <= 0 {
+                return true
+            }
+            if !isArmed {
+                isArmed = true
+                arm(maxDelay)
+            }
+            return false
+        }
+    }
+
+    /// Called when a scheduled deferred commit fires.
+    /// - Returns: `true` if there are still unsaved mutations to write.
+    func deadlineReached() -> Bool {
+        isArmed = false
+        return pendingChanges > 0
+    }
+
+    /// Called after every save of the context, scheduled or not.
+    func didCommit() {
+        pendingChanges = 0
+    }
+}
@@ -21,14 +21,19 @@ extension CoreDataWrapper {
         /// Array on NSEntityDescriptions that define the db model
         public let entities: [NSEntityDescription]
 
+        /// Determines when mutations are saved to disk
+        public let commitPolicy: CommitPolicy
+
         public init(
             storageMechanism: StorageMechanism,
             enableBackgroundTasks: Bool = true,
-            entities: [NSEntityDescription]
+            entities: [NSEntityDescription],
+            commitPolicy: CommitPolicy = .immediate
         ) {
             self.storageMechanism = storageMechanism
             self.enableBackgroundTasks = enableBackgroundTasks
             self.entities = entities
+            self.commitPolicy = commitPolicy
         }
     }
 }
@@ -22,6 +22,13 @@ public class CoreDataWrapper {
     let logger: InternalLogger
 
     private let workTracker: WorkTracker
+    private var commitScheduler: CoreDataCommitScheduler!
+    private let _saveCount = EmbraceAtomic<Int64>(0)
+
+    /// Number of context saves that reached the persistent store.
+    public var saveCount: Int {
+        Int(_saveCount.load(order: .relaxed))
+    }
 
     private var name: String {
         options.storageMechanism.name
@@ -103,6 +110,16 @@ public class CoreDataWrapper {
         }
 
         context = container.newBackgroundContext()
+
+        commitScheduler = CoreDataCommitScheduler(policy: options.commitPolicy) { [weak self] delay in
+            self?.scheduleDeferredCommit(after: delay)
+        }
+        workTracker.onEnterBackground = { [weak self] in
+            self?.flushAsync()
+        }
+        workTracker.onWillTerminate = { [weak self] in
+            self?.flush(allowMainQueue: true)
+        }
     }
 
     @discardableResult
@@ -130,7 +147,7 @@ public class CoreDataWrapper {
 
     /// Synchronously performs the given block on the current context
     /// behind a background task assertion.
-    /// And automatically save if requested.
+    /// And automatically save if requested, following `options.commitPolicy`.
     /// Note we do not cancel currently any tasks on assertion expiry,
     /// Note don't we care if a task assertion is actually given to us.
     public func performOperation<Result>(
@@ -148,7 +165,7 @@ public class CoreDataWrapper {
         context.performAndWait {
             result = block(context)
             if save {
-                saveIfNeeded()
+                commitIfNeeded()
             }
             workTracker.decrement(name, id: id, afterDebounce: true)
         }
@@ -158,7 +175,7 @@ public class CoreDataWrapper {
 
     /// Asynchronously performs the given block on the current context
     /// behind a background task assertion.
-    /// And automatically save if requested.
+    /// And automatically save if requested, following `options.commitPolicy`.
     public func performAsyncOperation(
         _ name: String = #function, save: Bool = false, _ block: @escaping (NSManagedObjectContext) -> Void
     ) {
@@ -168,21 +185,40 @@ public class CoreDataWrapper {
         cntxt.perform { [self, cntxt] in
             block(cntxt)
             if save {
-                saveIfNeeded()
+                commitIfNeeded()
             }
             workTracker.decrement(name, id: id, afterDebounce: true)
         }
     }
 
-    /// Requests all changes to be saved to disk as soon as possible
+    /// Requests all changes to be saved to disk.
+    /// With a `.coalesced` commit policy the save may be deferred; use `flush` when durability is required.
     public func save(allowMainQueue: Bool = false) {
         performOperation(save: true, allowMainQueue: allowMainQueue) { _ in }
     }
 
-    /// Requests all changes to be saved to disk async
+    /// Requests all changes to be saved to disk async.
+    /// With a `.coalesced` commit policy the save may be deferred; use `flushAsync` when durability is required.
     public func saveAsync() {
         performAsyncOperation(save: true) { _ in }
     }
+
+    /// Durability barrier: synchronously saves every pending change, regardless of the commit policy.
+    /// Can be called from a block passed to `performOperation`.
+    /// - Returns: `false` if the save failed.
+    @discardableResult
+    public func flush(allowMainQueue: Bool = false) -> Bool {
+        performOperation(allowMainQueue: allowMainQueue) { _ in
+            commitNow()
+        }
+    }
+
+    /// Durability barrier: asynchronously saves every pending change, regardless of the commit policy.
+    public func flushAsync() {
+        performAsyncOperation { [self] _ in
+            commitNow()
+        }
+    }
 }
 
 // MARK: - Fetch
@@ -287,12 +323,118 @@ extension CoreDataWrapper {
     }
 }
 
+// MARK: - Batch deletion
+
+extension CoreDataWrapper {
+    /// Synchronously deletes the records that satisfy the given request without loading them into the context.
+    ///
+    /// On SQLite stores this runs as a single `NSBatchDeleteRequest`; objects already registered in the
+    /// context are merged as deleted. Batch requests are not available for in-memory stores, where the
+    /// records are fetched as property-less faults instead, so their attribute values (and blobs) are never read.
+    /// - Note: Batch deletes don't process delete rules, delete dependent records first.
+    /// - Returns: The number of deleted records.
+    @discardableResult
+    public func batchDeleteRecords<T>(withRequest request: NSFetchRequest<T>) -> Int where T: NSManagedObject {
+        guard let entityName = request.entityName else {
+            return 0
+        }
+
+        return performOperation { context in
+            // pending changes must reach the store, otherwise the store-level delete can't see them
+            commitNow()
+
+            do {
+                let idsRequest = NSFetchRequest<NSManagedObjectID>(entityName: entityName)
+                idsRequest.resultType = .managedObjectIDResultType
+                idsRequest.predicate = request.predicate
+                idsRequest.sortDescriptors = request.sortDescriptors
+                idsRequest.fetchLimit = request.fetchLimit
+
+                guard supportsBatchRequests else {
+                    let ids = try context.fetch(idsRequest)
+                    for id in ids {
+                        context.delete(context.object(with: id))
+                    }
+                    commitNow()
+                    return ids.count
+                }
+
+                let deleteRequest: NSBatchDeleteRequest
+                if request.fetchLimit > 0 {
+                    // batch deletes ignore fetch limits, resolve which records go first
+                    let ids = try context.fetch(idsRequest)
+                    guard ids.isEmpty == false else {
+                        return 0
+                    }
+                    deleteRequest = NSBatchDeleteRequest(objectIDs: ids)
+                } else {
+                    let fetchRequest = NSFetchRequest<NSFetchRequestResult>(entityName: entityName)
+                    fetchRequest.predicate = request.predicate
+                    deleteRequest = NSBatchDeleteRequest(fetchRequest: fetchRequest)
+                }
+                deleteRequest.resultType = .resultTypeObjectIDs
+
+                let result = try context.execute(deleteRequest) as? NSBatchDeleteResult
+                let ids = result?.result as? [NSManagedObjectID] ?? []
+                if ids.isEmpty == false {
+                    NSManagedObjectContext.mergeChanges(fromRemoteContextSave: [NSDeletedObjectsKey: ids], into: [context])
+                }
+                return ids.count
+            } catch {
+                logger.critical("Error batch deleting records:\n\(error.localizedDescription)")
+            }
+            return 0
+        }
+    }
+
+    private var supportsBatchRequests: Bool {
+        let stores = container.persistentStoreCoordinator.persistentStores
+        return stores.isEmpty == false && stores.allSatisfy { $0.type == NSSQLiteStoreType }
+    }
+}
+
 // MARK: - Internal saves
 
 extension CoreDataWrapper {
 
+    /// Records a mutation and saves if the commit policy requires it.
+    /// Must be called on the context queue.
+    private func commitIfNeeded() {
+        if commitScheduler.didChange() {
+            saveIfNeeded()
+        }
+    }
+
+    /// Saves regardless of the commit policy.
+    /// Must be called on the context queue.
+    @discardableResult
+    private func commitNow() -> Bool {
+        saveIfNeeded()
+    }
+
+    /// Saves the changes accumulated under a `.coalesced` policy once its window closes.
+    /// Keeps the work tracker busy meanwhile so backgrounding holds a task assertion until it runs.
+    private func scheduleDeferredCommit(after delay: TimeInterval) {
+        let id = workTracker.increment("deferredCommit")
+        workTracker.queue.asyncAfter(deadline: .now() + delay) { [weak self] in
+            guard let self, let context = self.context else {
+                return
+            }
+            context.perform { [self] in
+                if commitScheduler.deadlineReached() {
+                    saveIfNeeded()
+                }
+                workTracker.decrement("deferredCommit", id: id, afterDebounce: false)
+            }
+        }
+    }
+
+    /// Must be called on the context queue, it also resets the commit scheduler.
     @discardableResult
-    package func saveIfNeeded() -> Bool {
+    private func saveIfNeeded() -> Bool {
+
+        // any save covers every pending mutation
+        commitScheduler.didCommit()
 
         guard context.hasChanges else {
             return true
@@ -317,6 +459,8 @@ extension CoreDataWrapper {
             )
             return false
         }
+
+        _saveCount += 1
         return true
 
     }
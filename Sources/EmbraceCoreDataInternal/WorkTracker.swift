@@ -27,8 +27,15 @@ internal class WorkTracker {
     let name: String
     let logger: InternalLogger
     var observer: NSObjectProtocol?
+    var terminateObserver: NSObjectProtocol?
     let queue: DispatchQueue
 
+    /// Called when the app is backgrounded, while the background task assertion is held.
+    var onEnterBackground: (() -> Void)?
+
+    /// Called on the main thread when the app is about to terminate. Anything left for later is lost after it returns.
+    var onWillTerminate: (() -> Void)?
+
     struct BusyData {
         var liveIDs: Set<WorkTrackerID> = Set()
         var currentID: WorkTrackerID = 1
@@ -48,6 +55,11 @@ internal class WorkTracker {
             ) { [weak self] _ in
                 self?.didEnterBackground()
             }
+            self.terminateObserver = NotificationCenter.default.addObserver(
+                forName: UIApplication.willTerminateNotification, object: nil, queue: nil
+            ) { [weak self] _ in
+                self?.onWillTerminate?()
+            }
         #elseif os(watchOS)
             if #available(watchOS 7.0, *) {
                 self.observer = NotificationCenter.default.addObserver(
@@ -63,6 +75,9 @@ internal class WorkTracker {
         if let observer {
             NotificationCenter.default.removeObserver(observer)
         }
+        if let terminateObserver {
+            NotificationCenter.default.removeObserver(terminateObserver)
+        }
     }
 
     public func increment(_ label: String = #function) -> WorkTrackerID {
@@ -134,6 +149,7 @@ internal class WorkTracker {
         // sure all our core data work has time to finish.
         let task = BackgroundTaskAssertion(name: "embrace.coredata.background.\(name)", logger: logger)
         let id = increment()
+        onEnterBackground?()
         onIdle {
             task?.finish()
         }
@@ -105,6 +105,35 @@
                 throw EmbraceMacroError.noBody
             }
 
+            // The argument has to be known while expanding. The error fails the build,
+            // so there's no point in generating members that would go unused.
+            guard var aggregated = aggregatedArgument(node, in: context) else {
+                return []
+            }
+
+            // Aggregated views share a static aggregate, which generic types can't have
+            if aggregated && structDecl.genericParameterClause != nil {
+                context.diagnose(
+                    Diagnostic(
+                        node: node,
+                        message: EmbraceTraceDiagnostic(
+                            message: "Generic views can't be aggregated, a span is created for each body evaluation instead",
+                            severity: .warning
+                        )))
+                aggregated = false
+            }
+
+            let viewName = structDecl.name.text
+            let aggregateDeclaration =
+                aggregated
+                ? """
+
+                /// Body evaluation metrics shared by every instance of this view.
+                private static let _embraceTraceAggregate = EmbraceTraceViewAggregate("\(viewName)")
+
+                """ : ""
+            let aggregateArgument = aggregated ? ", aggregate: Self._embraceTraceAggregate" : ""
+
             // Construct the injected declarations: original body, container view, and traced body
             let syntax = DeclSyntax(
                 """
@@ -125,7 +154,7 @@
                     // `body`, so duplicate it here.
                 \(raw: declaration.description)
                 }
-
+                \(raw: aggregateDeclaration)
                 /// A container view that wraps the original body implementation.
                 ///
                 /// This internal container provides a clean way to reference the original
@@ -156,7 +185,7 @@
                 @inline(never)
                 @ViewBuilder
                 var _embraceTracedBody: Self.Body {
-                    EmbraceTraceView(\"\(raw: structDecl.name.text)\") {
+                    EmbraceTraceView(\"\(raw: viewName)\"\(raw: aggregateArgument)) {
                         _EmbraceBodyContainer(view: self)
                     }
                 }
@@ -169,6 +198,24 @@
                 DeclSyntax(syntax)
             ]
         }
+
+        /// Value of the `aggregated:` argument, `false` when it's missing.
+        /// Returns `nil` after diagnosing an argument that isn't a boolean literal.
+        private static func aggregatedArgument(_ node: AttributeSyntax, in context: some MacroExpansionContext) -> Bool? {
+            guard let argument = node.arguments?.as(LabeledExprListSyntax.self)?.first(where: { $0.label?.text == "aggregated" }) else {
+                return false
+            }
+
+            guard let literal = argument.expression.as(BooleanLiteralExprSyntax.self) else {
+                context.diagnose(
+                    Diagnostic(
+                        node: argument.expression,
+                        message: EmbraceTraceDiagnostic(message: "`aggregated` must be a `true` or `false` literal to use EmbraceTrace")))
+                return nil
+            }
+
+            return literal.literal.tokenKind == .keyword(.true)
+        }
     }
 
     /// A helper type conforming to `DiagnosticMessage` for EmbraceTraceMacro.
@@ -186,7 +233,7 @@
             MessageID(domain: "EmbraceTraceDiagnostic", id: "EmbraceTraceError")
         }
 
-        /// The severity level of this diagnostic, always set to error
-        var severity: DiagnosticSeverity { .error }
+        /// The severity level of this diagnostic, error unless specified otherwise
+        var severity: DiagnosticSeverity = .error
     }
 #endif
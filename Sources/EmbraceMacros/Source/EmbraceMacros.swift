@@ -47,6 +47,23 @@
 /// }
 /// ```
 ///
+/// ### Frequently Updated Views
+/// Views that are re-evaluated many times per second, such as views driven by animations,
+/// can aggregate their body evaluations instead of creating a span for each one:
+/// ```swift
+/// @EmbraceTrace(aggregated: true)
+/// struct ProgressRing: View {
+///     var progress: Double
+///
+///     var body: some View {
+///         Circle().trim(from: 0, to: progress).stroke(lineWidth: 4)
+///     }
+/// }
+/// ```
+/// The macro generates a static ``EmbraceTraceViewAggregate`` for the view. A summary span is created
+/// per view when the session ends, and only the evaluations slower than a frame get their own span.
+/// Generic views can't have static stored properties, so they keep creating a span per evaluation.
+///
 /// ### With Custom View Names
 /// The macro automatically derives the view name from the struct name, but you can
 /// customize it using the manual `embraceTrace` modifier if needed:
@@ -147,7 +164,7 @@
 /// ## Considerations
 ///
 /// ### Performance Considerations
-/// - Avoid applying to very frequently updated views (animations, timers)
+/// - Use `@EmbraceTrace(aggregated: true)` for very frequently updated views (animations, timers)
 /// - Consider the overhead when tracing large numbers of simple views
 /// - Use sampling or conditional tracing for high-frequency scenarios
 ///
@@ -179,7 +196,7 @@
 @_exported import EmbraceCore
 
 @attached(member, names: arbitrary)
-public macro EmbraceTrace() =
+public macro EmbraceTrace(aggregated: Bool = false) =
     #externalMacro(
         module: "EmbraceMacroPlugin",
         type: "EmbraceTraceMacro"
@@ -16,6 +16,9 @@ package class EmbraceSpanProcessor: SpanProcessor {
 
     let nameLengthLimit = 128
 
+    /// Rough size of a span waiting to be exported, for the memory budget.
+    static let estimatedSpanSize = 1024
+
     let spanProcessors: [SpanProcessor]
     let embraceExporter: StorageSpanExporter?
     let spanExporters: [SpanExporter]
@@ -267,7 +270,12 @@ package class EmbraceSpanProcessor: SpanProcessor {
                 block()
             }
         } else {
+            // spans waiting for the processor queue count against the SDK's memory budget
+            let size = spans.count * Self.estimatedSpanSize
+            EmbraceMemoryBudget.shared.track(size, for: .spanProcessor)
+
             processorQueue.async { [self] in
+                defer { EmbraceMemoryBudget.shared.release(size, for: .spanProcessor) }
                 criticalResourceGroup?.wait()
                 block()
             }
@@ -0,0 +1,168 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if canImport(SQLite3)
+    import SQLite3
+#else
+    import CSQLite
+#endif
+
+/// A single SQLite connection with a prepared statement cache.
+///
+/// The connection is opened in multi-thread mode (no SQLite-level mutex); callers serialize access
+/// through `withLock(_:)` / `transaction(_:)`, which also keeps a cached statement from being
+/// used by two threads at once.
+public final class SQLiteConnection {
+
+    public enum Location: Equatable {
+        case inMemory
+        case file(URL)
+    }
+
+    public let location: Location
+
+    /// Statements with different SQL beyond this count evict the cache. The engine only uses a
+    /// small fixed set of statements plus a few multi-row insert shapes, so this is rarely hit.
+    public var statementCacheLimit: Int = 64
+
+    private let db: OpaquePointer
+    private let lock = NSRecursiveLock()
+    private var statements: [String: SQLiteStatement] = [:]
+    private var transactionDepth = 0
+
+    /// - Parameters:
+    ///   - location: Where the database lives. File databases are created if needed.
+    ///   - walEnabled: Enables write-ahead logging for file databases (ignored in memory).
+    public init(location: Location, walEnabled: Bool = true) throws {
+        self.location = location
+
+        let path: String
+        switch location {
+        case .inMemory:
+            path = ":memory:"
+        case .file(let url):
+            try? FileManager.default.createDirectory(
+                at: url.deletingLastPathComponent(),
+                withIntermediateDirectories: true
+            )
+            path = url.path
+        }
+
+        var handle: OpaquePointer?
+        let flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX
+        let code = sqlite3_open_v2(path, &handle, flags, nil)
+        guard code == SQLITE_OK, let handle else {
+            let message = handle.map { String(cString: sqlite3_errmsg($0)) } ?? "out of memory"
+            sqlite3_close_v2(handle)
+            throw SQLiteError.cannotOpen(code: code, message: message)
+        }
+        self.db = handle
+
+        sqlite3_busy_timeout(db, 5000)
+
+        if case .file = location, walEnabled {
+            // WAL: readers don't block the writer and commits append instead of rewriting pages.
+            // NORMAL is durable across app crashes in WAL mode; only power loss can drop the last commits.
+            try execute("PRAGMA journal_mode = WAL; PRAGMA synchronous = NORMAL;")
+        }
+        try execute("PRAGMA foreign_keys = ON;")
+    }
+
+    deinit {
+        statements.removeAll()
+        sqlite3_close_v2(db)
+    }
+
+    // MARK: - Locking
+
+    /// Runs `body` with exclusive access to the connection. Reentrant.
+    public func withLock<T>(_ body: () throws -> T) rethrows -> T {
+        lock.lock()
+        defer { lock.unlock() }
+        return try body()
+    }
+
+    /// Runs `body` inside a transaction, committing if it returns and rolling back if it throws.
+    /// Nested calls join the outermost transaction.
+    public func transaction<T>(_ body: () throws -> T) throws -> T {
+        try withLock {
+            if transactionDepth > 0 {
+                transactionDepth += 1
+                defer { transactionDepth -= 1 }
+                return try body()
+            }
+
+            try execute("BEGIN IMMEDIATE;")
+            transactionDepth = 1
+            defer { transactionDepth = 0 }
+
+            do {
+                let result = try body()
+                try execute("COMMIT;")
+                return result
+            } catch {
+                try? execute("ROLLBACK;")
+                throw error
+            }
+        }
+    }
+
+    // MARK: - Statements
+
+    /// Returns the cached prepared statement for `sql`, preparing it on first use.
+    /// - Important: Must be called while holding the lock.
+    public func statement(_ sql: String) throws -> SQLiteStatement {
+        if let statement = statements[sql] {
+            return statement
+        }
+
+        if statements.count >= statementCacheLimit {
+            statements.removeAll(keepingCapacity: true)
+        }
+
+        let statement = try SQLiteStatement(sql: sql, db: db)
+        statements[sql] = statement
+        return statement
+    }
+
+    /// Number of statements currently prepared and cached.
+    public var cachedStatementCount: Int {
+        withLock { statements.count }
+    }
+
+    /// Runs one or more SQL statements that don't return rows and don't take parameters.
+    public func execute(_ sql: String) throws {
+        try withLock {
+            var error: UnsafeMutablePointer<CChar>?
+            let code = sqlite3_exec(db, sql, nil, nil, &error)
+            guard code == SQLITE_OK else {
+                let message = error.map { String(cString: $0) } ?? String(cString: sqlite3_errmsg(db))
+                sqlite3_free(error)
+                throw SQLiteError.cannotExecute(code: code, message: message)
+            }
+        }
+    }
+
+    /// Rows modified by the most recent INSERT, UPDATE or DELETE.
+    public var changes: Int {
+        withLock { Int(sqlite3_changes(db)) }
+    }
+
+    /// Current journal mode, as reported by SQLite (e.g. "wal", "memory", "delete").
+    public var journalMode: String {
+        (try? withLock { try statement("PRAGMA journal_mode;").first { $0.string(0) } }) ?? ""
+    }
+
+    /// Schema version stored in the database header.
+    public var userVersion: Int {
+        get {
+            (try? withLock { try statement("PRAGMA user_version;").first { $0.int(0) } }) ?? 0
+        }
+        set {
+            try? execute("PRAGMA user_version = \(newValue);")
+        }
+    }
+}
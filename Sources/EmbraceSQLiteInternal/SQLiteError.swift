@@ -0,0 +1,65 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+public enum SQLiteError: Error, Equatable {
+    case cannotOpen(code: Int32, message: String)
+    case cannotPrepare(code: Int32, message: String, sql: String)
+    case cannotBind(code: Int32, message: String)
+    case cannotStep(code: Int32, message: String)
+    case cannotExecute(code: Int32, message: String)
+}
+
+extension SQLiteError: LocalizedError, CustomNSError {
+    public static var errorDomain: String {
+        return "Embrace"
+    }
+
+    public var errorCode: Int {
+        switch self {
+        case .cannotOpen:
+            return -1
+        case .cannotPrepare:
+            return -2
+        case .cannotBind:
+            return -3
+        case .cannotStep:
+            return -4
+        case .cannotExecute:
+            return -5
+        }
+    }
+
+    /// Underlying SQLite result code.
+    public var resultCode: Int32 {
+        switch self {
+        case .cannotOpen(let code, _),
+            .cannotPrepare(let code, _, _),
+            .cannotBind(let code, _),
+            .cannotStep(let code, _),
+            .cannotExecute(let code, _):
+            return code
+        }
+    }
+
+    public var errorDescription: String? {
+        switch self {
+        case .cannotOpen(let code, let message):
+            return "Failed to open database (\(code)): \(message)"
+        case .cannotPrepare(let code, let message, let sql):
+            return "Failed to prepare `\(sql)` (\(code)): \(message)"
+        case .cannotBind(let code, let message):
+            return "Failed to bind value (\(code)): \(message)"
+        case .cannotStep(let code, let message):
+            return "Failed to step statement (\(code)): \(message)"
+        case .cannotExecute(let code, let message):
+            return "Failed to execute statement (\(code)): \(message)"
+        }
+    }
+
+    public var localizedDescription: String {
+        return self.errorDescription ?? "No Matching Error"
+    }
+}
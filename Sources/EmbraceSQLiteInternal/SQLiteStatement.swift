@@ -0,0 +1,206 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if canImport(SQLite3)
+    import SQLite3
+#else
+    import CSQLite
+#endif
+
+/// `SQLITE_TRANSIENT` is a macro and isn't imported into Swift.
+let SQLITE_TRANSIENT = unsafeBitCast(-1, to: sqlite3_destructor_type.self)
+
+/// A value bound to a statement parameter.
+public enum SQLiteValue: Equatable {
+    case null
+    case integer(Int64)
+    case real(Double)
+    case text(String)
+    case blob(Data)
+
+    public init(_ value: String?) {
+        self = value.map { .text($0) } ?? .null
+    }
+
+    public init(_ value: Int) {
+        self = .integer(Int64(value))
+    }
+
+    public init(_ value: Bool) {
+        self = .integer(value ? 1 : 0)
+    }
+
+    /// Dates are stored as seconds since the reference date (as Core Data does), so they round-trip exactly.
+    public init(_ value: Date?) {
+        self = value.map { .real($0.timeIntervalSinceReferenceDate) } ?? .null
+    }
+}
+
+/// A prepared statement. Statements are owned and cached by their `SQLiteConnection` and must only
+/// be used while holding the connection's lock.
+public final class SQLiteStatement {
+
+    public let sql: String
+
+    let handle: OpaquePointer
+    private let db: OpaquePointer
+
+    init(sql: String, db: OpaquePointer) throws {
+        var handle: OpaquePointer?
+        let code = sqlite3_prepare_v3(db, sql, -1, UInt32(SQLITE_PREPARE_PERSISTENT), &handle, nil)
+        guard code == SQLITE_OK, let handle else {
+            sqlite3_finalize(handle)
+            throw SQLiteError.cannotPrepare(code: code, message: String(cString: sqlite3_errmsg(db)), sql: sql)
+        }
+
+        self.sql = sql
+        self.handle = handle
+        self.db = db
+    }
+
+    deinit {
+        sqlite3_finalize(handle)
+    }
+
+    // MARK: - Binding
+
+    /// Binds `values` to parameters `1...values.count`.
+    public func bind(_ values: [SQLiteValue]) throws {
+        for (offset, value) in values.enumerated() {
+            try bind(value, at: Int32(offset + 1))
+        }
+    }
+
+    public func bind(_ value: SQLiteValue, at index: Int32) throws {
+        let code: Int32
+        switch value {
+        case .null:
+            code = sqlite3_bind_null(handle, index)
+        case .integer(let int):
+            code = sqlite3_bind_int64(handle, index, int)
+        case .real(let double):
+            code = sqlite3_bind_double(handle, index, double)
+        case .text(let string):
+            code = sqlite3_bind_text(handle, index, string, -1, SQLITE_TRANSIENT)
+        case .blob(let data):
+            if data.isEmpty {
+                code = sqlite3_bind_zeroblob(handle, index, 0)
+            } else {
+                code = data.withUnsafeBytes {
+                    sqlite3_bind_blob(handle, index, $0.baseAddress, Int32($0.count), SQLITE_TRANSIENT)
+                }
+            }
+        }
+
+        guard code == SQLITE_OK else {
+            throw SQLiteError.cannotBind(code: code, message: String(cString: sqlite3_errmsg(db)))
+        }
+    }
+
+    // MARK: - Execution
+
+    /// Advances the statement.
+    /// - Returns: `true` if a row is available, `false` once the statement is done.
+    public func step() throws -> Bool {
+        let code = sqlite3_step(handle)
+        switch code {
+        case SQLITE_ROW:
+            return true
+        case SQLITE_DONE:
+            return false
+        default:
+            throw SQLiteError.cannotStep(code: code, message: String(cString: sqlite3_errmsg(db)))
+        }
+    }
+
+    /// Clears the bindings and rewinds the statement so it can be reused.
+    public func reset() {
+        sqlite3_reset(handle)
+        sqlite3_clear_bindings(handle)
+    }
+
+    /// Binds `values`, runs the statement to completion and resets it.
+    public func run(_ values: [SQLiteValue] = []) throws {
+        defer { reset() }
+        try bind(values)
+        while try step() {}
+    }
+
+    /// Binds `values` and calls `body` for every result row, without materializing the result set.
+    /// Return `false` from `body` to stop early. The row is only valid inside `body`.
+    public func forEachRow(_ values: [SQLiteValue] = [], _ body: (SQLiteRow) throws -> Bool) throws {
+        defer { reset() }
+        try bind(values)
+        let row = SQLiteRow(handle: handle)
+        while try step() {
+            guard try body(row) else {
+                return
+            }
+        }
+    }
+
+    /// Binds `values` and returns the first row mapped through `transform`, if any.
+    public func first<T>(_ values: [SQLiteValue] = [], _ transform: (SQLiteRow) throws -> T) throws -> T? {
+        var result: T?
+        try forEachRow(values) {
+            result = try transform($0)
+            return false
+        }
+        return result
+    }
+}
+
+/// Column accessors for the current row of a statement. Indices are 0-based.
+public struct SQLiteRow {
+    let handle: OpaquePointer
+
+    public func isNull(_ index: Int32) -> Bool {
+        return sqlite3_column_type(handle, index) == SQLITE_NULL
+    }
+
+    public func int64(_ index: Int32) -> Int64 {
+        return sqlite3_column_int64(handle, index)
+    }
+
+    public func int(_ index: Int32) -> Int {
+        return Int(sqlite3_column_int64(handle, index))
+    }
+
+    public func bool(_ index: Int32) -> Bool {
+        return sqlite3_column_int64(handle, index) != 0
+    }
+
+    public func double(_ index: Int32) -> Double {
+        return sqlite3_column_double(handle, index)
+    }
+
+    public func string(_ index: Int32) -> String {
+        guard let text = sqlite3_column_text(handle, index) else {
+            return ""
+        }
+        return String(cString: text)
+    }
+
+    public func optionalString(_ index: Int32) -> String? {
+        return isNull(index) ? nil : string(index)
+    }
+
+    public func data(_ index: Int32) -> Data {
+        let count = Int(sqlite3_column_bytes(handle, index))
+        guard count > 0, let bytes = sqlite3_column_blob(handle, index) else {
+            return Data()
+        }
+        return Data(bytes: bytes, count: count)
+    }
+
+    public func date(_ index: Int32) -> Date {
+        return Date(timeIntervalSinceReferenceDate: sqlite3_column_double(handle, index))
+    }
+
+    public func optionalDate(_ index: Int32) -> Date? {
+        return isNull(index) ? nil : date(index)
+    }
+}
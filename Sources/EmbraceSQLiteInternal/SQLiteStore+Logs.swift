@@ -0,0 +1,130 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+public struct SQLiteLogRow: Equatable {
+    public struct Attribute: Codable, Equatable {
+        public var key: String
+        public var value: String
+        public var type: Int
+
+        public init(key: String, value: String, type: Int) {
+            self.key = key
+            self.value = value
+            self.type = type
+        }
+    }
+
+    public var id: String
+    public var processId: String
+    public var sessionId: String?
+    public var severity: Int
+    public var body: String
+    public var timestamp: Date
+    public var attributes: [Attribute]
+
+    public init(
+        id: String,
+        processId: String,
+        sessionId: String? = nil,
+        severity: Int,
+        body: String,
+        timestamp: Date,
+        attributes: [Attribute] = []
+    ) {
+        self.id = id
+        self.processId = processId
+        self.sessionId = sessionId
+        self.severity = severity
+        self.body = body
+        self.timestamp = timestamp
+        self.attributes = attributes
+    }
+}
+
+extension SQLiteStore {
+
+    private static let logColumns = ["id", "process_id", "session_id", "severity", "body", "timestamp", "attributes"]
+
+    private static let logSelect = "SELECT \(logColumns.joined(separator: ", ")) FROM logs"
+
+    /// Inserts the given logs with multi-row statements. Logs already stored are left untouched.
+    public func insertLogs(_ logs: [SQLiteLogRow]) throws {
+        let rows: [[SQLiteValue]] = try connection.withLock {
+            try logs.map {
+                [
+                    .text($0.id),
+                    .text($0.processId),
+                    SQLiteValue($0.sessionId),
+                    SQLiteValue($0.severity),
+                    .text($0.body),
+                    SQLiteValue($0.timestamp),
+                    .blob(try encoder.encode($0.attributes))
+                ]
+            }
+        }
+
+        try insert(
+            into: "logs",
+            columns: Self.logColumns,
+            suffix: "ON CONFLICT (id, process_id) DO NOTHING",
+            rows: rows
+        )
+    }
+
+    /// Streams all logs not created by `processId`, oldest first. Return `false` from `body` to stop.
+    public func forEachLog(excludingProcessId processId: String, _ body: (SQLiteLogRow) throws -> Bool) throws {
+        try connection.withLock {
+            try connection.statement(Self.logSelect + " WHERE process_id != ? ORDER BY timestamp ASC")
+                .forEachRow([.text(processId)]) {
+                    try body(logRow(from: $0))
+                }
+        }
+    }
+
+    /// Deletes the logs with the given identifiers.
+    /// - Returns: Number of logs deleted.
+    @discardableResult
+    public func deleteLogs(_ keys: [(id: String, processId: String)]) throws -> Int {
+        guard !keys.isEmpty else {
+            return 0
+        }
+
+        return try connection.transaction {
+            let statement = try connection.statement("DELETE FROM logs WHERE id = ? AND process_id = ?")
+            var deleted = 0
+            for key in keys {
+                try statement.run([.text(key.id), .text(key.processId)])
+                deleted += connection.changes
+            }
+            return deleted
+        }
+    }
+
+    @discardableResult
+    public func deleteAllLogs() throws -> Int {
+        try run("DELETE FROM logs")
+    }
+
+    public func logCount() throws -> Int {
+        try connection.withLock {
+            try connection.statement("SELECT COUNT(*) FROM logs").first { $0.int(0) } ?? 0
+        }
+    }
+
+    // MARK: - Mapping
+
+    private func logRow(from row: SQLiteRow) -> SQLiteLogRow {
+        return SQLiteLogRow(
+            id: row.string(0),
+            processId: row.string(1),
+            sessionId: row.optionalString(2),
+            severity: row.int(3),
+            body: row.string(4),
+            timestamp: row.date(5),
+            attributes: (try? decoder.decode([SQLiteLogRow.Attribute].self, from: row.data(6))) ?? []
+        )
+    }
+}
@@ -0,0 +1,181 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+public struct SQLiteSessionRow: Equatable {
+    public var id: String
+    public var processId: String
+    public var state: String
+    public var traceId: String
+    public var spanId: String
+    public var startTime: Date
+    public var endTime: Date?
+    public var lastHeartbeatTime: Date
+    public var crashReportId: String?
+    public var coldStart: Bool
+    public var cleanExit: Bool
+    public var appTerminated: Bool
+    public var sessionNumber: Int
+
+    public init(
+        id: String,
+        processId: String,
+        state: String,
+        traceId: String,
+        spanId: String,
+        startTime: Date,
+        endTime: Date? = nil,
+        lastHeartbeatTime: Date,
+        crashReportId: String? = nil,
+        coldStart: Bool = false,
+        cleanExit: Bool = false,
+        appTerminated: Bool = false,
+        sessionNumber: Int = 0
+    ) {
+        self.id = id
+        self.processId = processId
+        self.state = state
+        self.traceId = traceId
+        self.spanId = spanId
+        self.startTime = startTime
+        self.endTime = endTime
+        self.lastHeartbeatTime = lastHeartbeatTime
+        self.crashReportId = crashReportId
+        self.coldStart = coldStart
+        self.cleanExit = cleanExit
+        self.appTerminated = appTerminated
+        self.sessionNumber = sessionNumber
+    }
+}
+
+extension SQLiteStore {
+
+    private static let sessionColumns = [
+        "id", "process_id", "state", "trace_id", "span_id", "start_time", "end_time", "last_heartbeat_time",
+        "crash_report_id", "cold_start", "clean_exit", "app_terminated", "session_number"
+    ]
+
+    private static let sessionSelect = "SELECT \(sessionColumns.joined(separator: ", ")) FROM sessions"
+
+    /// Inserts the session. A session already stored with the same identifier is left untouched.
+    public func insertSession(_ session: SQLiteSessionRow) throws {
+        try insert(
+            into: "sessions",
+            columns: Self.sessionColumns,
+            suffix: "ON CONFLICT (id) DO NOTHING",
+            rows: [Self.values(for: session)]
+        )
+    }
+
+    public func session(id: String) throws -> SQLiteSessionRow? {
+        try connection.withLock {
+            try connection.statement(Self.sessionSelect + " WHERE id = ?")
+                .first([.text(id)], Self.sessionRow(from:))
+        }
+    }
+
+    /// Newest session by start time, optionally ignoring the session with the given identifier.
+    public func latestSession(excludingId id: String? = nil) throws -> SQLiteSessionRow? {
+        try connection.withLock {
+            try connection.statement(Self.sessionSelect + " WHERE id IS NOT ? ORDER BY start_time DESC LIMIT 1")
+                .first([SQLiteValue(id)], Self.sessionRow(from:))
+        }
+    }
+
+    /// Oldest session by start time, optionally ignoring the session with the given identifier.
+    public func oldestSession(excludingId id: String? = nil) throws -> SQLiteSessionRow? {
+        try connection.withLock {
+            try connection.statement(Self.sessionSelect + " WHERE id IS NOT ? ORDER BY start_time ASC LIMIT 1")
+                .first([SQLiteValue(id)], Self.sessionRow(from:))
+        }
+    }
+
+    /// Streams every stored session. Return `false` from `body` to stop.
+    public func forEachSession(_ body: (SQLiteSessionRow) throws -> Bool) throws {
+        try connection.withLock {
+            try connection.statement(Self.sessionSelect).forEachRow {
+                try body(Self.sessionRow(from: $0))
+            }
+        }
+    }
+
+    /// Updates the given fields of a session in a single statement. `nil` leaves a field unchanged.
+    /// - Returns: `true` if the session exists.
+    @discardableResult
+    public func updateSession(
+        id: String,
+        state: String? = nil,
+        lastHeartbeatTime: Date? = nil,
+        endTime: Date? = nil,
+        cleanExit: Bool? = nil,
+        appTerminated: Bool? = nil,
+        crashReportId: String? = nil
+    ) throws -> Bool {
+        try run(
+            """
+            UPDATE sessions SET
+                state = COALESCE(?, state),
+                last_heartbeat_time = COALESCE(?, last_heartbeat_time),
+                end_time = COALESCE(?, end_time),
+                clean_exit = COALESCE(?, clean_exit),
+                app_terminated = COALESCE(?, app_terminated),
+                crash_report_id = COALESCE(?, crash_report_id)
+            WHERE id = ?
+            """,
+            [
+                SQLiteValue(state),
+                SQLiteValue(lastHeartbeatTime),
+                SQLiteValue(endTime),
+                cleanExit.map { SQLiteValue($0) } ?? .null,
+                appTerminated.map { SQLiteValue($0) } ?? .null,
+                SQLiteValue(crashReportId),
+                .text(id)
+            ]
+        ) > 0
+    }
+
+    @discardableResult
+    public func deleteSession(id: String) throws -> Bool {
+        try run("DELETE FROM sessions WHERE id = ?", [.text(id)]) > 0
+    }
+
+    // MARK: - Mapping
+
+    private static func values(for session: SQLiteSessionRow) -> [SQLiteValue] {
+        return [
+            .text(session.id),
+            .text(session.processId),
+            .text(session.state),
+            .text(session.traceId),
+            .text(session.spanId),
+            SQLiteValue(session.startTime),
+            SQLiteValue(session.endTime),
+            SQLiteValue(session.lastHeartbeatTime),
+            SQLiteValue(session.crashReportId),
+            SQLiteValue(session.coldStart),
+            SQLiteValue(session.cleanExit),
+            SQLiteValue(session.appTerminated),
+            SQLiteValue(session.sessionNumber)
+        ]
+    }
+
+    private static func sessionRow(from row: SQLiteRow) -> SQLiteSessionRow {
+        return SQLiteSessionRow(
+            id: row.string(0),
+            processId: row.string(1),
+            state: row.string(2),
+            traceId: row.string(3),
+            spanId: row.string(4),
+            startTime: row.date(5),
+            endTime: row.optionalDate(6),
+            lastHeartbeatTime: row.date(7),
+            crashReportId: row.optionalString(8),
+            coldStart: row.bool(9),
+            cleanExit: row.bool(10),
+            appTerminated: row.bool(11),
+            sessionNumber: row.int(12)
+        )
+    }
+}
@@ -0,0 +1,349 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+public struct SQLiteSpanRow: Equatable {
+    public var id: String
+    public var traceId: String
+    public var name: String
+    public var type: String
+    public var data: Data
+    public var startTime: Date
+    public var endTime: Date?
+    public var processId: String
+    public var sessionId: String?
+
+    public init(
+        id: String,
+        traceId: String,
+        name: String,
+        type: String,
+        data: Data,
+        startTime: Date,
+        endTime: Date? = nil,
+        processId: String,
+        sessionId: String? = nil
+    ) {
+        self.id = id
+        self.traceId = traceId
+        self.name = name
+        self.type = type
+        self.data = data
+        self.startTime = startTime
+        self.endTime = endTime
+        self.processId = processId
+        self.sessionId = sessionId
+    }
+}
+
+public struct SQLiteSpanEventRow: Equatable {
+    public var name: String
+    public var timestamp: Date
+    public var attributes: [String: String]
+
+    public init(name: String, timestamp: Date, attributes: [String: String]) {
+        self.name = name
+        self.timestamp = timestamp
+        self.attributes = attributes
+    }
+}
+
+/// What `upsertSpan(_:)` did with the row it was given.
+public enum SQLiteSpanUpsertResult {
+    /// The span wasn't stored yet.
+    case inserted
+
+    /// The span was open and got replaced.
+    case updated
+
+    /// The span is already closed, so the row was ignored.
+    case ignored
+}
+
+/// Which spans `forEachSpan(in:excludingType:limit:_:)` should return for a session.
+public enum SQLiteSpanSessionFilter {
+    /// Spans from `processId` that started before `endTime` (cold start sessions).
+    case process(processId: String, endTime: Date)
+
+    /// Spans tagged with `sessionId`, plus any span overlapping `startTime...endTime`.
+    case overlapping(sessionId: String, startTime: Date, endTime: Date)
+}
+
+extension SQLiteStore {
+
+    static let spanColumns = [
+        "id", "trace_id", "name", "type", "data", "start_time", "end_time", "process_id", "session_id"
+    ]
+
+    private static let spanSelect = "SELECT \(spanColumns.joined(separator: ", ")) FROM spans"
+
+    /// Closed spans are never modified again.
+    private static let spanUpsertSuffix = """
+        ON CONFLICT (trace_id, id) DO UPDATE SET
+            name = excluded.name,
+            type = excluded.type,
+            data = excluded.data,
+            start_time = excluded.start_time,
+            end_time = excluded.end_time,
+            process_id = excluded.process_id,
+            session_id = excluded.session_id
+        WHERE spans.end_time IS NULL
+        """
+
+    /// Inserts or updates the given spans with multi-row statements. Rows for spans that are already
+    /// closed in the store are ignored.
+    public func upsertSpans(_ rows: [SQLiteSpanRow]) throws {
+        try insert(
+            into: "spans",
+            columns: Self.spanColumns,
+            suffix: Self.spanUpsertSuffix,
+            rows: rows.map(Self.values(for:))
+        )
+    }
+
+    /// Inserts or updates a single span. The row is ignored if the stored span is already closed.
+    /// - Returns: Whether the span was inserted, updated or left untouched.
+    @discardableResult
+    public func upsertSpan(_ row: SQLiteSpanRow) throws -> SQLiteSpanUpsertResult {
+        try connection.transaction {
+            let open = try connection.statement("SELECT end_time IS NULL FROM spans WHERE trace_id = ? AND id = ?")
+                .first([.text(row.traceId), .text(row.id)]) { $0.int(0) != 0 }
+
+            guard open != false else {
+                return .ignored
+            }
+
+            try insert(into: "spans", columns: Self.spanColumns, suffix: Self.spanUpsertSuffix, rows: [Self.values(for: row)])
+            return open == nil ? .inserted : .updated
+        }
+    }
+
+    /// Returns the span with the given identifiers, if any.
+    public func span(id: String, traceId: String) throws -> SQLiteSpanRow? {
+        try connection.withLock {
+            try connection.statement(Self.spanSelect + " WHERE trace_id = ? AND id = ?")
+                .first([.text(traceId), .text(id)], Self.spanRow(from:))
+        }
+    }
+
+    /// Sets `endTime` on the span if it's still open.
+    /// - Returns: `true` if the span was open and got closed.
+    @discardableResult
+    public func endSpan(id: String, traceId: String, endTime: Date) throws -> Bool {
+        try run(
+            "UPDATE spans SET end_time = ? WHERE trace_id = ? AND id = ? AND end_time IS NULL",
+            [SQLiteValue(endTime), .text(traceId), .text(id)]
+        ) > 0
+    }
+
+    /// Closes every open span that doesn't belong to `processId`.
+    /// - Returns: Number of spans closed.
+    @discardableResult
+    public func closeOpenSpans(excludingProcessId processId: String, endTime: Date) throws -> Int {
+        try run(
+            "UPDATE spans SET end_time = ? WHERE end_time IS NULL AND process_id != ?",
+            [SQLiteValue(endTime), .text(processId)]
+        )
+    }
+
+    /// Deletes closed spans that ended before `date`.
+    /// - Returns: Number of spans deleted.
+    @discardableResult
+    public func deleteClosedSpans(endedBefore date: Date) throws -> Int {
+        try run(
+            "DELETE FROM spans WHERE end_time IS NOT NULL AND end_time < ?",
+            [SQLiteValue(date)]
+        )
+    }
+
+    /// Deletes closed spans that don't belong to `processId`.
+    /// - Returns: Number of spans deleted.
+    @discardableResult
+    public func deleteClosedSpans(excludingProcessId processId: String) throws -> Int {
+        try run(
+            "DELETE FROM spans WHERE end_time IS NOT NULL AND process_id != ?",
+            [.text(processId)]
+        )
+    }
+
+    /// Number of spans whose type starts with `typePrefix`.
+    public func spanCount(typePrefix: String) throws -> Int {
+        let (sql, values) = Self.typePrefixClause(typePrefix)
+        return try connection.withLock {
+            try connection.statement("SELECT COUNT(*) FROM spans WHERE " + sql).first(values) { $0.int(0) } ?? 0
+        }
+    }
+
+    /// Deletes the oldest spans whose type starts with `typePrefix` until at most `limit` remain.
+    /// The span identified by `keeping` is never deleted.
+    /// - Returns: Number of spans deleted.
+    @discardableResult
+    public func trimSpans(
+        typePrefix: String,
+        limit: Int,
+        keeping: (id: String, traceId: String)? = nil
+    ) throws -> Int {
+        let (clause, values) = Self.typePrefixClause(typePrefix)
+
+        return try connection.transaction {
+            let count = try spanCount(typePrefix: typePrefix)
+            let excess = count - max(0, limit)
+            guard excess > 0 else {
+                return 0
+            }
+
+            let keep = keeping.map { [SQLiteValue.text($0.traceId), .text($0.id)] } ?? [.null, .null]
+            return try run(
+                """
+                DELETE FROM spans WHERE rowid IN (
+                    SELECT rowid FROM spans
+                    WHERE \(clause) AND NOT (trace_id IS ? AND id IS ?)
+                    ORDER BY start_time ASC
+                    LIMIT ?
+                )
+                """,
+                values + keep + [SQLiteValue(excess)]
+            )
+        }
+    }
+
+    // MARK: - Events
+
+    /// Appends events to the span. Does nothing if the span doesn't exist.
+    public func addSpanEvents(_ events: [SQLiteSpanEventRow], spanId: String, traceId: String) throws {
+        guard !events.isEmpty else {
+            return
+        }
+
+        try connection.transaction {
+            let exists = try connection.statement("SELECT 1 FROM spans WHERE trace_id = ? AND id = ?")
+                .first([.text(traceId), .text(spanId)]) { _ in true } ?? false
+            guard exists else {
+                return
+            }
+
+            let rows: [[SQLiteValue]] = try events.map {
+                [
+                    .text(traceId),
+                    .text(spanId),
+                    .text($0.name),
+                    SQLiteValue($0.timestamp),
+                    .blob(try encoder.encode($0.attributes))
+                ]
+            }
+            try insert(
+                into: "span_events",
+                columns: ["trace_id", "span_id", "name", "timestamp", "attributes"],
+                rows: rows
+            )
+        }
+    }
+
+    /// Events of the given span, oldest first.
+    public func spanEvents(spanId: String, traceId: String) throws -> [SQLiteSpanEventRow] {
+        try connection.withLock {
+            var result: [SQLiteSpanEventRow] = []
+            try connection.statement(
+                """
+                SELECT name, timestamp, attributes FROM span_events
+                WHERE trace_id = ? AND span_id = ? ORDER BY timestamp ASC
+                """
+            ).forEachRow([.text(traceId), .text(spanId)]) { row in
+                result.append(
+                    SQLiteSpanEventRow(
+                        name: row.string(0),
+                        timestamp: row.date(1),
+                        attributes: (try? decoder.decode([String: String].self, from: row.data(2))) ?? [:]
+                    )
+                )
+                return true
+            }
+            return result
+        }
+    }
+
+    // MARK: - Streaming
+
+    /// Streams the spans that belong to a session.
+    /// - Parameters:
+    ///   - filter: Which spans belong to the session.
+    ///   - excludingType: Spans of this exact type are skipped.
+    ///   - limit: Maximum number of spans to return.
+    ///   - body: Called for every span. Return `false` to stop.
+    public func forEachSpan(
+        in filter: SQLiteSpanSessionFilter,
+        excludingType: String? = nil,
+        limit: Int,
+        _ body: (SQLiteSpanRow) throws -> Bool
+    ) throws {
+        var sql = Self.spanSelect + " WHERE "
+        var values: [SQLiteValue]
+
+        switch filter {
+        case let .process(processId, endTime):
+            sql += "(process_id = ? AND start_time <= ?)"
+            values = [.text(processId), SQLiteValue(endTime)]
+
+        case let .overlapping(sessionId, startTime, endTime):
+            sql += """
+                (session_id = ? \
+                OR (start_time >= ? AND start_time <= ?) \
+                OR (start_time < ? AND (end_time IS NULL OR end_time >= ?)))
+                """
+            values = [
+                .text(sessionId),
+                SQLiteValue(startTime), SQLiteValue(endTime),
+                SQLiteValue(startTime), SQLiteValue(startTime)
+            ]
+        }
+
+        sql += " AND type IS NOT ? LIMIT ?"
+        values += [SQLiteValue(excludingType), SQLiteValue(max(0, limit))]
+
+        try connection.withLock {
+            try connection.statement(sql).forEachRow(values) {
+                try body(Self.spanRow(from: $0))
+            }
+        }
+    }
+
+    // MARK: - Mapping
+
+    static func values(for row: SQLiteSpanRow) -> [SQLiteValue] {
+        return [
+            .text(row.id),
+            .text(row.traceId),
+            .text(row.name),
+            .text(row.type),
+            .blob(row.data),
+            SQLiteValue(row.startTime),
+            SQLiteValue(row.endTime),
+            .text(row.processId),
+            SQLiteValue(row.sessionId)
+        ]
+    }
+
+    static func spanRow(from row: SQLiteRow) -> SQLiteSpanRow {
+        return SQLiteSpanRow(
+            id: row.string(0),
+            traceId: row.string(1),
+            name: row.string(2),
+            type: row.string(3),
+            data: row.data(4),
+            startTime: row.date(5),
+            endTime: row.optionalDate(6),
+            processId: row.string(7),
+            sessionId: row.optionalString(8)
+        )
+    }
+
+    /// `type` prefix match expressed as an index range.
+    static func typePrefixClause(_ prefix: String) -> (String, [SQLiteValue]) {
+        if let upperBound = prefixUpperBound(prefix) {
+            return ("(type >= ? AND type < ?)", [.text(prefix), .text(upperBound)])
+        }
+        return ("type >= ?", [.text(prefix)])
+    }
+}
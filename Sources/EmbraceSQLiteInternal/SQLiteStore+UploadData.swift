@@ -0,0 +1,160 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+public struct SQLiteUploadDataRow: Equatable {
+    public var id: String
+    public var type: Int
+    public var data: Data
+    public var payloadTypes: String?
+    public var date: Date
+
+    public init(id: String, type: Int, data: Data, payloadTypes: String? = nil, date: Date) {
+        self.id = id
+        self.type = type
+        self.data = data
+        self.payloadTypes = payloadTypes
+        self.date = date
+    }
+}
+
+extension SQLiteStore {
+
+    private static let uploadDataSelect = "SELECT id, type, data, payload_types, date FROM upload_data"
+
+    /// Saves upload data. Existing entries keep their original date and get their payload replaced.
+    ///
+    /// When a new entry would take the cache to `countLimit` entries or more, the oldest entries are
+    /// deleted first (plus `evictionSlack` extra, so the next inserts don't have to evict again).
+    /// - Parameters:
+    ///   - row: Data to save.
+    ///   - countLimit: Maximum number of cached entries. `0` disables the limit.
+    ///   - evictionSlack: Extra entries removed when the limit is hit.
+    /// - Returns: The number of entries evicted to make room.
+    @discardableResult
+    public func saveUploadData(_ row: SQLiteUploadDataRow, countLimit: Int = 0, evictionSlack: Int = 10) throws -> Int {
+        try connection.transaction {
+            let updated = try run(
+                "UPDATE upload_data SET data = ?, payload_types = ? WHERE id = ? AND type = ?",
+                [.blob(row.data), SQLiteValue(row.payloadTypes), .text(row.id), SQLiteValue(row.type)]
+            )
+            guard updated == 0 else {
+                return 0
+            }
+
+            var evicted = 0
+            if countLimit > 0 {
+                let count = try uploadDataCount()
+                if count >= countLimit {
+                    evicted = try deleteOldestUploadData(count: count - countLimit + evictionSlack)
+                }
+            }
+
+            try run(
+                "INSERT INTO upload_data (id, type, data, payload_types, date) VALUES (?, ?, ?, ?, ?)",
+                [.text(row.id), SQLiteValue(row.type), .blob(row.data), SQLiteValue(row.payloadTypes), SQLiteValue(row.date)]
+            )
+            return evicted
+        }
+    }
+
+    public func uploadData(id: String, type: Int) throws -> SQLiteUploadDataRow? {
+        try connection.withLock {
+            try connection.statement(Self.uploadDataSelect + " WHERE id = ? AND type = ?")
+                .first([.text(id), SQLiteValue(type)], Self.uploadDataRow(from:))
+        }
+    }
+
+    /// Streams cached entries, oldest first.
+    /// - Parameters:
+    ///   - type: Only entries of this type are returned. `nil` returns every type.
+    ///   - excludingIds: Identifiers to skip (e.g. uploads already in flight).
+    ///   - limit: Maximum number of entries to return.
+    ///   - body: Called for every entry. Return `false` to stop.
+    public func forEachUploadData(
+        type: Int? = nil,
+        excludingIds: Set<String> = [],
+        limit: Int = .max,
+        _ body: (SQLiteUploadDataRow) throws -> Bool
+    ) throws {
+        guard limit > 0 else {
+            return
+        }
+
+        // exclusions are filtered here instead of with `NOT IN (...)` so the statement shape (and
+        // its cached prepared statement) doesn't depend on how many there are.
+        let sql: String
+        let values: [SQLiteValue]
+        if let type {
+            sql = Self.uploadDataSelect + " WHERE type = ? ORDER BY date ASC"
+            values = [SQLiteValue(type)]
+        } else {
+            sql = Self.uploadDataSelect + " ORDER BY date ASC"
+            values = []
+        }
+
+        try connection.withLock {
+            var returned = 0
+            try connection.statement(sql).forEachRow(values) { row in
+                if !excludingIds.isEmpty, excludingIds.contains(row.string(0)) {
+                    return true
+                }
+                returned += 1
+                return try body(Self.uploadDataRow(from: row)) && returned < limit
+            }
+        }
+    }
+
+    @discardableResult
+    public func deleteUploadData(id: String, type: Int) throws -> Bool {
+        try run("DELETE FROM upload_data WHERE id = ? AND type = ?", [.text(id), SQLiteValue(type)]) > 0
+    }
+
+    /// Deletes every entry saved before `date` in one statement, without reading any payload.
+    /// - Returns: Number of entries deleted.
+    @discardableResult
+    public func deleteUploadData(olderThan date: Date) throws -> Int {
+        try run("DELETE FROM upload_data WHERE date < ?", [SQLiteValue(date)])
+    }
+
+    /// Deletes the `count` oldest entries.
+    /// - Returns: Number of entries deleted.
+    @discardableResult
+    public func deleteOldestUploadData(count: Int) throws -> Int {
+        guard count > 0 else {
+            return 0
+        }
+        return try run(
+            "DELETE FROM upload_data WHERE rowid IN (SELECT rowid FROM upload_data ORDER BY date ASC LIMIT ?)",
+            [SQLiteValue(count)]
+        )
+    }
+
+    public func uploadDataCount() throws -> Int {
+        try connection.withLock {
+            try connection.statement("SELECT COUNT(*) FROM upload_data").first { $0.int(0) } ?? 0
+        }
+    }
+
+    /// Number of entries saved before `date`. Answered from the date index.
+    public func uploadDataCount(olderThan date: Date) throws -> Int {
+        try connection.withLock {
+            try connection.statement("SELECT COUNT(*) FROM upload_data WHERE date < ?")
+                .first([SQLiteValue(date)]) { $0.int(0) } ?? 0
+        }
+    }
+
+    // MARK: - Mapping
+
+    private static func uploadDataRow(from row: SQLiteRow) -> SQLiteUploadDataRow {
+        return SQLiteUploadDataRow(
+            id: row.string(0),
+            type: row.int(1),
+            data: row.data(2),
+            payloadTypes: row.optionalString(3),
+            date: row.date(4)
+        )
+    }
+}
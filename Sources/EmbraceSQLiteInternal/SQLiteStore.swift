@@ -0,0 +1,202 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+/// SQLite-backed storage engine for spans, sessions, logs and cached upload data.
+///
+/// This module only depends on Foundation and the system SQLite library so it builds (and its
+/// tests run) on Linux as well as Apple platforms. `EmbraceStorage` and the upload cache use it
+/// when configured with `StorageEngine.sqlite`.
+///
+/// Compared to the Core Data store:
+/// - The database runs in WAL mode with `synchronous = NORMAL`.
+/// - Every statement is prepared once and cached by the connection.
+/// - Bulk writes use multi-row `INSERT`s, and bulk deletes are single `DELETE`s that never load rows.
+/// - Reads stream rows through a closure instead of materializing result arrays.
+///
+/// All methods are thread safe; access is serialized by the connection lock.
+/// - Important: Streaming closures run while the lock is held. They may call back into the store
+///   (the lock is reentrant) but must not block on other threads that use it.
+public final class SQLiteStore {
+
+    /// Current schema version, stored in `PRAGMA user_version`.
+    public static let schemaVersion = 1
+
+    /// Conservative bound on bound parameters per statement (`SQLITE_MAX_VARIABLE_NUMBER` defaults
+    /// to 999 on older SQLite builds).
+    static let maxVariablesPerStatement = 999
+
+    public let connection: SQLiteConnection
+
+    let encoder = JSONEncoder()
+    let decoder = JSONDecoder()
+
+    /// - Parameters:
+    ///   - location: Where the database lives.
+    ///   - walEnabled: Enables write-ahead logging for file databases.
+    public init(location: SQLiteConnection.Location, walEnabled: Bool = true) throws {
+        connection = try SQLiteConnection(location: location, walEnabled: walEnabled)
+        try migrate()
+    }
+
+    // MARK: - Schema
+
+    private func migrate() throws {
+        try connection.transaction {
+            let version = connection.userVersion
+            guard version < Self.schemaVersion else {
+                return
+            }
+
+            if version < 1 {
+                try connection.execute(Self.schemaV1)
+            }
+
+            connection.userVersion = Self.schemaVersion
+        }
+    }
+
+    private static let schemaV1 = """
+        CREATE TABLE IF NOT EXISTS spans (
+            id TEXT NOT NULL,
+            trace_id TEXT NOT NULL,
+            name TEXT NOT NULL,
+            type TEXT NOT NULL,
+            data BLOB NOT NULL,
+            start_time REAL NOT NULL,
+            end_time REAL,
+            process_id TEXT NOT NULL,
+            session_id TEXT
+        );
+        CREATE UNIQUE INDEX IF NOT EXISTS spans_trace_id_id ON spans (trace_id, id);
+        CREATE INDEX IF NOT EXISTS spans_type_start_time ON spans (type, start_time);
+        CREATE INDEX IF NOT EXISTS spans_process_id_session_id ON spans (process_id, session_id);
+
+        CREATE TABLE IF NOT EXISTS span_events (
+            trace_id TEXT NOT NULL,
+            span_id TEXT NOT NULL,
+            name TEXT NOT NULL,
+            timestamp REAL NOT NULL,
+            attributes BLOB NOT NULL,
+            FOREIGN KEY (trace_id, span_id) REFERENCES spans (trace_id, id) ON DELETE CASCADE
+        );
+        CREATE INDEX IF NOT EXISTS span_events_trace_id_span_id ON span_events (trace_id, span_id);
+
+        CREATE TABLE IF NOT EXISTS sessions (
+            id TEXT NOT NULL PRIMARY KEY,
+            process_id TEXT NOT NULL,
+            state TEXT NOT NULL,
+            trace_id TEXT NOT NULL,
+            span_id TEXT NOT NULL,
+            start_time REAL NOT NULL,
+            end_time REAL,
+            last_heartbeat_time REAL NOT NULL,
+            crash_report_id TEXT,
+            cold_start INTEGER NOT NULL,
+            clean_exit INTEGER NOT NULL,
+            app_terminated INTEGER NOT NULL,
+            session_number INTEGER NOT NULL
+        );
+        CREATE INDEX IF NOT EXISTS sessions_process_id_id ON sessions (process_id, id);
+        CREATE INDEX IF NOT EXISTS sessions_start_time ON sessions (start_time);
+
+        CREATE TABLE IF NOT EXISTS logs (
+            id TEXT NOT NULL,
+            process_id TEXT NOT NULL,
+            session_id TEXT,
+            severity INTEGER NOT NULL,
+            body TEXT NOT NULL,
+            timestamp REAL NOT NULL,
+            attributes BLOB NOT NULL
+        );
+        CREATE UNIQUE INDEX IF NOT EXISTS logs_id_process_id ON logs (id, process_id);
+        CREATE INDEX IF NOT EXISTS logs_process_id_session_id ON logs (process_id, session_id);
+
+        CREATE TABLE IF NOT EXISTS upload_data (
+            id TEXT NOT NULL,
+            type INTEGER NOT NULL,
+            data BLOB NOT NULL,
+            payload_types TEXT,
+            date REAL NOT NULL
+        );
+        CREATE UNIQUE INDEX IF NOT EXISTS upload_data_id_type ON upload_data (id, type);
+        CREATE INDEX IF NOT EXISTS upload_data_type_date ON upload_data (type, date);
+        CREATE INDEX IF NOT EXISTS upload_data_date ON upload_data (date);
+        """
+
+    // MARK: - Helpers
+
+    /// Inserts `rows` using as few multi-row `INSERT` statements as possible.
+    ///
+    /// Rows are written in chunks whose sizes are powers of two, so each table only ever needs a
+    /// handful of distinct statement shapes in the statement cache.
+    /// - Parameters:
+    ///   - table: Table name.
+    ///   - columns: Column names, in the order of each row's values.
+    ///   - suffix: Optional clause appended to every statement (e.g. `ON CONFLICT ...`).
+    ///   - rows: Values for each row. Every row must have `columns.count` values.
+    func insert(into table: String, columns: [String], suffix: String = "", rows: [[SQLiteValue]]) throws {
+        guard !rows.isEmpty else {
+            return
+        }
+
+        let maxRows = Self.largestPowerOfTwo(notAbove: Self.maxVariablesPerStatement / columns.count)
+        let placeholders = "(" + Array(repeating: "?", count: columns.count).joined(separator: ",") + ")"
+        let prefix = "INSERT INTO \(table) (\(columns.joined(separator: ","))) VALUES "
+
+        try connection.transaction {
+            var index = rows.startIndex
+            while index < rows.endIndex {
+                let chunk = min(maxRows, Self.largestPowerOfTwo(notAbove: rows.endIndex - index))
+                let sql = prefix + Array(repeating: placeholders, count: chunk).joined(separator: ",") + " " + suffix
+                let statement = try connection.statement(sql)
+                defer { statement.reset() }
+
+                var parameter: Int32 = 1
+                for row in rows[index..<(index + chunk)] {
+                    for value in row {
+                        try statement.bind(value, at: parameter)
+                        parameter += 1
+                    }
+                }
+
+                while try statement.step() {}
+
+                index += chunk
+            }
+        }
+    }
+
+    /// Runs a cached statement that doesn't return rows and returns the number of changed rows.
+    @discardableResult
+    func run(_ sql: String, _ values: [SQLiteValue] = []) throws -> Int {
+        try connection.withLock {
+            try connection.statement(sql).run(values)
+            return connection.changes
+        }
+    }
+
+    static func largestPowerOfTwo(notAbove value: Int) -> Int {
+        guard value > 1 else {
+            return 1
+        }
+        return 1 << (Int.bitWidth - 1 - value.leadingZeroBitCount)
+    }
+
+    /// Exclusive upper bound for strings starting with `prefix`, so prefix matches can use an index
+    /// range (`column >= prefix AND column < upperBound`).
+    static func prefixUpperBound(_ prefix: String) -> String? {
+        var scalars = Array(prefix.unicodeScalars)
+        while let last = scalars.popLast() {
+            if let next = Unicode.Scalar(last.value + 1) {
+                scalars.append(next)
+                var result = String.UnicodeScalarView()
+                result.append(contentsOf: scalars)
+                return String(result)
+            }
+        }
+        return nil
+    }
+}
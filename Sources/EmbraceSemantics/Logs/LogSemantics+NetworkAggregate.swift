@@ -0,0 +1,18 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCommonInternal
+#endif
+
+extension LogType {
+    public static let networkAggregate = LogType(system: "network_aggregate")
+}
+
+extension LogSemantics {
+    public struct NetworkAggregate {
+        public static let keyPayload = "emb.payload"
+        public static let keyRequestCount = "emb.request_count"
+    }
+}
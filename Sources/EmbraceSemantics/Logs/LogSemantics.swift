@@ -16,6 +16,9 @@ public struct LogSemantics {
     public static let keyStackTrace = "emb.stacktrace.ios"
     public static let keyPropertiesPrefix = "emb.properties.%@"
 
+    /// Bundle identifier of the app extension that recorded the log.
+    public static let keyExtensionBundleId = "emb.extension.bundle_id"
+
     /// Marks a log as private to Embrace: it is uploaded to the Embrace backend for diagnostic
     /// purposes, but never stored locally nor forwarded to processors or exporters set by the user.
     public static let keyPrivate = "emb.private"
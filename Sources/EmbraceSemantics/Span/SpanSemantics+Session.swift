@@ -21,5 +21,10 @@ extension SpanSemantics {
         public static let keySessionNumber = "emb.session_number"
         public static let keyHeartbeat = "emb.heartbeat_time_unix_nano"
         public static let keyCrashId = "emb.crash_id"
+        public static let keySdkLatencyPrefix = "emb.sdk.latency."
+        public static let keySdkCountPrefix = "emb.sdk.count."
+        public static let keySdkMemoryPeak = "emb.sdk.memory.peak_bytes"
+        public static let keySdkMemoryMaxLevel = "emb.sdk.memory.max_level"
+        public static let keySdkDroppedPrefix = "emb.sdk.dropped."
     }
 }
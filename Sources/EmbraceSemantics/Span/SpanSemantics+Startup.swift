@@ -22,5 +22,11 @@ extension SpanSemantics {
         public static let sdkStart = "emb-sdk-start"
 
         public static let keyPrewarmed = "isPrewarmed"
+
+        public static let sdkStartupPhaseName = "emb-sdk-startup-phase"
+        public static let sdkStartupTaskName = "emb-sdk-startup-task"
+        public static let keyStartupPhase = "phase"
+        public static let keyStartupBudget = "budget_ms"
+        public static let keyStartupTask = "task"
     }
 }
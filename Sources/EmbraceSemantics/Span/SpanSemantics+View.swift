@@ -23,6 +23,12 @@ extension SpanSemantics {
         public static let uiReadyName = "ui-ready"
         public static let keyViewTitle = "view.title"
         public static let keyViewName = "view.name"
+
+        public static let keyViewDidLoadDuration = "view.did_load_ms"
+        public static let keyViewWillAppearDuration = "view.will_appear_ms"
+        public static let keyViewIsAppearingDuration = "view.is_appearing_ms"
+        public static let keyViewDidAppearDuration = "view.did_appear_ms"
+        public static let keyUiReadyDuration = "view.ui_ready_ms"
     }
 
     public struct SwiftUIView {
@@ -50,5 +56,17 @@ extension SpanSemantics {
         /// when that content is deemed complete.
         public static let timeToFirstContentComplete = "time-to-first-content-complete"
 
+        /// A span that summarizes the body evaluations, appears and disappears of a view
+        /// traced with an `EmbraceTraceViewAggregate`, from the first one recorded until the summary is flushed.
+        public static let bodySummaryName = "body-summary"
+
+        public static let keyBodyCount = "body.count"
+        public static let keyBodyTotalDuration = "body.total_ms"
+        public static let keyBodyMaxDuration = "body.max_ms"
+        public static let keyBodyHistogram = "body.histogram_ms"
+        public static let keyBodyOutlierCount = "body.outlier_count"
+        public static let keyAppearCount = "appear.count"
+        public static let keyDisappearCount = "disappear.count"
+
     }
 }
@@ -13,4 +13,7 @@ public struct SpanSemantics {
     public static let keyNSErrorCode = "error.code"
 
     public static let keyAutoTerminationCode = "emb.auto_termination.code"
+
+    /// Bundle identifier of the app extension that recorded the span.
+    public static let keyExtensionBundleId = "emb.extension.bundle_id"
 }
@@ -6,6 +6,7 @@ import Foundation
 
 #if !EMBRACE_COCOAPOD_BUILDING_SDK
     import EmbraceCommonInternal
+    import EmbraceCoreDataInternal
 #endif
 
 extension EmbraceStorage {
@@ -33,6 +34,13 @@ extension EmbraceStorage {
         /// Determines how many `MetadataRecords` of the `.personaTag` type can be present at any given time.
         public var personaTagsLimit: Int = 10
 
+        /// Determines when mutations are saved to disk. Writes are coalesced by default;
+        /// `EmbraceStorage.flush()` forces pending changes to disk.
+        public var commitPolicy: CoreDataWrapper.CommitPolicy = .default
+
+        /// Database engine used for spans, sessions and logs. Metadata always uses Core Data.
+        public var engine: StorageEngine = .coreData
+
         /// Use this initializer to create a storage object that is persisted locally to disk
         /// - Parameters:
         ///   - storageMechanism: The StorageMechanism to use
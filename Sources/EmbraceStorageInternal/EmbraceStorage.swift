@@ -8,17 +8,28 @@ import Foundation
 #if !EMBRACE_COCOAPOD_BUILDING_SDK
     import EmbraceCommonInternal
     import EmbraceCoreDataInternal
+    import EmbraceSQLiteInternal
 #endif
 
 public typealias Storage = EmbraceStorageMetadataFetcher & LogRepository
 
 /// Class in charge of storing all the data captured by the Embrace SDK.
-/// It provides an abstraction layer over a CoreData database.
+/// It provides an abstraction layer over a CoreData database. Spans, sessions and logs can
+/// optionally be kept in a SQLite database instead (see `Options.engine`).
 public class EmbraceStorage: Storage {
     public private(set) var options: Options
     public private(set) var logger: InternalLogger
     public private(set) var coreData: CoreDataWrapper
 
+    /// SQLite store for spans, sessions and logs when `options.engine` is `.sqlite`.
+    public let sqlite: SQLiteStore?
+
+    /// Open span records and per-type span counts, so span upserts can skip fetches and count queries.
+    let openSpans = OpenSpanIndex()
+
+    /// Metadata visible to recently read sessions and processes, kept current by the metadata write paths.
+    let metadataSnapshots = MetadataSnapshotIndex()
+
     /// Returns an `EmbraceStorage` instance for the given `EmbraceStorage.Options`
     /// - Parameters:
     ///   - options: `EmbraceStorage.Options` instance
@@ -41,14 +52,32 @@ public class EmbraceStorage: Storage {
         let coreDataOptions = CoreDataWrapper.Options(
             storageMechanism: options.storageMechanism,
             enableBackgroundTasks: options.enableBackgroundTasks,
-            entities: entities
+            entities: entities,
+            commitPolicy: options.commitPolicy
         )
         self.coreData = try CoreDataWrapper(options: coreDataOptions, logger: logger)
+
+        switch options.engine {
+        case .coreData:
+            self.sqlite = nil
+        case .sqlite:
+            let location: SQLiteConnection.Location =
+                options.storageMechanism.sqliteFileURL.map { .file($0) } ?? .inMemory
+            self.sqlite = try SQLiteStore(location: location)
+        }
     }
 
-    /// Saves all changes to disk
+    /// Saves all changes to disk asynchronously, including any whose commit is still deferred.
     public func save() {
-        coreData.saveAsync()
+        coreData.flushAsync()
+    }
+
+    /// Synchronously saves all changes to disk, including any whose commit is still deferred.
+    /// Use as a durability barrier before handing data off to something outside the storage.
+    public func flush() {
+        let mkSpan = EmbraceMetricKitSpan.begin(name: "storage-flush")
+        coreData.flush()
+        mkSpan.end()
     }
 }
 
@@ -58,12 +87,22 @@ extension EmbraceStorage {
     /// - Parameter record: `NSManagedObject` to delete
     public func delete<T: EmbraceStorageRecord>(_ record: T) {
         coreData.deleteRecord(record)
+        if T.self is SpanRecord.Type {
+            openSpans.invalidateCounts()
+        } else if T.self is MetadataRecord.Type {
+            metadataSnapshots.invalidate()
+        }
     }
 
     /// Deletes records from the storage synchronously.
     /// - Parameter record: `NSManagedObject` to delete
     public func delete<T: EmbraceStorageRecord>(_ records: [T]) {
         coreData.deleteRecords(records)
+        if T.self is SpanRecord.Type {
+            openSpans.invalidateCounts()
+        } else if T.self is MetadataRecord.Type {
+            metadataSnapshots.invalidate()
+        }
     }
 
     /// Fetches all the records of the given type in the storage synchronously.
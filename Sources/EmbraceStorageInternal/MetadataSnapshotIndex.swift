@@ -0,0 +1,136 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCommonInternal
+#endif
+
+/// Materialized metadata snapshots for the sessions and processes payloads are built for.
+///
+/// Every session payload, log batch and crash log asks for the resources, custom properties and
+/// persona tags visible to a session: its session-scoped records, the process-scoped records of its
+/// process and all permanent records. Answering that used to take one lifespan `OR` query per type.
+///
+/// A snapshot is built with a single fetch the first time a scope is read. After that, every metadata
+/// write is applied to the cached snapshots it is visible to, so reads never touch the store again.
+/// Bulk removals that can't be mirrored cheaply drop all snapshots instead.
+///
+/// A write that happens while a snapshot is being fetched bumps `generation`, and the fetched result is
+/// then discarded rather than cached, so a snapshot can never miss a write.
+final class MetadataSnapshotIndex {
+
+    /// Whose metadata a snapshot holds. A `nil` session means process-level reads.
+    struct Scope: Hashable {
+        let sessionId: String?
+        let processId: String
+    }
+
+    /// Identity of a metadata record, matching the upsert lookup in `fetchMetadataRequest`.
+    struct RecordKey: Hashable {
+        let key: String
+        let typeRaw: String
+        let lifespanRaw: String
+        let lifespanId: String
+
+        init(_ metadata: EmbraceMetadata) {
+            self.key = metadata.key
+            self.typeRaw = metadata.typeRaw
+            self.lifespanRaw = metadata.lifespanRaw
+            self.lifespanId = metadata.lifespanId
+        }
+    }
+
+    /// Snapshots kept at once; sessions from earlier launches are only read a few times.
+    static let scopeLimit = 16
+
+    private struct State {
+        var snapshots: [Scope: [RecordKey: EmbraceMetadata]] = [:]
+        var generation: UInt64 = 0
+    }
+
+    private let state = EmbraceMutex(State())
+
+    // MARK: - Reads
+
+    /// Current write generation. Capture it before fetching a snapshot and pass it to `store`.
+    var generation: UInt64 {
+        state.withLock { $0.generation }
+    }
+
+    func snapshot(for scope: Scope) -> [EmbraceMetadata]? {
+        state.withLock {
+            $0.snapshots[scope].map { $0.values.sorted { $0.collectedAt < $1.collectedAt } }
+        }
+    }
+
+    /// Caches a freshly fetched snapshot, unless a write happened since `generation` was read.
+    func store(_ records: [EmbraceMetadata], for scope: Scope, generation: UInt64) {
+        state.withLock {
+            guard $0.generation == generation else {
+                return
+            }
+            if $0.snapshots.count >= Self.scopeLimit {
+                $0.snapshots.removeAll()
+            }
+            $0.snapshots[scope] = Dictionary(records.map { (RecordKey($0), $0) }, uniquingKeysWith: { _, last in last })
+        }
+    }
+
+    // MARK: - Writes
+
+    /// Applies an inserted or updated record to every snapshot it is visible to.
+    func didUpsert(_ metadata: EmbraceMetadata) {
+        let key = RecordKey(metadata)
+        state.withLock {
+            $0.generation &+= 1
+            for scope in $0.snapshots.keys where Self.isVisible(key, in: scope) {
+                $0.snapshots[scope]?[key] = metadata
+            }
+        }
+    }
+
+    /// Removes a record from every snapshot.
+    func didRemove(key: String, type: MetadataRecordType, lifespan: MetadataRecordLifespan, lifespanId: String) {
+        let recordKey = RecordKey(key: key, typeRaw: type.rawValue, lifespanRaw: lifespan.rawValue, lifespanId: lifespanId)
+        didRemove { RecordKey($0) == recordKey }
+    }
+
+    /// Removes every record matching `isRemoved` from every snapshot.
+    func didRemove(where isRemoved: (EmbraceMetadata) -> Bool) {
+        state.withLock {
+            $0.generation &+= 1
+            for scope in $0.snapshots.keys {
+                $0.snapshots[scope] = $0.snapshots[scope]?.filter { !isRemoved($0.value) }
+            }
+        }
+    }
+
+    /// Drops every snapshot; the next read of each scope fetches it again.
+    func invalidate() {
+        state.withLock {
+            $0.generation &+= 1
+            $0.snapshots.removeAll()
+        }
+    }
+
+    private static func isVisible(_ key: RecordKey, in scope: Scope) -> Bool {
+        switch MetadataRecordLifespan(rawValue: key.lifespanRaw) {
+        case .permanent: return true
+        case .process: return key.lifespanId == scope.processId
+        case .session: return key.lifespanId == scope.sessionId
+        case .none: return false
+        }
+    }
+}
+
+extension MetadataSnapshotIndex.RecordKey {
+    init(key: String, typeRaw: String, lifespanRaw: String, lifespanId: String) {
+        self.key = key
+        self.typeRaw = typeRaw
+        self.lifespanRaw = lifespanRaw
+        self.lifespanId = lifespanId
+    }
+}
@@ -0,0 +1,119 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import CoreData
+import Foundation
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCommonInternal
+#endif
+
+/// In-memory index of the spans currently open in `EmbraceStorage`, plus per-type record counters.
+///
+/// Spans are upserted many times while they are open (every attribute change, event, status),
+/// and each upsert used to start with a `id == %@ AND traceId == %@` fetch. The index lets those
+/// updates go straight to the record, and the counters let the per-type limit check skip the
+/// `count` query on every insert.
+///
+/// The index holds the registered `SpanRecord` itself rather than its `NSManagedObjectID`: with
+/// write-behind commits a freshly inserted record only has a temporary ID until the next save, and
+/// obtaining a permanent one costs a store write. Records are only ever touched on the storage
+/// context's queue; the index itself is guarded by its own lock.
+///
+/// Entries are evicted when the span ends. Counters are seeded lazily from the store and dropped
+/// (re-seeded on next use) whenever records are removed in bulk.
+final class OpenSpanIndex {
+
+    struct Key: Hashable {
+        let traceId: String
+        let spanId: String
+    }
+
+    private struct State {
+        var records: [Key: SpanRecord] = [:]
+
+        /// Number of stored span records whose `typeRaw` begins with the key.
+        var countsByType: [String: Int] = [:]
+    }
+
+    private let state = EmbraceMutex(State())
+
+    // MARK: - Open spans
+
+    /// Returns the indexed record for the span, if it's still alive in its context.
+    /// - Important: Must be called on the storage context's queue.
+    func record(id: String, traceId: String) -> SpanRecord? {
+        let key = Key(traceId: traceId, spanId: id)
+        return state.withLock {
+            guard let record = $0.records[key] else {
+                return nil
+            }
+
+            // the record was deleted (e.g. by the type limit) or its context was reset
+            guard record.managedObjectContext != nil, !record.isDeleted else {
+                $0.records[key] = nil
+                return nil
+            }
+
+            return record
+        }
+    }
+
+    func insert(_ record: SpanRecord, id: String, traceId: String) {
+        state.withLock {
+            $0.records[Key(traceId: traceId, spanId: id)] = record
+        }
+    }
+
+    func remove(id: String, traceId: String) {
+        state.withLock {
+            $0.records[Key(traceId: traceId, spanId: id)] = nil
+        }
+    }
+
+    var openSpanCount: Int {
+        state.withLock { $0.records.count }
+    }
+
+    // MARK: - Type counters
+
+    /// Cached count of records for the given type, or `nil` if it needs to be seeded from the store.
+    func count(forType typeRaw: String) -> Int? {
+        state.withLock { $0.countsByType[typeRaw] }
+    }
+
+    func setCount(_ count: Int, forType typeRaw: String) {
+        state.withLock { $0.countsByType[typeRaw] = count }
+    }
+
+    /// Updates every tracked counter that matches a newly stored record of the given type.
+    func didInsert(typeRaw: String) {
+        adjustCounts(for: typeRaw, by: 1)
+    }
+
+    /// Updates every tracked counter that matches a removed record of the given type.
+    func didDelete(typeRaw: String) {
+        adjustCounts(for: typeRaw, by: -1)
+    }
+
+    /// Drops all cached counts so they get re-seeded from the store.
+    func invalidateCounts() {
+        state.withLock { $0.countsByType.removeAll() }
+    }
+
+    func removeAll() {
+        state.withLock {
+            $0.records.removeAll()
+            $0.countsByType.removeAll()
+        }
+    }
+
+    private func adjustCounts(for typeRaw: String, by delta: Int) {
+        state.withLock {
+            for (key, value) in $0.countsByType where typeRaw.hasPrefix(key) {
+                $0.countsByType[key] = max(0, value + delta)
+            }
+        }
+    }
+}
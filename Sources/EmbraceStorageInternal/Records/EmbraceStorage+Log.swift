@@ -34,6 +34,18 @@ extension EmbraceStorage {
         timestamp: Date = Date(),
         attributes: [String: OpenTelemetryApi.AttributeValue]
     ) -> EmbraceLog? {
+        if let sqlite {
+            return createLog(
+                sqlite,
+                id: id,
+                processId: processId,
+                severity: severity,
+                body: body,
+                timestamp: timestamp,
+                attributes: attributes
+            )
+        }
+
         if let log = LogRecord.create(
             context: coreData.context,
             id: id,
@@ -58,6 +70,10 @@ extension EmbraceStorage {
     }
 
     public func fetchAll(excludingProcessIdentifier processIdentifier: EmbraceIdentifier) -> [EmbraceLog] {
+        if let sqlite {
+            return fetchAllLogs(sqlite, excludingProcessIdentifier: processIdentifier)
+        }
+
         let request = LogRecord.createFetchRequest()
         request.predicate = NSPredicate(format: "processIdRaw != %@", processIdentifier.stringValue)
 
@@ -75,11 +91,21 @@ extension EmbraceStorage {
     }
 
     public func removeAllLogs() {
+        if let sqlite {
+            removeAllLogs(sqlite)
+            return
+        }
+
         let records: [LogRecord] = fetchAll()
         coreData.deleteRecords(records)
     }
 
     public func remove(logs: [EmbraceLog]) {
+        if let sqlite {
+            remove(sqlite, logs: logs)
+            return
+        }
+
         var records: [LogRecord] = []
 
         for log in logs {
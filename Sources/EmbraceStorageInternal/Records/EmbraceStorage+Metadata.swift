@@ -56,6 +56,7 @@ extension EmbraceStorage {
             lifespanId: lifespanId
         ) {
             coreData.save()
+            metadataSnapshots.didUpsert(metadata)
             return metadata
         }
 
@@ -75,6 +76,7 @@ extension EmbraceStorage {
             return
         }
 
+        var upserted: [EmbraceMetadata] = []
         for (key, value) in map {
             // find if exists
             let request = MetadataRecord.createFetchRequest()
@@ -108,8 +110,13 @@ extension EmbraceStorage {
                 record?.lifespanId = processId.stringValue
                 record?.collectedAt = Date()
             }
+
+            if let record {
+                upserted.append(record.toImmutable())
+            }
         }
         coreData.save(allowMainQueue: allowMainQueue)
+        upserted.forEach(metadataSnapshots.didUpsert)
     }
 
     /// Adds or updates all the given critical resources **synchronously**
@@ -184,7 +191,7 @@ extension EmbraceStorage {
         lifespan: MetadataRecordLifespan,
         lifespanId: String
     ) -> EmbraceMetadata? {
-        coreData.performOperation(save: true) { context in
+        let updated: EmbraceMetadata? = coreData.performOperation(save: true) { context in
             // fetch existing metadata
             let request = fetchMetadataRequest(key: key, type: type, lifespan: lifespan, lifespanId: lifespanId)
             guard let metadata = fetchMetadata(request: request, context: context) else {
@@ -193,6 +200,11 @@ extension EmbraceStorage {
             metadata.value = value
             return metadata.toImmutable()
         }
+
+        if let updated {
+            metadataSnapshots.didUpsert(updated)
+        }
+        return updated
     }
 
     /// Removes all `MetadataRecords` that don't correspond to any stored session.
@@ -233,7 +245,8 @@ extension EmbraceStorage {
         }
 
         request.predicate = NSCompoundPredicate(type: .or, subpredicates: [sessionPredicate, processPredicate])
-        coreData.deleteRecords(withRequest: request)
+        coreData.batchDeleteRecords(withRequest: request)
+        metadataSnapshots.invalidate()
     }
 
     /// Removes the `MetadataRecord` for the given values.
@@ -245,6 +258,7 @@ extension EmbraceStorage {
     ) {
         let request = fetchMetadataRequest(key: key, type: type, lifespan: lifespan, lifespanId: lifespanId)
         coreData.deleteRecords(withRequest: request)
+        metadataSnapshots.didRemove(key: key, type: type, lifespan: lifespan, lifespanId: lifespanId)
     }
 
     /// Removes all `MetadataRecords` for the given type and lifespans.
@@ -268,6 +282,9 @@ extension EmbraceStorage {
         request.predicate = NSCompoundPredicate(type: .and, subpredicates: [typePredicate, lifespansPredicate])
 
         coreData.deleteRecords(withRequest: request)
+
+        let lifespansRaw = Set(lifespans.map { $0.rawValue })
+        metadataSnapshots.didRemove { $0.typeRaw == type.rawValue && lifespansRaw.contains($0.lifespanRaw) }
     }
 
     /// Removes all `MetadataRecords` for the given keys and timespan.
@@ -291,6 +308,11 @@ extension EmbraceStorage {
         request.predicate = NSCompoundPredicate(type: .and, subpredicates: [typePredicate, keyPredicate])
 
         coreData.deleteRecords(withRequest: request)
+
+        let removedKeys = Set(keys)
+        metadataSnapshots.didRemove {
+            $0.typeRaw != MetadataRecordType.requiredResource.rawValue && removedKeys.contains($0.key)
+        }
     }
 
     /// Returns the permanent required resource for the given key.
@@ -301,7 +323,7 @@ extension EmbraceStorage {
     /// Increments the numeric value by 1 of a permanent resource for the given key.
     /// If no record exists it will create one with a value of 1.
     public func incrementCountForPermanentResource(key: String) -> EMBInt {
-        coreData.performOperation(save: true) { context in
+        let (count, metadata): (EMBInt, EmbraceMetadata?) = coreData.performOperation(save: true) { context in
             // fetch existing metadata
             let request = fetchMetadataRequest(key: key, type: .requiredResource, lifespan: .permanent)
 
@@ -309,11 +331,11 @@ extension EmbraceStorage {
             if let metadata = fetchMetadata(request: request, context: context) {
                 let val = (EMBInt(metadata.value) ?? 0) + 1
                 metadata.value = String(val)
-                return val
+                return (val, metadata.toImmutable())
                 // create it with a value of 1 if it doesn't exist
             } else {
                 let val: EMBInt = 1
-                _ = MetadataRecord.create(
+                let metadata = MetadataRecord.create(
                     context: context,
                     key: key,
                     value: String(val),
@@ -321,9 +343,14 @@ extension EmbraceStorage {
                     lifespan: .permanent,
                     lifespanId: ""
                 )
-                return val
+                return (val, metadata)
             }
         }
+
+        if let metadata {
+            metadataSnapshots.didUpsert(metadata)
+        }
+        return count
     }
 
     /// Returns immutable copies of all records with types `.requiredResource` or `.resource`
@@ -350,27 +377,7 @@ extension EmbraceStorage {
 
     /// Returns immutable copies of all records with types `.requiredResource` or `.resource` that are tied to a given session id or process id
     public func fetchResources(sessionId: String, processId: String) -> [EmbraceMetadata] {
-
-        let request = MetadataRecord.createFetchRequest()
-        request.predicate = NSCompoundPredicate(
-            type: .and,
-            subpredicates: [
-                resourcePredicate(),
-                lifespanPredicate(sessionId: sessionId, processId: processId)
-            ]
-        )
-
-        // fetch
-        var result: [EmbraceMetadata] = []
-        coreData.fetchAndPerform(withRequest: request) { records in
-
-            // convert to immutable structs
-            result = records.map {
-                $0.toImmutable()
-            }
-        }
-
-        return result
+        visibleMetadata(sessionId: sessionId, processId: processId).filter(isResource)
     }
 
     /// Returns immutable copies of all records with types `.requiredResource` or `.resource` that are tied to a given session id
@@ -384,51 +391,12 @@ extension EmbraceStorage {
 
     /// Returns immutable copies of all records with types `.requiredResource` or `.resource` that are tied to a given process id
     public func fetchResourcesForProcessId(_ processId: EmbraceIdentifier) -> [EmbraceMetadata] {
-
-        let request = MetadataRecord.createFetchRequest()
-        request.predicate = NSCompoundPredicate(
-            type: .and,
-            subpredicates: [
-                resourcePredicate(),
-                lifespanPredicate(processId: processId.stringValue)
-            ]
-        )
-
-        // fetch
-        var result: [EmbraceMetadata] = []
-        coreData.fetchAndPerform(withRequest: request) { records in
-
-            // convert to immutable structs
-            result = records.map {
-                $0.toImmutable()
-            }
-        }
-
-        return result
+        visibleMetadata(sessionId: nil, processId: processId.stringValue).filter(isResource)
     }
 
     /// Returns immutable copies of all records of the `.customProperty` type that are tied to a given session id and process id
     public func fetchCustomProperties(sessionId: String, processId: String) -> [EmbraceMetadata] {
-        let request = MetadataRecord.createFetchRequest()
-        request.predicate = NSCompoundPredicate(
-            type: .and,
-            subpredicates: [
-                customPropertyPredicate(),
-                lifespanPredicate(sessionId: sessionId, processId: processId)
-            ]
-        )
-
-        // fetch
-        var result: [EmbraceMetadata] = []
-        coreData.fetchAndPerform(withRequest: request) { records in
-
-            // convert to immutable structs
-            result = records.map {
-                $0.toImmutable()
-            }
-        }
-
-        return result
+        visibleMetadata(sessionId: sessionId, processId: processId).filter { $0.type == .customProperty }
     }
 
     /// Returns immutable copies of all records of the `.customProperty` type that are tied to a given session id
@@ -442,26 +410,7 @@ extension EmbraceStorage {
 
     /// Returns immutable copies of all records of the `.personaTag` type that are tied to a given session id and process id
     public func fetchPersonaTags(sessionId: String, processId: String) -> [EmbraceMetadata] {
-        let request = MetadataRecord.createFetchRequest()
-        request.predicate = NSCompoundPredicate(
-            type: .and,
-            subpredicates: [
-                personaTagPredicate(),
-                lifespanPredicate(sessionId: sessionId, processId: processId)
-            ]
-        )
-
-        // fetch
-        var result: [EmbraceMetadata] = []
-        coreData.fetchAndPerform(withRequest: request) { records in
-
-            // convert to immutable structs
-            result = records.map {
-                $0.toImmutable()
-            }
-        }
-
-        return result
+        visibleMetadata(sessionId: sessionId, processId: processId).filter { $0.type == .personaTag }
     }
 
     /// Returns immutable copies of all records of the `.personaTag` type that are tied to a given session id
@@ -475,27 +424,7 @@ extension EmbraceStorage {
 
     /// Returns immutable copies of all records of the `.personaTag` type that are tied to a given process id
     public func fetchPersonaTagsForProcessId(_ processId: EmbraceIdentifier) -> [EmbraceMetadata] {
-
-        let request = MetadataRecord.createFetchRequest()
-        request.predicate = NSCompoundPredicate(
-            type: .and,
-            subpredicates: [
-                personaTagPredicate(),
-                lifespanPredicate(processId: processId.stringValue)
-            ]
-        )
-
-        // fetch
-        var result: [EmbraceMetadata] = []
-        coreData.fetchAndPerform(withRequest: request) { records in
-
-            // convert to immutable structs
-            result = records.map {
-                $0.toImmutable()
-            }
-        }
-
-        return result
+        visibleMetadata(sessionId: nil, processId: processId.stringValue).filter { $0.type == .personaTag }
     }
 }
 
@@ -536,20 +465,46 @@ extension EmbraceStorage {
         }
     }
 
-    private func resourcePredicate() -> NSPredicate {
-        return NSPredicate(
-            format: "typeRaw == %@ OR typeRaw == %@",
-            MetadataRecordType.resource.rawValue,
-            MetadataRecordType.requiredResource.rawValue
-        )
+    private func isResource(_ metadata: EmbraceMetadata) -> Bool {
+        metadata.type == .resource || metadata.type == .requiredResource
     }
 
-    private func customPropertyPredicate() -> NSPredicate {
-        return NSPredicate(format: "typeRaw == %@", MetadataRecordType.customProperty.rawValue)
+    /// Returns every record visible to the given session (or to the process alone, if `sessionId` is nil):
+    /// its session records, its process records and all permanent records.
+    /// Served from the scope's snapshot; the first read of a scope fetches it from the store.
+    private func visibleMetadata(sessionId: String?, processId: String) -> [EmbraceMetadata] {
+        let scope = MetadataSnapshotIndex.Scope(sessionId: sessionId, processId: processId)
+        if let snapshot = metadataSnapshots.snapshot(for: scope) {
+            return snapshot
+        }
+
+        let generation = metadataSnapshots.generation
+        let records = queryMetadata(sessionId: sessionId, processId: processId)
+        metadataSnapshots.store(records, for: scope, generation: generation)
+
+        return records
     }
 
-    private func personaTagPredicate() -> NSPredicate {
-        return NSPredicate(format: "typeRaw == %@", MetadataRecordType.personaTag.rawValue)
+    /// Fetches the records visible to the given scope straight from the store.
+    func queryMetadata(sessionId: String?, processId: String) -> [EmbraceMetadata] {
+        let request = MetadataRecord.createFetchRequest()
+        if let sessionId {
+            request.predicate = lifespanPredicate(sessionId: sessionId, processId: processId)
+        } else {
+            request.predicate = lifespanPredicate(processId: processId)
+        }
+
+        // fetch
+        var result: [EmbraceMetadata] = []
+        coreData.fetchAndPerform(withRequest: request) { records in
+
+            // convert to immutable structs
+            result = records.map {
+                $0.toImmutable()
+            }
+        }
+
+        return result
     }
 
     private func lifespanPredicate(sessionId: String, processId: String) -> NSPredicate {
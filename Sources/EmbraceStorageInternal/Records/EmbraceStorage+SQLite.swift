@@ -0,0 +1,336 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+import OpenTelemetryApi
+
+#if !EMBRACE_COCOAPOD_BUILDING_SDK
+    import EmbraceCommonInternal
+    import EmbraceSemantics
+    import EmbraceSQLiteInternal
+#endif
+
+// Span, session and log operations backed by `SQLiteStore`, used when the storage is created with
+// `StorageEngine.sqlite`. Every public storage method checks `sqlite` first and forwards here.
+// Metadata records stay in Core Data for both engines.
+
+extension EmbraceStorage {
+
+    /// Runs `body`, logging and swallowing SQLite errors the same way the Core Data paths do.
+    func sqliteOperation<T>(_ name: String, fallback: T, _ body: () throws -> T) -> T {
+        do {
+            return try body()
+        } catch {
+            logger.critical("Error \(name):\n\(error.localizedDescription)")
+            return fallback
+        }
+    }
+
+    // MARK: - Spans
+
+    func upsertSpan(
+        _ store: SQLiteStore,
+        id: String,
+        name: String,
+        traceId: String,
+        type: SpanType,
+        data: Data,
+        startTime: Date,
+        endTime: Date?,
+        processId: EmbraceIdentifier,
+        sessionId: EmbraceIdentifier?
+    ) -> EmbraceSpan? {
+        sqliteOperation("upserting span", fallback: nil) {
+            let row = SQLiteSpanRow(
+                id: id,
+                traceId: traceId,
+                name: name,
+                type: type.rawValue,
+                data: data,
+                startTime: startTime,
+                endTime: endTime,
+                processId: processId.stringValue,
+                sessionId: sessionId?.stringValue
+            )
+
+            switch try store.upsertSpan(row) {
+            case .inserted:
+                // only new rows can push the type over its limit
+                try store.trimSpans(
+                    typePrefix: type.rawValue,
+                    limit: options.spanLimits[type, default: limitByType(type)],
+                    keeping: (id: id, traceId: traceId)
+                )
+                return try immutableSpan(row, store: store)
+
+            case .updated:
+                return try immutableSpan(row, store: store)
+
+            case .ignored:
+                return try fetchSpan(store, id: id, traceId: traceId)
+            }
+        }
+    }
+
+    func addEventsToSpan(_ store: SQLiteStore, id: String, traceId: String, events: [EmbraceSpanEvent]) {
+        sqliteOperation("adding span events", fallback: ()) {
+            try store.addSpanEvents(
+                events.map {
+                    SQLiteSpanEventRow(name: $0.name, timestamp: $0.timestamp, attributes: $0.attributes)
+                },
+                spanId: id,
+                traceId: traceId
+            )
+        }
+    }
+
+    func endSpan(_ store: SQLiteStore, id: String, traceId: String, endTime: Date) {
+        sqliteOperation("ending span", fallback: ()) {
+            try store.endSpan(id: id, traceId: traceId, endTime: endTime)
+        }
+    }
+
+    func fetchSpan(_ store: SQLiteStore, id: String, traceId: String) throws -> EmbraceSpan? {
+        guard let row = try store.span(id: id, traceId: traceId) else {
+            return nil
+        }
+        return try immutableSpan(row, store: store)
+    }
+
+    func cleanUpSpans(_ store: SQLiteStore, date: Date?) {
+        sqliteOperation("cleaning up spans", fallback: ()) {
+            if let date {
+                try store.deleteClosedSpans(endedBefore: date)
+            } else {
+                try store.deleteClosedSpans(excludingProcessId: ProcessIdentifier.current.stringValue)
+            }
+        }
+    }
+
+    func closeOpenSpans(_ store: SQLiteStore, endTime: Date) {
+        sqliteOperation("closing open spans", fallback: ()) {
+            try store.closeOpenSpans(excludingProcessId: ProcessIdentifier.current.stringValue, endTime: endTime)
+        }
+    }
+
+    func fetchSpans(_ store: SQLiteStore, for session: EmbraceSession, ignoreSessionSpans: Bool) -> [EmbraceSpan] {
+        let endTime = session.endTime ?? session.lastHeartbeatTime
+
+        let filter: SQLiteSpanSessionFilter =
+            session.coldStart
+            ? .process(processId: session.processIdRaw, endTime: endTime)
+            : .overlapping(sessionId: session.idRaw, startTime: session.startTime, endTime: endTime)
+
+        return sqliteOperation("fetching spans", fallback: []) {
+            var result: [EmbraceSpan] = []
+            try store.forEachSpan(
+                in: filter,
+                excludingType: ignoreSessionSpans ? SpanType.session.rawValue : nil,
+                limit: jsonSpansLimit
+            ) {
+                result.append(try immutableSpan($0, store: store))
+                return true
+            }
+            return result
+        }
+    }
+
+    private func immutableSpan(_ row: SQLiteSpanRow, store: SQLiteStore) throws -> EmbraceSpan {
+        let events = try store.spanEvents(spanId: row.id, traceId: row.traceId).map {
+            ImmutableSpanEventRecord(name: $0.name, timestamp: $0.timestamp, attributes: $0.attributes)
+        }
+
+        return ImmutableSpanRecord(
+            id: row.id,
+            name: row.name,
+            traceId: row.traceId,
+            typeRaw: row.type,
+            data: row.data,
+            startTime: row.startTime,
+            endTime: row.endTime,
+            processIdRaw: row.processId,
+            events: events
+        )
+    }
+
+    // MARK: - Sessions
+
+    func addSession(_ store: SQLiteStore, _ session: ImmutableSessionRecord, completion: (() -> Void)?) {
+        sqliteOperation("adding session", fallback: ()) {
+            try store.insertSession(
+                SQLiteSessionRow(
+                    id: session.idRaw,
+                    processId: session.processIdRaw,
+                    state: session.state,
+                    traceId: session.traceId,
+                    spanId: session.spanId,
+                    startTime: session.startTime,
+                    endTime: session.endTime,
+                    lastHeartbeatTime: session.lastHeartbeatTime,
+                    crashReportId: session.crashReportId,
+                    coldStart: session.coldStart,
+                    cleanExit: session.cleanExit,
+                    appTerminated: session.appTerminated,
+                    sessionNumber: Int(session.sessionNumber)
+                )
+            )
+        }
+
+        if let completion {
+            DispatchQueue.global(qos: .default).async {
+                completion()
+            }
+        }
+    }
+
+    func fetchSession(_ store: SQLiteStore, id: EmbraceIdentifier) -> EmbraceSession? {
+        sqliteOperation("fetching session", fallback: nil) {
+            try store.session(id: id.stringValue).map(immutableSession)
+        }
+    }
+
+    func deleteSession(_ store: SQLiteStore, id: EmbraceIdentifier) {
+        sqliteOperation("deleting session", fallback: ()) {
+            try store.deleteSession(id: id.stringValue)
+        }
+    }
+
+    func fetchLatestSession(_ store: SQLiteStore, ignoringCurrentSessionId sessionId: EmbraceIdentifier?) -> EmbraceSession? {
+        sqliteOperation("fetching latest session", fallback: nil) {
+            try store.latestSession(excludingId: sessionId?.stringValue).map(immutableSession)
+        }
+    }
+
+    func fetchOldestSession(_ store: SQLiteStore, ignoringCurrentSessionId sessionId: EmbraceIdentifier?) -> EmbraceSession? {
+        sqliteOperation("fetching oldest session", fallback: nil) {
+            try store.oldestSession(excludingId: sessionId?.stringValue).map(immutableSession)
+        }
+    }
+
+    func fetchAllSessions(_ store: SQLiteStore) -> [EmbraceSession] {
+        sqliteOperation("fetching sessions", fallback: []) {
+            var result: [EmbraceSession] = []
+            try store.forEachSession {
+                result.append(immutableSession($0))
+                return true
+            }
+            return result
+        }
+    }
+
+    func updateSession(
+        _ store: SQLiteStore,
+        id: EmbraceIdentifier,
+        state: SessionState?,
+        lastHeartbeatTime: Date?,
+        endTime: Date?,
+        cleanExit: Bool?,
+        appTerminated: Bool?,
+        crashReportId: String?
+    ) {
+        sqliteOperation("updating session", fallback: ()) {
+            try store.updateSession(
+                id: id.stringValue,
+                state: state?.rawValue,
+                lastHeartbeatTime: lastHeartbeatTime,
+                endTime: endTime,
+                cleanExit: cleanExit,
+                appTerminated: appTerminated,
+                crashReportId: crashReportId
+            )
+        }
+    }
+
+    private func immutableSession(_ row: SQLiteSessionRow) -> EmbraceSession {
+        return ImmutableSessionRecord(
+            idRaw: row.id,
+            processIdRaw: row.processId,
+            state: row.state,
+            traceId: row.traceId,
+            spanId: row.spanId,
+            startTime: row.startTime,
+            endTime: row.endTime,
+            lastHeartbeatTime: row.lastHeartbeatTime,
+            crashReportId: row.crashReportId,
+            coldStart: row.coldStart,
+            cleanExit: row.cleanExit,
+            appTerminated: row.appTerminated,
+            sessionNumber: EMBInt(row.sessionNumber)
+        )
+    }
+
+    // MARK: - Logs
+
+    func createLog(
+        _ store: SQLiteStore,
+        id: EmbraceIdentifier,
+        processId: EmbraceIdentifier,
+        severity: LogSeverity,
+        body: String,
+        timestamp: Date,
+        attributes: [String: AttributeValue]
+    ) -> EmbraceLog? {
+        let row = SQLiteLogRow(
+            id: id.stringValue,
+            processId: processId.stringValue,
+            sessionId: attributes[LogSemantics.keySessionId]?.description,
+            severity: severity.rawValue,
+            body: body,
+            timestamp: timestamp,
+            attributes: attributes.map {
+                SQLiteLogRow.Attribute(key: $0.key, value: $0.value.description, type: logAttributeType($0.value).rawValue)
+            }
+        )
+
+        return sqliteOperation("creating log", fallback: nil) {
+            try store.insertLogs([row])
+            return immutableLog(row)
+        }
+    }
+
+    func fetchAllLogs(_ store: SQLiteStore, excludingProcessIdentifier processIdentifier: EmbraceIdentifier) -> [EmbraceLog] {
+        sqliteOperation("fetching logs", fallback: []) {
+            var result: [EmbraceLog] = []
+            try store.forEachLog(excludingProcessId: processIdentifier.stringValue) {
+                result.append(immutableLog($0))
+                return true
+            }
+            return result
+        }
+    }
+
+    func remove(_ store: SQLiteStore, logs: [EmbraceLog]) {
+        sqliteOperation("removing logs", fallback: ()) {
+            try store.deleteLogs(logs.map { (id: $0.idRaw, processId: $0.processIdRaw) })
+        }
+    }
+
+    func removeAllLogs(_ store: SQLiteStore) {
+        sqliteOperation("removing logs", fallback: ()) {
+            try store.deleteAllLogs()
+        }
+    }
+
+    private func logAttributeType(_ value: AttributeValue) -> EmbraceLogAttributeType {
+        switch value {
+        case .int: return .int
+        case .double: return .double
+        case .bool: return .bool
+        default: return .string
+        }
+    }
+
+    private func immutableLog(_ row: SQLiteLogRow) -> EmbraceLog {
+        return ImmutableLogRecord(
+            idRaw: row.id,
+            processIdRaw: row.processId,
+            severityRaw: row.severity,
+            body: row.body,
+            timestamp: row.timestamp,
+            attributes: row.attributes.map {
+                ImmutableLogAttributeRecord(key: $0.key, valueRaw: $0.value, typeRaw: $0.type)
+            }
+        )
+    }
+}
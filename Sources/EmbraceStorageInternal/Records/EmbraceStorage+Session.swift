@@ -44,6 +44,26 @@ extension EmbraceStorage {
 
         let hbTime = lastHeartbeatTime ?? Date()
 
+        if let sqlite {
+            let session = ImmutableSessionRecord(
+                idRaw: id.stringValue,
+                processIdRaw: processId.stringValue,
+                state: state.rawValue,
+                traceId: traceId,
+                spanId: spanId,
+                startTime: startTime,
+                endTime: endTime,
+                lastHeartbeatTime: hbTime,
+                crashReportId: crashReportId,
+                coldStart: coldStart,
+                cleanExit: cleanExit,
+                appTerminated: appTerminated,
+                sessionNumber: sessionNumber
+            )
+            addSession(sqlite, session, completion: completion)
+            return session
+        }
+
         coreData.performAsyncOperation { [self] _ in
 
             defer {
@@ -74,7 +94,9 @@ extension EmbraceStorage {
                 return
             }
 
-            coreData.save()
+            // session records are committed right away, whatever the commit policy.
+            // they tell the next launch how this one ended
+            coreData.flush()
         }
 
         return ImmutableSessionRecord(
@@ -106,6 +128,9 @@ extension EmbraceStorage {
     ///   - id: Identifier of the session
     /// - Returns: Immutable copy of the stored `SessionRecord`, if any
     public func fetchSession(id: EmbraceIdentifier) -> EmbraceSession? {
+        if let sqlite {
+            return fetchSession(sqlite, id: id)
+        }
 
         // fetch
         let request = fetchSessionRequest(id: id)
@@ -120,6 +145,11 @@ extension EmbraceStorage {
 
     /// Asynchronously deletes the given session from the storage
     public func deleteSession(id: EmbraceIdentifier) {
+        if let sqlite {
+            deleteSession(sqlite, id: id)
+            return
+        }
+
         let request = fetchSessionRequest(id: id)
         coreData.deleteRecordsAsync(withRequest: request)
     }
@@ -129,6 +159,10 @@ extension EmbraceStorage {
     public func fetchLatestSession(
         ignoringCurrentSessionId sessionId: EmbraceIdentifier? = nil
     ) -> EmbraceSession? {
+        if let sqlite {
+            return fetchLatestSession(sqlite, ignoringCurrentSessionId: sessionId)
+        }
+
         let request = SessionRecord.createFetchRequest()
         request.fetchLimit = 1
         request.sortDescriptors = [NSSortDescriptor(key: "startTime", ascending: false)]
@@ -152,6 +186,13 @@ extension EmbraceStorage {
         ignoringCurrentSessionId sessionId: EmbraceIdentifier? = nil,
         _ completion: @escaping (EmbraceSession?) -> Void
     ) {
+        if let sqlite {
+            DispatchQueue.global(qos: .default).async { [self] in
+                completion(fetchLatestSession(sqlite, ignoringCurrentSessionId: sessionId))
+            }
+            return
+        }
+
         coreData.performAsyncOperation { [self] _ in
 
             let request = SessionRecord.createFetchRequest()
@@ -178,6 +219,10 @@ extension EmbraceStorage {
     /// Synchronously fetches the oldest session in the storage, if any.
     /// - Returns: Immutable copy of the oldest stored `SessionRecord`, if any
     public func fetchOldestSession(ignoringCurrentSessionId sessionId: EmbraceIdentifier? = nil) -> EmbraceSession? {
+        if let sqlite {
+            return fetchOldestSession(sqlite, ignoringCurrentSessionId: sessionId)
+        }
+
         let request = SessionRecord.createFetchRequest()
         request.fetchLimit = 1
         request.sortDescriptors = [NSSortDescriptor(key: "startTime", ascending: true)]
@@ -199,6 +244,10 @@ extension EmbraceStorage {
     /// Synchronously fetches all the sessions in the storage, if any
     /// - Returns: Immutable copies of all the stored sessions
     public func fetchAllSessions() -> [EmbraceSession] {
+        if let sqlite {
+            return fetchAllSessions(sqlite)
+        }
+
         let request = SessionRecord.createFetchRequest()
 
         // fetch
@@ -230,6 +279,27 @@ extension EmbraceStorage {
             return nil
         }
 
+        if let sqlite {
+            updateSession(
+                sqlite,
+                id: sessionId,
+                state: state,
+                lastHeartbeatTime: lastHeartbeatTime,
+                endTime: endTime,
+                cleanExit: cleanExit,
+                appTerminated: appTerminated,
+                crashReportId: crashReportId
+            )
+            return session.updated(
+                state: state,
+                lastHeartbeatTime: lastHeartbeatTime,
+                endTime: endTime,
+                cleanExit: cleanExit,
+                appTerminated: appTerminated,
+                crashReportId: crashReportId
+            )
+        }
+
         coreData.performAsyncOperation { [self] context in
 
             let request = fetchSessionRequest(id: sessionId)
@@ -262,7 +332,8 @@ extension EmbraceStorage {
                 fetchedSession.crashReportId = crashReportId
             }
 
-            coreData.save()
+            // committed right away, like new sessions
+            coreData.flush()
         }
 
         return session.updated(
@@ -277,7 +348,8 @@ extension EmbraceStorage {
 }
 
 extension EmbraceSession {
-    func updated(
+    /// Immutable copy of the session with the given values replaced.
+    public func updated(
         state: SessionState? = nil,
         lastHeartbeatTime: Date? = nil,
         endTime: Date? = nil,
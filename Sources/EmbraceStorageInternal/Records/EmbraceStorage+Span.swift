@@ -37,6 +37,21 @@ extension EmbraceStorage {
         sessionId: EmbraceIdentifier? = nil
     ) -> EmbraceSpan? {
 
+        if let sqlite {
+            return upsertSpan(
+                sqlite,
+                id: id,
+                name: name,
+                traceId: traceId,
+                type: type,
+                data: data,
+                startTime: startTime,
+                endTime: endTime,
+                processId: processId,
+                sessionId: sessionId
+            )
+        }
+
         // update existing?
         if let span = updateExistingSpan(
             id: id,
@@ -56,23 +71,34 @@ extension EmbraceStorage {
         removeOldSpanIfNeeded(forType: type)
 
         // add new
-        if let span = SpanRecord.create(
-            context: coreData.context,
-            id: id,
-            name: name,
-            traceId: traceId,
-            type: type,
-            data: data,
-            startTime: startTime,
-            endTime: endTime,
-            processId: processId,
-            sessionId: sessionId
-        ) {
-            coreData.save()
-            return span
+        var result: EmbraceSpan?
+        coreData.performOperation(save: true) { context in
+            guard
+                let record = SpanRecord.insert(
+                    context: context,
+                    id: id,
+                    name: name,
+                    traceId: traceId,
+                    type: type,
+                    data: data,
+                    startTime: startTime,
+                    endTime: endTime,
+                    processId: processId,
+                    sessionId: sessionId
+                )
+            else {
+                return
+            }
+
+            openSpans.didInsert(typeRaw: record.typeRaw)
+            if endTime == nil {
+                openSpans.insert(record, id: id, traceId: traceId)
+            }
+
+            result = record.toImmutable()
         }
 
-        return nil
+        return result
     }
 
     func fetchSpanRequest(id: String, traceId: String) -> NSFetchRequest<SpanRecord> {
@@ -83,6 +109,29 @@ extension EmbraceStorage {
         return request
     }
 
+    /// Finds the record for the given span. Open spans are served by the index; anything else is fetched.
+    /// - Important: Must be called on the context's queue.
+    func findSpanRecord(id: String, traceId: String, in context: NSManagedObjectContext) -> SpanRecord? {
+        if let record = openSpans.record(id: id, traceId: traceId) {
+            return record
+        }
+
+        do {
+            guard let record = try context.fetch(fetchSpanRequest(id: id, traceId: traceId)).first else {
+                return nil
+            }
+
+            // spans persisted by an earlier storage instance join the index once they are touched
+            if record.endTime == nil {
+                openSpans.insert(record, id: id, traceId: traceId)
+            }
+            return record
+        } catch {
+            logger.critical("Error fetching span:\n\(error.localizedDescription)")
+        }
+        return nil
+    }
+
     /// Adds span events to a span
     /// - Parameters:
     ///   - id: Identifier of the span
@@ -93,12 +142,16 @@ extension EmbraceStorage {
 
         guard !events.isEmpty else { return }
 
-        let request = fetchSpanRequest(id: id, traceId: traceId)
-        coreData.fetchFirstAndPerform(withRequest: request) { span in
-            guard let span else { return }
+        if let sqlite {
+            addEventsToSpan(sqlite, id: id, traceId: traceId, events: events)
+            return
+        }
+
+        coreData.performOperation { context in
+            guard let span = findSpanRecord(id: id, traceId: traceId, in: context) else { return }
             for event in events {
                 if let rec = SpanEventRecord.create(
-                    context: coreData.context,
+                    context: context,
                     name: event.name,
                     timestamp: event.timestamp,
                     attributes: event.attributes,
@@ -126,12 +179,16 @@ extension EmbraceStorage {
     ) -> EmbraceSpan? {
         var result: EmbraceSpan?
 
-        let request = fetchSpanRequest(id: id, traceId: traceId)
-        coreData.fetchFirstAndPerform(withRequest: request) { span in
-            guard let span else { return }
+        coreData.performOperation { context in
+            guard let span = findSpanRecord(id: id, traceId: traceId, in: context) else { return }
 
             // prevent modifications on closed spans!
             if span.endTime == nil {
+                if span.typeRaw != type.rawValue {
+                    openSpans.didDelete(typeRaw: span.typeRaw)
+                    openSpans.didInsert(typeRaw: type.rawValue)
+                }
+
                 span.name = name
                 span.typeRaw = type.rawValue
                 span.data = data
@@ -140,6 +197,10 @@ extension EmbraceStorage {
                 span.processIdRaw = processId.stringValue
                 span.sessionIdRaw = sessionId?.stringValue
                 coreData.save()
+
+                if endTime != nil {
+                    openSpans.remove(id: id, traceId: traceId)
+                }
             }
 
             result = span.toImmutable()
@@ -154,15 +215,20 @@ extension EmbraceStorage {
     ///   - id: Identifier of the span
     ///   - traceId: Identifier of the trace containing this span
     public func endSpan(id: String, traceId: String, endTime: Date) {
-        coreData.performAsyncOperation { [self] _ in
-            let request = fetchSpanRequest(id: id, traceId: traceId)
-            guard let span = coreData.fetch(withRequest: request).first else {
+        if let sqlite {
+            endSpan(sqlite, id: id, traceId: traceId, endTime: endTime)
+            return
+        }
+
+        coreData.performAsyncOperation { [self] context in
+            guard let span = findSpanRecord(id: id, traceId: traceId, in: context) else {
                 return
             }
             if span.endTime == nil {
                 span.endTime = endTime
                 coreData.save()
             }
+            openSpans.remove(id: id, traceId: traceId)
         }
     }
 
@@ -172,14 +238,17 @@ extension EmbraceStorage {
     ///   - traceId: Identifier of the trace containing this span
     /// - Returns: Immutable copy of rhe stored `SpanRecord`, if any
     public func fetchSpan(id: String, traceId: String) -> EmbraceSpan? {
+        if let sqlite {
+            return sqliteOperation("fetching span", fallback: nil) {
+                try fetchSpan(sqlite, id: id, traceId: traceId)
+            }
+        }
 
-        // fetch
-        let request = fetchSpanRequest(id: id, traceId: traceId)
         var result: EmbraceSpan?
 
-        coreData.fetchFirstAndPerform(withRequest: request) { record in
+        coreData.performOperation { context in
             // convert to immutable struct
-            result = record?.toImmutable()
+            result = findSpanRecord(id: id, traceId: traceId, in: context)?.toImmutable()
         }
         return result
     }
@@ -189,23 +258,40 @@ extension EmbraceStorage {
     /// will be removed.
     /// - Parameter date: Date used to determine which spans to remove
     public func cleanUpSpans(date: Date? = nil) {
+        if let sqlite {
+            cleanUpSpans(sqlite, date: date)
+            return
+        }
+
         let request = SpanRecord.createFetchRequest()
+        let eventsRequest = SpanEventRecord.createFetchRequest()
 
         if let date = date {
             request.predicate = NSPredicate(format: "endTime != nil AND endTime < %@", date as NSDate)
+            eventsRequest.predicate = NSPredicate(format: "span.endTime != nil AND span.endTime < %@", date as NSDate)
         } else {
             request.predicate = NSPredicate(
                 format: "endTime != nil AND processIdRaw != %@",
                 ProcessIdentifier.current.stringValue)
+            eventsRequest.predicate = NSPredicate(
+                format: "span.endTime != nil AND span.processIdRaw != %@",
+                ProcessIdentifier.current.stringValue)
         }
 
-        coreData.deleteRecords(withRequest: request)
+        // batch deletes skip the cascade rule, so events go first
+        coreData.batchDeleteRecords(withRequest: eventsRequest)
+        coreData.batchDeleteRecords(withRequest: request)
+        openSpans.invalidateCounts()
     }
 
     /// Synchronously closes all open spans from previous processes with the given `endTime`.
     /// - Parameters:
     ///   - endTime: Identifier of the trace containing this span
     public func closeOpenSpans(endTime: Date) {
+        if let sqlite {
+            closeOpenSpans(sqlite, endTime: endTime)
+            return
+        }
 
         let request = SpanRecord.createFetchRequest()
         request.predicate = NSPredicate(
@@ -216,6 +302,7 @@ extension EmbraceStorage {
         coreData.fetchAndPerform(withRequest: request) { [self] spans in
             for span in spans {
                 span.endTime = endTime
+                openSpans.remove(id: span.id, traceId: span.traceId)
             }
             coreData.save()
         }
@@ -234,6 +321,10 @@ extension EmbraceStorage {
         ignoreSessionSpans: Bool = true
     ) -> [EmbraceSpan] {
 
+        if let sqlite {
+            return fetchSpans(sqlite, for: session, ignoreSessionSpans: ignoreSessionSpans)
+        }
+
         let request = SpanRecord.createFetchRequest()
         request.fetchLimit = jsonSpansLimit
 
@@ -325,13 +416,33 @@ extension EmbraceStorage {
 
         let request = SpanRecord.createFetchRequest()
         request.predicate = NSPredicate(format: "typeRaw BEGINSWITH %@", type.rawValue)
-        let count = coreData.count(withRequest: request)
 
-        if count >= limit {
-            request.fetchLimit = count - limit + 1
-            request.sortDescriptors = [NSSortDescriptor(key: "startTime", ascending: true)]
+        // the count query only runs once per type; afterwards the index keeps it up to date
+        let count: Int
+        if let cached = openSpans.count(forType: type.rawValue) {
+            count = cached
+        } else {
+            count = coreData.count(withRequest: request)
+            openSpans.setCount(count, forType: type.rawValue)
+        }
+
+        guard count >= limit else {
+            return
+        }
 
-            coreData.deleteRecords(withRequest: request)
+        request.fetchLimit = count - limit + 1
+        request.sortDescriptors = [NSSortDescriptor(key: "startTime", ascending: true)]
+
+        coreData.performOperation(save: true) { context in
+            do {
+                for record in try context.fetch(request) {
+                    openSpans.didDelete(typeRaw: record.typeRaw)
+                    openSpans.remove(id: record.id, traceId: record.traceId)
+                    context.delete(record)
+                }
+            } catch {
+                logger.critical("Error deleting old spans:\n\(error.localizedDescription)")
+            }
         }
     }
 }
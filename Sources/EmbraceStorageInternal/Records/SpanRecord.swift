@@ -38,28 +38,56 @@ public class SpanRecord: NSManagedObject {
         var result: EmbraceSpan?
 
         context.performAndWait {
-            guard let description = NSEntityDescription.entity(forEntityName: Self.entityName, in: context) else {
-                return
-            }
-
-            let record = SpanRecord(entity: description, insertInto: context)
-            record.id = id
-            record.name = name
-            record.traceId = traceId
-            record.typeRaw = type.rawValue
-            record.data = data
-            record.startTime = startTime
-            record.endTime = endTime
-            record.processIdRaw = processId.stringValue
-            record.sessionIdRaw = sessionId?.stringValue
-            record.events = Set()
-
-            result = record.toImmutable()
+            result = insert(
+                context: context,
+                id: id,
+                name: name,
+                traceId: traceId,
+                type: type,
+                data: data,
+                startTime: startTime,
+                endTime: endTime,
+                processId: processId,
+                sessionId: sessionId
+            )?.toImmutable()
         }
 
         return result
     }
 
+    /// Inserts a new record into the context and returns it.
+    /// - Important: Must be called on the context's queue.
+    class func insert(
+        context: NSManagedObjectContext,
+        id: String,
+        name: String,
+        traceId: String,
+        type: SpanType,
+        data: Data,
+        startTime: Date,
+        endTime: Date? = nil,
+        processId: EmbraceIdentifier,
+        sessionId: EmbraceIdentifier? = nil
+    ) -> SpanRecord? {
+        guard let description = NSEntityDescription.entity(forEntityName: Self.entityName, in: context) else {
+            return nil
+        }
+
+        let record = SpanRecord(entity: description, insertInto: context)
+        record.id = id
+        record.name = name
+        record.traceId = traceId
+        record.typeRaw = type.rawValue
+        record.data = data
+        record.startTime = startTime
+        record.endTime = endTime
+        record.processIdRaw = processId.stringValue
+        record.sessionIdRaw = sessionId?.stringValue
+        record.events = Set()
+
+        return record
+    }
+
     static func createFetchRequest() -> NSFetchRequest<SpanRecord> {
         return NSFetchRequest<SpanRecord>(entityName: entityName)
     }
@@ -9,15 +9,26 @@ import Foundation
     import EmbraceOTelInternal
     import EmbraceCommonInternal
     import EmbraceCoreDataInternal
+    import EmbraceSQLiteInternal
 #endif
 
 /// Class that handles all the cached upload data generated by the Embrace SDK.
+/// Backed by Core Data, or by SQLite when `options.engine` is `.sqlite`.
 class EmbraceUploadCache {
 
     private(set) var options: EmbraceUpload.CacheOptions
     let coreData: CoreDataWrapper
+    let sqlite: SQLiteStore?
     let logger: InternalLogger
 
+    /// Number of stored records, counted once and then kept up to date on every insert and delete
+    /// so enforcing `cacheLimit` doesn't count the whole table on each save.
+    /// Only accessed on the Core Data context queue.
+    private var recordCount: Int?
+
+    /// Number of times records were evicted to stay under `cacheLimit`, so callers can tell a save dropped older records.
+    private(set) var evictionCount = 0
+
     init(options: EmbraceUpload.CacheOptions, logger: InternalLogger) throws {
         self.options = options
         self.logger = logger
@@ -34,13 +45,33 @@ class EmbraceUploadCache {
             try? FileManager.default.removeItem(at: cacheUrl)
         }
 
+        if options.resetCache,
+            let sqliteUrl = options.storageMechanism.sqliteFileURL
+        {
+            for suffix in ["", "-wal", "-shm"] {
+                try? FileManager.default.removeItem(atPath: sqliteUrl.path + suffix)
+            }
+        }
+
         // create core data stack
+        // (kept in memory when SQLite holds the data, so no empty store is left on disk)
         let coreDataOptions = CoreDataWrapper.Options(
-            storageMechanism: options.storageMechanism,
+            storageMechanism: options.engine == .sqlite
+                ? .inMemory(name: options.storageMechanism.name)
+                : options.storageMechanism,
             enableBackgroundTasks: options.enableBackgroundTasks,
             entities: [UploadDataRecord.entityDescription]
         )
         self.coreData = try CoreDataWrapper(options: coreDataOptions, logger: logger)
+
+        switch options.engine {
+        case .coreData:
+            self.sqlite = nil
+        case .sqlite:
+            let location: SQLiteConnection.Location =
+                options.storageMechanism.sqliteFileURL.map { .file($0) } ?? .inMemory
+            self.sqlite = try SQLiteStore(location: location)
+        }
     }
 
     func fetchUploadDataRequest(id: String, type: EmbraceUploadType) -> NSFetchRequest<UploadDataRecord> {
@@ -55,15 +86,35 @@ class EmbraceUploadCache {
     /// - Parameters:
     ///   - id: Identifier of the data
     ///   - type: Type of the data
-    /// - Returns: The cached `UploadDataRecord`, if any
-    public func fetchUploadData(id: String, type: EmbraceUploadType) -> UploadDataRecord? {
-        let request = fetchUploadDataRequest(id: id, type: type)
-        return coreData.fetch(withRequest: request).first
+    /// - Returns: The cached data, if any
+    func fetchUploadData(id: String, type: EmbraceUploadType) -> ImmutableUploadDataRecord? {
+        if let sqlite {
+            return fetchUploadData(sqlite, id: id, type: type)
+        }
+
+        var result: ImmutableUploadDataRecord?
+        coreData.fetchFirstAndPerform(withRequest: fetchUploadDataRequest(id: id, type: type)) { record in
+            result = record?.toImmutable()
+        }
+        return result
+    }
+
+    /// Whether there's cached upload data for the given identifier.
+    func hasUploadData(id: String, type: EmbraceUploadType) -> Bool {
+        if let sqlite {
+            return (try? sqlite.uploadData(id: id, type: type.rawValue)) != nil
+        }
+
+        return coreData.count(withRequest: fetchUploadDataRequest(id: id, type: type)) > 0
     }
 
     /// Fetches all the cached upload data.
     /// - Returns: An array containing all the cached `UploadDataRecords`
     public func fetchAllUploadData() -> [ImmutableUploadDataRecord] {
+        if let sqlite {
+            return fetchUploadData(sqlite, type: nil, excludingIDs: [], limit: .max)
+        }
+
         let request = NSFetchRequest<UploadDataRecord>(entityName: UploadDataRecord.entityName)
 
         // fetch
@@ -89,6 +140,10 @@ class EmbraceUploadCache {
         excludingIDs: Set<String>,
         limit: Int
     ) -> [ImmutableUploadDataRecord] {
+        if let sqlite {
+            return fetchUploadData(sqlite, type: type.rawValue, excludingIDs: excludingIDs, limit: limit)
+        }
+
         let request = NSFetchRequest<UploadDataRecord>(entityName: UploadDataRecord.entityName)
         request.sortDescriptors = [NSSortDescriptor(key: "date", ascending: true)]
         request.fetchLimit = limit
@@ -118,8 +173,13 @@ class EmbraceUploadCache {
 
         let now = Date().timeIntervalSince1970
         let lastValidTime = now - TimeInterval(options.cacheDaysLimit * 86400)  // (60 * 60 * 24) = 86400 seconds per day
-        let recordsToDelete = fetchRecordsToDelete(dateLimit: Date(timeIntervalSince1970: lastValidTime))
-        let deleteCount = recordsToDelete.count
+
+        if let sqlite {
+            return clearStaleData(sqlite, dateLimit: Date(timeIntervalSince1970: lastValidTime))
+        }
+
+        let request = staleRecordsRequest(dateLimit: Date(timeIntervalSince1970: lastValidTime))
+        let deleteCount = coreData.count(withRequest: request)
 
         if deleteCount > 0 {
             let span = EmbraceOTel().buildSpan(
@@ -131,10 +191,10 @@ class EmbraceUploadCache {
             span.setStartTime(time: Date())
 
             let startedSpan = span.startSpan()
-            coreData.deleteRecords(recordsToDelete)
+            let removed = deleteRecords(withRequest: request)
             startedSpan.end()
 
-            return UInt(deleteCount)
+            return UInt(removed)
         }
 
         return 0
@@ -148,6 +208,9 @@ class EmbraceUploadCache {
     ///   - payloadTypes: Payload types, if any
     /// - Returns: Boolean indicating if the operation was successful
     @discardableResult func saveUploadData(id: String, type: EmbraceUploadType, data: Data, payloadTypes: String? = nil) -> Bool {
+        if let sqlite {
+            return saveUploadData(sqlite, id: id, type: type, data: data, payloadTypes: payloadTypes)
+        }
 
         coreData.performOperation { context in
 
@@ -157,7 +220,7 @@ class EmbraceUploadCache {
                 if let uploadData = try context.fetch(request).first {
                     uploadData.data = data
                     uploadData.payloadTypes = payloadTypes
-                    return coreData.saveIfNeeded()
+                    return coreData.flush()
                 }
             } catch {
                 logger.warning("Error upading upload data:\n\(error.localizedDescription)")
@@ -175,7 +238,8 @@ class EmbraceUploadCache {
                 payloadTypes: payloadTypes,
                 date: Date()
             ) {
-                if coreData.saveIfNeeded() {
+                if coreData.flush() {
+                    recordCount = recordCount.map { $0 + 1 }
                     return true
                 }
                 context.delete(record)
@@ -193,18 +257,16 @@ class EmbraceUploadCache {
 
         do {
             let request = NSFetchRequest<UploadDataRecord>(entityName: UploadDataRecord.entityName)
-            let count = try context.count(for: request)
+            let count = try recordCount ?? context.count(for: request)
+            recordCount = count
 
             if count >= self.options.cacheLimit {
                 request.sortDescriptors = [NSSortDescriptor(key: "date", ascending: true)]
                 request.fetchLimit = max(0, count - Int(self.options.cacheLimit) + 10)
 
-                let result = try context.fetch(request)
-                for uploadData in result {
-                    context.delete(uploadData)
+                if deleteRecords(withRequest: request) > 0 {
+                    evictionCount += 1
                 }
-
-                coreData.save()
             }
         } catch {
             logger.error("error checking count limit:\n\(error.localizedDescription)")
@@ -216,15 +278,124 @@ class EmbraceUploadCache {
     ///   - id: Identifier of the data
     ///   - type: Type of the data
     func deleteUploadData(id: String, type: EmbraceUploadType) {
+        if let sqlite {
+            do {
+                try sqlite.deleteUploadData(id: id, type: type.rawValue)
+            } catch {
+                logger.error("Error deleting upload data:\n\(error.localizedDescription)")
+            }
+            return
+        }
+
         let request = fetchUploadDataRequest(id: id, type: type)
-        coreData.deleteRecords(withRequest: request)
+        deleteRecords(withRequest: request)
     }
 
-    /// Fetches all records that should be deleted based on them being older than the passed date
-    func fetchRecordsToDelete(dateLimit: Date) -> [UploadDataRecord] {
+    /// Request for all records that are older than the passed date
+    func staleRecordsRequest(dateLimit: Date) -> NSFetchRequest<UploadDataRecord> {
         let request = NSFetchRequest<UploadDataRecord>(entityName: UploadDataRecord.entityName)
         request.predicate = NSPredicate(format: "date < %@", dateLimit as NSDate)
 
-        return coreData.fetch(withRequest: request)
+        return request
+    }
+
+    /// Deletes the matching records in the store without reading their data, keeping `recordCount` in sync.
+    @discardableResult
+    private func deleteRecords(withRequest request: NSFetchRequest<UploadDataRecord>) -> Int {
+        coreData.performOperation { _ in
+            let removed = coreData.batchDeleteRecords(withRequest: request)
+            recordCount = recordCount.map { max(0, $0 - removed) }
+            return removed
+        }
+    }
+}
+
+// MARK: - SQLite
+extension EmbraceUploadCache {
+
+    func fetchUploadData(_ store: SQLiteStore, id: String, type: EmbraceUploadType) -> ImmutableUploadDataRecord? {
+        do {
+            return try store.uploadData(id: id, type: type.rawValue).map {
+                ImmutableUploadDataRecord(id: $0.id, type: $0.type, data: $0.data, payloadTypes: $0.payloadTypes, date: $0.date)
+            }
+        } catch {
+            logger.error("Error fetching upload data:\n\(error.localizedDescription)")
+            return nil
+        }
+    }
+
+    func fetchUploadData(
+        _ store: SQLiteStore,
+        type: Int?,
+        excludingIDs: Set<String>,
+        limit: Int
+    ) -> [ImmutableUploadDataRecord] {
+        var result: [ImmutableUploadDataRecord] = []
+        do {
+            try store.forEachUploadData(type: type, excludingIds: excludingIDs, limit: limit) {
+                result.append(
+                    ImmutableUploadDataRecord(
+                        id: $0.id,
+                        type: $0.type,
+                        data: $0.data,
+                        payloadTypes: $0.payloadTypes,
+                        date: $0.date
+                    )
+                )
+                return true
+            }
+        } catch {
+            logger.error("Error fetching upload data:\n\(error.localizedDescription)")
+        }
+        return result
+    }
+
+    func saveUploadData(
+        _ store: SQLiteStore,
+        id: String,
+        type: EmbraceUploadType,
+        data: Data,
+        payloadTypes: String?
+    ) -> Bool {
+        do {
+            let evicted = try store.saveUploadData(
+                SQLiteUploadDataRow(id: id, type: type.rawValue, data: data, payloadTypes: payloadTypes, date: Date()),
+                countLimit: Int(options.cacheLimit)
+            )
+            if evicted > 0 {
+                evictionCount += 1
+            }
+            return true
+        } catch {
+            logger.warning("Error saving upload data:\n\(error.localizedDescription)")
+            return false
+        }
+    }
+
+    /// Deletes expired entries with a single `DELETE`; no payload is read.
+    func clearStaleData(_ store: SQLiteStore, dateLimit: Date) -> UInt {
+        do {
+            let deleteCount = try store.uploadDataCount(olderThan: dateLimit)
+            guard deleteCount > 0 else {
+                return 0
+            }
+
+            let span = EmbraceOTel().buildSpan(
+                name: "emb-upload-cache-vacuum",
+                type: .performance,
+                attributes: ["removed": "\(deleteCount)"]
+            )
+            .markAsPrivate()
+            span.setStartTime(time: Date())
+
+            let startedSpan = span.startSpan()
+            let removed = try store.deleteUploadData(olderThan: dateLimit)
+            startedSpan.end()
+
+            return UInt(removed)
+        } catch {
+            logger.error("Error clearing stale upload data:\n\(error.localizedDescription)")
+            return 0
+        }
     }
 }
@@ -38,6 +38,10 @@ public class EmbraceUpload: EmbraceLogUploader {
         .spans: [], .log: [], .attachment: []
     ]
 
+    /// Per-type callbacks waiting to know if a cached record was sent, see `uploadSpans(id:data:completion:deliveryCompletion:)`.
+    /// Read and written exclusively on the coordination queue.
+    private var deliveryCompletions: [EmbraceUploadType: [String: (Bool) -> Void]] = [:]
+
     private let urlSession: URLSession
     let cache: EmbraceUploadCache
     private var reachabilityMonitor: EmbraceReachabilityMonitor?
@@ -101,7 +105,9 @@ public class EmbraceUpload: EmbraceLogUploader {
             }
 
             // Clear stale data
-            self.cache.clearStaleDataIfNeeded()
+            if self.cache.clearStaleDataIfNeeded() > 0 {
+                self.failRemovedDeliveries()
+            }
 
             // Fill queues — records are fetched in date order.
             // inFlightIDs is NOT reset here. On internet reconnection, queues may still
@@ -120,13 +126,23 @@ public class EmbraceUpload: EmbraceLogUploader {
     ///   - id: Identifier of the session
     ///   - data: Data of the session's payload
     ///   - completion: Completion block called when the data is successfully cached, or when an `Error` occurs
-    public func uploadSpans(id: String, data: Data, completion: ((Result<(), Error>) -> Void)?) {
+    ///   - deliveryCompletion: Called on the coordination queue once the cached data was sent (`true`), or removed from
+    ///     the cache without being sent (`false`). Not called if caching fails, or for data left for the next launch.
+    public func uploadSpans(
+        id: String,
+        data: Data,
+        completion: ((Result<(), Error>) -> Void)?,
+        deliveryCompletion: ((Bool) -> Void)? = nil
+    ) {
+        EmbraceMemoryBudget.shared.track(data.count, for: .uploads)
         queue.async { [weak self] in
+            defer { EmbraceMemoryBudget.shared.release(data.count, for: .uploads) }
             self?.uploadData(
                 id: id,
                 data: data,
                 type: .spans,
-                completion: completion
+                completion: completion,
+                deliveryCompletion: deliveryCompletion
             )
         }
     }
@@ -138,7 +154,9 @@ public class EmbraceUpload: EmbraceLogUploader {
     ///   - payloadTypes: Comma separated list of all the emb.types of logs that are being uploaded
     ///   - completion: Completion block called when the data is successfully cached, or when an `Error` occurs
     public func uploadLog(id: String, data: Data, payloadTypes: String = "", completion: ((Result<(), Error>) -> Void)?) {
+        EmbraceMemoryBudget.shared.track(data.count, for: .uploads)
         queue.async { [weak self] in
+            defer { EmbraceMemoryBudget.shared.release(data.count, for: .uploads) }
             self?.uploadData(
                 id: id,
                 data: data,
@@ -150,12 +168,21 @@ public class EmbraceUpload: EmbraceLogUploader {
     }
 
     /// Uploads the given attachment data
+    /// Attachments are shed, failing with `shedUnderMemoryPressure`, when the SDK's memory budget is critical.
     /// - Parameters:
     ///   - id: Identifier of the attachment
     ///   - data: The attachment's data
     ///   - completion: Completion block called when the data is successfully cached, or when an `Error` occurs
     public func uploadAttachment(id: String, data: Data, completion: ((Result<(), Error>) -> Void)?) {
+        guard EmbraceMemoryBudget.shared.admitsLowPriorityUploads else {
+            EmbraceMemoryBudget.shared.recordDrop(.uploads)
+            completion?(.failure(EmbraceUploadError.internalError(.shedUnderMemoryPressure)))
+            return
+        }
+
+        EmbraceMemoryBudget.shared.track(data.count, for: .uploads)
         queue.async { [weak self] in
+            defer { EmbraceMemoryBudget.shared.release(data.count, for: .uploads) }
             self?.uploadData(
                 id: id,
                 data: data,
@@ -174,7 +201,8 @@ public class EmbraceUpload: EmbraceLogUploader {
         data: Data,
         type: EmbraceUploadType,
         payloadTypes: String? = nil,
-        completion: ((Result<(), Error>) -> Void)?
+        completion: ((Result<(), Error>) -> Void)?,
+        deliveryCompletion: ((Bool) -> Void)? = nil
     ) {
 
         // validate identifier
@@ -191,7 +219,18 @@ public class EmbraceUpload: EmbraceLogUploader {
 
         // Save to cache synchronously (we are on the coordination queue).
         // Data is durable after this call.
-        guard cache.saveUploadData(id: id, type: type, data: data, payloadTypes: payloadTypes) else {
+        let mkSpan = EmbraceMetricKitSpan.begin(name: "upload-cache-save")
+        let evictions = cache.evictionCount
+        let saved = cache.saveUploadData(id: id, type: type, data: data, payloadTypes: payloadTypes)
+        mkSpan.end()
+
+        // making room for this record can drop older ones before they were sent
+        if cache.evictionCount != evictions {
+            failRemovedDeliveries()
+        }
+
+        guard saved else {
+            EmbraceSelfMetrics.shared.count("upload-cache-failures")
             logger.debug("Error caching upload data!")
             completion?(.failure(EmbraceUploadError.internalError(.cacheSaveFailed)))
             return
@@ -200,6 +239,11 @@ public class EmbraceUpload: EmbraceLogUploader {
         // Signal durability to the caller
         completion?(.success(()))
 
+        // the previous data with the same identifier won't be sent anymore
+        if let deliveryCompletion {
+            deliveryCompletions[type, default: [:]].updateValue(deliveryCompletion, forKey: id)?(false)
+        }
+
         // Try to fill the queue (may create an operation for this record or leave it in cache)
         fillQueue(for: type)
     }
@@ -217,6 +261,12 @@ public class EmbraceUpload: EmbraceLogUploader {
 
         guard currentCount < limit else { return }
 
+        // cached attachments wait until memory isn't critical anymore,
+        // they're picked up by the next attachment upload or retry
+        if type == .attachment && !EmbraceMemoryBudget.shared.admitsLowPriorityUploads {
+            return
+        }
+
         let availableSlots = limit - currentCount
         let excludedIDs = inFlightIDs[type] ?? []
 
@@ -248,7 +298,12 @@ public class EmbraceUpload: EmbraceLogUploader {
         payloadTypes: String?
     ) -> EmbraceUploadOperation {
 
+        // the payload stays in memory until the operation finishes
+        let size = data.count
+        EmbraceMemoryBudget.shared.track(size, for: .uploads)
+
         let operationCompletion: EmbraceUploadOperationCompletion = { [weak self] result, _ in
+            EmbraceMemoryBudget.shared.release(size, for: .uploads)
             self?.queue.async { [weak self] in
                 self?.handleOperationFinished(id: id, type: type, result: result)
             }
@@ -299,6 +354,13 @@ public class EmbraceUpload: EmbraceLogUploader {
         // Remove from in-flight tracking
         inFlightIDs[type]?.remove(id)
 
+        // Uploads that keep failing make the memory budget hold back what's produced
+        switch result {
+        case .success: EmbraceMemoryBudget.shared.reportUpload(succeeded: true)
+        case .failure: EmbraceMemoryBudget.shared.reportUpload(succeeded: false)
+        case .cancelled: break
+        }
+
         // Delete from cache unless cancelled (cancelled records are replayed on next launch)
         switch result {
         case .success, .failure:
@@ -307,12 +369,30 @@ public class EmbraceUpload: EmbraceLogUploader {
             break
         }
 
+        switch result {
+        case .success: deliveryCompletions[type]?.removeValue(forKey: id)?(true)
+        case .failure: deliveryCompletions[type]?.removeValue(forKey: id)?(false)
+        case .cancelled: break
+        }
+
         // Refill the queue
         fillQueue(for: type)
     }
 
     // MARK: - Internal: Helpers
 
+    /// Calls the delivery completions of records that were removed from the cache before being picked up.
+    /// Records in flight are reported when their operation finishes, they're uploaded from memory.
+    ///
+    /// Must be called on the coordination queue.
+    private func failRemovedDeliveries() {
+        for (type, completions) in deliveryCompletions {
+            for id in completions.keys where inFlightIDs[type]?.contains(id) != true && !cache.hasUploadData(id: id, type: type) {
+                deliveryCompletions[type]?.removeValue(forKey: id)?(false)
+            }
+        }
+    }
+
     private func uploadQueue(for type: EmbraceUploadType) -> OperationQueue {
         switch type {
         case .spans: return spansQueue
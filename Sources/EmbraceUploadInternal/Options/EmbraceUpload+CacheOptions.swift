@@ -26,18 +26,23 @@ extension EmbraceUpload {
         /// If enabled, the cache will be emptied when created
         public let resetCache: Bool
 
+        /// Database engine used for the cache
+        public let engine: StorageEngine
+
         public init(
             storageMechanism: StorageMechanism,
             enableBackgroundTasks: Bool = true,
             cacheLimit: UInt = 0,
             cacheDaysLimit: UInt = 7,
-            resetCache: Bool = false
+            resetCache: Bool = false,
+            engine: StorageEngine = .coreData
         ) {
             self.storageMechanism = storageMechanism
             self.enableBackgroundTasks = enableBackgroundTasks
             self.cacheLimit = cacheLimit
             self.cacheDaysLimit = cacheDaysLimit
             self.resetCache = resetCache
+            self.engine = engine
         }
     }
 }
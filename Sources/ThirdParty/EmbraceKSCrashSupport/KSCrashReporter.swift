@@ -210,14 +210,14 @@ public final class KSCrashReporter: NSObject, CrashReporter {
         }
     }
 
-    private static var dateFormatter: DateFormatter {
+    private static let dateFormatter: DateFormatter = {
         let formatter = DateFormatter()
         formatter.dateFormat = "yyyy-MM-dd'T'HH:mm:ss.SSSSSSZZZZZ"
         formatter.locale = Locale(identifier: "en_US_POSIX")
         formatter.formatterBehavior = .default
         formatter.timeZone = TimeZone(secondsFromGMT: 0)
         return formatter
-    }
+    }()
 
     public func appendCrashInfo(key: String, value: String?) {
         reporter.userInfo?[key] = value
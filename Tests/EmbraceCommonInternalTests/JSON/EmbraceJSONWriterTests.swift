@@ -0,0 +1,163 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import XCTest
+
+@testable import EmbraceCommonInternal
+
+final class EmbraceJSONWriterTests: XCTestCase {
+
+    private func string(_ writer: EmbraceJSONWriter) -> String {
+        String(decoding: writer.data, as: UTF8.self)
+    }
+
+    private func decoded(_ data: Data) throws -> Any {
+        try JSONSerialization.jsonObject(with: data, options: .fragmentsAllowed)
+    }
+
+    func test_structure() throws {
+        var writer = EmbraceJSONWriter()
+
+        writer.beginObject()
+        try writer.field("name", "test")
+        try writer.field("missing", ifPresent: String?.none)
+        try writer.field("null", String?.none)
+        writer.key("list")
+        writer.beginArray()
+        writer.value(1)
+        writer.beginObject()
+        writer.endObject()
+        writer.beginArray()
+        writer.endArray()
+        writer.value(true)
+        writer.endArray()
+        try writer.field("last", false)
+        writer.endObject()
+
+        XCTAssertEqual(string(writer), #"{"name":"test","null":null,"list":[1,{},[],true],"last":false}"#)
+    }
+
+    func test_numbers() throws {
+        var writer = EmbraceJSONWriter()
+        writer.beginArray()
+        writer.value(0)
+        writer.value(-42)
+        writer.value(Int64.min)
+        writer.value(Int64.max)
+        writer.value(UInt64.max)
+        try writer.value(1.0)
+        try writer.value(-0.5)
+        try writer.value(123.456)
+        try writer.value(1e300)
+        try writer.value(Float(2.5))
+        writer.endArray()
+
+        XCTAssertEqual(
+            string(writer),
+            "[0,-42,-9223372036854775808,9223372036854775807,18446744073709551615,1,-0.5,123.456,1e+300,2.5]"
+        )
+    }
+
+    func test_nonFiniteNumbersThrow() {
+        var writer = EmbraceJSONWriter()
+        XCTAssertThrowsError(try writer.value(Double.nan))
+        XCTAssertThrowsError(try writer.value(Double.infinity))
+        XCTAssertThrowsError(try writer.value(-Float.infinity))
+    }
+
+    func test_escaping_matchesJSONEncoder() throws {
+        // given strings with characters that need escaping at every position around the 16 byte chunks
+        var strings = [
+            "",
+            "plain",
+            "quote \" and backslash \\",
+            "new\nline\ttab\rreturn\u{08}\u{0C}",
+            "\u{00}\u{01}\u{1F}\u{7F}",
+            "emoji 🙂 and accents áéí and cjk 漢字",
+            "slashes /path/to/file"
+        ]
+        for length in 0..<40 {
+            for special in ["\"", "\\", "\n", "\u{01}"] {
+                var string = String(repeating: "a", count: length)
+                string.append(special)
+                string.append(String(repeating: "b", count: 40 - length))
+                strings.append(string)
+            }
+        }
+
+        for string in strings {
+            // when writing them
+            var writer = EmbraceJSONWriter()
+            writer.value(string)
+
+            // then they decode to the same value JSONEncoder produces
+            XCTAssertEqual(try decoded(writer.data) as? String, string)
+            XCTAssertEqual(try decoded(JSONEncoder().encode(string)) as? String, string)
+        }
+    }
+
+    func test_escaping_output() {
+        var writer = EmbraceJSONWriter()
+        writer.value("a\"b\\c\nd\u{01}e/f")
+        XCTAssertEqual(string(writer), #""a\"b\\c\nd\u0001e/f""#)
+    }
+
+    func test_keysAreEscaped() throws {
+        var writer = EmbraceJSONWriter()
+        try ["we\"ird": 1].writeJSON(to: &writer)
+        XCTAssertEqual(string(writer), #"{"we\"ird":1}"#)
+    }
+
+    func test_reset_reusesWriter() {
+        // given a writer that already wrote something
+        var writer = EmbraceJSONWriter(capacity: 16)
+        writer.beginArray()
+        writer.value("first")
+
+        // when resetting it mid way
+        writer.reset()
+        writer.beginObject()
+        writer.endObject()
+
+        // then only the new output is there
+        XCTAssertEqual(string(writer), "{}")
+    }
+
+    func test_sink_receivesEverything() throws {
+        // given a writer with a tiny flush threshold
+        var received = Data()
+        var flushes = 0
+        var writer = EmbraceJSONWriter(flushThreshold: 8) {
+            received.append(contentsOf: $0)
+            flushes += 1
+        }
+
+        // when writing more than that
+        let values = (0..<100).map { "value \($0)" }
+        try values.writeJSON(to: &writer)
+        try writer.finish()
+
+        // then the sink gets it in pieces, and the pieces put together are the whole output
+        XCTAssertGreaterThan(flushes, 1)
+        XCTAssertEqual(try decoded(received) as? [String], values)
+    }
+
+    func test_sink_errorsAreThrownOnFinish() {
+        struct SinkError: Error {}
+
+        var calls = 0
+        var writer = EmbraceJSONWriter(flushThreshold: 4) { _ in
+            calls += 1
+            throw SinkError()
+        }
+        writer.beginArray()
+        for value in 0..<100 {
+            writer.value(value)
+        }
+        writer.endArray()
+
+        XCTAssertThrowsError(try writer.finish()) { XCTAssertTrue($0 is SinkError) }
+        XCTAssertEqual(calls, 1, "the sink isn't called again after it fails")
+    }
+}
@@ -0,0 +1,108 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import XCTest
+
+@testable import EmbraceCommonInternal
+
+class EmbraceAdaptiveLockTests: XCTestCase {
+
+    func test_tryLock() {
+        let sut = EmbraceAdaptiveLock()
+
+        XCTAssertTrue(sut.tryLock())
+        XCTAssertFalse(sut.tryLock())
+
+        sut.unlock()
+        XCTAssertTrue(sut.tryLock())
+        sut.unlock()
+    }
+
+    func test_locked_returnsValue() {
+        let sut = EmbraceAdaptiveLock()
+        XCTAssertEqual(sut.locked { 42 }, 42)
+        XCTAssertTrue(sut.tryLock())
+        sut.unlock()
+    }
+
+    func test_locked_rethrows() {
+        let sut = EmbraceAdaptiveLock()
+
+        XCTAssertThrowsError(try sut.locked { throw NSError(domain: "test", code: 1) })
+
+        // and the lock was released
+        XCTAssertTrue(sut.tryLock())
+        sut.unlock()
+    }
+
+    func test_mutualExclusion() {
+        // given a value only guarded by the lock
+        let sut = EmbraceAdaptiveLock()
+        var counter = 0
+        var inside = false
+        var overlaps = 0
+        let threads = max(8, ProcessInfo.processInfo.processorCount * 2)
+        let perThread = 20_000
+
+        // when many threads update it
+        DispatchQueue.concurrentPerform(iterations: threads) { _ in
+            for _ in 0..<perThread {
+                sut.locked {
+                    if inside {
+                        overlaps += 1
+                    }
+                    inside = true
+                    counter += 1
+                    inside = false
+                }
+            }
+        }
+
+        // then no updates were lost or overlapped
+        XCTAssertEqual(overlaps, 0)
+        XCTAssertEqual(counter, threads * perThread)
+    }
+
+    func test_longCriticalSections_parkWaiters() {
+        // given a lock held for a while
+        let sut = EmbraceAdaptiveLock()
+        sut.lock()
+
+        // when another thread waits for it
+        let acquired = expectation(description: "acquired")
+        DispatchQueue.global().async {
+            sut.locked {
+                acquired.fulfill()
+            }
+        }
+
+        // then it gets it once it's released
+        Thread.sleep(forTimeInterval: 0.1)
+        sut.unlock()
+        wait(for: [acquired], timeout: 5)
+    }
+
+    func test_failedSpins_shrinkTheSpinLimit() {
+        // given a lock that's always held for longer than waiters spin
+        let sut = EmbraceAdaptiveLock()
+
+        for _ in 0..<20 {
+            sut.lock()
+
+            let acquired = expectation(description: "acquired")
+            DispatchQueue.global().async {
+                sut.locked {
+                    acquired.fulfill()
+                }
+            }
+
+            Thread.sleep(forTimeInterval: 0.01)
+            sut.unlock()
+            wait(for: [acquired], timeout: 5)
+        }
+
+        // then waiters park right away instead of spinning longer every time
+        XCTAssertLessThan(sut.spinAverage, 4)
+    }
+}
@@ -0,0 +1,306 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import XCTest
+
+@testable import EmbraceCommonInternal
+
+final class EmbraceLockFreeTests: XCTestCase {
+
+    private class Box {
+        let value: Int
+        init(_ value: Int) { self.value = value }
+    }
+
+    // MARK: - Pointers
+
+    func test_atomicPointer_basicOps() {
+        let first = UnsafeMutablePointer<Int>.allocate(capacity: 1)
+        let second = UnsafeMutablePointer<Int>.allocate(capacity: 1)
+        defer {
+            first.deallocate()
+            second.deallocate()
+        }
+
+        let pointer = EmbraceAtomicPointer<Int>()
+        XCTAssertNil(pointer.load())
+
+        pointer.store(first, order: .release)
+        XCTAssertEqual(pointer.load(order: .acquire), first)
+
+        XCTAssertEqual(pointer.exchange(second), first)
+        XCTAssertEqual(pointer.load(), second)
+
+        var expected: UnsafeMutablePointer<Int>? = first
+        XCTAssertFalse(pointer.compareExchange(expected: &expected, desired: nil))
+        XCTAssertEqual(expected, second)
+
+        XCTAssertTrue(pointer.compareExchange(expected: &expected, desired: nil))
+        XCTAssertNil(pointer.load())
+    }
+
+    func test_taggedPointer_detectsABA() {
+        let node = UnsafeMutablePointer<Int>.allocate(capacity: 1)
+        defer { node.deallocate() }
+
+        // given a tagged pointer read by a thread
+        let pointer = EmbraceAtomicTaggedPointer<Int>(EmbraceTaggedPointer(pointer: node))
+        var stale = pointer.load()
+
+        // when another thread swaps it away and back
+        var current = pointer.load()
+        XCTAssertTrue(pointer.compareExchange(expected: &current, desired: current.next(pointer: nil)))
+        XCTAssertTrue(pointer.compareExchange(expected: &current, desired: current.next(pointer: node)))
+
+        // then the stale compare-and-swap fails even though the pointer is the same
+        XCTAssertFalse(pointer.compareExchange(expected: &stale, desired: stale.next(pointer: nil)))
+        XCTAssertEqual(stale.pointer, node)
+        XCTAssertEqual(stale.tag, 2)
+    }
+
+    func test_taggedPointer_concurrentUpdates() {
+        let pointer = EmbraceAtomicTaggedPointer<Int>()
+        let threads = max(4, ProcessInfo.processInfo.processorCount)
+        let perThread = 10_000
+
+        DispatchQueue.concurrentPerform(iterations: threads) { _ in
+            for _ in 0..<perThread {
+                var current = pointer.load(order: .relaxed)
+                while !pointer.compareExchange(expected: &current, desired: current.next(pointer: nil)) {}
+            }
+        }
+
+        XCTAssertEqual(pointer.load().tag, UInt(threads * perThread))
+    }
+
+    // MARK: - SPSC ring
+
+    func test_spscRing_roundsCapacityUp() {
+        XCTAssertEqual(EmbraceSPSCRing<Int>(capacity: 1).capacity, 1)
+        XCTAssertEqual(EmbraceSPSCRing<Int>(capacity: 5).capacity, 8)
+        XCTAssertEqual(EmbraceSPSCRing<Int>(capacity: 1024).capacity, 1024)
+    }
+
+    func test_spscRing_fullAndEmpty() {
+        // given a ring
+        let ring = EmbraceSPSCRing<Int>(capacity: 4)
+        XCTAssertNil(ring.pop())
+
+        // when filling it
+        for value in 0..<4 {
+            XCTAssertTrue(ring.push(value))
+        }
+
+        // then it rejects more elements
+        XCTAssertFalse(ring.push(4))
+        XCTAssertEqual(ring.count, 4)
+
+        // and hands them back in order, making room again
+        XCTAssertEqual(ring.pop(), 0)
+        XCTAssertTrue(ring.push(4))
+        XCTAssertEqual((0..<4).compactMap { _ in ring.pop() }, [1, 2, 3, 4])
+        XCTAssertNil(ring.pop())
+    }
+
+    func test_spscRing_releasesRemainingElements() {
+        weak var weakBox: Box?
+
+        autoreleasepool {
+            let ring = EmbraceSPSCRing<Box>(capacity: 4)
+            let box = Box(1)
+            weakBox = box
+            ring.push(box)
+        }
+
+        XCTAssertNil(weakBox)
+    }
+
+    func test_spscRing_stress() {
+        // given a small ring so the producer keeps wrapping around
+        let ring = EmbraceSPSCRing<Box>(capacity: 64)
+        let total = 200_000
+
+        // when one thread pushes while another pops
+        let done = expectation(description: "producer done")
+        DispatchQueue.global().async {
+            for value in 0..<total {
+                let box = Box(value)
+                while !ring.push(box) { sched_yield() }
+            }
+            done.fulfill()
+        }
+
+        // then every element comes out once and in order
+        var next = 0
+        while next < total {
+            guard let box = ring.pop() else {
+                sched_yield()
+                continue
+            }
+            XCTAssertEqual(box.value, next)
+            next += 1
+        }
+
+        wait(for: [done], timeout: 30)
+        XCTAssertNil(ring.pop())
+    }
+
+    // MARK: - MPSC queue
+
+    func test_mpscQueue_fullAndDrain() {
+        // given a full queue
+        let queue = EmbraceMPSCQueue<Int>(capacity: 8)
+        for value in 0..<8 {
+            XCTAssertTrue(queue.push(value))
+        }
+        XCTAssertFalse(queue.push(8))
+
+        // when draining part of it
+        var drained: [Int] = []
+        XCTAssertEqual(queue.drain(maxCount: 5) { drained.append($0) }, 5)
+
+        // then elements come out in order
+        XCTAssertEqual(drained, [0, 1, 2, 3, 4])
+        XCTAssertEqual(queue.count, 3)
+        XCTAssertEqual(queue.drain { drained.append($0) }, 3)
+        XCTAssertEqual(drained, Array(0..<8))
+        XCTAssertNil(queue.pop())
+    }
+
+    func test_mpscQueue_stress() {
+        // given a small queue shared by several producers
+        let queue = EmbraceMPSCQueue<(producer: Int, value: Int)>(capacity: 128)
+        let producers = max(4, ProcessInfo.processInfo.processorCount)
+        let perProducer = 50_000
+
+        // when they all push at once
+        let group = DispatchGroup()
+        for producer in 0..<producers {
+            DispatchQueue.global().async(group: group) {
+                for value in 0..<perProducer {
+                    while !queue.push((producer, value)) { sched_yield() }
+                }
+            }
+        }
+
+        // then the consumer gets every element once, and each producer's in order
+        var next = [Int](repeating: 0, count: producers)
+        var received = 0
+        while received < producers * perProducer {
+            guard let element = queue.pop() else {
+                sched_yield()
+                continue
+            }
+            XCTAssertEqual(element.value, next[element.producer])
+            next[element.producer] += 1
+            received += 1
+        }
+
+        XCTAssertEqual(group.wait(timeout: .now() + 30), .success)
+        XCTAssertEqual(next, [Int](repeating: perProducer, count: producers))
+        XCTAssertNil(queue.pop())
+    }
+
+    // MARK: - Free-list
+
+    func test_freeList_popsEveryIndexOnce() {
+        let list = EmbraceFreeList(capacity: 16)
+
+        let indices = (0..<16).compactMap { _ in list.pop() }
+        XCTAssertEqual(Set(indices), Set(0..<16))
+        XCTAssertNil(list.pop())
+
+        // most recently pushed comes back first
+        list.push(3)
+        list.push(7)
+        XCTAssertEqual(list.pop(), 7)
+        XCTAssertEqual(list.pop(), 3)
+    }
+
+    func test_freeList_stress() {
+        // given fewer indices than threads
+        let capacity = 4
+        let list = EmbraceFreeList(capacity: capacity)
+        let owners = (0..<capacity).map { _ in EmbraceAtomic<Int32>(0) }
+        let overlaps = EmbraceAtomic<Int32>(0)
+
+        // when threads keep taking and returning them
+        DispatchQueue.concurrentPerform(iterations: max(8, ProcessInfo.processInfo.processorCount * 2)) { _ in
+            for _ in 0..<20_000 {
+                guard let index = list.pop() else {
+                    continue
+                }
+                if owners[index].fetchAdd(1) != 0 {
+                    overlaps += 1
+                }
+                owners[index].fetchSub(1)
+                list.push(index)
+            }
+        }
+
+        // then no index was ever held twice, and all are free again
+        XCTAssertEqual(overlaps.load(), 0)
+        XCTAssertEqual(Set((0..<capacity).compactMap { _ in list.pop() }), Set(0..<capacity))
+    }
+
+    // MARK: - Seqlock
+
+    private struct Sample: Equatable {
+        var a: Int64
+        var b: Int64
+        var c: Double
+        var flag: Bool
+    }
+
+    func test_seqLock_basicOps() {
+        let lock = EmbraceSeqLock(Sample(a: 1, b: 2, c: 3, flag: true))
+        XCTAssertEqual(lock.load(), Sample(a: 1, b: 2, c: 3, flag: true))
+        XCTAssertEqual(lock.version, 0)
+
+        lock.store(Sample(a: 4, b: 5, c: 6, flag: false))
+        XCTAssertEqual(lock.load(), Sample(a: 4, b: 5, c: 6, flag: false))
+        XCTAssertEqual(lock.version, 1)
+    }
+
+    func test_seqLock_readersNeverSeeTornValues() {
+        // given a value whose fields are always consistent with each other
+        let lock = EmbraceSeqLock(Sample(a: 0, b: 0, c: 0, flag: true))
+        let writers = 2
+        let readers = max(4, ProcessInfo.processInfo.processorCount)
+        let writes = 20_000
+        let torn = EmbraceAtomic<Int32>(0)
+
+        // when writers update it while readers load it
+        let writing = DispatchGroup()
+        for _ in 0..<writers {
+            DispatchQueue.global().async(group: writing) {
+                for value in 1...writes {
+                    let v = Int64(value)
+                    lock.store(Sample(a: v, b: -v, c: Double(v) * 2, flag: value % 2 == 0))
+                }
+            }
+        }
+
+        let stop = EmbraceAtomic<Bool>(false)
+        let reading = DispatchGroup()
+        for _ in 0..<readers {
+            DispatchQueue.global().async(group: reading) {
+                while !stop.load(order: .relaxed) {
+                    let sample = lock.load()
+                    if sample.b != -sample.a || sample.c != Double(sample.a) * 2 || sample.flag != (sample.a % 2 == 0) {
+                        torn += 1
+                    }
+                }
+            }
+        }
+
+        XCTAssertEqual(writing.wait(timeout: .now() + 30), .success)
+        stop.store(true)
+        XCTAssertEqual(reading.wait(timeout: .now() + 30), .success)
+
+        // then none of them saw a half written value
+        XCTAssertEqual(torn.load(), 0)
+        XCTAssertEqual(lock.version, UInt32(writers * writes))
+    }
+}
@@ -0,0 +1,80 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import XCTest
+
+@testable import EmbraceCommonInternal
+
+class EmbraceShardedCounterTests: XCTestCase {
+
+    func test_shards_roundedToPowerOfTwo() {
+        XCTAssertEqual(EmbraceShardedCounter(shards: 0).shards, 1)
+        XCTAssertEqual(EmbraceShardedCounter(shards: 3).shards, 4)
+        XCTAssertEqual(EmbraceShardedCounter(shards: 8).shards, 8)
+        XCTAssertEqual(EmbraceShardedCounter(shards: 1_000).shards, 64)
+    }
+
+    func test_addAndLoad() {
+        let sut = EmbraceShardedCounter()
+        XCTAssertEqual(sut.load(), 0)
+
+        sut.increment()
+        sut.add(10)
+        sut.decrement()
+
+        XCTAssertEqual(sut.load(), 10)
+    }
+
+    func test_reset() {
+        // given a counter with a value
+        let sut = EmbraceShardedCounter()
+        sut.add(42)
+
+        // when resetting it
+        let value = sut.reset()
+
+        // then it returns the value and starts over
+        XCTAssertEqual(value, 42)
+        XCTAssertEqual(sut.load(), 0)
+    }
+
+    func test_concurrentAdds() {
+        let sut = EmbraceShardedCounter(shards: 4)
+        let threads = max(8, ProcessInfo.processInfo.processorCount * 2)
+        let perThread = 50_000
+
+        DispatchQueue.concurrentPerform(iterations: threads) { _ in
+            for _ in 0..<perThread {
+                sut.increment()
+            }
+        }
+
+        XCTAssertEqual(sut.load(), Int64(threads * perThread))
+    }
+
+    func test_resetWhileAdding_losesNothing() {
+        // given threads adding to a counter
+        let sut = EmbraceShardedCounter()
+        let threads = 4
+        let perThread = 50_000
+        let group = DispatchGroup()
+        for _ in 0..<threads {
+            DispatchQueue.global().async(group: group) {
+                for _ in 0..<perThread {
+                    sut.increment()
+                }
+            }
+        }
+
+        // when it's reset repeatedly meanwhile
+        var flushed: Int64 = 0
+        while group.wait(timeout: .now()) == .timedOut {
+            flushed += sut.reset()
+        }
+        flushed += sut.reset()
+
+        // then every add shows up in exactly one reset
+        XCTAssertEqual(flushed, Int64(threads * perThread))
+    }
+}
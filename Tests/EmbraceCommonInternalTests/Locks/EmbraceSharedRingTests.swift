@@ -0,0 +1,250 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import XCTest
+
+@testable import EmbraceCommonInternal
+
+final class EmbraceSharedRingTests: XCTestCase {
+
+    var url: URL!
+
+    override func setUpWithError() throws {
+        url = URL(fileURLWithPath: NSTemporaryDirectory())
+            .appendingPathComponent("EmbraceSharedRingTests")
+            .appendingPathComponent(UUID().uuidString)
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: url.deletingLastPathComponent())
+    }
+
+    private func record(_ value: String) -> Data {
+        Data(value.utf8)
+    }
+
+    private func drainAll(_ ring: EmbraceSharedRing, now: Date = Date()) -> [String] {
+        var result: [String] = []
+        ring.drain(now: now) { result.append(String(decoding: $0, as: UTF8.self)) }
+        return result
+    }
+
+    func test_invalidGeometry_returnsNil() {
+        XCTAssertNil(EmbraceSharedRing(url: url, slotSize: 100, slotCount: 8))
+        XCTAssertNil(EmbraceSharedRing(url: url, slotSize: 32, slotCount: 8))
+        XCTAssertNil(EmbraceSharedRing(url: url, slotSize: 128, slotCount: 6))
+    }
+
+    func test_pushAndDrain_preservesOrder() throws {
+        let ring = try XCTUnwrap(EmbraceSharedRing(url: url, slotSize: 128, slotCount: 8))
+
+        XCTAssertTrue(ring.push(record("a")))
+        XCTAssertTrue(ring.push(record("b")))
+        XCTAssertTrue(ring.push(Data()))
+        XCTAssertEqual(ring.count, 3)
+
+        XCTAssertEqual(drainAll(ring), ["a", "b", ""])
+        XCTAssertEqual(ring.count, 0)
+        XCTAssertEqual(drainAll(ring), [])
+    }
+
+    func test_push_rejectsWhenFullOrTooLarge() throws {
+        let ring = try XCTUnwrap(EmbraceSharedRing(url: url, slotSize: 64, slotCount: 4))
+
+        XCTAssertFalse(ring.push(Data(count: ring.maxRecordSize + 1)))
+        XCTAssertTrue(ring.push(Data(count: ring.maxRecordSize)))
+
+        for i in 1..<4 {
+            XCTAssertTrue(ring.push(record("\(i)")))
+        }
+        XCTAssertFalse(ring.push(record("overflow")))
+
+        // then draining makes room again, across laps
+        XCTAssertEqual(ring.drain(maxCount: 2) { _ in }, 2)
+        XCTAssertTrue(ring.push(record("4")))
+        XCTAssertTrue(ring.push(record("5")))
+        XCTAssertEqual(drainAll(ring), ["2", "3", "4", "5"])
+    }
+
+    func test_records_surviveReopening() throws {
+        // given records pushed by a process that went away
+        var producer = EmbraceSharedRing(url: url, slotSize: 128, slotCount: 8)
+        producer?.push(record("first"))
+        producer?.push(record("second"))
+        producer = nil
+
+        // when another one opens the file
+        let consumer = try XCTUnwrap(EmbraceSharedRing(url: url, slotSize: 128, slotCount: 8))
+
+        // then the records are there
+        XCTAssertEqual(drainAll(consumer), ["first", "second"])
+    }
+
+    func test_incompatibleRing_isOnlyResetWhenAsked() throws {
+        // given a ring written with another geometry
+        let old = try XCTUnwrap(EmbraceSharedRing(url: url, slotSize: 128, slotCount: 8))
+        old.push(record("old"))
+
+        // then it can't be opened with a different one
+        XCTAssertNil(EmbraceSharedRing(url: url, slotSize: 256, slotCount: 8))
+
+        // unless it's reset
+        let new = try XCTUnwrap(EmbraceSharedRing(url: url, slotSize: 256, slotCount: 8, resetIfIncompatible: true))
+        XCTAssertEqual(new.count, 0)
+        XCTAssertTrue(new.push(record("new")))
+        XCTAssertEqual(drainAll(new), ["new"])
+    }
+
+    func test_drain_releasesRecordsWhenBodyThrows() throws {
+        struct Failure: Error {}
+        let ring = try XCTUnwrap(EmbraceSharedRing(url: url, slotSize: 128, slotCount: 8))
+        ring.push(record("a"))
+        ring.push(record("b"))
+
+        XCTAssertThrowsError(try ring.drain { _ in throw Failure() })
+        XCTAssertEqual(drainAll(ring), ["b"])
+    }
+
+    func test_slotReservedByDeadProducer_isSkippedAfterTimeout() throws {
+        let ring = try XCTUnwrap(EmbraceSharedRing(url: url, slotSize: 128, slotCount: 8))
+
+        // given a producer that reserved the first slot and died before filling it,
+        // which leaves the tail (second cache line of the header) one past the head
+        let handle = try FileHandle(forUpdating: url)
+        try handle.seek(toOffset: 128)
+        var tail: UInt64 = 1
+        handle.write(Data(bytes: &tail, count: MemoryLayout<UInt64>.size))
+        try handle.synchronize()
+        try handle.close()
+
+        // and a record pushed after it
+        XCTAssertTrue(ring.push(record("after")))
+        XCTAssertEqual(ring.count, 2)
+
+        // then the consumer waits for the reserved slot
+        let start = Date()
+        XCTAssertEqual(drainAll(ring, now: start), [])
+        XCTAssertEqual(drainAll(ring, now: start.addingTimeInterval(10)), [])
+
+        // and skips it once it was waiting for long enough
+        XCTAssertEqual(drainAll(ring, now: start.addingTimeInterval(31)), ["after"])
+        XCTAssertEqual(ring.count, 0)
+    }
+
+    func test_concurrentProducers_onSeparateMappings() throws {
+        // separate mappings of the same file, like separate processes
+        let consumer = try XCTUnwrap(EmbraceSharedRing(url: url, slotSize: 64, slotCount: 64))
+        let producers = (0..<4).compactMap { _ in EmbraceSharedRing(url: url, slotSize: 64, slotCount: 64) }
+        XCTAssertEqual(producers.count, 4)
+
+        let perProducer = 2_000
+        var received: [[Int]] = Array(repeating: [], count: producers.count)
+        let done = EmbraceAtomic<Bool>(false)
+
+        let consumerThread = Thread {
+            while true {
+                let finished = done.load()
+                let drained = consumer.drain { data in
+                    let parts = String(decoding: data, as: UTF8.self).split(separator: ":")
+                    received[Int(parts[0])!].append(Int(parts[1])!)
+                }
+                if finished && drained == 0 {
+                    break
+                }
+            }
+        }
+        consumerThread.start()
+
+        DispatchQueue.concurrentPerform(iterations: producers.count) { index in
+            for i in 0..<perProducer {
+                while !producers[index].push(Data("\(index):\(i)".utf8)) {}
+            }
+        }
+        done.store(true)
+
+        let expectation = expectation(description: "drained")
+        DispatchQueue.global().async {
+            while !consumerThread.isFinished {
+                usleep(1000)
+            }
+            expectation.fulfill()
+        }
+        wait(for: [expectation], timeout: 30)
+
+        // then every record arrives once, in the order each producer pushed them
+        for values in received {
+            XCTAssertEqual(values, Array(0..<perProducer))
+        }
+    }
+
+    #if os(macOS) || os(Linux)
+        func test_concurrentProducers_inSeparateProcesses() throws {
+            // `fork` is unavailable in Swift, so it's looked up like any other C symbol
+            typealias ForkFunction = @convention(c) () -> pid_t
+            let handle = dlopen(nil, RTLD_NOW)
+            defer { dlclose(handle) }
+            let fork = unsafeBitCast(try XCTUnwrap(dlsym(handle, "fork")), to: ForkFunction.self)
+
+            let ring = try XCTUnwrap(EmbraceSharedRing(url: url, slotSize: 64, slotCount: 256))
+            let processes = 6
+            let perProcess = 20_000
+
+            // given producers in other processes sharing the mapping
+            var children: [pid_t] = []
+            for index in 0..<processes {
+                let pid = fork()
+                guard pid >= 0 else {
+                    children.forEach { kill($0, SIGKILL) }
+                    throw XCTSkip("Couldn't fork producer \(index)")
+                }
+
+                if pid == 0 {
+                    // only the ring and the stack from here on, the child inherits the locks of every other thread
+                    for i in 0..<perProcess {
+                        var value = UInt64(index) << 32 | UInt64(i)
+                        let record = Data(bytes: &value, count: MemoryLayout<UInt64>.size)
+                        while !ring.push(record) {
+                            sched_yield()
+                        }
+                    }
+                    _exit(0)
+                }
+                children.append(pid)
+            }
+
+            // when draining from this one until every record arrived
+            var received: [[Int]] = Array(repeating: [], count: processes)
+            var total = 0
+            let deadline = Date().addingTimeInterval(120)
+            while total < processes * perProcess && Date() < deadline {
+                let drained = ring.drain { data in
+                    let value = data.withUnsafeBytes { $0.loadUnaligned(as: UInt64.self) }
+                    received[Int(value >> 32)].append(Int(value & 0xFFFF_FFFF))
+                }
+                total += drained
+                if drained == 0 {
+                    sched_yield()
+                }
+            }
+
+            // producers blocked on a full ring would never exit otherwise
+            if total < processes * perProcess {
+                children.forEach { kill($0, SIGKILL) }
+            }
+
+            for pid in children {
+                var status: Int32 = 0
+                XCTAssertEqual(waitpid(pid, &status, 0), pid)
+                XCTAssertEqual(status, 0)
+            }
+
+            // then every record arrives once, in the order each process pushed them
+            XCTAssertEqual(total, processes * perProcess)
+            for values in received {
+                XCTAssertEqual(values, Array(0..<perProcess))
+            }
+            XCTAssertEqual(ring.count, 0)
+        }
+    #endif
+}
@@ -0,0 +1,104 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import XCTest
+
+@testable import EmbraceCommonInternal
+
+final class EmbraceSnapshotTests: XCTestCase {
+
+    private final class Limits {
+        let maxSpans: Int
+        let maxLogs: Int
+        init(_ value: Int) {
+            maxSpans = value
+            maxLogs = value * 2
+        }
+    }
+
+    func test_publishAndUpdate() {
+        let snapshot = EmbraceSnapshot([1, 2])
+        XCTAssertEqual(snapshot.load(), [1, 2])
+
+        snapshot.publish([3])
+        XCTAssertEqual(snapshot.load(), [3])
+
+        XCTAssertEqual(snapshot.update { $0 + [4] }, [3, 4])
+        XCTAssertEqual(snapshot.read { $0.count }, 2)
+    }
+
+    func test_releasesReplacedValues() {
+        // given a published value
+        weak var weakFirst: Limits?
+        weak var weakSecond: Limits?
+        var snapshot: EmbraceSnapshot<Limits>?
+
+        autoreleasepool {
+            let first = Limits(1)
+            weakFirst = first
+            snapshot = EmbraceSnapshot(first)
+        }
+        XCTAssertNotNil(weakFirst)
+
+        // when it's replaced
+        autoreleasepool {
+            let second = Limits(2)
+            weakSecond = second
+            snapshot?.publish(second)
+        }
+
+        // then the old one is released, and the current one goes with the snapshot
+        XCTAssertNil(weakFirst)
+        XCTAssertNotNil(weakSecond)
+
+        snapshot = nil
+        XCTAssertNil(weakSecond)
+    }
+
+    func test_concurrentUpdatesAreNotLost() {
+        let snapshot = EmbraceSnapshot(0)
+        let threads = max(4, ProcessInfo.processInfo.processorCount)
+
+        DispatchQueue.concurrentPerform(iterations: threads) { _ in
+            for _ in 0..<1_000 {
+                snapshot.update { $0 + 1 }
+            }
+        }
+
+        XCTAssertEqual(snapshot.load(), threads * 1_000)
+    }
+
+    func test_readersAlwaysSeeWholeLiveValues() {
+        // given a value whose fields are always consistent with each other
+        let snapshot = EmbraceSnapshot(Limits(0))
+        let readers = max(4, ProcessInfo.processInfo.processorCount)
+        let writes = 10_000
+        let torn = EmbraceAtomic<Int32>(0)
+
+        // when a writer keeps replacing it while readers use it
+        let stop = EmbraceAtomic<Bool>(false)
+        let reading = DispatchGroup()
+        for _ in 0..<readers {
+            DispatchQueue.global().async(group: reading) {
+                while !stop.load(order: .relaxed) {
+                    snapshot.read { limits in
+                        if limits.maxLogs != limits.maxSpans * 2 {
+                            torn += 1
+                        }
+                    }
+                }
+            }
+        }
+
+        for value in 1...writes {
+            snapshot.publish(Limits(value))
+        }
+        stop.store(true)
+        XCTAssertEqual(reading.wait(timeout: .now() + 30), .success)
+
+        // then none of them saw a mixed or released value
+        XCTAssertEqual(torn.load(), 0)
+        XCTAssertEqual(snapshot.load().maxSpans, writes)
+    }
+}
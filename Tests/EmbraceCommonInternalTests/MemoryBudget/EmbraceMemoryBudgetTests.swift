@@ -0,0 +1,209 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import XCTest
+
+@testable import EmbraceCommonInternal
+
+class EmbraceMemoryBudgetTests: XCTestCase {
+
+    private let megabyte = 1024 * 1024
+    private let second: UInt64 = 1_000_000_000
+
+    private var now: UInt64 = 1_000
+    private var availableMemory: UInt64?
+
+    private func budget(ceiling: Int = 1000, enabled: Bool = true) -> EmbraceMemoryBudget {
+        let sut = EmbraceMemoryBudget(
+            ceiling: ceiling,
+            clock: { [unowned self] in self.now },
+            availableMemory: { [unowned self] in self.availableMemory }
+        )
+        sut.bootstrap(enabled: enabled, ceiling: ceiling)
+        return sut
+    }
+
+    func test_disabled_tracksButNeverDegrades() {
+        // given a disabled budget over its ceiling
+        let sut = budget(enabled: false)
+        XCTAssertTrue(sut.reserve(2000, for: .uploads))
+        availableMemory = 1
+
+        // then it doesn't refuse or drop anything
+        XCTAssertEqual(sut.trackedBytes, 2000)
+        XCTAssertEqual(sut.level, .normal)
+        XCTAssertTrue(sut.admitsLog(severity: .trace))
+        XCTAssertTrue(sut.admitsNetworkSpan())
+        XCTAssertTrue(sut.admitsLowPriorityUploads)
+        XCTAssertTrue(sut.snapshot().drops.isEmpty)
+    }
+
+    func test_reserve_refusesPastCeiling() {
+        let sut = budget(ceiling: 1000)
+
+        XCTAssertTrue(sut.reserve(600, for: .networkBodies))
+        XCTAssertFalse(sut.reserve(600, for: .networkBodies))
+        XCTAssertEqual(sut.trackedBytes, 600)
+
+        // tracked bytes can't be refused
+        sut.track(600, for: .uploads)
+        XCTAssertEqual(sut.trackedBytes, 1200)
+
+        sut.release(600, for: .uploads)
+        sut.release(600, for: .networkBodies)
+        XCTAssertEqual(sut.trackedBytes, 0)
+        XCTAssertTrue(sut.reserve(600, for: .networkBodies))
+    }
+
+    func test_snapshot_hasBytesAndDepthsByProducer() {
+        let sut = budget(ceiling: 10_000)
+        sut.reserve(100, for: .networkBodies)
+        sut.reserve(100, for: .networkBodies)
+        sut.track(50, for: .spanProcessor)
+
+        let snapshot = sut.snapshot()
+        XCTAssertEqual(snapshot.bytes[.networkBodies], 200)
+        XCTAssertEqual(snapshot.depths[.networkBodies], 2)
+        XCTAssertEqual(snapshot.bytes[.spanProcessor], 50)
+        XCTAssertEqual(snapshot.depths[.spanProcessor], 1)
+        XCTAssertEqual(snapshot.bytes[.logBatcher], 0)
+        XCTAssertEqual(snapshot.peakBytes, 250)
+
+        sut.release(200, count: 2, for: .networkBodies)
+        XCTAssertEqual(sut.snapshot().depths[.networkBodies], 0)
+        XCTAssertEqual(sut.snapshot().peakBytes, 250)
+    }
+
+    func test_level_followsCeilingUsage() {
+        let sut = budget(ceiling: 1000)
+        XCTAssertEqual(sut.level, .normal)
+
+        sut.track(500, for: .uploads)
+        XCTAssertEqual(sut.level, .elevated)
+
+        sut.track(250, for: .uploads)
+        XCTAssertEqual(sut.level, .high)
+
+        sut.track(150, for: .uploads)
+        XCTAssertEqual(sut.level, .critical)
+
+        sut.release(900, count: 3, for: .uploads)
+        XCTAssertEqual(sut.level, .normal)
+    }
+
+    func test_level_followsAvailableMemory() {
+        let sut = budget(ceiling: 1000)
+
+        availableMemory = UInt64(40 * megabyte)
+        XCTAssertEqual(sut.level, .elevated)
+
+        // the available memory is only checked every so often
+        availableMemory = UInt64(10 * megabyte)
+        XCTAssertEqual(sut.level, .elevated)
+
+        now += second
+        XCTAssertEqual(sut.level, .critical)
+
+        now += second
+        availableMemory = nil
+        XCTAssertEqual(sut.level, .normal)
+    }
+
+    func test_memoryPressure_raisesLevelForAWhile() {
+        let sut = budget(ceiling: 1000)
+
+        sut.reportMemoryPressure(critical: false)
+        XCTAssertEqual(sut.level, .high)
+
+        sut.reportMemoryPressure(critical: true)
+        XCTAssertEqual(sut.level, .critical)
+
+        now += 61 * second
+        XCTAssertEqual(sut.level, .normal)
+    }
+
+    func test_failingUploads_raiseLevelOverTime() {
+        let sut = budget(ceiling: 1000)
+
+        sut.reportUpload(succeeded: false)
+        now += 60 * second
+        sut.reportUpload(succeeded: false)
+        XCTAssertEqual(sut.level, .normal)
+
+        // measured from the first failure
+        now += 15 * 60 * second
+        XCTAssertEqual(sut.level, .elevated)
+
+        now += 60 * 60 * second
+        XCTAssertEqual(sut.level, .high)
+
+        sut.reportUpload(succeeded: true)
+        XCTAssertEqual(sut.level, .normal)
+    }
+
+    func test_logs_areDroppedBySeverity() {
+        let sut = budget(ceiling: 1000)
+
+        // elevated
+        sut.track(500, for: .logBatcher)
+        XCTAssertFalse(sut.admitsLog(severity: .trace))
+        XCTAssertFalse(sut.admitsLog(severity: .debug))
+        XCTAssertTrue(sut.admitsLog(severity: .info))
+
+        // critical
+        sut.track(500, for: .logBatcher)
+        XCTAssertFalse(sut.admitsLog(severity: .info))
+        XCTAssertTrue(sut.admitsLog(severity: .warn))
+        XCTAssertTrue(sut.admitsLog(severity: .error))
+
+        XCTAssertEqual(sut.snapshot().drops, [.debugLogs: 2, .infoLogs: 1])
+    }
+
+    func test_networkSpans_areSampledWhenHigh() {
+        let sut = budget(ceiling: 1000)
+        XCTAssertTrue(sut.admitsNetworkSpan())
+        XCTAssertTrue(sut.admitsNetworkBody())
+
+        // when high
+        sut.track(800, for: .networkBodies)
+
+        // then one span out of ten is kept, and no bodies
+        let kept = (0..<100).filter { _ in sut.admitsNetworkSpan() }.count
+        XCTAssertEqual(kept, 10)
+        XCTAssertFalse(sut.admitsNetworkBody())
+        XCTAssertTrue(sut.admitsLowPriorityUploads)
+
+        XCTAssertEqual(sut.snapshot().drops, [.networkSpans: 90, .networkBodies: 1])
+    }
+
+    func test_lowPriorityUploads_areShedWhenCritical() {
+        let sut = budget(ceiling: 1000)
+        sut.reportMemoryPressure(critical: true)
+
+        XCTAssertFalse(sut.admitsLowPriorityUploads)
+    }
+
+    func test_snapshot_reset() {
+        // given a budget that had to step in
+        let sut = budget(ceiling: 1000)
+        sut.track(900, for: .uploads)
+        XCTAssertFalse(sut.admitsLog(severity: .debug))
+        sut.release(800, for: .uploads)
+
+        // when taking a snapshot that resets it
+        let snapshot = sut.snapshot(reset: true)
+
+        // then it has the peak, level and drops
+        XCTAssertTrue(snapshot.isDegraded)
+        XCTAssertEqual(snapshot.peakBytes, 900)
+        XCTAssertEqual(snapshot.maxLevel, .critical)
+        XCTAssertEqual(snapshot.drops, [.debugLogs: 1])
+
+        // and the next one starts over from what's tracked now
+        let next = sut.snapshot()
+        XCTAssertFalse(next.isDegraded)
+        XCTAssertEqual(next.peakBytes, 100)
+        XCTAssertEqual(next.bytes[.uploads], 100)
+    }
+}
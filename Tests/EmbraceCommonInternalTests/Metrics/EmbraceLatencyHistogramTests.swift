@@ -0,0 +1,110 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import XCTest
+
+@testable import EmbraceCommonInternal
+
+class EmbraceLatencyHistogramTests: XCTestCase {
+
+    func test_index_roundTrips() {
+        for index in 0..<EmbraceLatencyHistogram.bucketCount {
+            let lowest = EmbraceLatencyHistogram.lowestValue(inBucket: index)
+            let highest = EmbraceLatencyHistogram.highestValue(inBucket: index)
+
+            XCTAssertEqual(EmbraceLatencyHistogram.index(of: lowest), index)
+            XCTAssertEqual(EmbraceLatencyHistogram.index(of: highest), index)
+            XCTAssertLessThanOrEqual(highest - lowest, max(lowest / 16, 1))
+
+            if index > 0 {
+                XCTAssertEqual(EmbraceLatencyHistogram.highestValue(inBucket: index - 1) + 1, lowest)
+            }
+        }
+    }
+
+    func test_index_clampsLargeValues() {
+        let last = EmbraceLatencyHistogram.bucketCount - 1
+        XCTAssertEqual(EmbraceLatencyHistogram.index(of: 1 << 37), last)
+        XCTAssertEqual(EmbraceLatencyHistogram.index(of: .max), last)
+    }
+
+    func test_snapshot_emptyHistogram() {
+        let snapshot = EmbraceLatencyHistogram(name: "test").snapshot()
+
+        XCTAssertEqual(snapshot.name, "test")
+        XCTAssertEqual(snapshot.count, 0)
+        XCTAssertEqual(snapshot.mean, 0)
+        XCTAssertEqual(snapshot.value(atPercentile: 99), 0)
+    }
+
+    func test_percentiles() {
+        // given a histogram with the values 1µs to 1000µs
+        let sut = EmbraceLatencyHistogram(name: "test")
+        for value in 1...1000 {
+            sut.record(nanoseconds: UInt64(value) * 1000)
+        }
+
+        // when taking a snapshot
+        let snapshot = sut.snapshot()
+
+        // then the percentiles are within the precision of the buckets
+        XCTAssertEqual(snapshot.count, 1000)
+        XCTAssertEqual(snapshot.max, 1_000_000)
+        XCTAssertEqual(snapshot.mean, 500_500)
+        assertClose(snapshot.value(atPercentile: 50), 500_000)
+        assertClose(snapshot.value(atPercentile: 90), 900_000)
+        assertClose(snapshot.value(atPercentile: 99), 990_000)
+        XCTAssertEqual(snapshot.value(atPercentile: 100), 1_000_000)
+    }
+
+    func test_snapshot_reset() {
+        // given a histogram with values
+        let sut = EmbraceLatencyHistogram(name: "test")
+        sut.record(nanoseconds: 5_000)
+        sut.record(nanoseconds: 10_000)
+
+        // when taking a snapshot that resets it
+        let snapshot = sut.snapshot(reset: true)
+
+        // then the snapshot has the values and the histogram starts over
+        XCTAssertEqual(snapshot.count, 2)
+        XCTAssertEqual(snapshot.sum, 15_000)
+        XCTAssertEqual(snapshot.max, 10_000)
+
+        let next = sut.snapshot()
+        XCTAssertEqual(next.count, 0)
+        XCTAssertEqual(next.max, 0)
+        XCTAssertEqual(next.value(atPercentile: 50), 0)
+    }
+
+    func test_recordSince() {
+        let sut = EmbraceLatencyHistogram(name: "test")
+
+        sut.record(since: EmbraceLatencyHistogram.now())
+        sut.record(since: .max)
+
+        XCTAssertEqual(sut.snapshot().count, 2)
+    }
+
+    func test_concurrentRecords() {
+        let sut = EmbraceLatencyHistogram(name: "test", shards: 4)
+        let threads = max(8, ProcessInfo.processInfo.processorCount * 2)
+        let perThread = 20_000
+
+        DispatchQueue.concurrentPerform(iterations: threads) { thread in
+            for value in 0..<perThread {
+                sut.record(nanoseconds: UInt64(thread * perThread + value))
+            }
+        }
+
+        let snapshot = sut.snapshot()
+        XCTAssertEqual(snapshot.count, UInt64(threads * perThread))
+        XCTAssertEqual(snapshot.max, UInt64(threads * perThread - 1))
+    }
+
+    private func assertClose(_ value: UInt64, _ expected: UInt64, file: StaticString = #filePath, line: UInt = #line) {
+        XCTAssertLessThanOrEqual(Double(value), Double(expected) * 1.07, file: file, line: line)
+        XCTAssertGreaterThanOrEqual(Double(value), Double(expected) * 0.93, file: file, line: line)
+    }
+}
@@ -0,0 +1,79 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import XCTest
+
+@testable import EmbraceCommonInternal
+
+class EmbraceSelfMetricsTests: XCTestCase {
+
+    func test_disabled_recordsNothing() {
+        // given disabled metrics
+        let sut = EmbraceSelfMetrics()
+
+        // when recording values
+        sut.record("test", nanoseconds: 1_000)
+        sut.count("test")
+
+        // then nothing is recorded
+        XCTAssertNil(sut.histogram("test"))
+        XCTAssertTrue(sut.snapshot().isEmpty)
+    }
+
+    func test_histogram_createdOnce() {
+        let sut = EmbraceSelfMetrics()
+        sut.bootstrap(enabled: true)
+
+        XCTAssertTrue(sut.histogram("test") === sut.histogram("test"))
+        XCTAssertFalse(sut.histogram("test") === sut.histogram("other"))
+    }
+
+    func test_staticHistogram_sharedWithStringLookup() {
+        let sut = EmbraceSelfMetrics()
+        let name: StaticString = "test"
+
+        // disabled until bootstrapped
+        XCTAssertNil(sut.histogram(name))
+
+        sut.bootstrap(enabled: true)
+        let histogram = sut.histogram(name)
+        XCTAssertNotNil(histogram)
+        XCTAssertTrue(histogram === sut.histogram(name))
+        XCTAssertTrue(histogram === sut.histogram(String("test")))
+    }
+
+    func test_snapshot() {
+        // given metrics with values
+        let sut = EmbraceSelfMetrics()
+        sut.bootstrap(enabled: true)
+        sut.record("b", nanoseconds: 2_000)
+        sut.record("a", nanoseconds: 1_000)
+        sut.count("failures")
+        sut.count("failures", 2)
+        _ = sut.histogram("empty")
+
+        // when taking a snapshot that resets them
+        let snapshot = sut.snapshot(reset: true)
+
+        // then it has the recorded values, sorted, and the next one is empty
+        XCTAssertEqual(snapshot.histograms.map(\.name), ["a", "b"])
+        XCTAssertEqual(snapshot.histograms.map(\.count), [1, 1])
+        XCTAssertEqual(snapshot.counters, ["failures": 3])
+        XCTAssertTrue(sut.snapshot().isEmpty)
+    }
+
+    func test_concurrentFirstUse() {
+        let sut = EmbraceSelfMetrics()
+        sut.bootstrap(enabled: true)
+
+        DispatchQueue.concurrentPerform(iterations: 16) { index in
+            sut.record("test-\(index % 4)", nanoseconds: 1_000)
+            sut.count("test")
+        }
+
+        let snapshot = sut.snapshot()
+        XCTAssertEqual(snapshot.histograms.reduce(0) { $0 + $1.count }, 16)
+        XCTAssertEqual(snapshot.counters["test"], 16)
+    }
+}
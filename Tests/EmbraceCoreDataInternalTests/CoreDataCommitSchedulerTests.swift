@@ -0,0 +1,154 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import CoreData
+import EmbraceCommonInternal
+import Foundation
+import TestSupport
+import XCTest
+
+#if canImport(UIKit) && !os(watchOS)
+    import UIKit
+#endif
+
+@testable import EmbraceCoreDataInternal
+
+class CoreDataCommitSchedulerTests: XCTestCase {
+
+    func createWrapper(policy: CoreDataWrapper.CommitPolicy) throws -> CoreDataWrapper {
+        let options = CoreDataWrapper.Options(
+            storageMechanism: .inMemory(name: testName),
+            enableBackgroundTasks: false,
+            entities: [MockRecord.entityDescription],
+            commitPolicy: policy
+        )
+        return try CoreDataWrapper(options: options, logger: MockLogger())
+    }
+
+    func insert(_ wrapper: CoreDataWrapper, id: String) {
+        wrapper.performOperation(save: true) { context in
+            _ = MockRecord.create(context: context, id: id)
+        }
+    }
+
+    func test_immediate_savesEveryMutation() throws {
+        // given a wrapper that saves immediately
+        let wrapper = try createWrapper(policy: .immediate)
+
+        // when inserting records
+        for i in 0..<5 {
+            insert(wrapper, id: "\(i)")
+        }
+
+        // then each mutation is saved
+        XCTAssertEqual(wrapper.saveCount, 5)
+        XCTAssertFalse(wrapper.performOperation { $0.hasChanges })
+    }
+
+    func test_coalesced_defersSavesUntilThreshold() throws {
+        // given a wrapper that coalesces up to 10 changes
+        let wrapper = try createWrapper(policy: .coalesced(maxPendingChanges: 10, maxDelay: 60))
+
+        // when inserting fewer records than the threshold
+        for i in 0..<9 {
+            insert(wrapper, id: "\(i)")
+        }
+
+        // then nothing is saved yet, but the data is visible
+        XCTAssertEqual(wrapper.saveCount, 0)
+        XCTAssertEqual(wrapper.count(withRequest: NSFetchRequest<MockRecord>(entityName: MockRecord.entityName)), 9)
+
+        // when reaching the threshold
+        insert(wrapper, id: "9")
+
+        // then all changes are saved at once
+        XCTAssertEqual(wrapper.saveCount, 1)
+        XCTAssertFalse(wrapper.performOperation { $0.hasChanges })
+    }
+
+    func test_coalesced_savesWhenWindowCloses() throws {
+        // given a wrapper with a short commit window
+        let wrapper = try createWrapper(policy: .coalesced(maxPendingChanges: 1000, maxDelay: 0.1))
+
+        // when inserting a few records
+        for i in 0..<3 {
+            insert(wrapper, id: "\(i)")
+        }
+        XCTAssertEqual(wrapper.saveCount, 0)
+
+        // then a single save happens after the window
+        wait(timeout: 2) {
+            wrapper.saveCount == 1
+        }
+        XCTAssertFalse(wrapper.performOperation { $0.hasChanges })
+    }
+
+    func test_flush_isDurabilityBarrier() throws {
+        // given a wrapper with pending changes
+        let wrapper = try createWrapper(policy: .coalesced(maxPendingChanges: 1000, maxDelay: 60))
+        insert(wrapper, id: "a")
+        insert(wrapper, id: "b")
+
+        // when flushing
+        wrapper.flush()
+
+        // then everything is saved in one go
+        XCTAssertEqual(wrapper.saveCount, 1)
+        XCTAssertFalse(wrapper.performOperation { $0.hasChanges })
+
+        // and flushing without changes doesn't save again
+        wrapper.flush()
+        XCTAssertEqual(wrapper.saveCount, 1)
+    }
+
+    func test_flush_insideOperation() throws {
+        // given a wrapper with pending changes
+        let wrapper = try createWrapper(policy: .coalesced(maxPendingChanges: 1000, maxDelay: 60))
+        insert(wrapper, id: "a")
+
+        // when flushing from inside an operation
+        let saved = wrapper.performOperation { context in
+            _ = MockRecord.create(context: context, id: "b")
+            return wrapper.flush()
+        }
+
+        // then both changes are saved
+        XCTAssertTrue(saved)
+        XCTAssertEqual(wrapper.saveCount, 1)
+        XCTAssertFalse(wrapper.performOperation { $0.hasChanges })
+    }
+
+    #if canImport(UIKit) && !os(watchOS)
+        func test_willTerminate_flushes() throws {
+            // given a wrapper with pending changes
+            let wrapper = try createWrapper(policy: .coalesced(maxPendingChanges: 1000, maxDelay: 60))
+            insert(wrapper, id: "a")
+
+            // when the app is about to terminate
+            NotificationCenter.default.post(name: UIApplication.willTerminateNotification, object: nil)
+
+            // then the changes are saved before the notification returns
+            XCTAssertEqual(wrapper.saveCount, 1)
+            XCTAssertFalse(wrapper.performOperation { $0.hasChanges })
+        }
+    #endif
+
+    func test_scheduler_armsOncePerWindow() {
+        var armed: [TimeInterval] = []
+        let scheduler = CoreDataCommitScheduler(policy: .coalesced(maxPendingChanges: 3, maxDelay: 0.5)) {
+            armed.append($0)
+        }
+
+        XCTAssertFalse(scheduler.didChange())
+        XCTAssertFalse(scheduler.didChange())
+        XCTAssertEqual(armed, [0.5])
+        XCTAssertTrue(scheduler.didChange())
+
+        scheduler.didCommit()
+        XCTAssertFalse(scheduler.deadlineReached())
+        XCTAssertFalse(scheduler.didChange())
+        XCTAssertEqual(armed, [0.5, 0.5])
+        XCTAssertTrue(scheduler.deadlineReached())
+    }
+}
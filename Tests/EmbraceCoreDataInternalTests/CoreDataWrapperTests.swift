@@ -152,6 +152,42 @@ class CoreDataWrapperTests: XCTestCase {
         XCTAssertEqual(result.count, 0)
     }
 
+    func test_batchDeleteRecords() throws {
+        // given a wrapper with unsaved data
+        _ = MockRecord.create(context: wrapper.context, id: "test1")
+        _ = MockRecord.create(context: wrapper.context, id: "test2")
+        _ = MockRecord.create(context: wrapper.context, id: "keep")
+
+        // when batch deleting some of it
+        let request = NSFetchRequest<MockRecord>(entityName: MockRecord.entityName)
+        request.predicate = NSPredicate(format: "id BEGINSWITH %@", "test")
+        let count = wrapper.batchDeleteRecords(withRequest: request)
+
+        // then only the matching records are deleted
+        XCTAssertEqual(count, 2)
+        let result = wrapper.fetch(withRequest: NSFetchRequest<MockRecord>(entityName: MockRecord.entityName))
+        XCTAssertEqual(result.map(\.id), ["keep"])
+    }
+
+    func test_batchDeleteRecords_honorsFetchLimit() throws {
+        // given a wrapper with data
+        for i in 0..<5 {
+            _ = MockRecord.create(context: wrapper.context, id: "test\(i)")
+        }
+        wrapper.save()
+
+        // when batch deleting with a sorted, limited request
+        let request = NSFetchRequest<MockRecord>(entityName: MockRecord.entityName)
+        request.sortDescriptors = [NSSortDescriptor(key: "id", ascending: true)]
+        request.fetchLimit = 2
+        let count = wrapper.batchDeleteRecords(withRequest: request)
+
+        // then only the first records are deleted
+        XCTAssertEqual(count, 2)
+        let remaining = wrapper.fetch(withRequest: NSFetchRequest<MockRecord>(entityName: MockRecord.entityName))
+        XCTAssertEqual(Set(remaining.map(\.id)), ["test2", "test3", "test4"])
+    }
+
     func test_performOperation_returnsNil() throws {
         let expectedReturnValue: Int? = nil
         let val = wrapper.performOperation { _ in
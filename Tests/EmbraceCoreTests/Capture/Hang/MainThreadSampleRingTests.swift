@@ -0,0 +1,118 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+#if !os(watchOS) && !os(macOS)
+
+    import EmbraceCommonInternal
+    import Foundation
+    import TestSupport
+    import XCTest
+
+    @testable import EmbraceCore
+
+    final class MainThreadSampleRingTests: XCTestCase {
+
+        /// Writes `count` frames whose addresses are `base + i`, stamped at `timestamp`.
+        private func write(_ ring: MainThreadSampleRing, timestamp: UInt64, base: UInt, count: Int) {
+            ring.write { frames, capacity in
+                let n = min(count, capacity)
+                for i in 0..<n {
+                    frames[i] = base + UInt(i)
+                }
+                return (timestamp: timestamp, overhead: 7, count: n)
+            }
+        }
+
+        func test_samplesAreReturnedOldestToNewest_withTheirFrames() {
+            let ring = MainThreadSampleRing(capacity: 4, framesPerSlot: 16)
+            write(ring, timestamp: 100, base: 0x1000, count: 3)
+            write(ring, timestamp: 200, base: 0x2000, count: 5)
+
+            let samples = ring.samples(in: 0...UInt64.max)
+            XCTAssertEqual(samples.map(\.timestamp), [100, 200])
+            XCTAssertEqual(samples.map(\.overhead), [7, 7])
+            XCTAssertEqual(samples[0].backtrace.threads.first?.callstack.addresses, [0x1000, 0x1001, 0x1002])
+            XCTAssertEqual(samples[1].backtrace.threads.first?.callstack.count, 5)
+            XCTAssertEqual(samples[1].backtrace.timestamp, 200)
+        }
+
+        func test_wrapAround_keepsOnlyTheNewestCapacitySamples() {
+            let ring = MainThreadSampleRing(capacity: 3, framesPerSlot: 4)
+            for i in 1...7 {
+                write(ring, timestamp: UInt64(i), base: UInt(i) << 8, count: 2)
+            }
+
+            let samples = ring.samples(in: 0...UInt64.max)
+            XCTAssertEqual(samples.map(\.timestamp), [5, 6, 7])
+            XCTAssertEqual(samples.last?.backtrace.threads.first?.callstack.addresses, [0x700, 0x701])
+        }
+
+        func test_rangeFiltersByTimestamp() {
+            let ring = MainThreadSampleRing(capacity: 8, framesPerSlot: 4)
+            for ts: UInt64 in [10, 20, 30, 40] {
+                write(ring, timestamp: ts, base: 1, count: 1)
+            }
+            XCTAssertEqual(ring.samples(in: 15...35).map(\.timestamp), [20, 30])
+        }
+
+        func test_framesAreClampedToSlotSize() {
+            let ring = MainThreadSampleRing(capacity: 2, framesPerSlot: 4)
+            ring.write { frames, capacity in
+                for i in 0..<capacity { frames[i] = UInt(i) }
+                return (timestamp: 1, overhead: 0, count: 1_000)  // a walker that over-reports
+            }
+            XCTAssertEqual(ring.samples(in: 0...UInt64.max).first?.backtrace.threads.first?.callstack.count, 4)
+        }
+
+        func test_failedCapture_doesNotPublishAndRetiresTheSlot() {
+            let ring = MainThreadSampleRing(capacity: 1, framesPerSlot: 4)
+            write(ring, timestamp: 1, base: 1, count: 1)
+            ring.write { _, _ in nil }
+
+            XCTAssertTrue(
+                ring.samples(in: 0...UInt64.max).isEmpty,
+                "a failed walk may have overwritten the slot; it must not be returned as the old sample")
+
+            write(ring, timestamp: 2, base: 2, count: 1)
+            XCTAssertEqual(ring.samples(in: 0...UInt64.max).map(\.timestamp), [2])
+        }
+
+        /// One writer, many lock-free readers: every sample a reader gets back must be internally
+        /// consistent (all frames derived from its own timestamp) and in order.
+        func test_concurrentReaders_neverObserveTornSlots() throws {
+            // seqlock payload reads race the writer by design (and are discarded when torn); TSan
+            // can't model that and would report it.
+            try XCTSkipIfSanitizing("seqlock payload reads are intentionally unsynchronized")
+
+            let ring = MainThreadSampleRing(capacity: 4, framesPerSlot: 32)
+            let done = EmbraceAtomic<Bool>(false)
+            let group = DispatchGroup()
+
+            for _ in 0..<4 {
+                DispatchQueue.global(qos: .userInitiated).async(group: group) {
+                    while !done.load() {
+                        let samples = ring.samples(in: 0...UInt64.max)
+                        let stamps = samples.map(\.timestamp)
+                        XCTAssertEqual(stamps, stamps.sorted())
+                        for sample in samples {
+                            let expected = (0..<32).map { UInt(sample.timestamp) &* 1_000 &+ UInt($0) }
+                            XCTAssertEqual(sample.backtrace.threads.first?.callstack.addresses, expected)
+                        }
+                    }
+                }
+            }
+
+            for ts in 1...20_000 {
+                ring.write { frames, capacity in
+                    for i in 0..<capacity { frames[i] = UInt(ts) &* 1_000 &+ UInt(i) }
+                    return (timestamp: UInt64(ts), overhead: 0, count: capacity)
+                }
+            }
+            done.store(true)
+
+            XCTAssertEqual(group.wait(timeout: .now() + 30), .success)
+        }
+    }
+
+#endif
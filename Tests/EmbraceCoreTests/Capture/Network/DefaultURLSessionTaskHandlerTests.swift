@@ -129,6 +129,39 @@ class DefaultURLSessionTaskHandlerTests: XCTestCase {
         thenSpanShouldHaveErrorMessageAttribute(withValue: "Sad Error!")
     }
 
+    // MARK: - Aggregation
+
+    func test_aggregatedRequest_isSummarizedWithoutSpan() throws {
+        givenTaskHandler()
+        givenAnURLSessionTask(method: "GET")
+        givenAggregationForTaskUrl()
+        whenInvokingCreate(withoutWaiting: true)
+        thenNoSpanShouldBeCreated()
+        whenInvokingFinish(withoutWaiting: true)
+        thenSpanShouldntEnd()
+
+        let summaries = try XCTUnwrap(dataSource.aggregator).flush()
+        XCTAssertEqual(summaries.count, 1)
+        XCTAssertEqual(summaries.first?.method, "GET")
+        XCTAssertEqual(summaries.first?.count, 1)
+        XCTAssertEqual(summaries.first?.statusCodes, [200: 1])
+    }
+
+    func test_aggregatedRequestWithError_isStillCapturedAsSpan() throws {
+        givenTaskHandler()
+        givenAnURLSessionTask(method: "GET")
+        givenAggregationForTaskUrl()
+        whenInvokingCreate(withoutWaiting: true)
+        whenInvokingFinish(
+            error: NSError(domain: "RequestDomain", code: 1234, userInfo: [NSLocalizedDescriptionKey: "Sad Error!"]))
+        thenSpanShouldHaveErrorDomainAttribute(withValue: "RequestDomain")
+        thenSpanShouldHaveErrorCodeAttribute(withValue: 1234)
+
+        let summaries = try XCTUnwrap(dataSource.aggregator).flush()
+        XCTAssertEqual(summaries.first?.count, 1)
+        XCTAssertEqual(summaries.first?.errorCount, 1)
+    }
+
     // MARK: - Tracing header
 
     func test_configsEnabled_tracingHeaderIncluded() {
@@ -349,6 +382,13 @@ extension DefaultURLSessionTaskHandlerTests {
         dataSource.requestsDataSource = requestsDataSource
     }
 
+    fileprivate func givenAggregationForTaskUrl() {
+        let template = URLTemplate.template(for: task.originalRequest!.url!)
+        dataSource.aggregator = NetworkRequestAggregator(
+            options: URLSessionCaptureService.Aggregation(templates: [template], slowRequestThreshold: 60)
+        )
+    }
+
     fileprivate func givenIgnoredURLs() {
         dataSource.ignoredURLs = ["embrace.io"]
     }
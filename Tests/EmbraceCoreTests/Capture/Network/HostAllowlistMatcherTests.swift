@@ -67,4 +67,81 @@ final class HostAllowlistMatcherTests: XCTestCase {
     func test_unrelatedHost_ReturnsFalse() {
         XCTAssertFalse(HostAllowlistMatcher.matches(host: "notinlist.com", allowlist: ["test.com", "othertest.com"]))
     }
+
+    // MARK: - Matched rule
+
+    func test_match_ReturnsMostSpecificEntry() {
+        let matcher = HostAllowlistMatcher(allowlist: ["test.com", "api.test.com", "other.com"])
+
+        XCTAssertEqual(matcher.match(host: "v1.API.test.com"), "api.test.com")
+        XCTAssertEqual(matcher.match(host: "cdn.test.com"), "test.com")
+        XCTAssertEqual(matcher.match(host: "other.com"), "other.com")
+        XCTAssertNil(matcher.match(host: "api.test.org"))
+        XCTAssertNil(matcher.match(host: nil))
+    }
+
+    // MARK: - Equivalence with the per-entry suffix check
+
+    /// The matcher used before the allowlist was compiled into a trie.
+    private func referenceMatches(host: String?, allowlist: [String]) -> Bool {
+        guard !allowlist.isEmpty else { return false }
+        guard let host else { return false }
+
+        let lowerHost = host.lowercased()
+        for entry in allowlist {
+            if lowerHost == entry { return true }
+            if lowerHost.hasSuffix("." + entry) { return true }
+        }
+        return false
+    }
+
+    func test_compiledMatcher_MatchesReference() {
+        let allowlist = [
+            "test.com", "api.example.org", "example.net", "co.uk", "a.b.c.d.e", "xn--bcher-kva.example",
+            "münchen.de", "localhost", "127.0.0.1", "test.com.fail.com", "a..b"
+        ]
+        let hosts: [String?] = [
+            nil, "", ".", "test.com", "TEST.COM", "api.test.com", "failtest.com", "test.com.", "test.com.fail.com",
+            "x.test.com.fail.com", "api.example.org", "v2.API.example.org", "example.org", "www.example.net",
+            "example.net.evil.com", "bbc.co.uk", "co.uk", "uk", "x.a.b.c.d.e", "b.c.d.e", "xn--bcher-kva.example",
+            "MÜNCHEN.de", "www.münchen.de", "localhost", "sub.localhost", "127.0.0.1", "1127.0.0.1", "x.a..b",
+            "..test.com", "test..com", "com"
+        ]
+
+        for count in [0, 1, 3, allowlist.count] {
+            let entries = Array(allowlist.prefix(count))
+            let matcher = HostAllowlistMatcher(allowlist: entries)
+
+            for host in hosts {
+                XCTAssertEqual(
+                    matcher.matches(host: host),
+                    referenceMatches(host: host, allowlist: entries),
+                    "host: \(host ?? "nil"), allowlist: \(entries)"
+                )
+            }
+        }
+    }
+
+    func test_compiledMatcher_MatchesReference_RandomHosts() {
+        var generator = SystemRandomNumberGenerator()
+        let labels = ["a", "b", "api", "test", "com", "org", "Test", "COM", "x-y", ""]
+
+        func randomName(_ maxLabels: Int) -> String {
+            (0..<Int.random(in: 1...maxLabels, using: &generator))
+                .map { _ in labels.randomElement(using: &generator)! }
+                .joined(separator: ".")
+        }
+
+        let allowlist = (0..<20).map { _ in randomName(3).lowercased() }
+        let matcher = HostAllowlistMatcher(allowlist: allowlist)
+
+        for _ in 0..<2_000 {
+            let host = randomName(5)
+            XCTAssertEqual(
+                matcher.matches(host: host),
+                referenceMatches(host: host, allowlist: allowlist),
+                "host: \(host), allowlist: \(allowlist)"
+            )
+        }
+    }
 }
@@ -138,6 +138,107 @@ class EncryptedNetworkPayloadTests: XCTestCase {
         // then the encryption fails
         XCTAssertNil(result)
     }
+
+    func streamedPayload(body: Data, bodyLimit: Int = .max, bufferLimit: Int = .max) -> EncryptedNetworkPayload? {
+        let url = URL(string: "www.test.com/user/1234")!
+        var request = URLRequest(url: url)
+        request.httpMethod = "GET"
+
+        // received in irregular pieces, like a data task
+        let buffer = NetworkBodyBuffer(limit: bufferLimit)
+        var offset = 0
+        while offset < body.count {
+            let length = min(1 + (offset * 7919) % 50_000, body.count - offset)
+            buffer.append(body[offset..<(offset + length)])
+            offset += length
+        }
+
+        return EncryptedNetworkPayload(
+            request: request,
+            response: nil,
+            body: buffer,
+            bodyLimit: bodyLimit,
+            error: nil,
+            startTime: startTime,
+            endTime: endTime,
+            matchedUrl: "www.test.com/user/*",
+            sessionId: TestConstants.sessionId
+        )
+    }
+
+    func test_streamedJSON_multiMegabyteBody() throws {
+        // given a multi-megabyte body with characters that need escaping
+        let line = "{\"name\": \"caf\u{e9} \\ \u{1F600}\",\t\"id\": 42}\r\n\u{01}"
+        let text = String(repeating: line, count: 100_000)
+        let payload = try XCTUnwrap(streamedPayload(body: Data(text.utf8)))
+
+        // when writing its json
+        let data = try XCTUnwrap(payload.jsonData())
+        let dict = try XCTUnwrap(JSONSerialization.jsonObject(with: data, options: []) as? [String: Any])
+
+        // then the body round trips and the rest of the payload is there
+        XCTAssertEqual(dict["response-body"] as! String, text)
+        XCTAssertEqual(dict["response-body-size"] as! Int, text.utf8.count)
+        XCTAssertEqual(dict["url"] as! String, "www.test.com/user/1234")
+        XCTAssertEqual(dict["matched-url"] as! String, "www.test.com/user/*")
+
+        // and it's the same json the encoder writes
+        let encoded = try JSONEncoder().encode(payload)
+        let encodedDict = try XCTUnwrap(JSONSerialization.jsonObject(with: encoded, options: []) as? [String: Any])
+        XCTAssertEqual(NSDictionary(dictionary: dict), NSDictionary(dictionary: encodedDict))
+    }
+
+    func test_streamedJSON_truncatedBody() throws {
+        // given a body cut in the middle of a character
+        let text = "a" + String(repeating: "\u{e9}", count: 2_000_000)
+        let payload = try XCTUnwrap(streamedPayload(body: Data(text.utf8), bodyLimit: 2_000_000))
+
+        // when writing its json
+        let data = try XCTUnwrap(payload.jsonData())
+        let dict = try XCTUnwrap(JSONSerialization.jsonObject(with: data, options: []) as? [String: Any])
+
+        // then the body ends at the last complete character, and the size is the full one
+        XCTAssertEqual(dict["response-body"] as! String, "a" + String(repeating: "\u{e9}", count: 999_999))
+        XCTAssertEqual(dict["response-body-size"] as! Int, text.utf8.count)
+    }
+
+    func test_streamedJSON_bufferLimit() throws {
+        // given a body that was only partially kept while received
+        let body = Data(repeating: UInt8(ascii: "x"), count: 3_000_000)
+        let payload = try XCTUnwrap(streamedPayload(body: body, bufferLimit: 100_000))
+
+        // then only the kept bytes are captured, but the size is the full one
+        XCTAssertEqual(payload.responseBody?.utf8.count, 100_000)
+        XCTAssertEqual(payload.responseBodySize, 3_000_000)
+    }
+
+    func test_streamedJSON_invalidUTF8() throws {
+        // given a binary body
+        let body = Data([0x7B, 0xFF, 0x00, 0x7D])
+        let payload = try XCTUnwrap(streamedPayload(body: body))
+
+        // when writing its json
+        let data = try XCTUnwrap(payload.jsonData())
+        let dict = try XCTUnwrap(JSONSerialization.jsonObject(with: data, options: []) as? [String: Any])
+
+        // then the body is left out, like `String(data:encoding:)` would
+        XCTAssertNil(dict["response-body"])
+        XCTAssertEqual(dict["response-body-size"] as! Int, 4)
+    }
+
+    func test_encryption_multiMegabyteBody() throws {
+        // given a payload with a multi-megabyte body
+        let body = Data(String(repeating: "0123456789abcdef", count: 250_000).utf8)
+        let payload = try XCTUnwrap(streamedPayload(body: body))
+
+        // when encrypting it
+        let result = try XCTUnwrap(payload.encrypted(withKey: TestConstants.rsaSanitizedPublicKey))
+
+        // then the encrypted payload holds the whole json
+        let json = try XCTUnwrap(payload.jsonData())
+        let encrypted = try XCTUnwrap(Data(base64Encoded: result.payload))
+        XCTAssertEqual(encrypted.count, (json.count / 16 + 1) * 16)
+    }
 }
 
 // swiftlint:enable force_cast
@@ -39,4 +39,28 @@ class EncryptionHelperTests: XCTestCase {
         XCTAssertNotNil(result)
         XCTAssertEqual(result?.algorithm, "aes-256-cbc")
     }
+
+    func test_aesStream_matchesOneShot() throws {
+        // given a multi-megabyte input
+        var generator = SystemRandomNumberGenerator()
+        let data = Data((0..<3_000_000).map { _ in UInt8.random(in: 0...255, using: &generator) })
+        let key = try XCTUnwrap(AES.createRandomKey())
+        let iv = try XCTUnwrap(AES.createRandomIv())
+
+        // when encrypting it in irregular pieces
+        let encryptor = try XCTUnwrap(AES.StreamEncryptor(key: key, iv: iv, expectedLength: data.count))
+        var offset = 0
+        while offset < data.count {
+            let length = min(Int.random(in: 1...70_000, using: &generator), data.count - offset)
+            let updated = data[offset..<(offset + length)].withUnsafeBytes { encryptor.update($0) }
+            XCTAssertTrue(updated)
+            offset += length
+        }
+        let streamed = try XCTUnwrap(encryptor.finish())
+
+        // then the output is the same as encrypting it at once
+        let oneShot = try XCTUnwrap(AES.encrypt(data: data, key: key, iv: iv))
+        XCTAssertEqual(streamed.data, oneShot.data)
+        XCTAssertEqual(streamed.algorithm, "aes-256-cbc")
+    }
 }
@@ -0,0 +1,121 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import XCTest
+
+@testable import EmbraceCore
+
+class NetworkBodyBufferTests: XCTestCase {
+
+    private func randomData(count: Int) -> Data {
+        var generator = SystemRandomNumberGenerator()
+        return Data((0..<count).map { _ in UInt8.random(in: 0...255, using: &generator) })
+    }
+
+    func test_append_multiMegabyteBody() {
+        // given a buffer with no limit
+        let buffer = NetworkBodyBuffer(limit: .max)
+        let body = randomData(count: 5_000_000)
+
+        // when appending a body in pieces that don't line up with the chunks
+        var offset = 0
+        while offset < body.count {
+            let length = min(Int.random(in: 1...200_000), body.count - offset)
+            buffer.append(body[offset..<(offset + length)])
+            offset += length
+        }
+
+        // then the whole body is kept
+        XCTAssertEqual(buffer.count, body.count)
+        XCTAssertEqual(buffer.totalBytes, body.count)
+        XCTAssertFalse(buffer.isTruncated)
+        XCTAssertEqual(buffer.data, body)
+    }
+
+    func test_append_overLimit() {
+        // given a buffer with a limit
+        let buffer = NetworkBodyBuffer(limit: 100_000)
+        let body = randomData(count: 3_000_000)
+
+        // when appending a larger body
+        stride(from: 0, to: body.count, by: 16_384).forEach {
+            buffer.append(body[$0..<min($0 + 16_384, body.count)])
+        }
+
+        // then only the first bytes are kept, but every byte is counted
+        XCTAssertEqual(buffer.count, 100_000)
+        XCTAssertEqual(buffer.totalBytes, 3_000_000)
+        XCTAssertTrue(buffer.isTruncated)
+        XCTAssertEqual(buffer.data, body.prefix(100_000))
+    }
+
+    func test_append_zeroLimit() {
+        // given a buffer for a task no rule can capture
+        let buffer = NetworkBodyBuffer(limit: 0)
+
+        // when appending data
+        buffer.append(randomData(count: 1_000))
+
+        // then nothing is kept
+        XCTAssertEqual(buffer.count, 0)
+        XCTAssertEqual(buffer.totalBytes, 1_000)
+        XCTAssertEqual(buffer.data, Data())
+    }
+
+    func test_append_toWrappedData() {
+        // given a buffer wrapping data
+        let buffer = NetworkBodyBuffer(data: Data("Hello".utf8))
+
+        // when appending to it
+        buffer.append(Data(" World".utf8))
+
+        // then the data is appended
+        XCTAssertEqual(buffer.data, Data("Hello World".utf8))
+    }
+
+    func test_pool_recyclesChunks() {
+        // given a pool
+        let pool = NetworkBodyBuffer.Pool(capacity: 4)
+
+        // when a buffer using 6 chunks is released
+        autoreleasepool {
+            let buffer = NetworkBodyBuffer(limit: .max, pool: pool)
+            buffer.append(Data(count: NetworkBodyBuffer.Pool.chunkSize * 6))
+        }
+
+        // then the pool keeps up to its capacity
+        XCTAssertEqual(pool.freeCount, 4)
+
+        // when a new buffer uses them
+        let buffer = NetworkBodyBuffer(limit: .max, pool: pool)
+        buffer.append(Data(count: NetworkBodyBuffer.Pool.chunkSize + 1))
+
+        // then they're taken from the pool
+        XCTAssertEqual(pool.freeCount, 2)
+    }
+
+    func test_utf8Validator_matchesFoundation() {
+        var generator = SystemRandomNumberGenerator()
+        let pieces: [[UInt8]] = [
+            [0x61], [0x22], [0xC3, 0xA9], [0xE2, 0x82, 0xAC], [0xF0, 0x9F, 0x98, 0x80], [0xED, 0xA0, 0x80],
+            [0xC0, 0xAF], [0xE0, 0x80, 0xAF], [0xF4, 0x90, 0x80, 0x80], [0x80], [0xFF], [0xC3], [0xF0, 0x9F]
+        ]
+
+        for _ in 0..<2_000 {
+            // given random sequences of valid and invalid UTF-8
+            let bytes = (0..<Int.random(in: 0...8, using: &generator)).flatMap { _ in
+                pieces.randomElement(using: &generator)!
+            }
+            let data = Data(bytes)
+
+            // then the buffer agrees with Foundation
+            let length = NetworkBodyBuffer(data: data).utf8Length()
+            let expected = String(data: data, encoding: .utf8)
+            XCTAssertEqual(length != nil, expected != nil, "\(bytes)")
+            if length != nil {
+                XCTAssertEqual(length, data.count)
+            }
+        }
+    }
+}
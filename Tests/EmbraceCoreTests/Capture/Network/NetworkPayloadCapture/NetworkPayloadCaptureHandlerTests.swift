@@ -186,25 +186,70 @@ class NetworkPayloadCaptureHandlerTests: XCTestCase {
         XCTAssertEqual(otel.logs[0].attributes["key-algorithm"], .string("RSA.PKCS1"))
         XCTAssertNotNil(otel.logs[0].attributes["encrypted-key"])
     }
+
+    func test_bodyCaptureLimit() throws {
+        // given a handler with a rule that sets its own body limit
+        let handler = DefaultNetworkPayloadCaptureHandler(otel: nil)
+        handler.active = true
+        handler.updateRules(
+            rules + [
+                NetworkPayloadCaptureRule(
+                    id: "rule3",
+                    urlRegex: "www.test.com/user/*",
+                    statusCodes: nil,
+                    method: "GET",
+                    expiration: 9_999_999_999,
+                    publicKey: TestConstants.rsaSanitizedPublicKey,
+                    maxBodySize: 5_000_000
+                )
+            ])
+
+        let url = URL(string: "www.test.com/user/1234")!
+        var request = URLRequest(url: url)
+        request.httpMethod = "GET"
+
+        // then the largest limit of the rules that could capture the task is used
+        XCTAssertEqual(handler.bodyCaptureLimit(request: request, response: nil), 5_000_000)
+
+        // when rule3 was triggered already, only rule1 is left
+        handler.rulesTriggeredMap = ["rule3": true]
+        XCTAssertEqual(handler.bodyCaptureLimit(request: request, response: nil), URLSessionTaskCaptureRule.defaultBodyLimit)
+
+        // and rule1 can't capture a response with a different status code
+        let response = HTTPURLResponse(url: url, statusCode: 200, httpVersion: nil, headerFields: nil)
+        XCTAssertEqual(handler.bodyCaptureLimit(request: request, response: response), 0)
+
+        // and nothing is buffered for urls no rule matches
+        request.url = URL(string: "www.test.com/other")!
+        XCTAssertEqual(handler.bodyCaptureLimit(request: request, response: nil), 0)
+    }
 }
 
 extension DefaultNetworkPayloadCaptureHandler {
     var rules: [URLSessionTaskCaptureRule] {
-        state.withLock { $0.rules }
+        state.load().rules
     }
 
     var rulesTriggeredMap: [String: Bool] {
-        get { state.withLock { $0.rulesTriggeredMap } }
-        set { state.withLock { $0.rulesTriggeredMap = newValue } }
+        get { state.load().rulesTriggeredMap }
+        set { update { $0.rulesTriggeredMap = newValue } }
     }
 
     var active: Bool {
-        get { state.withLock { $0.active } }
-        set { state.withLock { $0.active = newValue } }
+        get { state.load().active }
+        set { update { $0.active = newValue } }
     }
 
     var currentSessionId: EmbraceIdentifier? {
-        get { state.withLock { $0.currentSessionId } }
-        set { state.withLock { $0.currentSessionId = newValue } }
+        get { state.load().currentSessionId }
+        set { update { $0.currentSessionId = newValue } }
+    }
+
+    private func update(_ body: (inout State) -> Void) {
+        state.update {
+            var state = $0
+            body(&state)
+            return state
+        }
     }
 }
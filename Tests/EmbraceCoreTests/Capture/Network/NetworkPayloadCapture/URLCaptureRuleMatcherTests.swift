@@ -0,0 +1,182 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import TestSupport
+import XCTest
+
+@testable import EmbraceConfiguration
+@testable import EmbraceCore
+
+class URLCaptureRuleMatcherTests: XCTestCase {
+
+    let patterns = [
+        "www.test.com/user/*",
+        "https://www.test.com/test",
+        "api\\.example\\.com/v[0-9]+/items/\\d+$",
+        "^cdn.example.com/.*\\.png",
+        "EXAMPLE.org/search\\?q=.+",
+        "example.org/a{2,3}b",
+        "[^/]+/orders/[a-f0-9-]{8}",
+        "\\w+\\.internal/health$",
+        "^$",
+        ".*",
+        "x?",
+        "tracking/(pixel|beacon)",
+        "[[:alpha:]]+/x",
+        "invalid(regex"
+    ]
+
+    let urls = [
+        "https://www.test.com/user/12",
+        "http://WWW.TEST.COM/USER",
+        "https://www-test.com/user",
+        "https://www.test.com/test?x=1",
+        "https://api.example.com/v2/items/42",
+        "https://api.example.com/v2/items/42/details",
+        "https://api.example.com/v/items/42",
+        "https://cdn.example.com/img/logo.png",
+        "https://static.cdn.example.com/img/logo.png",
+        "https://example.org/search?q=shoes",
+        "https://example.org/search?q=",
+        "https://example.org/aab",
+        "https://example.org/aaaab",
+        "https://example.org/ab",
+        "https://shop.example.org/orders/1a2b3c4d-ffff",
+        "https://shop.example.org/orders/1a2b",
+        "https://db.internal/health",
+        "https://db.internal/health/deep",
+        "https://example.com/tracking/pixel",
+        "https://example.com/abc/x",
+        "",
+        "https://example.com/caf%C3%A9",
+        "https://example.com/café/user/*"
+    ]
+
+    private func rules(_ patterns: [String]) -> [URLSessionTaskCaptureRule] {
+        patterns.enumerated().map {
+            URLSessionTaskCaptureRule(
+                rule: NetworkPayloadCaptureRule(
+                    id: "rule\($0.offset)",
+                    urlRegex: $0.element,
+                    statusCodes: nil,
+                    method: "GET",
+                    expiration: 9_999_999_999,
+                    publicKey: TestConstants.rsaSanitizedPublicKey
+                )
+            )
+        }
+    }
+
+    func test_supportedSubset() {
+        XCTAssertNotNil(URLPattern("www.test.com/user/*"))
+        XCTAssertNotNil(URLPattern("^api\\.example\\.com/v[0-9]+/items/\\d{1,5}$"))
+        XCTAssertNotNil(URLPattern("[^/]+/orders/[a-f0-9-]{8}"))
+
+        XCTAssertNil(URLPattern("tracking/(pixel|beacon)"))
+        XCTAssertNil(URLPattern("a*+b"))
+        XCTAssertNil(URLPattern("\\sfoo"))
+        XCTAssertNil(URLPattern("café"))
+    }
+
+    func test_digitRunInvariance() {
+        XCTAssertTrue(URLPattern("/users/.*/profile")!.isDigitRunInvariant)
+        XCTAssertTrue(URLPattern("example\\.com/[a-z]+")!.isDigitRunInvariant)
+        XCTAssertFalse(URLPattern("www.test.com")!.isDigitRunInvariant)
+        XCTAssertFalse(URLPattern("/v[0-9]+/")!.isDigitRunInvariant)
+        XCTAssertFalse(URLPattern("/users/.+")!.isDigitRunInvariant)
+
+        XCTAssertEqual(URLPattern.digitRunTemplate(of: Array("a/12/b3c/456".utf8)), Array("a/\0/b\0c/\0".utf8))
+    }
+
+    func test_matchingRules_matchesRegex() {
+        // given a matcher for rules using both the automaton and the regex fallback
+        let rules = rules(patterns)
+        let matcher = URLCaptureRuleMatcher(rules: rules)
+
+        for url in urls {
+            // when matching a url
+            let matched = Set(matcher.matchingRules(for: url).map { $0.id })
+
+            // then the rules are the ones whose regex matches on its own
+            let expected = Set(rules.filter { $0.urlMatches(normalizedURL: url.removingHttpPrefix()) }.map { $0.id })
+            XCTAssertEqual(matched, expected, url)
+        }
+    }
+
+    func test_matchingRules_templatedRules_matchRegex() {
+        // given rules that don't distinguish numbers, matched through the template cache
+        let rules = rules([
+            "example\\.com/users/.*/profile",
+            "example\\.com/[a-z]+/settings$",
+            "/orders/.*status=open"
+        ])
+        let matcher = URLCaptureRuleMatcher(rules: rules)
+
+        let urls = [
+            "https://example.com/users/12/profile",
+            "https://example.com/users/345/profile",
+            "https://example.com/users/345/profile2",
+            "https://example.com/users/profile",
+            "https://example.com/abc/settings",
+            "https://example.com/abc1/settings",
+            "https://example.com/orders/99?status=open",
+            "https://example.com/orders/100?status=closed"
+        ]
+
+        // when matching urls repeatedly
+        for _ in 0..<2 {
+            for url in urls {
+                let matched = Set(matcher.matchingRules(for: url).map { $0.id })
+
+                // then the cached results still match the regexes
+                let expected = Set(rules.filter { $0.urlMatches(normalizedURL: url.removingHttpPrefix()) }.map { $0.id })
+                XCTAssertEqual(matched, expected, url)
+            }
+        }
+    }
+
+    func test_matchingRules_randomUrls_matchRegex() {
+        let rules = rules(patterns)
+        let matcher = URLCaptureRuleMatcher(rules: rules)
+
+        var generator = SystemRandomNumberGenerator()
+        let pieces = [
+            "www.", "test", ".com", "/user", "/", "api", "example", ".org", "/v2", "/items/", "42", "?q=", "x", "a", "b",
+            ".png", "internal", "/health", "-", "1a2b3c4d"
+        ]
+
+        for _ in 0..<1_000 {
+            let url = "https://" + (0..<Int.random(in: 0...8, using: &generator)).map { _ in
+                pieces.randomElement(using: &generator)!
+            }.joined()
+
+            let matched = Set(matcher.matchingRules(for: url).map { $0.id })
+            let expected = Set(rules.filter { $0.urlMatches(normalizedURL: url.removingHttpPrefix()) }.map { $0.id })
+            XCTAssertEqual(matched, expected, url)
+        }
+    }
+
+    func test_automaton_rebuildsAfterStateLimit() throws {
+        // given patterns whose optional runs produce a large number of DFA states
+        let sources = ["x[a-z]{0,30}y", "q[a-z]{0,30}xy$"]
+        let automaton = URLPatternAutomaton(patterns: sources.compactMap { URLPattern($0) })
+        let regexes = try sources.map { try NSRegularExpression(pattern: $0, options: .caseInsensitive) }
+
+        var generator = SystemRandomNumberGenerator()
+        let alphabet = Array("xqay")
+
+        // when matching enough distinct inputs to exceed the state limit
+        for _ in 0..<3_000 {
+            let input = String((0..<40).map { _ in alphabet.randomElement(using: &generator)! })
+            let matched = Array(input.utf8).withUnsafeBufferPointer { automaton.matches($0) }
+
+            // then results stay correct
+            for (index, regex) in regexes.enumerated() {
+                let expected = regex.firstMatch(in: input, range: NSRange(location: 0, length: input.utf16.count)) != nil
+                XCTAssertEqual(matched.contains(index), expected, input)
+            }
+        }
+        XCTAssertLessThanOrEqual(automaton.stateCount, URLPatternAutomaton.stateLimit)
+    }
+}
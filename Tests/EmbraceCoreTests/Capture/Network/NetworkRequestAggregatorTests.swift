@@ -0,0 +1,118 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import XCTest
+
+@testable import EmbraceCore
+
+class NetworkRequestAggregatorTests: XCTestCase {
+
+    func test_urlTemplate() {
+        let cases = [
+            "https://API.test.com/v1/users/12/feed?limit=10&cursor=abc": "api.test.com/v1/users/{int}/feed?cursor&limit",
+            "https://api.test.com/v1/users/345/feed?cursor=x&limit=1&cursor=y": "api.test.com/v1/users/{int}/feed?cursor&limit",
+            "https://api.test.com/items/3F2504E0-4F89-11D3-9A0C-0305E82C3301/": "api.test.com/items/{uuid}/",
+            "https://api.test.com/items/3F2504E0-4F89-11D3-9A0C-0305E82C330": "api.test.com/items/3F2504E0-4F89-11D3-9A0C-0305E82C330",
+            "https://api.test.com/v2/a1b2": "api.test.com/v2/a1b2",
+            "http://localhost:8080/poll?": "localhost:8080/poll",
+            "https://test.com": "test.com"
+        ]
+
+        for (url, template) in cases {
+            XCTAssertEqual(URLTemplate.template(for: URL(string: url)!), template, url)
+        }
+    }
+
+    func test_key_matchesTemplates() throws {
+        // given an aggregator for a template with a query and one without
+        let aggregator = try XCTUnwrap(
+            NetworkRequestAggregator(
+                options: URLSessionCaptureService.Aggregation(
+                    templates: ["api.test.com/v1/poll/{int}?since", "beacon.test.com/collect"]
+                )
+            )
+        )
+
+        // then requests are keyed by the template they match
+        let poll = aggregator.key(for: URL(string: "https://api.test.com/v1/poll/12?since=100")!, method: "GET")
+        XCTAssertEqual(poll?.template, "api.test.com/v1/poll/{int}?since")
+
+        let beacon = aggregator.key(for: URL(string: "https://beacon.test.com/collect?id=1&e=tap")!, method: "POST")
+        XCTAssertEqual(beacon?.template, "beacon.test.com/collect")
+        XCTAssertEqual(beacon?.method, "POST")
+
+        XCTAssertNil(aggregator.key(for: URL(string: "https://api.test.com/v1/poll/12?until=100")!, method: "GET"))
+        XCTAssertNil(aggregator.key(for: URL(string: "https://api.test.com/v1/poll")!, method: "GET"))
+    }
+
+    func test_noTemplates_noAggregator() {
+        XCTAssertNil(NetworkRequestAggregator(options: URLSessionCaptureService.Aggregation()))
+    }
+
+    func test_keepsIndividually() throws {
+        let aggregator = try XCTUnwrap(
+            NetworkRequestAggregator(
+                options: URLSessionCaptureService.Aggregation(templates: ["test.com"], slowRequestThreshold: 2)
+            )
+        )
+
+        XCTAssertFalse(aggregator.keepsIndividually(duration: 0.1, statusCode: 204, error: nil))
+        XCTAssertTrue(aggregator.keepsIndividually(duration: 2.5, statusCode: 200, error: nil))
+        XCTAssertTrue(aggregator.keepsIndividually(duration: 0.1, statusCode: 503, error: nil))
+        XCTAssertTrue(aggregator.keepsIndividually(duration: 0.1, statusCode: nil, error: nil))
+        XCTAssertTrue(aggregator.keepsIndividually(duration: 0.1, statusCode: 200, error: NSError(domain: "test", code: 1)))
+    }
+
+    func test_recordAndFlush() throws {
+        // given an aggregator
+        let aggregator = try XCTUnwrap(
+            NetworkRequestAggregator(options: URLSessionCaptureService.Aggregation(templates: ["test.com/poll"]))
+        )
+        let key = try XCTUnwrap(aggregator.key(for: URL(string: "https://test.com/poll")!, method: "GET"))
+
+        // when recording requests
+        for index in 0..<1_000 {
+            aggregator.record(
+                key,
+                duration: Double(index % 100) / 1000,
+                responseBytes: 512,
+                statusCode: index % 10 == 0 ? 304 : 200
+            )
+        }
+        aggregator.record(key, duration: 3, responseBytes: 0, statusCode: nil, failed: true)
+
+        // then they're rolled into a single summary
+        let summaries = aggregator.flush()
+        XCTAssertEqual(summaries.count, 1)
+
+        let summary = try XCTUnwrap(summaries.first)
+        XCTAssertEqual(summary.count, 1_001)
+        XCTAssertEqual(summary.errorCount, 1)
+        XCTAssertEqual(summary.statusCodes, [200: 900, 304: 100])
+        XCTAssertEqual(summary.durationMs.count, 1_001)
+        XCTAssertEqual(summary.durationMs.min, 0)
+        XCTAssertEqual(summary.durationMs.max, 3_000)
+        XCTAssertEqual(summary.responseBytes.sum, 512_000)
+
+        // and the next flush starts over
+        XCTAssertTrue(aggregator.flush().isEmpty)
+    }
+
+    func test_histogram_json() throws {
+        // given a histogram
+        var histogram = NetworkAggregateHistogram()
+        [0, 1, 3, 3, 100, 1_000].forEach { histogram.record($0) }
+
+        // when encoding it
+        let data = try JSONEncoder().encode(histogram)
+        let dict = try XCTUnwrap(JSONSerialization.jsonObject(with: data) as? [String: Any])
+
+        // then values are counted in power of two buckets, keyed by their exclusive upper bound
+        XCTAssertEqual(dict["count"] as? Int, 6)
+        XCTAssertEqual(dict["sum"] as? Int, 1_107)
+        XCTAssertEqual(dict["min"] as? Int, 0)
+        XCTAssertEqual(dict["max"] as? Int, 1_000)
+        XCTAssertEqual(dict["buckets"] as? [[Int]], [[1, 1], [2, 1], [4, 2], [128, 1], [1_024, 1]])
+    }
+}
@@ -70,6 +70,36 @@ class URLSessionCaptureServiceTests: XCTestCase {
         whenInvokingInstall()
         thenEachSwizzlerShouldHaveBeenInstalledOnce()
     }
+
+    func test_onSessionWillEnd_logsAggregatedRequests() throws {
+        // given a service aggregating some requests
+        sut = URLSessionCaptureService(
+            options: URLSessionCaptureService.Options(
+                aggregation: URLSessionCaptureService.Aggregation(templates: ["test.com/poll"])
+            ),
+            lock: lock,
+            swizzlerProvider: provider
+        )
+        whenInvokingInstall()
+
+        let aggregator = try XCTUnwrap(sut.aggregator)
+        let key = try XCTUnwrap(aggregator.key(for: URL(string: "https://test.com/poll")!, method: "GET"))
+        aggregator.record(key, duration: 0.1, responseBytes: 10, statusCode: 200)
+        aggregator.record(key, duration: 0.2, responseBytes: 10, statusCode: 200)
+
+        // when the session ends
+        sut.logAggregatedRequests()
+
+        // then a single summary log is emitted
+        XCTAssertEqual(otel.logs.count, 1)
+        XCTAssertEqual(otel.logs[0].attributes["emb.type"], .string("sys.network_aggregate"))
+        XCTAssertEqual(otel.logs[0].attributes["emb.request_count"], .string("2"))
+        XCTAssertNotNil(otel.logs[0].attributes["emb.payload"])
+
+        // and nothing is logged if there were no new requests
+        sut.logAggregatedRequests()
+        XCTAssertEqual(otel.logs.count, 1)
+    }
 }
 
 extension URLSessionCaptureServiceTests {
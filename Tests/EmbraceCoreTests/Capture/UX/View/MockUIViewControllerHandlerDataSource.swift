@@ -16,6 +16,8 @@
         var otel: EmbraceOpenTelemetry? = MockEmbraceOpenTelemetry()
         var instrumentVisibility: Bool = true
         var instrumentFirstRender: Bool = true
+        var consolidateLifecycleSpans: Bool = false
+        var lifecyclePhaseSpanThreshold: TimeInterval = 0.1
 
         var blockList: ViewControllerBlockList = ViewControllerBlockList()
         func isViewControllerBlocked(_ vc: UIViewController) -> Bool {
@@ -370,6 +370,113 @@
             }
         }
 
+        func test_consolidatedTimeToFirstRenderFlow() {
+            // given a handler that uses a single span per view controller
+            dataSource.consolidateLifecycleSpans = true
+            dataSource.lifecyclePhaseSpanThreshold = 10
+            let vc = MockViewController()
+            let start = Date()
+
+            // when a view controller is loaded and shown
+            runLifecycle(vc: vc, start: start)
+
+            // then only the parent span is created, with the duration of each phase
+            wait(timeout: .longTimeout) {
+                self.otel.spanProcessor.endedSpans.contains(where: { $0.name.contains("time-to-first-render") }) && self.cacheIsEmpty()
+            }
+
+            let parent = otel.spanProcessor.endedSpans.first(where: { $0.name.contains("time-to-first-render") })!
+            XCTAssertEqual(parent.startTime, start)
+            XCTAssertEqual(parent.endTime, start.addingTimeInterval(0.4))
+            XCTAssertEqual(parent.attributes["view.did_load_ms"], .int(100))
+            XCTAssertEqual(parent.attributes["view.will_appear_ms"], .int(50))
+            XCTAssertEqual(parent.attributes["view.is_appearing_ms"], .int(150))
+            XCTAssertEqual(parent.attributes["view.did_appear_ms"], .int(100))
+            XCTAssertEqual(otel.spanProcessor.startedSpans.filter({ $0.embType == .viewLoad }).count, 1)
+        }
+
+        func test_consolidatedTimeToFirstRenderFlow_slowPhase() {
+            // given a handler that uses a single span per view controller
+            dataSource.consolidateLifecycleSpans = true
+            dataSource.lifecyclePhaseSpanThreshold = 0.075
+            let vc = MockViewController()
+            let start = Date()
+
+            // when a view controller is loaded and shown
+            runLifecycle(vc: vc, start: start)
+
+            // then the phases that reached the threshold get their own span
+            wait(timeout: .longTimeout) {
+                self.otel.spanProcessor.endedSpans.contains(where: { $0.name.contains("time-to-first-render") }) && self.cacheIsEmpty()
+            }
+
+            let parent = otel.spanProcessor.endedSpans.first(where: { $0.name.contains("time-to-first-render") })!
+            let children = otel.spanProcessor.endedSpans.filter { $0.parentSpanId == parent.spanId }
+            XCTAssertEqual(Set(children.map(\.name)), ["emb-view-did-load", "emb-view-is-appearing", "emb-view-did-appear"])
+
+            let isAppearing = children.first(where: { $0.name == "emb-view-is-appearing" })!
+            XCTAssertEqual(isAppearing.startTime, start.addingTimeInterval(0.15))
+            XCTAssertEqual(isAppearing.endTime, start.addingTimeInterval(0.3))
+            XCTAssertEqual(isAppearing.embType, .viewLoad)
+        }
+
+        func test_consolidatedTimeToFirstRenderFlow_interrupted() {
+            // given a handler that uses a single span per view controller
+            dataSource.consolidateLifecycleSpans = true
+            dataSource.lifecyclePhaseSpanThreshold = 0
+            let vc = MockViewController()
+
+            // when a view controller is loaded but disappears before appearing
+            handler.onViewDidLoadStart(vc)
+            handler.onViewDidLoadEnd(vc)
+            handler.onViewWillAppearStart(vc)
+            handler.onViewDidDisappear(vc)
+
+            // then the parent span and the unfinished phase are ended as abandoned
+            wait(timeout: .longTimeout) {
+                let parent = self.otel.spanProcessor.endedSpans.first(where: { $0.name.contains("time-to-first-render") })
+                let willAppear = self.otel.spanProcessor.endedSpans.first(where: { $0.name == "emb-view-will-appear" })
+                return parent != nil && parent!.status.isError == true && willAppear != nil && willAppear!.status.isError == true
+                    && willAppear!.parentSpanId == parent!.spanId && self.cacheIsEmpty()
+            }
+        }
+
+        func test_consolidatedTimeToInteractiveFlow() {
+            // given a handler that uses a single span per view controller
+            dataSource.consolidateLifecycleSpans = true
+            dataSource.lifecyclePhaseSpanThreshold = 10
+            let vc = MockInteractableViewController()
+
+            // when a view controller is shown and then becomes interactive
+            runLifecycle(vc: vc, start: Date())
+
+            wait(timeout: .longTimeout) {
+                self.handler.data.safeValue.lifecyclePhases.first?.value[.uiReady].start != nil
+            }
+            XCTAssertTrue(otel.spanProcessor.endedSpans.filter({ $0.embType == .viewLoad }).isEmpty)
+
+            handler.onViewBecameInteractive(vc)
+
+            // then the parent span ends with the ui ready duration
+            wait(timeout: .longTimeout) {
+                let parent = self.otel.spanProcessor.endedSpans.first(where: { $0.name.contains("time-to-interactive") })
+                return parent != nil && parent!.attributes["view.ui_ready_ms"] != nil && self.cacheIsEmpty()
+            }
+            XCTAssertEqual(otel.spanProcessor.startedSpans.filter({ $0.embType == .viewLoad }).count, 1)
+        }
+
+        /// Runs the phases with fixed durations: 100ms, 50ms, 150ms and 100ms.
+        func runLifecycle(vc: UIViewController, start: Date) {
+            handler.onViewDidLoadStart(vc, now: start)
+            handler.onViewDidLoadEnd(vc, now: start.addingTimeInterval(0.1))
+            handler.onViewWillAppearStart(vc, now: start.addingTimeInterval(0.1))
+            handler.onViewWillAppearEnd(vc, now: start.addingTimeInterval(0.15))
+            handler.onViewIsAppearingStart(vc, now: start.addingTimeInterval(0.15))
+            handler.onViewIsAppearingEnd(vc, now: start.addingTimeInterval(0.3))
+            handler.onViewDidAppearStart(vc, now: start.addingTimeInterval(0.3))
+            handler.onViewDidAppearEnd(vc, now: start.addingTimeInterval(0.4))
+        }
+
         func validateViewDidLoadSpans(vc: UIViewController, parentName: String) {
             // when view did load starts
             handler.onViewDidLoadStart(vc)
@@ -466,7 +573,7 @@
                 && handler.data.safeValue.viewWillAppearSpans.count == 0 && handler.data.safeValue.viewIsAppearingSpans.count == 0
                 && handler.data.safeValue.viewDidAppearSpans.count == 0
                 && (!checkVisibilitySpans || handler.data.safeValue.visibilitySpans.count == 0) && handler.data.safeValue.uiReadySpans.count == 0
-                && handler.data.safeValue.alreadyFinishedUiReadyIds.count == 0
+                && handler.data.safeValue.alreadyFinishedUiReadyIds.count == 0 && handler.data.safeValue.lifecyclePhases.count == 0
         }
     }
 
@@ -0,0 +1,137 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import EmbraceCommonInternal
+import EmbraceSemantics
+import TestSupport
+import XCTest
+
+@testable import EmbraceCore
+
+final class ExtensionRecordImporterTests: XCTestCase {
+
+    var url: URL!
+    var ring: EmbraceSharedRing!
+    var storage: SpyLogRepository!
+    var otel: MockEmbraceOpenTelemetry!
+
+    override func setUpWithError() throws {
+        url = URL(fileURLWithPath: NSTemporaryDirectory())
+            .appendingPathComponent("ExtensionRecordImporterTests")
+            .appendingPathComponent(UUID().uuidString)
+        ring = try XCTUnwrap(EmbraceSharedRing(url: url))
+        storage = SpyLogRepository()
+        otel = MockEmbraceOpenTelemetry()
+    }
+
+    override func tearDownWithError() throws {
+        ring = nil
+        try? FileManager.default.removeItem(at: url.deletingLastPathComponent())
+    }
+
+    func test_record_encodingRoundTrip() throws {
+        let record = ExtensionRecord.span(
+            "widget-reload",
+            startTime: Date(timeIntervalSince1970: 1_700_000_000),
+            endTime: Date(timeIntervalSince1970: 1_700_000_001.5),
+            attributes: ["kind": "timeline"]
+        )
+
+        let data = try XCTUnwrap(record.encoded(maxSize: 1024))
+        let decoded = try JSONDecoder().decode(ExtensionRecord.self, from: data)
+
+        XCTAssertEqual(decoded, record)
+        XCTAssertEqual(decoded.startDate.timeIntervalSince1970, 1_700_000_000, accuracy: 0.001)
+        XCTAssertEqual(try XCTUnwrap(decoded.endDate).timeIntervalSince1970, 1_700_000_001.5, accuracy: 0.001)
+    }
+
+    func test_record_truncatesLongMessages() throws {
+        let message = String(repeating: "a", count: 2000)
+        let record = ExtensionRecord.log(message, severity: .warn, timestamp: Date(), attributes: [:])
+
+        let data = try XCTUnwrap(record.encoded(maxSize: ring.maxRecordSize))
+        XCTAssertLessThanOrEqual(data.count, ring.maxRecordSize)
+
+        let decoded = try JSONDecoder().decode(ExtensionRecord.self, from: data)
+        XCTAssertTrue(message.hasPrefix(decoded.name))
+        XCTAssertFalse(decoded.name.isEmpty)
+    }
+
+    func test_record_withLargeAttributes_isDropped() {
+        let record = ExtensionRecord.log(
+            "message",
+            severity: .info,
+            timestamp: Date(),
+            attributes: ["key": String(repeating: "a", count: 2000)]
+        )
+        XCTAssertNil(record.encoded(maxSize: ring.maxRecordSize))
+    }
+
+    func test_import_storesLogsWithExtensionProcess() throws {
+        // given a log recorded by an extension
+        let extensionSDK = EmbraceExtension(ring: try XCTUnwrap(EmbraceSharedRing(url: url)))
+        let timestamp = Date(timeIntervalSince1970: 1_700_000_000)
+        XCTAssertTrue(extensionSDK.log("hello", severity: .error, timestamp: timestamp, attributes: ["foo": "bar"]))
+
+        // when importing
+        let count = ExtensionRecordImporter.importRecords(from: ring, storage: storage, otel: otel)
+
+        // then it's stored as a regular log
+        XCTAssertEqual(count, 1)
+        let log = try XCTUnwrap(storage.createdLogs.first)
+        XCTAssertEqual(log.body, "hello")
+        XCTAssertEqual(log.severity, .error)
+        XCTAssertEqual(log.timestamp.timeIntervalSince1970, timestamp.timeIntervalSince1970, accuracy: 0.001)
+        XCTAssertEqual(log.processIdRaw, ProcessIdentifier.current.stringValue)
+        XCTAssertEqual(log.attribute(forKey: "foo")?.valueRaw, "bar")
+        XCTAssertEqual(log.attribute(forKey: LogSemantics.keyEmbraceType)?.valueRaw, LogType.message.rawValue)
+        XCTAssertEqual(ring.count, 0)
+    }
+
+    func test_import_recreatesSpans() throws {
+        // given a span recorded by an extension
+        let extensionSDK = EmbraceExtension(ring: try XCTUnwrap(EmbraceSharedRing(url: url)))
+        let start = Date(timeIntervalSince1970: 1_700_000_000)
+        let end = start.addingTimeInterval(2)
+        XCTAssertTrue(extensionSDK.recordSpan(name: "fetch", startTime: start, endTime: end, attributes: ["foo": "bar"]))
+
+        // when importing
+        ExtensionRecordImporter.importRecords(from: ring, storage: storage, otel: otel)
+
+        // then the span is ended with its original times
+        let span = try XCTUnwrap(otel.spanProcessor.endedSpans.first { $0.name == "fetch" })
+        XCTAssertEqual(span.startTime.timeIntervalSince1970, start.timeIntervalSince1970, accuracy: 0.001)
+        XCTAssertEqual(span.endTime.timeIntervalSince1970, end.timeIntervalSince1970, accuracy: 0.001)
+        XCTAssertEqual(span.attributes["foo"], .string("bar"))
+        XCTAssertFalse(storage.didCallCreate)
+    }
+
+    func test_import_skipsUndecodableRecords() {
+        // given garbage followed by a valid record
+        ring.push(Data("not json".utf8))
+        ring.push(ExtensionRecord.log("valid", severity: .info, timestamp: Date(), attributes: [:]).encoded(maxSize: 1024)!)
+
+        // when importing
+        ExtensionRecordImporter.importRecords(from: ring, storage: storage, otel: otel)
+
+        // then only the valid one is stored, and both are gone
+        XCTAssertEqual(storage.createdLogs.map(\.body), ["valid"])
+        XCTAssertEqual(ring.count, 0)
+    }
+
+    func test_import_withoutStorageOrOTel_leavesRecords() {
+        // given records waiting in the ring
+        ring.push(ExtensionRecord.log("log", severity: .info, timestamp: Date(), attributes: [:]).encoded(maxSize: 1024)!)
+        ring.push(ExtensionRecord.span("span", startTime: Date(), endTime: Date(), attributes: [:]).encoded(maxSize: 1024)!)
+
+        // when importing before the SDK can handle them
+        XCTAssertEqual(ExtensionRecordImporter.importRecords(from: ring, storage: nil, otel: otel), 0)
+        XCTAssertEqual(ExtensionRecordImporter.importRecords(from: ring, storage: storage, otel: nil), 0)
+
+        // then they're kept for a later import
+        XCTAssertEqual(ring.count, 2)
+        XCTAssertEqual(ExtensionRecordImporter.importRecords(from: ring, storage: storage, otel: otel), 2)
+        XCTAssertEqual(storage.createdLogs.map(\.body), ["log"])
+    }
+}
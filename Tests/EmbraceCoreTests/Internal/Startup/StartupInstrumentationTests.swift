@@ -1,3 +1,4 @@
+import EmbraceCaptureService
 import Foundation
 import TestSupport
 //
@@ -236,4 +237,52 @@ class StartupInstrumentationTests: XCTestCase {
         XCTAssertEqual(parent!.attributes["key1"], .string("value1"))
         XCTAssertEqual(parent!.attributes["key2"], .string("value2"))
     }
+
+    func test_recordOverruns() {
+        instrumentation.buildMainSpans()
+
+        // given a phase where one task finished past the budget
+        let start = Date(timeIntervalSince1970: 20)
+        let report = StartupScheduler.PhaseReport(
+            phase: .deferred,
+            budget: 0.05,
+            startTime: start,
+            endTime: start.addingTimeInterval(0.2),
+            tasks: [
+                .init(name: "fast", startTime: start, endTime: start.addingTimeInterval(0.01)),
+                .init(name: "slow", startTime: start.addingTimeInterval(0.01), endTime: start.addingTimeInterval(0.2))
+            ]
+        )
+
+        // when recording it
+        instrumentation.recordOverruns(report)
+
+        // then there's a span for the phase and one for the late task
+        let phase = otel.spanProcessor.endedSpans.first(where: { $0.name == "emb-sdk-startup-phase" })
+        XCTAssertEqual(phase!.attributes["phase"], .string("deferred"))
+        XCTAssertEqual(phase!.attributes["budget_ms"], .string("50"))
+
+        let tasks = otel.spanProcessor.endedSpans.filter { $0.name == "emb-sdk-startup-task" }
+        XCTAssertEqual(tasks.count, 1)
+        XCTAssertEqual(tasks.first!.attributes["task"], .string("slow"))
+        XCTAssertEqual(tasks.first!.parentSpanId, phase!.spanId)
+    }
+
+    func test_recordOverruns_withinBudget() {
+        // given a phase that finished on time
+        let start = Date(timeIntervalSince1970: 20)
+        let report = StartupScheduler.PhaseReport(
+            phase: .critical,
+            budget: 0.1,
+            startTime: start,
+            endTime: start.addingTimeInterval(0.05),
+            tasks: [.init(name: "fast", startTime: start, endTime: start.addingTimeInterval(0.05))]
+        )
+
+        // when recording it
+        instrumentation.recordOverruns(report)
+
+        // then nothing is recorded
+        XCTAssertEqual(otel.spanProcessor.startedSpans.count, 0)
+    }
 }
@@ -0,0 +1,212 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import EmbraceCaptureService
+import TestSupport
+import XCTest
+
+@testable import EmbraceCore
+
+class StartupSchedulerTests: XCTestCase {
+
+    private let queue = DispatchQueue(label: "com.embrace.test.startup")
+
+    private var idleBlock: (() -> Void)?
+    private var scheduler: StartupScheduler!
+
+    private var ran: [String] = []
+    private let lock = NSLock()
+
+    override func setUpWithError() throws {
+        ran = []
+        idleBlock = nil
+        scheduler = StartupScheduler(backgroundQueue: queue, backgroundDelayLimit: 60) { [weak self] in
+            self?.idleBlock = $0
+        }
+    }
+
+    private func task(_ name: String) -> () -> Void {
+        return { [weak self] in
+            self?.lock.lock()
+            self?.ran.append(name)
+            self?.lock.unlock()
+        }
+    }
+
+    private var ranTasks: [String] {
+        lock.lock()
+        defer { lock.unlock() }
+        return ran
+    }
+
+    private func goIdle() {
+        idleBlock?()
+        queue.sync {}
+    }
+
+    func test_phases() {
+        // given tasks in every phase
+        scheduler.add("background", phase: .background, work: task("background"))
+        scheduler.add("deferred", phase: .deferred, work: task("deferred"))
+        scheduler.add("critical", phase: .critical, work: task("critical"))
+
+        // when running the critical phase
+        scheduler.runCriticalPhase()
+
+        // then only the critical tasks ran
+        XCTAssertEqual(ranTasks, ["critical"])
+
+        // when the main thread goes idle
+        goIdle()
+
+        // then the rest run in order
+        XCTAssertEqual(ranTasks, ["critical", "deferred", "background"])
+    }
+
+    func test_dependencies_runFirst() {
+        // given tasks added before the tasks they depend on
+        scheduler.add("c", phase: .critical, dependencies: ["b"], work: task("c"))
+        scheduler.add("b", phase: .critical, dependencies: ["a"], work: task("b"))
+        scheduler.add("a", phase: .critical, work: task("a"))
+        scheduler.add("d", phase: .critical, work: task("d"))
+
+        // when running them
+        scheduler.runCriticalPhase()
+
+        // then the dependencies run first and the rest keep their order
+        XCTAssertEqual(ranTasks, ["a", "b", "c", "d"])
+    }
+
+    func test_dependencies_promoteToLaterPhase() {
+        // given a critical task that depends on a background one
+        scheduler.add("early", phase: .critical, dependencies: ["late"], work: task("early"))
+        scheduler.add("late", phase: .background, work: task("late"))
+
+        // when running the critical phase
+        scheduler.runCriticalPhase()
+
+        // then the critical task waits for its dependency
+        XCTAssertEqual(ranTasks, [])
+
+        goIdle()
+        XCTAssertEqual(ranTasks, ["late", "early"])
+    }
+
+    func test_dependencies_unknownAndCyclic() {
+        // given tasks with an unknown dependency and a cycle
+        scheduler.add("a", phase: .critical, dependencies: ["missing"], work: task("a"))
+        scheduler.add("b", phase: .critical, dependencies: ["c"], work: task("b"))
+        scheduler.add("c", phase: .critical, dependencies: ["b"], work: task("c"))
+
+        // when running them
+        scheduler.runCriticalPhase()
+
+        // then every task still runs once
+        XCTAssertEqual(ranTasks.sorted(), ["a", "b", "c"])
+    }
+
+    func test_backgroundPhase_runsAfterDelayLimit() {
+        // given a main thread that never goes idle
+        scheduler = StartupScheduler(backgroundQueue: queue, backgroundDelayLimit: 0.01) { _ in }
+        let expectation = expectation(description: "background")
+        scheduler.add("background", phase: .background) { expectation.fulfill() }
+
+        // when running the critical phase
+        scheduler.runCriticalPhase()
+
+        // then background tasks run anyway
+        wait(for: [expectation], timeout: .defaultTimeout)
+    }
+
+    func test_delayLimit_runsDeferredDependenciesFirst() {
+        // given a background task that depends on a deferred one, and a main thread that's busy for a while
+        scheduler = StartupScheduler(backgroundQueue: queue, backgroundDelayLimit: 0.01) { [weak self] in
+            self?.idleBlock = $0
+        }
+        let expectation = expectation(description: "background")
+        scheduler.add("deferred", phase: .deferred, work: task("deferred"))
+        scheduler.add("background", phase: .background, dependencies: ["deferred"]) { [weak self] in
+            self?.task("background")()
+            expectation.fulfill()
+        }
+
+        // when the delay limit is reached before the main thread goes idle
+        scheduler.runCriticalPhase()
+        wait(for: [expectation], timeout: .defaultTimeout)
+
+        // then the deferred task ran first, off the main thread
+        XCTAssertEqual(ranTasks, ["deferred", "background"])
+
+        // and not again once the main thread gets to it
+        goIdle()
+        XCTAssertEqual(ranTasks, ["deferred", "background"])
+    }
+
+    func test_backgroundPhase_runsOnce() {
+        // given a scheduler with a short delay limit
+        scheduler = StartupScheduler(backgroundQueue: queue, backgroundDelayLimit: 0.01) { [weak self] in
+            self?.idleBlock = $0
+        }
+        scheduler.add("background", phase: .background, work: task("background"))
+        scheduler.runCriticalPhase()
+
+        // when the main thread goes idle and then the delay limit is reached
+        goIdle()
+
+        let expectation = expectation(description: "delay limit")
+        queue.asyncAfter(deadline: .now() + 0.1) { expectation.fulfill() }
+        wait(for: [expectation], timeout: .defaultTimeout)
+
+        // then background tasks didn't run twice
+        XCTAssertEqual(ranTasks, ["background"])
+    }
+
+    func test_cancel() {
+        // given scheduled tasks
+        scheduler.add("critical", phase: .critical, work: task("critical"))
+        scheduler.add("deferred", phase: .deferred, work: task("deferred"))
+        scheduler.add("background", phase: .background, work: task("background"))
+        scheduler.runCriticalPhase()
+
+        // when cancelling before the main thread goes idle
+        scheduler.cancel()
+        goIdle()
+
+        // then the pending tasks never run
+        XCTAssertEqual(ranTasks, ["critical"])
+    }
+
+    func test_addAfterScheduling_runsImmediately() {
+        // given a scheduler that already ran
+        scheduler.runCriticalPhase()
+
+        // when adding a task
+        scheduler.add("late", phase: .background, work: task("late"))
+
+        // then it runs right away
+        XCTAssertEqual(ranTasks, ["late"])
+    }
+
+    func test_report_overruns() {
+        // given a phase with a tiny budget
+        var budgets = StartupScheduler.Budgets()
+        budgets.critical = 0.001
+        scheduler = StartupScheduler(budgets: budgets, backgroundQueue: queue) { _ in }
+
+        var reports: [StartupScheduler.PhaseReport] = []
+        scheduler.onPhaseFinished = { reports.append($0) }
+
+        scheduler.add("fast", phase: .critical) {}
+        scheduler.add("slow", phase: .critical) { Thread.sleep(forTimeInterval: 0.01) }
+
+        // when running it
+        scheduler.runCriticalPhase()
+
+        // then the report includes every task and flags the slow one
+        XCTAssertEqual(reports.count, 1)
+        XCTAssertEqual(reports.first?.phase, .critical)
+        XCTAssertEqual(reports.first?.tasks.map(\.name), ["fast", "slow"])
+        XCTAssertEqual(reports.first?.overruns.map(\.name), ["slow"])
+    }
+}
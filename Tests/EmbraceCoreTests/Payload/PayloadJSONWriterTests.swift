@@ -0,0 +1,153 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import EmbraceCommonInternal
+import EmbraceStorageInternal
+import OpenTelemetryApi
+import OpenTelemetrySdk
+import TestSupport
+import XCTest
+
+@testable import EmbraceCore
+
+/// Golden tests: payloads written with `EmbraceJSONWriter` must decode to the same JSON `JSONEncoder` produces.
+class PayloadJSONWriterTests: XCTestCase {
+
+    private func assertSameJSON<T: Encodable & EmbraceJSONWritable>(
+        _ value: T,
+        file: StaticString = #filePath,
+        line: UInt = #line
+    ) throws {
+        let expected = try JSONSerialization.jsonObject(with: JSONEncoder().encode(value), options: .fragmentsAllowed)
+        let actual = try JSONSerialization.jsonObject(with: value.jsonData(), options: .fragmentsAllowed)
+        XCTAssertEqual(actual as? NSObject, expected as? NSObject, file: file, line: line)
+    }
+
+    private var resource: ResourcePayload {
+        var resource = ResourcePayload(from: [
+            MockMetadata.createUserMetadata(key: AppResourceKey.appVersion.rawValue, value: "1.2.3"),
+            MockMetadata.createUserMetadata(key: AppResourceKey.launchCount.rawValue, value: "12"),
+            MockMetadata.createUserMetadata(key: AppResourceKey.processPreWarm.rawValue, value: "false"),
+            MockMetadata.createResourceRecord(key: DeviceResourceKey.totalDiskSpace.rawValue, value: "494384795648"),
+            MockMetadata.createResourceRecord(key: "custom \"resource\"", value: "with\nnew line")
+        ])
+        resource.additionalResources["os_build"] = "overridden"
+        return resource
+    }
+
+    private var metadata: MetadataPayload {
+        MetadataPayload(from: [
+            MockMetadata.createUserMetadata(key: UserResourceKey.email.rawValue, value: "test@embrace.io"),
+            MockMetadata.createPersonaTagRecord(value: "premium"),
+            MockMetadata.createPersonaTagRecord(value: "beta")
+        ])
+    }
+
+    private var span: SpanData {
+        SpanData(
+            traceId: TraceId.random(),
+            spanId: SpanId.random(),
+            parentSpanId: SpanId.random(),
+            name: "span \"name\" / é",
+            kind: .internal,
+            startTime: Date(timeIntervalSince1970: 12.345),
+            attributes: ["string": .string("value"), "int": .int(1), "bool": .bool(true)],
+            events: [
+                SpanData.Event(name: "event", timestamp: Date(timeIntervalSince1970: 20), attributes: ["double": .double(1.5)])
+            ],
+            links: [
+                SpanData.Link(
+                    context: .create(traceId: .random(), spanId: .random(), traceFlags: .init(), traceState: .init()),
+                    attributes: ["link": .string("attribute")]
+                )
+            ],
+            status: .error(description: "failed"),
+            endTime: Date(timeIntervalSince1970: 60),
+            hasEnded: true
+        )
+    }
+
+    func test_resourcePayload() throws {
+        try assertSameJSON(resource)
+        try assertSameJSON(ResourcePayload(from: []))
+    }
+
+    func test_metadataPayload() throws {
+        try assertSameJSON(metadata)
+        try assertSameJSON(MetadataPayload(from: []))
+    }
+
+    func test_logsEnvelope() throws {
+        let logs = [
+            LogPayload(
+                timeUnixNano: "123456789",
+                severityNumber: LogSeverity.info.number,
+                severityText: LogSeverity.info.text,
+                body: "Hello \"World\"\n\ttab 🙂",
+                attributes: [.init(key: "key", value: "value"), .init(key: "emb.type", value: "sys.log")]
+            ),
+            LogPayload(
+                timeUnixNano: "987654321",
+                severityNumber: LogSeverity.error.number,
+                severityText: LogSeverity.error.text,
+                body: "",
+                attributes: [],
+                traceId: "trace",
+                spanId: "span"
+            )
+        ]
+
+        try assertSameJSON(PayloadEnvelope(data: logs, resource: resource, metadata: metadata))
+    }
+
+    func test_spansEnvelope() throws {
+        let open = SpanPayload(from: span, endTime: nil)
+        let failed = SpanPayload(from: span, endTime: Date(timeIntervalSince1970: 90), failed: true)
+
+        try assertSameJSON(
+            PayloadEnvelope(spans: [failed], spanSnapshots: [open], resource: resource, metadata: metadata)
+        )
+        try assertSameJSON(PayloadEnvelope(spans: [], spanSnapshots: [], resource: resource, metadata: metadata))
+    }
+
+    func test_gzippedJSON_matchesUncompressed() throws {
+        // given a payload bigger than the writer's flush threshold
+        let logs = (0..<500).map {
+            LogPayload(
+                timeUnixNano: "\($0)",
+                severityNumber: LogSeverity.info.number,
+                severityText: LogSeverity.info.text,
+                body: "log number \($0)",
+                attributes: [.init(key: "index", value: "\($0)")]
+            )
+        }
+        let envelope = PayloadEnvelope(data: logs, resource: resource, metadata: metadata)
+
+        // when compressing it while writing
+        let gzipped = try envelope.gzippedJSON()
+
+        // then it's a regular gzip stream of the same JSON
+        XCTAssertTrue(gzipped.isGzipped)
+        XCTAssertEqual(try gzipped.gunzipped(), try envelope.jsonData())
+    }
+
+    func test_jsonObject_matchesJSONSerialization() throws {
+        let frames: [[String: Any]] = [
+            ["a": "0x0000000100000000", "m": "App", "o": UInt64(1234), "so": 56, "flag": true],
+            ["a": "0x0000000100000010", "nested": ["list": [1, 2.5, "three", NSNull()]], "u": "F0E1-\"uuid\""]
+        ]
+
+        var writer = EmbraceJSONWriter()
+        try writer.value(jsonObject: frames)
+
+        let expected = try JSONSerialization.jsonObject(with: JSONSerialization.data(withJSONObject: frames))
+        let actual = try JSONSerialization.jsonObject(with: writer.data)
+        XCTAssertEqual(actual as? NSObject, expected as? NSObject)
+    }
+
+    func test_jsonObject_invalidValueThrows() {
+        var writer = EmbraceJSONWriter()
+        XCTAssertThrowsError(try writer.value(jsonObject: ["date": Date()]))
+    }
+}
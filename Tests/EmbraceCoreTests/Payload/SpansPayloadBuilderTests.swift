@@ -828,4 +828,89 @@ final class SpansPayloadBuilderTests: XCTestCase {
         XCTAssertEqual(closed[0].name, "emb-session")  // session span always first
         XCTAssertEqual(open.count, 0)
     }
+
+    func test_snapshotTracker_skipsUnchangedSnapshots() throws {
+        // given an open span that was already uploaded
+        let tracker = SpanSnapshotTracker()
+        tracker.bootstrap(enabled: true)
+        try addSpan(startTime: Date(timeIntervalSince1970: 55), endTime: nil, id: "open", traceId: "trace")
+
+        let (_, first) = SpansPayloadBuilder.build(for: sessionRecord, storage: storage, snapshotTracker: tracker)
+        tracker.uploadSucceeded(batch: sessionRecord.idRaw)
+
+        // when building the payload again
+        let (_, second) = SpansPayloadBuilder.build(for: sessionRecord, storage: storage, snapshotTracker: tracker)
+
+        // then the snapshot is only sent the first time
+        XCTAssertEqual(first.count, 1)
+        XCTAssertEqual(second.count, 0)
+    }
+
+    func test_snapshotTracker_sendsChangedSnapshots() throws {
+        // given an open span that was already uploaded
+        let tracker = SpanSnapshotTracker()
+        tracker.bootstrap(enabled: true)
+        try addSpan(startTime: Date(timeIntervalSince1970: 55), endTime: nil, id: "open", traceId: "trace")
+
+        _ = SpansPayloadBuilder.build(for: sessionRecord, storage: storage, snapshotTracker: tracker)
+        tracker.uploadSucceeded(batch: sessionRecord.idRaw)
+
+        // when the span changes
+        try addSpan(startTime: Date(timeIntervalSince1970: 55), endTime: nil, id: "open", traceId: "trace", name: "renamed")
+        let (_, snapshots) = SpansPayloadBuilder.build(for: sessionRecord, storage: storage, snapshotTracker: tracker)
+
+        // then the new snapshot is sent
+        XCTAssertEqual(snapshots.count, 1)
+        XCTAssertEqual(snapshots.first?.name, "renamed")
+    }
+
+    func test_snapshotTracker_failedUpload_sendsFullSnapshots() throws {
+        // given an open span included in a payload that failed to upload
+        let tracker = SpanSnapshotTracker()
+        tracker.bootstrap(enabled: true)
+        try addSpan(startTime: Date(timeIntervalSince1970: 55), endTime: nil, id: "open", traceId: "trace")
+
+        _ = SpansPayloadBuilder.build(for: sessionRecord, storage: storage, snapshotTracker: tracker)
+        tracker.uploadFailed(batch: sessionRecord.idRaw)
+
+        // when building the payload again
+        let (_, snapshots) = SpansPayloadBuilder.build(for: sessionRecord, storage: storage, snapshotTracker: tracker)
+
+        // then the snapshot is sent again
+        XCTAssertEqual(snapshots.count, 1)
+    }
+
+    func test_snapshotTracker_endedSpan_isForgotten() throws {
+        // given an open span that was already uploaded
+        let tracker = SpanSnapshotTracker()
+        tracker.bootstrap(enabled: true)
+        try addSpan(startTime: Date(timeIntervalSince1970: 55), endTime: nil, id: "open", traceId: "trace")
+
+        _ = SpansPayloadBuilder.build(for: sessionRecord, storage: storage, snapshotTracker: tracker)
+        tracker.uploadSucceeded(batch: sessionRecord.idRaw)
+
+        // when the span ends
+        try addSpan(startTime: Date(timeIntervalSince1970: 55), endTime: Date(timeIntervalSince1970: 60), id: "open", traceId: "trace")
+        let (spans, snapshots) = SpansPayloadBuilder.build(for: sessionRecord, storage: storage, snapshotTracker: tracker)
+
+        // then it's sent as a closed span and no longer tracked
+        XCTAssertEqual(spans.count, 2)
+        XCTAssertEqual(snapshots.count, 0)
+        XCTAssertTrue(tracker.state.safeValue.uploaded.isEmpty)
+    }
+
+    func test_snapshotTracker_disabled_sendsEverySnapshot() throws {
+        // given a disabled tracker
+        let tracker = SpanSnapshotTracker()
+        try addSpan(startTime: Date(timeIntervalSince1970: 55), endTime: nil, id: "open", traceId: "trace")
+
+        _ = SpansPayloadBuilder.build(for: sessionRecord, storage: storage, snapshotTracker: tracker)
+        tracker.uploadSucceeded(batch: sessionRecord.idRaw)
+
+        // when building the payload again
+        let (_, snapshots) = SpansPayloadBuilder.build(for: sessionRecord, storage: storage, snapshotTracker: tracker)
+
+        // then the snapshot is sent again
+        XCTAssertEqual(snapshots.count, 1)
+    }
 }
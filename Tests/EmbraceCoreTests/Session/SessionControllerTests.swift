@@ -532,6 +532,35 @@ final class SessionControllerTests: XCTestCase {
         }
     }
 
+    func test_heartbeat_withSlot_persistsOnlyOnTransitions() throws {
+        let url = URL(fileURLWithPath: NSTemporaryDirectory()).appendingPathComponent(UUID().uuidString)
+        defer { try? FileManager.default.removeItem(at: url) }
+
+        // given a session controller with a heartbeat slot
+        let slot = try XCTUnwrap(SessionHeartbeatSlot(url: url))
+        let controller = SessionController(storage: storage, upload: nil, config: nil, heartbeatSlot: slot)
+        controller.sdkStateProvider = sdkStateProvider
+        let session = try XCTUnwrap(controller.startSession(state: .foreground))
+        let sessionId = try XCTUnwrap(session.id)
+
+        // when a heartbeat ticks
+        let heartbeat = session.lastHeartbeatTime.addingTimeInterval(5)
+        controller.update(heartbeat: heartbeat)
+
+        // then only the in-memory session and the slot see it
+        XCTAssertEqual(controller.currentSession?.lastHeartbeatTime, heartbeat)
+        XCTAssertEqual(storage.fetchSession(id: sessionId)?.lastHeartbeatTime, session.lastHeartbeatTime)
+        XCTAssertEqual(SessionHeartbeatSlot(url: url)?.recovered?.sessionId, sessionId)
+
+        // when the session transitions
+        controller.update(state: .background)
+
+        // then the heartbeat is persisted
+        wait(timeout: .longTimeout, interval: .shortInterval) {
+            self.storage.fetchSession(id: sessionId)?.lastHeartbeatTime == heartbeat
+        }
+    }
+
     func test_startSession_coldStart_backgroundDropped_deletesOldSession() throws {
         // given a cold-start background session with background sessions disabled (config == nil)
         let backgroundSession = controller.startSession(state: .background)
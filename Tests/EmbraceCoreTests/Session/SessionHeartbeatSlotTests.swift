@@ -0,0 +1,111 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import EmbraceCommonInternal
+import TestSupport
+import XCTest
+
+@testable import EmbraceCore
+
+final class SessionHeartbeatSlotTests: XCTestCase {
+
+    var url: URL!
+
+    override func setUpWithError() throws {
+        url = URL(fileURLWithPath: NSTemporaryDirectory())
+            .appendingPathComponent("SessionHeartbeatSlotTests")
+            .appendingPathComponent(UUID().uuidString)
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: url)
+    }
+
+    func test_newSlot_recoversNothing() throws {
+        let slot = try XCTUnwrap(SessionHeartbeatSlot(url: url))
+        XCTAssertNil(slot.recovered)
+    }
+
+    func test_unfinishedSession_isRecoveredOnNextLaunch() throws {
+        let sessionId = EmbraceIdentifier.random
+        let start = Date(timeIntervalSince1970: 1_700_000_000)
+        let lastBeat = start.addingTimeInterval(25)
+
+        // given a session that received heartbeats and never ended (the process "crashed")
+        var slot = SessionHeartbeatSlot(url: url)
+        slot?.begin(sessionId: sessionId, state: .foreground, heartbeat: start)
+        slot?.beat(start.addingTimeInterval(5))
+        slot?.update(appTerminated: true)
+        slot?.beat(lastBeat)
+        slot = nil
+
+        // when the slot is opened again
+        let relaunched = try XCTUnwrap(SessionHeartbeatSlot(url: url))
+
+        // then the session and its last heartbeat are recovered
+        let recovered = try XCTUnwrap(relaunched.recovered)
+        XCTAssertEqual(recovered.sessionId, sessionId)
+        XCTAssertEqual(recovered.lastHeartbeat.nanosecondsSince1970Truncated, lastBeat.nanosecondsSince1970Truncated)
+        XCTAssertEqual(recovered.state, .foreground)
+        XCTAssertTrue(recovered.appTerminated)
+
+        // and a third launch doesn't recover it again
+        XCTAssertNil(SessionHeartbeatSlot(url: url)?.recovered)
+    }
+
+    func test_stateTransition_isRecovered() throws {
+        var slot = SessionHeartbeatSlot(url: url)
+        slot?.begin(sessionId: .random, state: .foreground, heartbeat: Date())
+        slot?.update(state: .background)
+        slot = nil
+
+        XCTAssertEqual(SessionHeartbeatSlot(url: url)?.recovered?.state, .background)
+    }
+
+    func test_endedSession_isNotRecovered() throws {
+        // given a session that ended cleanly
+        var slot = SessionHeartbeatSlot(url: url)
+        slot?.begin(sessionId: .random, state: .foreground, heartbeat: Date())
+        slot?.beat(Date())
+        slot?.end()
+
+        // heartbeats and transitions after the end are ignored
+        slot?.update(state: .background)
+        slot = nil
+
+        // then nothing is recovered
+        XCTAssertNil(SessionHeartbeatSlot(url: url)?.recovered)
+    }
+
+    func test_tornIdentityWrite_isNotRecovered() throws {
+        // given a slot left mid-transition: active, but with an odd sequence counter
+        var slot = SessionHeartbeatSlot(url: url)
+        slot?.begin(sessionId: .random, state: .foreground, heartbeat: Date())
+        slot = nil
+
+        let handle = try FileHandle(forUpdating: url)
+        handle.seek(toFileOffset: UInt64(SessionHeartbeatSlot.Word.sequence.rawValue * 8))
+        handle.write(withUnsafeBytes(of: UInt64(3)) { Data($0) })
+        handle.closeFile()
+
+        // then the identity can't be trusted and nothing is recovered
+        let relaunched = try XCTUnwrap(SessionHeartbeatSlot(url: url))
+        XCTAssertNil(relaunched.recovered)
+
+        // and the slot is usable again
+        let sessionId = EmbraceIdentifier.random
+        relaunched.begin(sessionId: sessionId, state: .foreground, heartbeat: Date())
+        XCTAssertEqual(SessionHeartbeatSlot(url: url)?.recovered?.sessionId, sessionId)
+    }
+
+    func test_foreignFile_isReset() throws {
+        // given a file with unrelated content
+        try FileManager.default.createDirectory(at: url.deletingLastPathComponent(), withIntermediateDirectories: true)
+        try Data(repeating: 0xFF, count: SessionHeartbeatSlot.size).write(to: url)
+
+        // then it is not trusted
+        let slot = try XCTUnwrap(SessionHeartbeatSlot(url: url))
+        XCTAssertNil(slot.recovered)
+    }
+}
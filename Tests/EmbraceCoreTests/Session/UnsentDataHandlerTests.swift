@@ -7,6 +7,10 @@ import Foundation
 import TestSupport
 import XCTest
 
+#if canImport(UIKit) && !os(watchOS)
+    import UIKit
+#endif
+
 @testable import EmbraceCore
 @testable import EmbraceStorageInternal
 @testable import EmbraceUploadInternal
@@ -368,6 +372,68 @@ class UnsentDataHandlerTests: XCTestCase {
         XCTAssertEqual(otel.logs[0].timestamp, report.timestamp)
     }
 
+    func test_recoverHeartbeat_fromSlotAfterCrash() throws {
+        let storage = try EmbraceStorage.createInMemoryDb()
+        defer { storage.coreData.destroy() }
+
+        let slotUrl = filePathProvider.tmpDirectory.appendingPathComponent("session-heartbeat")
+        let startTime = Date(timeIntervalSinceNow: -60)
+        let lastBeat = Date(timeIntervalSinceNow: -10)
+
+        // given an unfinished session whose heartbeats only reached the slot before the process died
+        storage.addSession(
+            id: TestConstants.sessionId,
+            processId: ProcessIdentifier.current,
+            state: .foreground,
+            traceId: TestConstants.traceId,
+            spanId: TestConstants.spanId,
+            startTime: startTime,
+            lastHeartbeatTime: startTime
+        )
+        var slot = SessionHeartbeatSlot(url: slotUrl)
+        slot?.begin(sessionId: TestConstants.sessionId, state: .foreground, heartbeat: startTime)
+        slot?.beat(lastBeat)
+        slot = nil
+
+        // when the next launch recovers it
+        let recovered = try XCTUnwrap(SessionHeartbeatSlot(url: slotUrl)?.recovered)
+        UnsentDataHandler.recoverHeartbeat(recovered, storage: storage)
+
+        // then the stored session ends at the last heartbeat instead of its last transition
+        let session = try XCTUnwrap(storage.fetchSession(id: TestConstants.sessionId))
+        XCTAssertEqual(session.lastHeartbeatTime.timeIntervalSince1970, lastBeat.timeIntervalSince1970, accuracy: 0.001)
+        XCTAssertNil(session.endTime)
+    }
+
+    func test_recoverHeartbeat_ignoresFinishedSession() throws {
+        let storage = try EmbraceStorage.createInMemoryDb()
+        defer { storage.coreData.destroy() }
+
+        // given a session that already has an end time
+        let endTime = Date(timeIntervalSinceNow: -30)
+        storage.addSession(
+            id: TestConstants.sessionId,
+            processId: ProcessIdentifier.current,
+            state: .foreground,
+            traceId: TestConstants.traceId,
+            spanId: TestConstants.spanId,
+            startTime: Date(timeIntervalSinceNow: -60),
+            endTime: endTime,
+            lastHeartbeatTime: endTime
+        )
+        let before = try XCTUnwrap(storage.fetchSession(id: TestConstants.sessionId))
+
+        // when recovering a later heartbeat for it
+        let snapshot = SessionHeartbeatSlot.Snapshot(
+            sessionId: TestConstants.sessionId, lastHeartbeat: Date(), state: .foreground, appTerminated: false)
+        UnsentDataHandler.recoverHeartbeat(snapshot, storage: storage)
+
+        // then the session is left untouched
+        let after = try XCTUnwrap(storage.fetchSession(id: TestConstants.sessionId))
+        XCTAssertEqual(after.lastHeartbeatTime, before.lastHeartbeatTime)
+        XCTAssertEqual(after.endTime, endTime)
+    }
+
     func test_sendCrashLog() async throws {
         try XCTSkipIf(XCTestCase.isWatchOS(), "Unavailable on WatchOS")
         // mock successful requests
@@ -698,6 +764,61 @@ class UnsentDataHandlerTests: XCTestCase {
         XCTAssertNil(records.first(where: { $0.key == "differentProcessId" }))
     }
 
+    func test_snapshotTracker_delivered() async throws {
+        try XCTSkipIf(XCTestCase.isWatchOS(), "Unavailable on WatchOS")
+        // mock successful requests
+        EmbraceHTTPMock.mock(url: testSpansUrl())
+
+        // given a storage and upload modules
+        let storage = try EmbraceStorage.createInMemoryDb()
+        defer { storage.coreData.destroy() }
+
+        let upload = try EmbraceUpload(
+            options: uploadOptions, logger: logger, queue: queue)
+
+        // given a session with an open span
+        let session = try await givenSessionWithOpenSpan(storage: storage)
+
+        let tracker = SpanSnapshotTracker()
+        tracker.bootstrap(enabled: true)
+
+        // when uploading the session
+        await UnsentDataHandler.sendSession(session, storage: storage, upload: upload, snapshotTracker: tracker)
+        wait(timeout: .longTimeout, interval: .shortInterval, until: { tracker.state.safeValue.pending.isEmpty })
+
+        // then the snapshot is remembered as uploaded
+        XCTAssertEqual(EmbraceHTTPMock.requestsForUrl(testSpansUrl()).count, 1)
+        XCTAssertEqual(tracker.state.safeValue.uploaded.count, 1)
+    }
+
+    func test_snapshotTracker_failedAfterCaching() async throws {
+        try XCTSkipIf(XCTestCase.isWatchOS(), "Unavailable on WatchOS")
+        // mock error requests
+        EmbraceHTTPMock.mock(url: testSpansUrl(), errorCode: 500)
+
+        // given a storage and upload modules (no retries, so the payload is dropped after the first request)
+        let storage = try EmbraceStorage.createInMemoryDb()
+        defer { storage.coreData.destroy() }
+
+        let upload = try EmbraceUpload(
+            options: uploadOptions(automaticRetryCount: 0), logger: logger, queue: queue)
+
+        // given a session with an open span
+        let session = try await givenSessionWithOpenSpan(storage: storage)
+
+        let tracker = SpanSnapshotTracker()
+        tracker.bootstrap(enabled: true)
+
+        // when the payload is cached but its upload fails
+        await UnsentDataHandler.sendSession(session, storage: storage, upload: upload, snapshotTracker: tracker)
+        wait(timeout: .longTimeout, interval: .shortInterval, until: { tracker.state.safeValue.pending.isEmpty })
+
+        // then the snapshot isn't remembered as uploaded, so the next payload sends it again
+        XCTAssertEqual(EmbraceHTTPMock.requestsForUrl(testSpansUrl()).count, 1)
+        XCTAssertTrue(tracker.state.safeValue.uploaded.isEmpty)
+        XCTAssertTrue(upload.cache.fetchAllUploadData().isEmpty)
+    }
+
     func test_logsUpload() async throws {
         try XCTSkipIf(XCTestCase.isWatchOS(), "Unavailable on WatchOS")
         // mock successful requests
@@ -818,6 +939,165 @@ class UnsentDataHandlerTests: XCTestCase {
         XCTAssertEqual(EmbraceHTTPMock.requestsForUrl(testLogsUrl()).count, 0)
         XCTAssertFalse(FileManager.default.fileExists(atPath: pendingLogsFilePath.path))
     }
+
+    // MARK: - Recovery stages
+
+    private func addFinishedSessions(_ count: Int, to storage: EmbraceStorage) async -> [EmbraceIdentifier] {
+        var ids: [EmbraceIdentifier] = []
+        for index in 0..<count {
+            let id = EmbraceIdentifier.random
+            await storage.addSession(
+                id: id,
+                processId: ProcessIdentifier.current,
+                state: .foreground,
+                traceId: TestConstants.traceId,
+                spanId: TestConstants.spanId,
+                startTime: Date(timeIntervalSinceNow: Double(-60 * (count - index))),
+                endTime: Date(timeIntervalSinceNow: Double(-60 * (count - index) + 30))
+            )
+            ids.append(id)
+        }
+        return ids
+    }
+
+    private func run(
+        _ recovery: UnsentDataRecovery,
+        storage: EmbraceStorage,
+        upload: EmbraceUpload?,
+        otel: EmbraceOpenTelemetry?,
+        crashReporter: EmbraceCrashReporter?
+    ) async {
+        await withCheckedContinuation { continuation in
+            recovery.run(
+                storage: storage,
+                upload: upload,
+                otel: otel,
+                logController: nil,
+                currentSessionId: nil,
+                crashReporter: crashReporter,
+                recoveredHeartbeat: nil
+            ) {
+                continuation.resume()
+            }
+        }
+    }
+
+    private func crashReports(for sessionIds: [EmbraceIdentifier]) -> [EmbraceCrashReport] {
+        sessionIds.enumerated().map { index, sessionId in
+            EmbraceCrashReport(
+                payload: "test",
+                provider: "mock",
+                internalId: EMBInt(index),
+                sessionId: sessionId.stringValue,
+                timestamp: Date()
+            )
+        }
+    }
+
+    func test_recovery_manySessions() async throws {
+        try XCTSkipIf(XCTestCase.isWatchOS(), "Unavailable on WatchOS")
+        // mock successful requests
+        EmbraceHTTPMock.mock(url: testSpansUrl())
+        EmbraceHTTPMock.mock(url: testLogsUrl())
+
+        // given a storage and upload modules
+        let storage = try EmbraceStorage.createInMemoryDb()
+        defer { storage.coreData.destroy() }
+
+        let upload = try EmbraceUpload(options: uploadOptions, logger: logger, queue: queue)
+        let otel = MockEmbraceOpenTelemetry()
+
+        // given 20 finished sessions, two of them with a crash
+        let sessionIds = await addFinishedSessions(20, to: storage)
+        let crashReporter = CrashReporterMock(mockReports: crashReports(for: [sessionIds[3], sessionIds[15]]))
+        let embraceReporter = EmbraceCrashReporter(reporter: crashReporter)
+
+        // when recovering the unsent data
+        await run(UnsentDataRecovery(), storage: storage, upload: upload, otel: otel, crashReporter: embraceReporter)
+        wait(timeout: .longTimeout, interval: .shortInterval, until: { upload.cache.fetchAllUploadData().isEmpty })
+
+        // then every session and crash report was sent
+        XCTAssertEqual(EmbraceHTTPMock.requestsForUrl(testSpansUrl()).count, 20)
+        XCTAssertEqual(EmbraceHTTPMock.requestsForUrl(testLogsUrl()).count, 2)
+        XCTAssertEqual(storage.fetchAllSessions().count, 0)
+        XCTAssertEqual(crashReporter.mockReports.count, 0)
+        XCTAssertEqual(otel.logs.count, 2)
+    }
+
+    func test_recovery_crashLogsGoFirst() async throws {
+        // given a storage with 20 finished sessions
+        let storage = try EmbraceStorage.createInMemoryDb()
+        defer { storage.coreData.destroy() }
+        let sessionIds = await addFinishedSessions(20, to: storage)
+
+        // given a crash reporter that checks the stored sessions when a report is handed off
+        let crashReporter = OrderRecordingCrashReporter(mockReports: crashReports(for: Array(sessionIds.prefix(3))))
+        crashReporter.storage = storage
+        let embraceReporter = EmbraceCrashReporter(reporter: crashReporter)
+
+        // when recovering the unsent data one stage at a time
+        let recovery = UnsentDataRecovery(maxConcurrentStages: 1, cancelWhenBackgrounded: false)
+        await run(recovery, storage: storage, upload: nil, otel: nil, crashReporter: embraceReporter)
+
+        // then the crash reports were handled before any session was
+        XCTAssertEqual(crashReporter.sessionCountOnDelete, [20, 20, 20])
+        XCTAssertEqual(storage.fetchAllSessions().count, 0)
+    }
+
+    func test_linkCrashReports() async throws {
+        // given a storage with some sessions
+        let storage = try EmbraceStorage.createInMemoryDb()
+        defer { storage.coreData.destroy() }
+        let sessionIds = await addFinishedSessions(5, to: storage)
+
+        // given crash reports for two of them and one for an unknown session
+        let reports = crashReports(for: [sessionIds[1], sessionIds[4], .random])
+
+        // when linking them
+        let linked = UnsentDataHandler.linkCrashReports(reports, storage: storage)
+
+        // then the known sessions have the crash report id
+        XCTAssertEqual(linked.count, 2)
+        XCTAssertEqual(storage.fetchSession(id: sessionIds[1])?.crashReportId, reports[0].id.uuidString)
+        XCTAssertEqual(storage.fetchSession(id: sessionIds[4])?.crashReportId, reports[1].id.uuidString)
+        XCTAssertNil(storage.fetchSession(id: sessionIds[0])?.crashReportId)
+    }
+
+    func test_recovery_cancelled() async throws {
+        // given a storage with finished sessions and a crash report
+        let storage = try EmbraceStorage.createInMemoryDb()
+        defer { storage.coreData.destroy() }
+        let sessionIds = await addFinishedSessions(20, to: storage)
+
+        let crashReporter = CrashReporterMock(mockReports: crashReports(for: [sessionIds[0]]))
+        let embraceReporter = EmbraceCrashReporter(reporter: crashReporter)
+
+        // when the recovery is cancelled before it gets to run
+        let recovery = UnsentDataRecovery(maxConcurrentStages: 1, cancelWhenBackgrounded: false)
+        recovery.cancel()
+        await run(recovery, storage: storage, upload: nil, otel: nil, crashReporter: embraceReporter)
+
+        // then it still completes, and everything is left for the next launch
+        XCTAssertEqual(storage.fetchAllSessions().count, 20)
+        XCTAssertEqual(crashReporter.mockReports.count, 1)
+    }
+
+    #if canImport(UIKit) && !os(watchOS)
+        func test_recovery_cancelledWhenBackgrounded() async throws {
+            // given a storage with finished sessions
+            let storage = try EmbraceStorage.createInMemoryDb()
+            defer { storage.coreData.destroy() }
+            _ = await addFinishedSessions(20, to: storage)
+
+            // when the app goes to the background before the recovery runs
+            let recovery = UnsentDataRecovery(maxConcurrentStages: 1)
+            NotificationCenter.default.post(name: UIApplication.didEnterBackgroundNotification, object: nil)
+            await run(recovery, storage: storage, upload: nil, otel: nil, crashReporter: nil)
+
+            // then the sessions are left for the next launch
+            XCTAssertEqual(storage.fetchAllSessions().count, 20)
+        }
+    #endif
 }
 
 extension UnsentDataHandlerTests {
@@ -829,6 +1109,29 @@ extension UnsentDataHandlerTests {
         )
     }
 
+    fileprivate func givenSessionWithOpenSpan(storage: EmbraceStorage) async throws -> EmbraceSession {
+        let session = await storage.addSession(
+            id: TestConstants.sessionId,
+            processId: ProcessIdentifier.current,
+            state: .foreground,
+            traceId: TestConstants.traceId,
+            spanId: TestConstants.spanId,
+            startTime: Date(timeIntervalSinceNow: -60),
+            endTime: Date()
+        )
+
+        storage.upsertSpan(
+            id: "openSpan",
+            name: "test",
+            traceId: TestConstants.traceId,
+            type: .performance,
+            data: Data(),
+            startTime: Date(timeIntervalSinceNow: -50)
+        )
+
+        return try XCTUnwrap(session)
+    }
+
     fileprivate func uploadOptions(automaticRetryCount: Int) -> EmbraceUpload.Options {
         let urlSessionConfig = URLSessionConfiguration.ephemeral
         urlSessionConfig.httpMaximumConnectionsPerHost = .max
@@ -891,3 +1194,13 @@ extension EmbraceStorage {
     }
 
 }
+
+private class OrderRecordingCrashReporter: CrashReporterMock {
+    var storage: EmbraceStorage?
+    private(set) var sessionCountOnDelete: [Int] = []
+
+    override func deleteCrashReport(_ report: EmbraceCrashReport) {
+        sessionCountOnDelete.append(storage?.fetchAllSessions().count ?? 0)
+        super.deleteCrashReport(report)
+    }
+}
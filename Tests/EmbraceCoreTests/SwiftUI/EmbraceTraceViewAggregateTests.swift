@@ -0,0 +1,117 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import EmbraceCommonInternal
+import OpenTelemetryApi
+import OpenTelemetrySdk
+import TestSupport
+import XCTest
+
+@testable import EmbraceCore
+
+@available(iOS 13, macOS 10.15, tvOS 13, watchOS 6.0, *)
+final class EmbraceTraceViewAggregateTests: XCTestCase {
+
+    var otel: MockEmbraceOpenTelemetry!
+
+    override func setUpWithError() throws {
+        otel = MockEmbraceOpenTelemetry()
+    }
+
+    private var summaries: [SpanData] {
+        otel.spanProcessor.endedSpans.filter { $0.name.hasSuffix(".body-summary") }
+    }
+
+    func test_recordBody() {
+        // given an aggregate
+        let aggregate = EmbraceTraceViewAggregate("Badge", outlierThreshold: 0.016)
+        let start = Date()
+
+        // when recording body evaluations
+        XCTAssertFalse(aggregate.recordBody(start: start, end: start.addingTimeInterval(0.0001), otel: otel))
+        XCTAssertFalse(aggregate.recordBody(start: start, end: start.addingTimeInterval(0.003), otel: otel))
+        XCTAssertTrue(aggregate.recordBody(start: start, end: start.addingTimeInterval(0.1), otel: otel))
+        aggregate.recordAppear(time: start)
+
+        // then they're counted in their buckets
+        let counters = aggregate.counters.safeValue
+        XCTAssertEqual(counters.evaluations, 3)
+        XCTAssertEqual(counters.outliers, 1)
+        XCTAssertEqual(counters.appears, 1)
+        XCTAssertEqual(counters.maxDuration, 0.1, accuracy: 0.0001)
+        XCTAssertEqual(counters.buckets, [1, 0, 0, 0, 1, 0, 0, 0, 0, 1])
+
+        // and no spans are created until it's flushed
+        XCTAssertTrue(otel.spanProcessor.startedSpans.isEmpty)
+    }
+
+    func test_flush() throws {
+        // given an aggregate with some evaluations
+        let aggregate = EmbraceTraceViewAggregate("Badge")
+        let start = Date()
+        _ = aggregate.recordBody(start: start, end: start.addingTimeInterval(0.0007), otel: otel)
+        _ = aggregate.recordBody(start: start.addingTimeInterval(1), end: start.addingTimeInterval(1.0015), otel: otel)
+        aggregate.recordDisappear(time: start.addingTimeInterval(2))
+
+        // when flushing it
+        aggregate.flush(time: start.addingTimeInterval(3))
+
+        // then a summary span covers what was recorded
+        let summary = try XCTUnwrap(summaries.first)
+        XCTAssertEqual(summaries.count, 1)
+        XCTAssertEqual(summary.name, "emb-swiftui.view.Badge.body-summary")
+        XCTAssertEqual(summary.startTime, start)
+        XCTAssertEqual(summary.endTime, start.addingTimeInterval(3))
+        XCTAssertEqual(summary.attributes["body.count"], .string("2"))
+        XCTAssertEqual(summary.attributes["body.total_ms"], .string("2"))
+        XCTAssertEqual(summary.attributes["body.outlier_count"], .string("0"))
+        XCTAssertEqual(summary.attributes["disappear.count"], .string("1"))
+        XCTAssertEqual(
+            summary.attributes["body.histogram_ms"],
+            .string("0.25=0,0.5=0,1.0=1,2.0=1,4.0=0,8.0=0,16.0=0,33.0=0,66.0=0,inf=0")
+        )
+
+        // and the counters start over
+        XCTAssertTrue(aggregate.counters.safeValue.isEmpty)
+        aggregate.flush()
+        XCTAssertEqual(summaries.count, 1)
+    }
+
+    func test_window() {
+        // given an aggregate with a short window
+        let aggregate = EmbraceTraceViewAggregate("Badge", window: 10)
+        let start = Date()
+
+        // when evaluations are recorded past the window
+        for second in 0..<25 {
+            let time = start.addingTimeInterval(TimeInterval(second))
+            _ = aggregate.recordBody(start: time, end: time.addingTimeInterval(0.001), otel: otel)
+        }
+
+        // then a summary is created for each elapsed window
+        XCTAssertEqual(summaries.count, 2)
+        XCTAssertEqual(summaries.map { $0.attributes["body.count"] }, [.string("11"), .string("11")])
+        XCTAssertEqual(aggregate.counters.safeValue.evaluations, 3)
+    }
+
+    func test_sessionEnd_flushesAll() {
+        // given aggregates registered in the same list
+        let notificationCenter = NotificationCenter()
+        let aggregates = EmbraceTraceViewAggregates(notificationCenter: notificationCenter)
+        let first = EmbraceTraceViewAggregate("First")
+        let second = EmbraceTraceViewAggregate("Second")
+        aggregates.register(first)
+        aggregates.register(second)
+
+        let start = Date()
+        _ = first.recordBody(start: start, end: start, otel: otel)
+        _ = second.recordBody(start: start, end: start, otel: otel)
+
+        // when the session is about to end
+        notificationCenter.post(name: .embraceSessionWillEnd, object: nil)
+
+        // then every view gets its summary
+        XCTAssertEqual(Set(summaries.map(\.name)), ["emb-swiftui.view.First.body-summary", "emb-swiftui.view.Second.body-summary"])
+    }
+}
@@ -48,8 +48,8 @@
         }
 
         @MainActor
-        func runLayout() {
-            let traceView = EmbraceTraceView("BenchmarkScreen") {
+        func runLayout(aggregate: EmbraceTraceViewAggregate? = nil) {
+            let traceView = EmbraceTraceView("BenchmarkScreen", aggregate: aggregate) {
                 Text("Performance Test")
             }
             .environment(\.embraceTraceViewLogger, traceViewLogger)
@@ -76,6 +76,17 @@
             }
         }
 
+        @MainActor
+        func testEmbraceTraceViewAggregatedPerformance() async throws {
+            // Perf measurements are meaningless under sanitizer instrumentation.
+            try XCTSkipIfSanitizing()
+            mockConfig.isSwiftUiViewInstrumentationEnabled = true
+            let aggregate = EmbraceTraceViewAggregate("BenchmarkScreen")
+            measure {
+                runLayout(aggregate: aggregate)
+            }
+        }
+
         @MainActor
         func testEmbraceTraceViewDisabledPerformance() async throws {
             // Perf measurements are meaningless under sanitizer instrumentation.
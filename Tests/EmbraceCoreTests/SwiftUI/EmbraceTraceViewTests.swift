@@ -203,6 +203,51 @@
             window.isHidden = true
         }
 
+        @MainActor
+        func testEmbraceTraceViewAggregated() async {
+            // Given: tracing is enabled and the view is aggregated
+            mockConfig.isSwiftUiViewInstrumentationEnabled = true
+            let aggregate = EmbraceTraceViewAggregate("AggregatedScreen", outlierThreshold: 10)
+
+            // When: we create and render an EmbraceTraceView
+            let traceView = EmbraceTraceView("AggregatedScreen", aggregate: aggregate) {
+                Text("Aggregated")
+            }
+            .environment(\.embraceTraceViewLogger, traceViewLogger)
+            .environment(\.embraceTraceViewContext, traceViewContext)
+
+            let hostingController = UIHostingController(rootView: traceView)
+            let window = UIWindow(frame: CGRect(x: 0, y: 0, width: 300, height: 600))
+            window.rootViewController = hostingController
+            window.makeKeyAndVisible()
+
+            hostingController.loadViewIfNeeded()
+            hostingController.view.layoutIfNeeded()
+
+            await RunLoop.main.waitForNextTick()
+
+            // Then: only time to first render gets a span, the rest is counted
+            let spanNames = (spanProcessor.startedSpans + spanProcessor.endedSpans).map { $0.name }
+            XCTAssertTrue(spanNames.contains("emb-swiftui.view.AggregatedScreen.time-to-first-render"))
+            XCTAssertFalse(spanNames.contains("emb-swiftui.view.AggregatedScreen.render-loop"))
+            XCTAssertFalse(spanNames.contains("emb-swiftui.view.AggregatedScreen.body"))
+            XCTAssertFalse(spanNames.contains("emb-swiftui.view.AggregatedScreen.appear"))
+
+            let counters = aggregate.counters.safeValue
+            XCTAssertGreaterThan(counters.evaluations, 0)
+            XCTAssertEqual(counters.appears, 1)
+
+            // When: the summary is flushed
+            aggregate.flush()
+
+            // Then: a single summary span is created
+            let summaries = spanProcessor.endedSpans.filter { $0.name == "emb-swiftui.view.AggregatedScreen.body-summary" }
+            XCTAssertEqual(summaries.count, 1)
+            XCTAssertEqual(summaries.first?.attributes["body.count"], .string("\(counters.evaluations)"))
+
+            window.isHidden = true
+        }
+
         @MainActor
         func testMultipleEmbraceTraceViews() async {
             // Given: tracing is enabled
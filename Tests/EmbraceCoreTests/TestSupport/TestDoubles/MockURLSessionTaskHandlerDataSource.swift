@@ -20,6 +20,8 @@ class MockURLSessionTaskHandlerDataSource: URLSessionTaskHandlerDataSource {
 
     var ignoredTaskTypes: [AnyClass] = []
 
+    var aggregator: NetworkRequestAggregator?
+
     func shouldInjectHeader(for request: URLRequest) -> Bool {
         stubbedShouldInjectHeader
     }
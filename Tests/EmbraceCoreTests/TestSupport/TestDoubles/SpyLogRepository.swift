@@ -28,6 +28,7 @@ class SpyLogRepository: LogRepository {
     }
 
     var didCallCreate = false
+    var createdLogs: [EmbraceLog] = []
     func createLog(
         id: EmbraceIdentifier,
         processId: EmbraceIdentifier,
@@ -38,7 +39,7 @@ class SpyLogRepository: LogRepository {
     ) -> EmbraceLog? {
         didCallCreate = true
 
-        return MockLog(
+        let log = MockLog(
             id: id,
             processId: processId,
             severity: severity,
@@ -46,5 +47,7 @@ class SpyLogRepository: LogRepository {
             timestamp: timestamp,
             attributes: attributes
         )
+        createdLogs.append(log)
+        return log
     }
 }
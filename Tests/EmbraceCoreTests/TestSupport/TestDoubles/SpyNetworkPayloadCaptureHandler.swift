@@ -25,6 +25,14 @@ class SpyNetworkPayloadCaptureHandler: NetworkPayloadCaptureHandler {
         return stubbedIsEnabled
     }
 
+    var stubbedBodyCaptureLimit: Int = .max
+
+    func bodyCaptureLimit(request: URLRequest?, response: URLResponse?) -> Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return stubbedBodyCaptureLimit
+    }
+
     private var _didCallProcess: Bool = false
     var didCallProcess: Bool {
         lock.lock()
@@ -35,7 +43,7 @@ class SpyNetworkPayloadCaptureHandler: NetworkPayloadCaptureHandler {
     func process(
         request: URLRequest?,
         response: URLResponse?,
-        data: Data?,
+        body: NetworkBodyBuffer?,
         error: (any Error)?,
         startTime: Date?,
         endTime: Date?
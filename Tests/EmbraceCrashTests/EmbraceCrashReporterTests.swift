@@ -66,6 +66,51 @@
             wait(for: [expectation], timeout: .defaultTimeout)
         }
 
+        func test_fetchCrashReports_watchdogEvent_flagsMainThread() throws {
+            givenCrashReporter()
+
+            // given a watchdog report whose threads have no crash flags
+            let path = try XCTUnwrap(Bundle.module.path(forResource: "crash_report", ofType: "json", inDirectory: "Mocks"))
+            var json = try XCTUnwrap(
+                JSONSerialization.jsonObject(with: Data(contentsOf: URL(fileURLWithPath: path))) as? [String: Any]
+            )
+            var crash = try XCTUnwrap(json["crash"] as? [String: Any])
+            var threads = try XCTUnwrap(crash["threads"] as? [[String: Any]])
+            for index in threads.indices {
+                threads[index]["crashed"] = nil
+                threads[index]["current_thread"] = nil
+            }
+            crash["threads"] = threads
+            crash["error"] = ["type": "user", "user_reported": ["name": "watchdog_event"]]
+            json["crash"] = crash
+
+            let basePath = try XCTUnwrap(crashReporter.basePath)
+            try FileManager.default.createDirectory(atPath: basePath + "/Reports", withIntermediateDirectories: true)
+            try JSONSerialization.data(withJSONObject: json).write(
+                to: URL(fileURLWithPath: basePath + "/Reports/appId-report-0000000000000001.json")
+            )
+
+            // when fetching it
+            let expectation = XCTestExpectation()
+            crashReporter.fetchUnsentCrashReports { reports in
+                XCTAssertEqual(reports.count, 1)
+
+                // then the flags are added, with the main thread as the crashed one
+                let payload = try? JSONSerialization.jsonObject(with: Data((reports.first?.payload ?? "").utf8)) as? [String: Any]
+                let threads = (payload?["crash"] as? [String: Any])?["threads"] as? [[String: Any]] ?? []
+                XCTAssertFalse(threads.isEmpty)
+                for thread in threads {
+                    let isMain = thread["index"] as? Int == 0
+                    XCTAssertEqual(thread["crashed"] as? Bool, isMain)
+                    XCTAssertEqual(thread["current_thread"] as? Bool, isMain)
+                }
+
+                expectation.fulfill()
+            }
+
+            wait(for: [expectation], timeout: .defaultTimeout)
+        }
+
         func test_fetchCrashReports_count() throws {
             givenCrashReporter()
 
@@ -5,11 +5,15 @@
 import EmbraceCommonInternal
 import EmbraceCore
 import EmbraceCrash
+import EmbraceSQLiteInternal
 import Foundation
+import OpenTelemetryApi
 import TestSupport
 import XCTest
 
+@testable import EmbraceConfiguration
 @testable import EmbraceCore
+@testable import EmbraceCoreDataInternal
 @testable import EmbraceIO
 @testable import EmbraceStorageInternal
 @testable import EmbraceUploadInternal
@@ -190,6 +194,330 @@ class PerformanceLogicalWritesTests: XCTestCase {
     }
 }
 
+class PerformanceCommitSchedulerTests: XCTestCase {
+
+    /// Mixed workload: each iteration opens a span, logs, updates the span and ends it.
+    private func runMixedWorkload(_ storage: EmbraceStorage, iterations: Int) {
+        let startDate = Date()
+        for index in 0..<iterations {
+            let spanId = String(format: "%016x", index)
+            storage.upsertSpan(
+                id: spanId,
+                name: "span-\(index)",
+                traceId: TestConstants.traceId,
+                type: .performance,
+                data: Data(count: 256),
+                startTime: startDate
+            )
+            storage.createLog(
+                id: EmbraceIdentifier.random,
+                processId: ProcessIdentifier.current,
+                severity: .info,
+                body: "log-\(index)",
+                attributes: [:]
+            )
+            storage.upsertSpan(
+                id: spanId,
+                name: "span-\(index)",
+                traceId: TestConstants.traceId,
+                type: .performance,
+                data: Data(count: 512),
+                startTime: startDate,
+                endTime: startDate.addingTimeInterval(1)
+            )
+        }
+        storage.flush()
+    }
+
+    private func measureWorkload(commitPolicy: CoreDataWrapper.CommitPolicy) throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        let iterations = 500
+        let options = EmbraceStorage.Options(
+            storageMechanism: .onDisk(
+                name: UUID().uuidString,
+                baseURL: URL(fileURLWithPath: NSTemporaryDirectory()),
+                journalMode: .wal
+            ),
+            enableBackgroundTasks: false
+        )
+        options.commitPolicy = commitPolicy
+
+        measure(metrics: [XCTClockMetric(), XCTStorageMetric()]) {
+            guard let storage = try? EmbraceStorage(options: options, logger: MockLogger()) else {
+                return XCTFail("failed to create storage")
+            }
+
+            runMixedWorkload(storage, iterations: iterations)
+
+            // coalescing is what's being measured, so make sure it happened
+            if commitPolicy != .immediate {
+                XCTAssertLessThan(storage.coreData.saveCount, iterations * 3)
+            }
+        }
+    }
+
+    func test_mixedWorkload_immediateCommits() throws {
+        try measureWorkload(commitPolicy: .immediate)
+    }
+
+    func test_mixedWorkload_coalescedCommits() throws {
+        try measureWorkload(commitPolicy: .default)
+    }
+}
+
+class PerformanceOpenSpansTests: XCTestCase {
+
+    /// 500 spans open at once, each updated repeatedly before ending — the shape of a span-heavy screen.
+    private func measureFrequentUpdates(engine: StorageEngine) throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        let spanCount = 500
+        let updatesPerSpan = 10
+
+        measure(metrics: [XCTClockMetric()]) {
+            guard let storage = try? EmbraceStorage.createInMemoryDb(engine: engine) else {
+                return XCTFail("failed to create storage")
+            }
+            defer { storage.coreData.destroy() }
+
+            let startDate = Date()
+            let spans = (0..<spanCount).map { _ in (id: SpanId.random().hexString, traceId: TraceId.random().hexString) }
+
+            for span in spans {
+                storage.upsertSpan(
+                    id: span.id, name: "span", traceId: span.traceId, type: .performance, data: Data(),
+                    startTime: startDate)
+            }
+
+            for update in 0..<updatesPerSpan {
+                for span in spans {
+                    storage.upsertSpan(
+                        id: span.id, name: "span-\(update)", traceId: span.traceId, type: .performance,
+                        data: Data(count: 64), startTime: startDate)
+                }
+            }
+
+            for span in spans {
+                storage.upsertSpan(
+                    id: span.id, name: "span", traceId: span.traceId, type: .performance, data: Data(),
+                    startTime: startDate, endTime: startDate.addingTimeInterval(1))
+            }
+
+            storage.flush()
+        }
+    }
+
+    func test_openSpans_frequentUpdates() throws {
+        try measureFrequentUpdates(engine: .coreData)
+    }
+
+    func test_openSpans_frequentUpdates_sqlite() throws {
+        try measureFrequentUpdates(engine: .sqlite)
+    }
+}
+
+class PerformanceRetentionTests: XCTestCase {
+
+    private let recordCount = 100_000
+    private let baseURL = URL(fileURLWithPath: NSTemporaryDirectory()).appendingPathComponent("PerformanceRetentionTests")
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: baseURL)
+    }
+
+    /// On disk, since in-memory Core Data stores don't support the batch delete used by the cleanup.
+    private func makeCache(engine: StorageEngine) throws -> EmbraceUploadCache {
+        try FileManager.default.createDirectory(at: baseURL, withIntermediateDirectories: true)
+
+        let options = EmbraceUpload.CacheOptions(
+            storageMechanism: .onDisk(name: UUID().uuidString, baseURL: baseURL, journalMode: .wal),
+            enableBackgroundTasks: false,
+            cacheDaysLimit: 1,
+            engine: engine
+        )
+        return try EmbraceUploadCache(options: options, logger: MockLogger())
+    }
+
+    private func fillExpired(_ cache: EmbraceUploadCache) throws {
+        let data = Data(count: 256)
+        let date = Date(timeIntervalSinceNow: -7 * 86400)
+
+        if let sqlite = cache.sqlite {
+            try sqlite.connection.transaction {
+                for i in 0..<recordCount {
+                    try sqlite.saveUploadData(SQLiteUploadDataRow(id: "\(i)", type: 0, data: data, date: date))
+                }
+            }
+            return
+        }
+
+        cache.coreData.performOperation { context in
+            for i in 0..<recordCount {
+                _ = UploadDataRecord.create(context: context, id: "\(i)", type: 0, data: data, payloadTypes: nil, date: date)
+            }
+            try? context.save()
+            context.reset()
+        }
+    }
+
+    /// Launch-time cleanup of 100k expired cached payloads; only the cleanup itself is measured.
+    private func measureCleanup(engine: StorageEngine) throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        measureMetrics([.wallClockTime], automaticallyStartMeasuring: false) {
+            do {
+                let cache = try makeCache(engine: engine)
+                try fillExpired(cache)
+
+                startMeasuring()
+                let removed = cache.clearStaleDataIfNeeded()
+                stopMeasuring()
+
+                XCTAssertEqual(removed, UInt(recordCount))
+            } catch {
+                XCTFail("\(error)")
+            }
+        }
+    }
+
+    func test_uploadCache_cleanupExpired() throws {
+        try measureCleanup(engine: .coreData)
+    }
+
+    func test_uploadCache_cleanupExpired_sqlite() throws {
+        try measureCleanup(engine: .sqlite)
+    }
+}
+
+class PerformanceHostAllowlistTests: XCTestCase {
+
+    private let entryCount = 500
+    private let lookupCount = 100_000
+
+    private lazy var allowlist: [String] = (0..<entryCount).map { "service\($0).example\($0 % 10).com" }
+
+    /// Mix of hits on entries and subdomains, and misses that share a suffix with the entries.
+    private lazy var hosts: [String] = (0..<lookupCount).map {
+        switch $0 % 4 {
+        case 0: return "api.service\($0 % entryCount).example\($0 % 10).com"
+        case 1: return "SERVICE\($0 % entryCount).EXAMPLE\($0 % 10).COM"
+        case 2: return "cdn.other\($0).example\($0 % 10).com"
+        default: return "unrelated\($0).net"
+        }
+    }
+
+    func test_hostAllowlist_500Entries_compiled() throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        let matcher = HostAllowlistMatcher(allowlist: allowlist)
+        let hosts = hosts
+
+        measure(metrics: [XCTClockMetric()]) {
+            var hits = 0
+            for host in hosts where matcher.matches(host: host) {
+                hits += 1
+            }
+            XCTAssertEqual(hits, lookupCount / 2)
+        }
+    }
+
+    /// Baseline: the per-entry `"." + entry` suffix check the matcher replaced.
+    func test_hostAllowlist_500Entries_linearScan() throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        let allowlist = allowlist
+        let hosts = hosts
+
+        measure(metrics: [XCTClockMetric()]) {
+            var hits = 0
+            for host in hosts {
+                let lowerHost = host.lowercased()
+                if allowlist.contains(where: { lowerHost == $0 || lowerHost.hasSuffix("." + $0) }) {
+                    hits += 1
+                }
+            }
+            XCTAssertEqual(hits, lookupCount / 2)
+        }
+    }
+}
+
+class PerformanceURLCaptureRulesTests: XCTestCase {
+
+    private let ruleCount = 50
+    private let urlCount = 10_000
+
+    /// Rule shapes seen in remote config: hosts with unescaped dots, path wildcards, id classes.
+    private func makeRules() -> [URLSessionTaskCaptureRule] {
+        (0..<ruleCount).map { i in
+            let pattern: String
+            switch i % 5 {
+            case 0: pattern = "api\(i).example.com/v1/users/*"
+            case 1: pattern = "https://api\(i)\\.example\\.com/orders/[0-9]+/items"
+            case 2: pattern = "cdn\(i).example.com/.*\\.json$"
+            case 3: pattern = "example\\.com/service\(i)/.*/status"
+            default: pattern = "^api\(i).example.com/(search|browse)"
+            }
+
+            return URLSessionTaskCaptureRule(
+                rule: NetworkPayloadCaptureRule(
+                    id: "rule\(i)",
+                    urlRegex: pattern,
+                    statusCodes: [500],
+                    method: "GET",
+                    expiration: 9_999_999_999,
+                    publicKey: ""
+                )
+            )
+        }
+    }
+
+    private func makeURLs() -> [String] {
+        (0..<urlCount).map { i in
+            let host = i % ruleCount
+            switch i % 4 {
+            case 0: return "https://api\(host).example.com/v1/users/\(i)?page=\(i % 7)"
+            case 1: return "https://api\(host).example.com/orders/\(i)/items"
+            case 2: return "https://example.com/service\(host)/jobs/\(i)/status"
+            default: return "https://unrelated\(i).example.net/assets/\(i).png"
+            }
+        }
+    }
+
+    func test_captureRules_50Rules_10kURLs_matcher() throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        let rules = makeRules()
+        let urls = makeURLs()
+
+        measure(metrics: [XCTClockMetric()]) {
+            let matcher = URLCaptureRuleMatcher(rules: rules)
+            var matches = 0
+            for url in urls {
+                matches += matcher.matchingRules(for: url).count
+            }
+            XCTAssertGreaterThan(matches, 0)
+        }
+    }
+
+    /// Baseline: every rule's regex evaluated against every url.
+    func test_captureRules_50Rules_10kURLs_perRuleRegex() throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        let rules = makeRules()
+        let urls = makeURLs()
+
+        measure(metrics: [XCTClockMetric()]) {
+            var matches = 0
+            for url in urls {
+                let normalized = url.removingHttpPrefix()
+                matches += rules.filter { $0.urlMatches(normalizedURL: normalized) }.count
+            }
+            XCTAssertGreaterThan(matches, 0)
+        }
+    }
+}
+
 extension EmbraceStorage {
 
     @discardableResult
@@ -218,3 +546,444 @@ extension EmbraceStorage {
     }
 
 }
+
+class PerformanceLockFreeTests: XCTestCase {
+
+    private let producers = 8
+    private let perProducer = 20_000
+
+    private struct Limits {
+        var maxSpans: Int64
+        var maxLogs: Int64
+        var sampleRate: Double
+    }
+
+    func test_handoff_mpscQueue() throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        let producers = producers
+        let perProducer = perProducer
+
+        measure(metrics: [XCTClockMetric()]) {
+            let queue = EmbraceMPSCQueue<Int>(capacity: 1024)
+            let group = DispatchGroup()
+            for _ in 0..<producers {
+                DispatchQueue.global().async(group: group) {
+                    for value in 0..<perProducer {
+                        while !queue.push(value) { sched_yield() }
+                    }
+                }
+            }
+
+            var received = 0
+            while received < producers * perProducer {
+                received += queue.drain { _ in }
+            }
+
+            group.wait()
+            XCTAssertEqual(received, producers * perProducer)
+        }
+    }
+
+    /// Baseline: the mutex guarded array the queue replaces.
+    func test_handoff_mutex() throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        let producers = producers
+        let perProducer = perProducer
+
+        measure(metrics: [XCTClockMetric()]) {
+            let queue = EmbraceMutex([Int]())
+            let group = DispatchGroup()
+            for _ in 0..<producers {
+                DispatchQueue.global().async(group: group) {
+                    for value in 0..<perProducer {
+                        queue.withLock { $0.append(value) }
+                    }
+                }
+            }
+
+            var received = 0
+            while received < producers * perProducer {
+                received += queue.withLock {
+                    defer { $0.removeAll(keepingCapacity: true) }
+                    return $0.count
+                }
+            }
+
+            group.wait()
+            XCTAssertEqual(received, producers * perProducer)
+        }
+    }
+
+    func test_readMostly_seqLock() throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        let limits = EmbraceSeqLock(Limits(maxSpans: 500, maxLogs: 1_000, sampleRate: 1))
+
+        measure(metrics: [XCTClockMetric()]) {
+            DispatchQueue.concurrentPerform(iterations: 8) { index in
+                for iteration in 0..<100_000 {
+                    if index == 0 && iteration % 1_000 == 0 {
+                        limits.store(Limits(maxSpans: Int64(iteration), maxLogs: 1_000, sampleRate: 1))
+                    } else {
+                        _ = limits.load().maxSpans
+                    }
+                }
+            }
+        }
+    }
+
+    /// Baseline: the same reads and writes through a mutex.
+    func test_readMostly_mutex() throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        let limits = EmbraceMutex(Limits(maxSpans: 500, maxLogs: 1_000, sampleRate: 1))
+
+        measure(metrics: [XCTClockMetric()]) {
+            DispatchQueue.concurrentPerform(iterations: 8) { index in
+                for iteration in 0..<100_000 {
+                    if index == 0 && iteration % 1_000 == 0 {
+                        limits.withLock { $0 = Limits(maxSpans: Int64(iteration), maxLogs: 1_000, sampleRate: 1) }
+                    } else {
+                        _ = limits.safeValue.maxSpans
+                    }
+                }
+            }
+        }
+    }
+}
+
+class PerformanceLockContentionTests: XCTestCase {
+
+    private let threads = 8
+    private let perThread = 100_000
+
+    /// Many threads taking the same lock for a tiny critical section, like concurrent logging.
+    private func measureContention(lock: @escaping () -> Void, unlock: @escaping () -> Void) {
+        let threads = threads
+        let perThread = perThread
+
+        measure(metrics: [XCTClockMetric()]) {
+            var counter = 0
+            DispatchQueue.concurrentPerform(iterations: threads) { _ in
+                for _ in 0..<perThread {
+                    lock()
+                    counter += 1
+                    unlock()
+                }
+            }
+            XCTAssertEqual(counter, threads * perThread)
+        }
+    }
+
+    func test_contention_adaptiveLock() throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        let lock = EmbraceAdaptiveLock()
+        measureContention(lock: lock.lock, unlock: lock.unlock)
+    }
+
+    func test_contention_unfairLock() throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        let lock = UnfairLock()
+        measureContention(lock: lock.lock, unlock: lock.unlock)
+    }
+
+    func test_contention_readWriteLock() throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        let lock = ReadWriteLock()
+        measureContention(lock: lock.lockForWriting, unlock: lock.unlock)
+    }
+
+    func test_counter_sharded() throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        let threads = threads
+        let perThread = perThread
+
+        measure(metrics: [XCTClockMetric()]) {
+            let counter = EmbraceShardedCounter()
+            DispatchQueue.concurrentPerform(iterations: threads) { _ in
+                for _ in 0..<perThread {
+                    counter.increment()
+                }
+            }
+            XCTAssertEqual(counter.load(), Int64(threads * perThread))
+        }
+    }
+
+    /// Baseline: a single atomic shared by every thread.
+    func test_counter_atomic() throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        let threads = threads
+        let perThread = perThread
+
+        measure(metrics: [XCTClockMetric()]) {
+            let counter = EmbraceAtomic<Int64>(0)
+            DispatchQueue.concurrentPerform(iterations: threads) { _ in
+                for _ in 0..<perThread {
+                    counter.fetchAdd(1, order: .relaxed)
+                }
+            }
+            XCTAssertEqual(counter.load(), Int64(threads * perThread))
+        }
+    }
+
+    /// Baseline: a counter behind `EmbraceMutex`.
+    func test_counter_mutex() throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        let threads = threads
+        let perThread = perThread
+
+        measure(metrics: [XCTClockMetric()]) {
+            let counter = EmbraceMutex<Int64>(0)
+            DispatchQueue.concurrentPerform(iterations: threads) { _ in
+                for _ in 0..<perThread {
+                    counter.withLock { $0 += 1 }
+                }
+            }
+            XCTAssertEqual(counter.safeValue, Int64(threads * perThread))
+        }
+    }
+}
+
+class PerformanceSnapshotTests: XCTestCase {
+
+    private let threads = 8
+    private let perThread = 100_000
+
+    /// Config-like value that holds references, so it can't go in a seqlock.
+    private struct Config {
+        var maxLogs: Int
+        var capturedHosts: [String]
+    }
+
+    private let initial = Config(maxLogs: 1_000, capturedHosts: ["api.embrace.io", "example.com"])
+
+    func test_readMostly_snapshot() throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        let threads = threads
+        let perThread = perThread
+        let config = EmbraceSnapshot(initial)
+
+        measure(metrics: [XCTClockMetric()]) {
+            DispatchQueue.concurrentPerform(iterations: threads) { index in
+                for iteration in 0..<perThread {
+                    if index == 0 && iteration % 1_000 == 0 {
+                        config.update { Config(maxLogs: iteration, capturedHosts: $0.capturedHosts) }
+                    } else {
+                        _ = config.read { $0.capturedHosts.count + $0.maxLogs }
+                    }
+                }
+            }
+        }
+    }
+
+    /// Baseline: the same reads and writes through a mutex.
+    func test_readMostly_mutexConfig() throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        let threads = threads
+        let perThread = perThread
+        let config = EmbraceMutex(initial)
+
+        measure(metrics: [XCTClockMetric()]) {
+            DispatchQueue.concurrentPerform(iterations: threads) { index in
+                for iteration in 0..<perThread {
+                    if index == 0 && iteration % 1_000 == 0 {
+                        config.withLock { $0.maxLogs = iteration }
+                    } else {
+                        _ = config.withLock { $0.capturedHosts.count + $0.maxLogs }
+                    }
+                }
+            }
+        }
+    }
+}
+
+class PerformanceJSONWriterTests: XCTestCase {
+
+    private let envelope = PayloadEnvelope(
+        data: (0..<1_000).map { index in
+            LogPayload(
+                timeUnixNano: "\(1_700_000_000_000_000_000 + index)",
+                severityNumber: LogSeverity.info.number,
+                severityText: LogSeverity.info.text,
+                body: "Request to \"/api/v2/items/\(index)\" finished\nstatus: 200",
+                attributes: (0..<10).map { Attribute(key: "emb.attribute.\($0)", value: "value \(index) \($0)") },
+                traceId: "0af7651916cd43dd8448eb211c80319c",
+                spanId: "b7ad6b7169203331"
+            )
+        },
+        resource: ResourcePayload(from: []),
+        metadata: MetadataPayload(from: [])
+    )
+
+    func test_encode_jsonWriter() throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        var writer = EmbraceJSONWriter(capacity: 1 << 20)
+        measure(metrics: [XCTClockMetric()]) {
+            for _ in 0..<10 {
+                writer.reset()
+                XCTAssertNoThrow(try envelope.writeJSON(to: &writer))
+            }
+        }
+    }
+
+    /// Baseline: `JSONEncoder`, which is what payloads used before.
+    func test_encode_jsonEncoder() throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        measure(metrics: [XCTClockMetric()]) {
+            for _ in 0..<10 {
+                XCTAssertNoThrow(try JSONEncoder().encode(envelope))
+            }
+        }
+    }
+
+    func test_encodeAndGzip_jsonWriter() throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        measure(metrics: [XCTClockMetric()]) {
+            XCTAssertNoThrow(try envelope.gzippedJSON())
+        }
+    }
+
+    /// Baseline: encoding the whole payload and then gzipping it.
+    func test_encodeAndGzip_jsonEncoder() throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        measure(metrics: [XCTClockMetric()]) {
+            XCTAssertNoThrow(try JSONEncoder().encode(envelope).gzipped())
+        }
+    }
+}
+
+class PerformanceRecoveryTests: XCTestCase {
+
+    private let sessionCount = 20
+
+    private class FakeCrashReporter: CrashReporter {
+        private let reports: EmbraceMutex<[EmbraceCrashReport]>
+
+        init(reports: [EmbraceCrashReport]) {
+            self.reports = EmbraceMutex(reports)
+        }
+
+        var onNewReport: ((EmbraceCrashReport) -> Void)?
+        var disableMetricKitReports: Bool = false
+        var basePath: String?
+
+        func install(context: CrashReporterContext) throws {}
+        func getLastRunState() -> LastRunState { .crash }
+        func appendCrashInfo(key: String, value: String?) {}
+        func getCrashInfo(key: String) -> String? { nil }
+
+        func fetchUnsentCrashReports(completion: @escaping ([EmbraceCrashReport]) -> Void) {
+            completion(reports.safeValue)
+        }
+
+        func deleteCrashReport(_ report: EmbraceCrashReport) {
+            reports.withLock { $0.removeAll { stored in stored.id == report.id } }
+        }
+    }
+
+    private func makeUpload(name: String) throws -> EmbraceUpload {
+        let urlSessionConfig = URLSessionConfiguration.ephemeral
+        urlSessionConfig.httpMaximumConnectionsPerHost = .max
+        urlSessionConfig.protocolClasses = [EmbraceHTTPMock.self]
+
+        let options = EmbraceUpload.Options(
+            endpoints: .init(
+                spansURL: URL(string: "https://embrace.test.com/sessions")!,
+                logsURL: URL(string: "https://embrace.test.com/logs")!,
+                attachmentsURL: URL(string: "https://embrace.test.com/attachments")!
+            ),
+            cache: EmbraceUpload.CacheOptions(storageMechanism: .inMemory(name: name), enableBackgroundTasks: false),
+            metadata: EmbraceUpload.MetadataOptions(apiKey: "apiKey", userAgent: "userAgent", deviceId: "12345678"),
+            redundancy: EmbraceUpload.RedundancyOptions(automaticRetryCount: 0),
+            urlSessionConfiguration: urlSessionConfig
+        )
+        return try EmbraceUpload(options: options, logger: MockLogger(), queue: DispatchQueue(label: "com.test.embrace.upload"))
+    }
+
+    /// Launch-time recovery of 20 pending sessions, 3 of them with a crash report; only the recovery itself is measured.
+    private func measureRecovery(maxConcurrentStages: Int) throws {
+        try XCTSkipIfSanitizing("perf measurements are meaningless under sanitizer instrumentation")
+
+        EmbraceHTTPMock.mock(url: URL(string: "https://embrace.test.com/sessions")!)
+        EmbraceHTTPMock.mock(url: URL(string: "https://embrace.test.com/logs")!)
+        defer { EmbraceHTTPMock.clearRequests() }
+
+        measureMetrics([.wallClockTime], automaticallyStartMeasuring: false) {
+            do {
+                let storage = try EmbraceStorage.createInMemoryDb()
+                defer { storage.coreData.destroy() }
+                let upload = try makeUpload(name: UUID().uuidString)
+
+                var reports: [EmbraceCrashReport] = []
+                for index in 0..<sessionCount {
+                    let id = EmbraceIdentifier.random
+                    let sem = DispatchSemaphore(value: 0)
+                    _ = storage.addSession(
+                        id: id,
+                        processId: ProcessIdentifier.current,
+                        state: .foreground,
+                        traceId: TestConstants.traceId,
+                        spanId: TestConstants.spanId,
+                        startTime: Date(timeIntervalSinceNow: -3600),
+                        endTime: Date(timeIntervalSinceNow: -1800)
+                    ) {
+                        sem.signal()
+                    }
+                    sem.wait()
+
+                    if index % 7 == 0 {
+                        reports.append(
+                            EmbraceCrashReport(payload: "crash", provider: "fake", sessionId: id.stringValue, timestamp: Date())
+                        )
+                    }
+                }
+                let crashReporter = EmbraceCrashReporter(reporter: FakeCrashReporter(reports: reports))
+
+                let done = DispatchSemaphore(value: 0)
+                let recovery = UnsentDataRecovery(maxConcurrentStages: maxConcurrentStages, cancelWhenBackgrounded: false)
+
+                startMeasuring()
+                recovery.run(
+                    storage: storage,
+                    upload: upload,
+                    otel: nil,
+                    logController: nil,
+                    currentSessionId: nil,
+                    crashReporter: crashReporter,
+                    recoveredHeartbeat: nil
+                ) {
+                    done.signal()
+                }
+                done.wait()
+                stopMeasuring()
+
+                XCTAssertEqual(storage.fetchAllSessions().count, 0)
+            } catch {
+                XCTFail("\(error)")
+            }
+        }
+    }
+
+    func test_recovery_20Sessions() throws {
+        try measureRecovery(maxConcurrentStages: UnsentDataRecovery.defaultMaxConcurrentStages)
+    }
+
+    /// Baseline: one stage at a time, which is how recovery used to run.
+    func test_recovery_20Sessions_serial() throws {
+        try measureRecovery(maxConcurrentStages: 1)
+    }
+}
@@ -7,6 +7,7 @@
     import EmbraceConfiguration
     import Foundation
     import TestSupport
+    import TestSupportObjc
     import XCTest
 
     @testable import EmbraceCore
@@ -145,6 +146,44 @@
             blockMainThread(for: 0.3)
             XCTAssertEqual(sampler.samples(in: 0...UInt64.max).count, 1, "resume() should re-arm sampling")
         }
+
+        #if DEBUG
+            /// The stall-capture path (backtracer lookup, suspend, walk, ring commit) runs while main is
+            /// suspended and possibly holding the malloc lock, so it must not allocate at all. The
+            /// sentinel window is opened on the poll thread around the whole capture.
+            @MainActor
+            func test_stallCapture_performsNoAllocation() throws {
+                try XCTSkipIfSanitizing("KSCrash + malloc interposition are unsafe under sanitizer instrumentation")
+
+                let sampler = StallTriggeredSampler(
+                    mainThread: pthread_self(),
+                    triggerThreshold: 0.05,
+                    pollInterval: 0.02,
+                    logger: nil
+                )
+
+                EMBSuspendWindowSentinelArm()
+                StallTriggeredSamplerCaptureProbe.willEnter = { EMBSuspendWindowSentinelBeginWindow() }
+                StallTriggeredSamplerCaptureProbe.didExit = { EMBSuspendWindowSentinelEndWindow() }
+                defer {
+                    sampler.stop()
+                    StallTriggeredSamplerCaptureProbe.willEnter = nil
+                    StallTriggeredSamplerCaptureProbe.didExit = nil
+                    EMBSuspendWindowSentinelDisarm()
+                }
+                EMBSuspendWindowSentinelResetViolations()
+
+                sampler.start()
+                blockMainThread(for: 0.3)
+
+                XCTAssertEqual(sampler.samples(in: 0...UInt64.max).count, 1, "expected the stall to be captured")
+                XCTAssertEqual(
+                    EMBSuspendWindowSentinelViolationCount(), 0,
+                    "The stall-capture path allocated. Everything between the capture probe hooks in "
+                        + "`PollWorker.captureSample` must write into preallocated ring memory only."
+                )
+            }
+        #endif
     }
 
 #endif
@@ -0,0 +1,348 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+#if !os(watchOS)
+
+    import EmbraceCommonInternal
+    import Foundation
+    import Network
+
+    @testable import EmbraceCore
+
+    enum LoadCollectorError: Error {
+        case failedToStart(Error?)
+        case invalidPayload(String)
+    }
+
+    /// Stand-in for the Embrace backend, listening on the loopback interface.
+    ///
+    /// Speaks just enough HTTP/1.1 for `EmbraceUpload` and the remote config fetcher: bodies need a
+    /// `Content-Length`, and connections are kept alive. It answers the config request with `configPayload`,
+    /// and gunzips and validates every span and log payload. Items are matched to what the `LoadGenerator`
+    /// produced through their `load.seq` and `load.produced_at` attributes.
+    final class LoadCollector {
+
+        static let sequenceKey = "load.seq"
+        static let producedAtKey = "load.produced_at"
+
+        /// Raises the per session log limits so they don't cap the load.
+        static let defaultConfig = Data(
+            """
+            {
+                "threshold": 100,
+                "log": { "info_limit": 1000000, "warning_limit": 1000000, "error_limit": 1000000 }
+            }
+            """.utf8
+        )
+
+        struct Stats {
+            /// Requests by path.
+            var requests: [String: Int] = [:]
+
+            /// Size of the upload requests as sent, and of their payloads once decompressed.
+            var wireBytes = 0
+            var payloadBytes = 0
+
+            var invalidPayloads = 0
+            var lastInvalidReason: String?
+
+            /// Delivery delay in nanoseconds of every item that arrived, by sequence number.
+            var spans: [Int64: UInt64] = [:]
+            var logs: [Int64: UInt64] = [:]
+            var duplicates = 0
+
+            /// Wall clock time of the last upload, in nanoseconds since 1970.
+            var lastArrival: UInt64 = 0
+        }
+
+        let configPayload: Data
+        private(set) var port: UInt16 = 0
+
+        var baseURL: String {
+            "http://127.0.0.1:\(port)"
+        }
+
+        var stats: Stats {
+            state.safeValue
+        }
+
+        private let listener: NWListener
+        private let queue = DispatchQueue(label: "io.embrace.load.collector")
+        private let state = EmbraceMutex(Stats())
+
+        init(configPayload: Data = LoadCollector.defaultConfig) throws {
+            self.configPayload = configPayload
+
+            let parameters = NWParameters.tcp
+            parameters.requiredLocalEndpoint = .hostPort(host: .ipv4(.loopback), port: .any)
+            listener = try NWListener(using: parameters)
+
+            let ready = DispatchSemaphore(value: 0)
+            let failure = EmbraceMutex<Error?>(nil)
+            listener.stateUpdateHandler = { state in
+                switch state {
+                case .ready:
+                    ready.signal()
+                case .failed(let error):
+                    failure.withLock { $0 = error }
+                    ready.signal()
+                default:
+                    break
+                }
+            }
+            listener.newConnectionHandler = { [weak self] connection in
+                self?.accept(connection)
+            }
+            listener.start(queue: queue)
+
+            guard ready.wait(timeout: .now() + 5) == .success,
+                failure.safeValue == nil,
+                let port = listener.port?.rawValue
+            else {
+                listener.cancel()
+                throw LoadCollectorError.failedToStart(failure.safeValue)
+            }
+
+            self.port = port
+        }
+
+        deinit {
+            stop()
+        }
+
+        func stop() {
+            listener.cancel()
+        }
+
+        // MARK: - Connections
+        private func accept(_ connection: NWConnection) {
+            connection.start(queue: queue)
+            receive(on: connection, buffer: Data())
+        }
+
+        private func receive(on connection: NWConnection, buffer: Data) {
+            connection.receive(minimumIncompleteLength: 1, maximumLength: 1 << 16) { [weak self] data, _, isComplete, error in
+                guard let self else {
+                    connection.cancel()
+                    return
+                }
+
+                var buffer = buffer
+                if let data {
+                    buffer.append(data)
+                }
+
+                while let request = LoadHTTPRequest.parse(&buffer) {
+                    self.handle(request, on: connection)
+                }
+
+                if isComplete || error != nil {
+                    connection.cancel()
+                } else {
+                    self.receive(on: connection, buffer: buffer)
+                }
+            }
+        }
+
+        private func handle(_ request: LoadHTTPRequest, on connection: NWConnection) {
+            let arrival = LoadClock.wallNanoseconds()
+            let path = request.path.split(separator: "?", maxSplits: 1).first.map(String.init) ?? request.path
+
+            state.withLock { $0.requests[path, default: 0] += 1 }
+
+            var status = 200
+            var body = Data()
+
+            switch (request.method, path) {
+            case ("GET", "/v2/config"):
+                body = configPayload
+
+            case ("POST", "/v2/spans"), ("POST", "/v2/logs"):
+                let type = path == "/v2/spans" ? "spans" : "logs"
+                record(request, type: type, arrival: arrival)
+
+            case ("POST", "/v2/attachments"):
+                state.withLock {
+                    $0.wireBytes += request.size
+                    $0.payloadBytes += request.body.count
+                    $0.lastArrival = arrival
+                }
+
+            default:
+                status = 404
+            }
+
+            let head =
+                "HTTP/1.1 \(status) \(status == 200 ? "OK" : "Not Found")\r\n"
+                + "Content-Type: application/json\r\n"
+                + "Content-Length: \(body.count)\r\n"
+                + "\r\n"
+            connection.send(content: Data(head.utf8) + body, completion: .idempotent)
+        }
+
+        private func record(_ request: LoadHTTPRequest, type: String, arrival: UInt64) {
+            do {
+                let (payloadSize, items) = try Self.validate(
+                    request.body,
+                    contentEncoding: request.headers["content-encoding"],
+                    type: type
+                )
+
+                let delivered: WritableKeyPath<Stats, [Int64: UInt64]> = type == "spans" ? \.spans : \.logs
+
+                state.withLock { stats in
+                    stats.wireBytes += request.size
+                    stats.payloadBytes += payloadSize
+                    stats.lastArrival = arrival
+
+                    // retried uploads can bring the same item twice, only the first one counts
+                    for (sequence, producedAt) in items {
+                        guard stats[keyPath: delivered][sequence] == nil else {
+                            stats.duplicates += 1
+                            continue
+                        }
+                        stats[keyPath: delivered][sequence] = arrival > producedAt ? arrival - producedAt : 0
+                    }
+                }
+            } catch {
+                state.withLock { stats in
+                    stats.wireBytes += request.size
+                    stats.invalidPayloads += 1
+                    stats.lastInvalidReason = String(describing: error)
+                }
+            }
+        }
+
+        // MARK: - Validation
+
+        /// Checks the payload has the envelope the backend expects, and returns its decompressed size
+        /// and the sequence number and production time of the generated items in it.
+        static func validate(
+            _ body: Data,
+            contentEncoding: String?,
+            type: String
+        ) throws -> (size: Int, items: [(Int64, UInt64)]) {
+            guard contentEncoding == "gzip" else {
+                throw LoadCollectorError.invalidPayload("unexpected content encoding \(contentEncoding ?? "none")")
+            }
+
+            let payload = try body.gunzipped()
+
+            guard let envelope = try JSONSerialization.jsonObject(with: payload) as? [String: Any] else {
+                throw LoadCollectorError.invalidPayload("the envelope is not an object")
+            }
+
+            guard envelope["resource"] is [String: Any],
+                envelope["metadata"] is [String: Any],
+                envelope["version"] is String,
+                envelope["type"] as? String == type,
+                let data = envelope["data"] as? [String: Any]
+            else {
+                throw LoadCollectorError.invalidPayload("malformed \(type) envelope")
+            }
+
+            let requiredKeys: [String]
+            let entries: [Any]
+            if type == "spans" {
+                requiredKeys = ["trace_id", "span_id", "name", "start_time_unix_nano", "attributes"]
+                entries = data["spans"] as? [Any] ?? []
+
+                // open spans aren't delivered yet, but they still need to be well formed
+                for snapshot in data["span_snapshots"] as? [Any] ?? [] {
+                    try check(snapshot, has: requiredKeys, type: type)
+                }
+            } else {
+                requiredKeys = ["time_unix_nano", "severity_number", "body", "attributes"]
+                entries = data["logs"] as? [Any] ?? []
+            }
+
+            var items: [(Int64, UInt64)] = []
+            for entry in entries {
+                let attributes = try check(entry, has: requiredKeys, type: type)
+
+                guard let sequence = attributes[sequenceKey].flatMap(Int64.init) else {
+                    continue
+                }
+                guard let producedAt = attributes[producedAtKey].flatMap(UInt64.init) else {
+                    throw LoadCollectorError.invalidPayload("\(type) item \(sequence) lost its production time")
+                }
+                items.append((sequence, producedAt))
+            }
+
+            return (payload.count, items)
+        }
+
+        @discardableResult
+        private static func check(_ entry: Any, has keys: [String], type: String) throws -> [String: String] {
+            guard let object = entry as? [String: Any],
+                keys.allSatisfy({ object[$0] != nil }),
+                let attributes = object["attributes"] as? [[String: Any]]
+            else {
+                throw LoadCollectorError.invalidPayload("malformed item in \(type) payload")
+            }
+
+            var result: [String: String] = [:]
+            for attribute in attributes {
+                guard let key = attribute["key"] as? String, let value = attribute["value"] as? String else {
+                    throw LoadCollectorError.invalidPayload("malformed attribute in \(type) payload")
+                }
+                result[key] = value
+            }
+            return result
+        }
+    }
+
+    /// A request read off a collector connection.
+    struct LoadHTTPRequest {
+        let method: String
+        let path: String
+
+        /// Header names are lowercased.
+        let headers: [String: String]
+        let body: Data
+
+        /// Bytes the whole request took, headers included.
+        let size: Int
+
+        private static let headerTerminator = Data("\r\n\r\n".utf8)
+
+        /// Removes the first complete request from `buffer` and returns it, if there's one.
+        static func parse(_ buffer: inout Data) -> LoadHTTPRequest? {
+            guard let headerEnd = buffer.range(of: headerTerminator) else {
+                return nil
+            }
+
+            let head = String(decoding: buffer[buffer.startIndex..<headerEnd.lowerBound], as: UTF8.self)
+            var lines = head.components(separatedBy: "\r\n")
+            let requestLine = lines.removeFirst().split(separator: " ")
+
+            var headers: [String: String] = [:]
+            for line in lines {
+                guard let colon = line.firstIndex(of: ":") else {
+                    continue
+                }
+                let value = line[line.index(after: colon)...].trimmingCharacters(in: .whitespaces)
+                headers[line[..<colon].lowercased()] = value
+            }
+
+            let length = Int(headers["content-length"] ?? "") ?? 0
+            guard buffer.distance(from: headerEnd.upperBound, to: buffer.endIndex) >= length else {
+                return nil
+            }
+
+            let bodyEnd = buffer.index(headerEnd.upperBound, offsetBy: length)
+            let request = LoadHTTPRequest(
+                method: requestLine.count > 0 ? String(requestLine[0]) : "",
+                path: requestLine.count > 1 ? String(requestLine[1]) : "",
+                headers: headers,
+                body: Data(buffer[headerEnd.upperBound..<bodyEnd]),
+                size: buffer.distance(from: buffer.startIndex, to: bodyEnd)
+            )
+
+            buffer = Data(buffer[bodyEnd...])
+            return request
+        }
+    }
+
+#endif
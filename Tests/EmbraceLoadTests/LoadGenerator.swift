@@ -0,0 +1,355 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+#if !os(watchOS)
+
+    import EmbraceCommonInternal
+    import EmbraceConfiguration
+    import Foundation
+    import OpenTelemetryApi
+
+    @testable import EmbraceCore
+
+    /// Produces the events of a `LoadProfile` through the public SDK API, from several threads at once,
+    /// and waits for them to reach the `LoadCollector`.
+    ///
+    /// Spans and logs go through the whole pipeline: `EmbraceSpanProcessor` and `DefaultLogBatcher`, storage,
+    /// the session and log payload builders and `EmbraceUpload`. Every span and log carries its sequence number
+    /// and production time, which is what the collector uses to measure the delivery delay.
+    final class LoadGenerator {
+
+        static let propertyKeys = 16
+
+        let profile: LoadProfile
+        let collector: LoadCollector
+
+        private let sequence = EmbraceAtomic<Int64>(0)
+        private let produced: [LoadEventKind: EmbraceAtomic<Int64>]
+        private let latencies: [LoadEventKind: EmbraceLatencyHistogram]
+        private let fillerAttributes: [String: String]
+
+        init(profile: LoadProfile, collector: LoadCollector) {
+            self.profile = profile
+            self.collector = collector
+
+            var produced: [LoadEventKind: EmbraceAtomic<Int64>] = [:]
+            var latencies: [LoadEventKind: EmbraceLatencyHistogram] = [:]
+            for kind in LoadEventKind.allCases {
+                produced[kind] = EmbraceAtomic(0)
+                latencies[kind] = EmbraceLatencyHistogram(name: kind.rawValue)
+            }
+            self.produced = produced
+            self.latencies = latencies
+
+            let value = String(repeating: "x", count: max(profile.attributeValueLength, 0))
+            fillerAttributes = Dictionary(
+                uniqueKeysWithValues: (0..<max(profile.attributesPerEvent, 0)).map { ("load.attr.\($0)", value) }
+            )
+        }
+
+        /// Runs the profile against `client`, which should be started and uploading to `collector`.
+        /// Blocks until everything was delivered or `drainTimeout` expired.
+        func run(client: Embrace) -> LoadReport {
+            let startedAt = Date()
+            let startWall = LoadClock.wallNanoseconds()
+            let configApplied = waitForConfig(client: client)
+
+            // spans that start before there's a session aren't in any session payload
+            client.startNewSession()
+            waitUntil(timeout: 5) { client.currentSessionId() != nil }
+
+            let sampler = LoadMemorySampler()
+            let start = LoadClock.now()
+            let deadline = start + UInt64(profile.duration * 1_000_000_000)
+            let pattern = profile.pattern
+
+            let group = DispatchGroup()
+            let producers = max(profile.producers, 1)
+            for worker in 0..<producers {
+                group.enter()
+                let thread = Thread { [self] in
+                    produce(client: client, worker: worker, of: producers, pattern: pattern, until: deadline)
+                    group.leave()
+                }
+                thread.name = "io.embrace.load.producer.\(worker)"
+                thread.start()
+            }
+
+            if profile.sessionLength > 0 {
+                group.enter()
+                let thread = Thread { [self] in
+                    transitionSessions(client: client, until: deadline)
+                    group.leave()
+                }
+                thread.name = "io.embrace.load.sessions"
+                thread.start()
+            }
+
+            group.wait()
+            let generationEnd = LoadClock.now()
+
+            // ending the session flushes the pending logs and uploads the last session payload
+            client.endCurrentSession()
+
+            let spans = producedCount(.span)
+            let logs = producedCount(.log)
+            let drained = waitUntil(timeout: profile.drainTimeout) {
+                let stats = collector.stats
+                return stats.spans.count >= spans && stats.logs.count >= logs
+            }
+            let drainEnd = LoadClock.now()
+
+            let memory = sampler.stop()
+            let stats = collector.stats
+
+            return report(
+                startedAt: startedAt,
+                startWall: startWall,
+                configApplied: configApplied,
+                generationNanoseconds: generationEnd - start,
+                drainNanoseconds: drainEnd - generationEnd,
+                drained: drained,
+                stats: stats,
+                memory: memory
+            )
+        }
+
+        // MARK: - Producing
+        private func produce(
+            client: Embrace,
+            worker: Int,
+            of producers: Int,
+            pattern: [LoadEventKind],
+            until deadline: UInt64
+        ) {
+            let interval: UInt64 =
+                profile.eventsPerSecond > 0 ? UInt64(1_000_000_000 * Double(producers) / Double(profile.eventsPerSecond)) : 0
+            var next = LoadClock.now() + interval * UInt64(worker) / UInt64(producers)
+
+            while true {
+                let now = LoadClock.now()
+                guard now < deadline else {
+                    return
+                }
+
+                if interval > 0 {
+                    if next > now {
+                        usleep(useconds_t(min((next - now) / 1_000, 100_000)))
+                        continue
+                    }
+                    next += interval
+                }
+
+                let seq = sequence.fetchAdd(1)
+                emit(pattern[Int(seq % Int64(pattern.count))], seq: seq, client: client)
+            }
+        }
+
+        private func emit(_ kind: LoadEventKind, seq: Int64, client: Embrace) {
+            var attributes = fillerAttributes
+            attributes[LoadCollector.sequenceKey] = String(seq)
+            attributes[LoadCollector.producedAtKey] = String(LoadClock.wallNanoseconds())
+
+            let start = EmbraceLatencyHistogram.now()
+            switch kind {
+            case .span:
+                client.buildSpan(name: "load-span", attributes: attributes).startSpan().end()
+
+            case .log:
+                client.log("load-log", severity: .info, attributes: attributes, stackTraceBehavior: .notIncluded)
+
+            case .metadata:
+                // fails while there's no session, which is part of what's measured
+                try? client.metadata.addProperty(key: "load.property.\(seq % Int64(Self.propertyKeys))", value: String(seq))
+
+            case .session:
+                client.startNewSession()
+            }
+            latencies[kind]?.record(since: start)
+
+            _ = produced[kind]?.fetchAdd(1)
+        }
+
+        private func transitionSessions(client: Embrace, until deadline: UInt64) {
+            let length = UInt64(profile.sessionLength * 1_000_000_000)
+            var next = LoadClock.now() + length
+
+            while next < deadline {
+                let now = LoadClock.now()
+                if next > now {
+                    usleep(useconds_t(min((next - now) / 1_000, 100_000)))
+                    continue
+                }
+
+                emit(.session, seq: sequence.fetchAdd(1), client: client)
+                next += length
+            }
+        }
+
+        private func producedCount(_ kind: LoadEventKind) -> Int {
+            Int(produced[kind]?.load() ?? 0)
+        }
+
+        // MARK: - Helpers
+
+        /// The collector raises the log limits, see `LoadCollector.defaultConfig`.
+        private func waitForConfig(client: Embrace) -> Bool {
+            let defaultLimit = LogsLimits().info
+            return waitUntil(timeout: 5) { client.logController.limits.info > defaultLimit }
+        }
+
+        @discardableResult
+        private func waitUntil(timeout: TimeInterval, _ condition: () -> Bool) -> Bool {
+            let deadline = Date().addingTimeInterval(timeout)
+            while !condition() {
+                guard Date() < deadline else {
+                    return false
+                }
+                usleep(20_000)
+            }
+            return true
+        }
+
+        private func report(
+            startedAt: Date,
+            startWall: UInt64,
+            configApplied: Bool,
+            generationNanoseconds: UInt64,
+            drainNanoseconds: UInt64,
+            drained: Bool,
+            stats: LoadCollector.Stats,
+            memory: LoadMemorySampler.Peaks
+        ) -> LoadReport {
+            var events: [String: LoadReport.Events] = [:]
+            for kind in LoadEventKind.allCases {
+                let latency = latencies[kind].map { LoadReport.Latency($0.snapshot()) } ?? .empty
+                let count = producedCount(kind)
+
+                switch kind {
+                case .span, .log:
+                    let delivered = kind == .span ? stats.spans : stats.logs
+                    events[kind.rawValue] = LoadReport.Events(
+                        produced: count,
+                        delivered: delivered.count,
+                        lost: max(count - delivered.count, 0),
+                        producerLatency: latency,
+                        deliveryDelay: LoadReport.Latency(values: delivered.values)
+                    )
+                case .metadata, .session:
+                    events[kind.rawValue] = LoadReport.Events(produced: count, producerLatency: latency)
+                }
+            }
+
+            let generationSeconds = Double(generationNanoseconds) / 1_000_000_000
+            let ingested = producedCount(.span) + producedCount(.log) + producedCount(.metadata)
+            let deliverySeconds = Double(stats.lastArrival > startWall ? stats.lastArrival - startWall : 0) / 1_000_000_000
+
+            return LoadReport(
+                profile: profile,
+                sdkVersion: EmbraceMeta.sdkVersion,
+                startedAt: startedAt,
+                configApplied: configApplied,
+                generationSeconds: generationSeconds,
+                drainSeconds: Double(drainNanoseconds) / 1_000_000_000,
+                drained: drained,
+                throughput: LoadReport.Throughput(
+                    ingestPerSecond: generationSeconds > 0 ? Double(ingested) / generationSeconds : 0,
+                    deliveredPerSecond: deliverySeconds > 0 ? Double(stats.spans.count + stats.logs.count) / deliverySeconds : 0
+                ),
+                events: events,
+                wire: LoadReport.Wire(
+                    requests: stats.requests,
+                    bytes: stats.wireBytes,
+                    payloadBytes: stats.payloadBytes,
+                    compressionRatio: stats.wireBytes > 0 ? Double(stats.payloadBytes) / Double(stats.wireBytes) : 0,
+                    invalidPayloads: stats.invalidPayloads,
+                    lastInvalidReason: stats.lastInvalidReason,
+                    duplicates: stats.duplicates
+                ),
+                memory: LoadReport.Memory(
+                    baselineFootprintBytes: memory.baselineFootprint,
+                    peakFootprintBytes: memory.peakFootprint,
+                    peakSdkTrackedBytes: memory.peakTrackedBytes,
+                    maxBudgetLevel: memory.maxLevel.name
+                )
+            )
+        }
+    }
+
+    /// Clocks the generator and the collector share.
+    enum LoadClock {
+
+        /// Monotonic, for durations within the process.
+        static func now() -> UInt64 {
+            EmbraceLatencyHistogram.now()
+        }
+
+        /// Wall clock, to compare with production times carried in the payloads.
+        static func wallNanoseconds() -> UInt64 {
+            UInt64(Date().timeIntervalSince1970 * 1_000_000_000)
+        }
+    }
+
+    /// Samples the process footprint and the bytes tracked by `EmbraceMemoryBudget` while a run goes on.
+    final class LoadMemorySampler {
+
+        struct Peaks {
+            var baselineFootprint: UInt64 = 0
+            var peakFootprint: UInt64 = 0
+            var peakTrackedBytes = 0
+            var maxLevel: EmbraceMemoryBudget.Level = .normal
+        }
+
+        private let peaks = EmbraceMutex(Peaks())
+        private let running = EmbraceAtomic<Bool>(true)
+        private let finished = DispatchSemaphore(value: 0)
+
+        init(interval: TimeInterval = 0.01) {
+            let baseline = Self.footprint() ?? 0
+            peaks.withLock {
+                $0.baselineFootprint = baseline
+                $0.peakFootprint = baseline
+            }
+
+            let thread = Thread { [peaks, running, finished] in
+                while running.load() {
+                    let footprint = Self.footprint() ?? 0
+                    let budget = EmbraceMemoryBudget.shared
+                    let tracked = budget.trackedBytes
+                    let level = budget.level
+
+                    peaks.withLock {
+                        $0.peakFootprint = max($0.peakFootprint, footprint)
+                        $0.peakTrackedBytes = max($0.peakTrackedBytes, tracked)
+                        $0.maxLevel = max($0.maxLevel, level)
+                    }
+                    Thread.sleep(forTimeInterval: interval)
+                }
+                finished.signal()
+            }
+            thread.name = "io.embrace.load.memory"
+            thread.start()
+        }
+
+        func stop() -> Peaks {
+            if running.exchange(false) {
+                finished.wait()
+            }
+            return peaks.safeValue
+        }
+
+        /// Physical footprint of the process, the figure the OS uses to decide when it's using too much memory.
+        static func footprint() -> UInt64? {
+            var info = task_vm_info_data_t()
+            var count = mach_msg_type_number_t(MemoryLayout<task_vm_info_data_t>.size / MemoryLayout<natural_t>.size)
+            let result = withUnsafeMutablePointer(to: &info) {
+                $0.withMemoryRebound(to: integer_t.self, capacity: Int(count)) {
+                    task_info(mach_task_self_, task_flavor_t(TASK_VM_INFO), $0, &count)
+                }
+            }
+            return result == KERN_SUCCESS ? info.phys_footprint : nil
+        }
+    }
+
+#endif
@@ -0,0 +1,251 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+
+/// Kinds of events the `LoadGenerator` produces.
+enum LoadEventKind: String, CaseIterable, Codable {
+    case span
+    case log
+    case metadata
+    case session
+}
+
+/// Describes a load run: how long, how fast, and which mix of events.
+///
+/// Runs use the `smoke` preset by default. Set `EMBRACE_LOAD_PROFILE` to the name of another preset,
+/// or to a JSON object with the fields to change, e.g. `{"preset": "steady", "producers": 8}`.
+/// Fields use the same snake case keys as the reports.
+struct LoadProfile: Codable, Equatable {
+
+    /// Name the report is filed under.
+    var name: String
+
+    /// Seconds spent producing events.
+    var duration: TimeInterval
+
+    /// Number of threads producing events at the same time.
+    var producers: Int
+
+    /// Target rate across all producers. `0` produces as fast as possible.
+    var eventsPerSecond: Int
+
+    /// Relative weights of spans, logs and metadata changes in the mix.
+    var spanWeight: Int
+    var logWeight: Int
+    var metadataWeight: Int
+
+    /// Seconds between session transitions. `0` keeps a single session for the whole run.
+    var sessionLength: TimeInterval
+
+    /// Extra attributes added to every span and log, and the length of their values.
+    var attributesPerEvent: Int
+    var attributeValueLength: Int
+
+    /// Seconds to wait for everything to reach the collector once production stops.
+    var drainTimeout: TimeInterval
+
+    enum CodingKeys: String, CodingKey {
+        case name
+        case preset
+        case duration
+        case producers
+        case eventsPerSecond
+        case spanWeight
+        case logWeight
+        case metadataWeight
+        case sessionLength
+        case attributesPerEvent
+        case attributeValueLength
+        case drainTimeout
+    }
+
+    init(
+        name: String,
+        duration: TimeInterval,
+        producers: Int,
+        eventsPerSecond: Int,
+        spanWeight: Int,
+        logWeight: Int,
+        metadataWeight: Int,
+        sessionLength: TimeInterval,
+        attributesPerEvent: Int,
+        attributeValueLength: Int,
+        drainTimeout: TimeInterval
+    ) {
+        self.name = name
+        self.duration = duration
+        self.producers = producers
+        self.eventsPerSecond = eventsPerSecond
+        self.spanWeight = spanWeight
+        self.logWeight = logWeight
+        self.metadataWeight = metadataWeight
+        self.sessionLength = sessionLength
+        self.attributesPerEvent = attributesPerEvent
+        self.attributeValueLength = attributeValueLength
+        self.drainTimeout = drainTimeout
+    }
+
+    /// Missing fields are taken from `preset`, or from `smoke` if there's none.
+    init(from decoder: Decoder) throws {
+        let container = try decoder.container(keyedBy: CodingKeys.self)
+
+        var base = LoadProfile.smoke
+        if let preset = try container.decodeIfPresent(String.self, forKey: .preset) {
+            guard let profile = LoadProfile.preset(named: preset) else {
+                throw DecodingError.dataCorruptedError(
+                    forKey: .preset,
+                    in: container,
+                    debugDescription: "Unknown load profile preset \(preset)"
+                )
+            }
+            base = profile
+        }
+
+        name = try container.decodeIfPresent(String.self, forKey: .name) ?? base.name
+        duration = try container.decodeIfPresent(TimeInterval.self, forKey: .duration) ?? base.duration
+        producers = try container.decodeIfPresent(Int.self, forKey: .producers) ?? base.producers
+        eventsPerSecond = try container.decodeIfPresent(Int.self, forKey: .eventsPerSecond) ?? base.eventsPerSecond
+        spanWeight = try container.decodeIfPresent(Int.self, forKey: .spanWeight) ?? base.spanWeight
+        logWeight = try container.decodeIfPresent(Int.self, forKey: .logWeight) ?? base.logWeight
+        metadataWeight = try container.decodeIfPresent(Int.self, forKey: .metadataWeight) ?? base.metadataWeight
+        sessionLength = try container.decodeIfPresent(TimeInterval.self, forKey: .sessionLength) ?? base.sessionLength
+        attributesPerEvent =
+            try container.decodeIfPresent(Int.self, forKey: .attributesPerEvent) ?? base.attributesPerEvent
+        attributeValueLength =
+            try container.decodeIfPresent(Int.self, forKey: .attributeValueLength) ?? base.attributeValueLength
+        drainTimeout = try container.decodeIfPresent(TimeInterval.self, forKey: .drainTimeout) ?? base.drainTimeout
+    }
+
+    func encode(to encoder: Encoder) throws {
+        var container = encoder.container(keyedBy: CodingKeys.self)
+        try container.encode(name, forKey: .name)
+        try container.encode(duration, forKey: .duration)
+        try container.encode(producers, forKey: .producers)
+        try container.encode(eventsPerSecond, forKey: .eventsPerSecond)
+        try container.encode(spanWeight, forKey: .spanWeight)
+        try container.encode(logWeight, forKey: .logWeight)
+        try container.encode(metadataWeight, forKey: .metadataWeight)
+        try container.encode(sessionLength, forKey: .sessionLength)
+        try container.encode(attributesPerEvent, forKey: .attributesPerEvent)
+        try container.encode(attributeValueLength, forKey: .attributeValueLength)
+        try container.encode(drainTimeout, forKey: .drainTimeout)
+    }
+
+    /// Repeating order in which events are produced, following the weights.
+    /// Interleaved so that any stretch of the run has roughly the same mix.
+    var pattern: [LoadEventKind] {
+        let weights: [(LoadEventKind, Int)] = [
+            (.span, max(spanWeight, 0)),
+            (.log, max(logWeight, 0)),
+            (.metadata, max(metadataWeight, 0))
+        ]
+        let total = weights.reduce(0) { $0 + $1.1 }
+        guard total > 0 else {
+            return [.span]
+        }
+
+        var pattern: [LoadEventKind] = []
+        var credits = weights.map { _ in 0 }
+        for _ in 0..<total {
+            for index in weights.indices {
+                credits[index] += weights[index].1
+            }
+            let next = credits.indices.max { credits[$0] < credits[$1] } ?? 0
+            credits[next] -= total
+            pattern.append(weights[next].0)
+        }
+        return pattern
+    }
+}
+
+// MARK: - Presets
+extension LoadProfile {
+
+    /// Short run that's part of the regular test suite.
+    static let smoke = LoadProfile(
+        name: "smoke",
+        duration: 2,
+        producers: 2,
+        eventsPerSecond: 500,
+        spanWeight: 6,
+        logWeight: 3,
+        metadataWeight: 1,
+        sessionLength: 0,
+        attributesPerEvent: 4,
+        attributeValueLength: 32,
+        drainTimeout: 30
+    )
+
+    /// Sustained rate an app with a lot of instrumentation could reach.
+    static let steady = LoadProfile(
+        name: "steady",
+        duration: 30,
+        producers: 4,
+        eventsPerSecond: 2_000,
+        spanWeight: 6,
+        logWeight: 3,
+        metadataWeight: 1,
+        sessionLength: 10,
+        attributesPerEvent: 8,
+        attributeValueLength: 64,
+        drainTimeout: 60
+    )
+
+    /// Everything as fast as possible, to find where producers start waiting on the SDK.
+    static let burst = LoadProfile(
+        name: "burst",
+        duration: 10,
+        producers: 8,
+        eventsPerSecond: 0,
+        spanWeight: 6,
+        logWeight: 3,
+        metadataWeight: 1,
+        sessionLength: 0,
+        attributesPerEvent: 8,
+        attributeValueLength: 64,
+        drainTimeout: 120
+    )
+
+    /// Short sessions, so most of the work is building and uploading session payloads.
+    static let sessionChurn = LoadProfile(
+        name: "session-churn",
+        duration: 30,
+        producers: 2,
+        eventsPerSecond: 500,
+        spanWeight: 4,
+        logWeight: 4,
+        metadataWeight: 2,
+        sessionLength: 1,
+        attributesPerEvent: 4,
+        attributeValueLength: 32,
+        drainTimeout: 60
+    )
+
+    static let presets: [LoadProfile] = [.smoke, .steady, .burst, .sessionChurn]
+
+    static func preset(named name: String) -> LoadProfile? {
+        presets.first { $0.name == name }
+    }
+
+    /// Profile selected through `EMBRACE_LOAD_PROFILE`, see `LoadProfile`.
+    static func fromEnvironment(
+        _ environment: [String: String] = ProcessInfo.processInfo.environment
+    ) throws -> LoadProfile {
+        guard let value = environment["EMBRACE_LOAD_PROFILE"]?.trimmingCharacters(in: .whitespacesAndNewlines),
+            !value.isEmpty
+        else {
+            return .smoke
+        }
+
+        if let preset = preset(named: value) {
+            return preset
+        }
+
+        // same keys as the profile in the reports
+        let decoder = JSONDecoder()
+        decoder.keyDecodingStrategy = .convertFromSnakeCase
+        return try decoder.decode(LoadProfile.self, from: Data(value.utf8))
+    }
+}
@@ -0,0 +1,122 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import EmbraceCommonInternal
+import Foundation
+
+/// Results of a load run, meant to be compared between releases.
+///
+/// Encoded as JSON with snake case keys and sorted fields, so reports can be diffed as text.
+/// Durations are in nanoseconds and sizes in bytes.
+struct LoadReport: Codable {
+
+    struct Latency: Codable, Equatable {
+        var count: Int
+        var meanNs: UInt64
+        var p50Ns: UInt64
+        var p99Ns: UInt64
+        var maxNs: UInt64
+
+        static let empty = Latency(count: 0, meanNs: 0, p50Ns: 0, p99Ns: 0, maxNs: 0)
+    }
+
+    struct Events: Codable {
+        var produced: Int
+
+        /// Only spans and logs are tracked to the collector, for the other kinds these are `nil`.
+        var delivered: Int?
+        var lost: Int?
+
+        /// Time the producing call blocked the caller.
+        var producerLatency: Latency
+
+        /// Time from production until the item reached the collector.
+        var deliveryDelay: Latency?
+    }
+
+    struct Throughput: Codable {
+        /// Events produced per second while producing.
+        var ingestPerSecond: Double
+
+        /// Spans and logs delivered per second, from the start of the run until the last one arrived.
+        var deliveredPerSecond: Double
+    }
+
+    struct Wire: Codable {
+        var requests: [String: Int]
+        var bytes: Int
+        var payloadBytes: Int
+        var compressionRatio: Double
+        var invalidPayloads: Int
+        var lastInvalidReason: String?
+        var duplicates: Int
+    }
+
+    struct Memory: Codable {
+        /// Physical footprint of the process before the run, and the highest one seen during it.
+        var baselineFootprintBytes: UInt64
+        var peakFootprintBytes: UInt64
+
+        /// Highest amount of bytes held by SDK producers, as tracked by `EmbraceMemoryBudget`.
+        var peakSdkTrackedBytes: Int
+        var maxBudgetLevel: String
+    }
+
+    var profile: LoadProfile
+    var sdkVersion: String
+    var startedAt: Date
+    var configApplied: Bool
+
+    var generationSeconds: Double
+    var drainSeconds: Double
+    var drained: Bool
+
+    var throughput: Throughput
+    var events: [String: Events]
+    var wire: Wire
+    var memory: Memory
+
+    func jsonData() throws -> Data {
+        let encoder = JSONEncoder()
+        encoder.keyEncodingStrategy = .convertToSnakeCase
+        encoder.dateEncodingStrategy = .iso8601
+        encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+        return try encoder.encode(self)
+    }
+}
+
+extension LoadReport.Latency {
+
+    init(_ snapshot: EmbraceLatencyHistogram.Snapshot) {
+        self.init(
+            count: Int(snapshot.count),
+            meanNs: snapshot.mean,
+            p50Ns: snapshot.value(atPercentile: 50),
+            p99Ns: snapshot.value(atPercentile: 99),
+            maxNs: snapshot.max
+        )
+    }
+
+    /// Exact percentiles, for values that were all kept.
+    init<S: Sequence>(values: S) where S.Element == UInt64 {
+        let sorted = values.sorted()
+        guard let max = sorted.last else {
+            self = .empty
+            return
+        }
+
+        func percentile(_ percentile: Double) -> UInt64 {
+            let rank = Int((percentile / 100 * Double(sorted.count)).rounded(.up))
+            return sorted[Swift.min(Swift.max(rank, 1), sorted.count) - 1]
+        }
+
+        self.init(
+            count: sorted.count,
+            meanNs: UInt64(sorted.reduce(0.0) { $0 + Double($1) } / Double(sorted.count)),
+            p50Ns: percentile(50),
+            p99Ns: percentile(99),
+            maxNs: max
+        )
+    }
+}
@@ -0,0 +1,83 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+#if !os(watchOS)
+
+    import EmbraceCommonInternal
+    import Foundation
+    import TestSupport
+    import XCTest
+
+    @testable import EmbraceCore
+
+    /// Runs the SDK against a `LoadCollector` with the profile from `EMBRACE_LOAD_PROFILE`.
+    ///
+    /// The report is attached to the test results, and also written to `EMBRACE_LOAD_REPORT` when it's set.
+    final class LoadTests: IntegrationTestCase {
+
+        override func tearDownWithError() throws {
+            try? Embrace.client?.stop()
+            try super.tearDownWithError()
+        }
+
+        @MainActor
+        func test_load() throws {
+            try XCTSkipIfSanitizing("Load runs measure the SDK without sanitizer instrumentation")
+
+            // given an SDK uploading to the collector
+            let profile = try LoadProfile.fromEnvironment()
+            let collector = try LoadCollector()
+            defer { collector.stop() }
+
+            let client = try Embrace.setup(
+                options: Embrace.Options(
+                    appId: "lOad5",
+                    endpoints: Embrace.Endpoints(baseURL: collector.baseURL, configBaseURL: collector.baseURL),
+                    captureServices: [],
+                    crashReporter: nil,
+                    logLevel: .none,
+                    backtracer: nil,
+                    symbolicator: nil
+                )
+            ).start()
+
+            // when running the profile
+            let result = EmbraceMutex<LoadReport?>(nil)
+            let done = expectation(description: "load run")
+            DispatchQueue.global(qos: .userInitiated).async {
+                let report = LoadGenerator(profile: profile, collector: collector).run(client: client)
+                result.withLock { $0 = report }
+                done.fulfill()
+            }
+            wait(for: [done], timeout: profile.duration + profile.drainTimeout + 30)
+
+            let report = try XCTUnwrap(result.safeValue)
+            try publish(report)
+
+            // then every payload was valid and everything made it through
+            XCTAssertEqual(report.wire.invalidPayloads, 0, report.wire.lastInvalidReason ?? "")
+            XCTAssertTrue(report.drained, "Not everything was delivered within \(profile.drainTimeout) seconds")
+            for kind in [LoadEventKind.span, .log] {
+                let events = try XCTUnwrap(report.events[kind.rawValue])
+                XCTAssertGreaterThan(events.delivered ?? 0, 0, kind.rawValue)
+                XCTAssertEqual(events.lost, 0, kind.rawValue)
+            }
+            XCTAssertGreaterThan(report.wire.bytes, 0)
+        }
+
+        private func publish(_ report: LoadReport) throws {
+            let data = try report.jsonData()
+
+            let attachment = XCTAttachment(data: data, uniformTypeIdentifier: "public.json")
+            attachment.name = "load-report-\(report.profile.name).json"
+            attachment.lifetime = .keepAlways
+            add(attachment)
+
+            if let path = ProcessInfo.processInfo.environment["EMBRACE_LOAD_REPORT"], !path.isEmpty {
+                try data.write(to: URL(fileURLWithPath: path), options: .atomic)
+            }
+        }
+    }
+
+#endif
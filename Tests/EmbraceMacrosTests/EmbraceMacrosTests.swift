@@ -4,8 +4,11 @@
 
 #if canImport(EmbraceMacroPlugin)
     import EmbraceIO
+    import SwiftDiagnostics
+    import SwiftParser
     import SwiftSyntax
     import SwiftSyntaxBuilder
+    import SwiftSyntaxMacroExpansion
     import SwiftSyntaxMacros
     import SwiftSyntaxMacrosTestSupport
     import XCTest
@@ -13,7 +16,7 @@
     import EmbraceMacroPlugin
 
     let macros: [String: Macro.Type] = [
-        "embraceTrace": EmbraceTraceMacro.self
+        "EmbraceTrace": EmbraceTraceMacro.self
     ]
 
     final class EmbraceTraceMacroTests: XCTestCase {
@@ -96,5 +99,118 @@
             )
             */
         }
+
+        // The generated members are formatted differently by each supported swift-syntax version,
+        // so the aggregated cases check what's generated instead of the whole expanded source.
+
+        func test_aggregated_addsSharedAggregate() throws {
+            // when expanding an aggregated view
+            let (members, diagnostics) = try expand(
+                """
+                @EmbraceTrace(aggregated: true)
+                struct Row: View {
+                    var body: some View {
+                        Text("row")
+                    }
+                }
+                """
+            )
+
+            // then it declares a shared aggregate and passes it to the trace view
+            XCTAssertTrue(diagnostics.isEmpty)
+            XCTAssertTrue(members.contains(#"private static let _embraceTraceAggregate = EmbraceTraceViewAggregate("Row")"#))
+            XCTAssertTrue(members.contains(#"EmbraceTraceView("Row", aggregate: Self._embraceTraceAggregate)"#))
+        }
+
+        func test_notAggregated_hasNoAggregate() throws {
+            // when expanding a view that isn't aggregated, explicitly or by default
+            for attribute in ["@EmbraceTrace(aggregated: false)", "@EmbraceTrace"] {
+                let (members, diagnostics) = try expand(
+                    """
+                    \(attribute)
+                    struct Row: View {
+                        var body: some View {
+                            Text("row")
+                        }
+                    }
+                    """
+                )
+
+                // then each body evaluation gets its own span
+                XCTAssertTrue(diagnostics.isEmpty, attribute)
+                XCTAssertFalse(members.contains("_embraceTraceAggregate"), attribute)
+                XCTAssertTrue(members.contains(#"EmbraceTraceView("Row")"#), attribute)
+            }
+        }
+
+        func test_aggregated_genericView_warnsAndFallsBack() throws {
+            // when expanding an aggregated generic view
+            let (members, diagnostics) = try expand(
+                """
+                @EmbraceTrace(aggregated: true)
+                struct Row<Content: View>: View {
+                    let content: Content
+                    var body: some View {
+                        content
+                    }
+                }
+                """
+            )
+
+            // then it warns and isn't aggregated
+            XCTAssertEqual(diagnostics.count, 1)
+            XCTAssertEqual(diagnostics.first?.diagMessage.severity, .warning)
+            XCTAssertEqual(
+                diagnostics.first?.message,
+                "Generic views can't be aggregated, a span is created for each body evaluation instead"
+            )
+            XCTAssertFalse(members.contains("_embraceTraceAggregate"))
+            XCTAssertTrue(members.contains(#"EmbraceTraceView("Row")"#))
+        }
+
+        func test_aggregated_nonLiteral_isAnError() {
+            assertMacroExpansion(
+                """
+                @EmbraceTrace(aggregated: isAggregated)
+                struct Row: View {
+                    var body: some View {
+                        Text("row")
+                    }
+                }
+                """,
+                expandedSource: """
+                    struct Row: View {
+                        var body: some View {
+                            Text("row")
+                        }
+                    }
+                    """,
+                diagnostics: [
+                    DiagnosticSpec(
+                        message: "`aggregated` must be a `true` or `false` literal to use EmbraceTrace",
+                        line: 1,
+                        column: 27,
+                        severity: .error
+                    )
+                ],
+                macros: macros
+            )
+        }
+
+        /// Expands the macro on the first declaration in `source`.
+        private func expand(_ source: String) throws -> (members: String, diagnostics: [Diagnostic]) {
+            let file = Parser.parse(source: source)
+            let declaration = try XCTUnwrap(file.statements.first?.item.as(StructDeclSyntax.self))
+            let attribute = try XCTUnwrap(declaration.attributes.first?.as(AttributeSyntax.self))
+
+            let context = BasicMacroExpansionContext()
+            let members = try EmbraceTraceMacro.expansion(
+                of: attribute,
+                providingMembersOf: declaration,
+                conformingTo: [],
+                in: context
+            )
+            return (members.map(\.description).joined(separator: "\n"), context.diagnostics)
+        }
     }
 #endif
@@ -0,0 +1,158 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+import XCTest
+
+@testable import EmbraceSQLiteInternal
+
+class SQLiteConnectionTests: XCTestCase {
+
+    var fileURL: URL!
+
+    override func setUpWithError() throws {
+        fileURL = URL(fileURLWithPath: NSTemporaryDirectory())
+            .appendingPathComponent("SQLiteConnectionTests")
+            .appendingPathComponent(UUID().uuidString + ".db")
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: fileURL.deletingLastPathComponent())
+    }
+
+    func test_fileDatabase_usesWAL() throws {
+        // given a connection to a file database
+        let connection = try SQLiteConnection(location: .file(fileURL))
+
+        // then write-ahead logging is enabled
+        XCTAssertEqual(connection.journalMode.lowercased(), "wal")
+        XCTAssertTrue(FileManager.default.fileExists(atPath: fileURL.path))
+    }
+
+    func test_fileDatabase_withoutWAL() throws {
+        // given a connection with WAL disabled
+        let connection = try SQLiteConnection(location: .file(fileURL), walEnabled: false)
+
+        // then the default rollback journal is used
+        XCTAssertEqual(connection.journalMode.lowercased(), "delete")
+    }
+
+    func test_statements_areCachedAndReusable() throws {
+        // given a connection
+        let connection = try SQLiteConnection(location: .inMemory)
+        try connection.execute("CREATE TABLE t (value INTEGER);")
+
+        // when running the same statement several times
+        try connection.withLock {
+            for i in 0..<10 {
+                try connection.statement("INSERT INTO t (value) VALUES (?)").run([.integer(Int64(i))])
+            }
+        }
+
+        // then it is prepared only once
+        XCTAssertEqual(connection.cachedStatementCount, 1)
+
+        let sum = try connection.withLock {
+            try connection.statement("SELECT SUM(value) FROM t").first { $0.int(0) }
+        }
+        XCTAssertEqual(sum, 45)
+        XCTAssertEqual(connection.cachedStatementCount, 2)
+    }
+
+    func test_statementCache_isBounded() throws {
+        // given a connection with a small statement cache
+        let connection = try SQLiteConnection(location: .inMemory)
+        connection.statementCacheLimit = 4
+
+        // when preparing more distinct statements than the limit
+        try connection.withLock {
+            for i in 0..<10 {
+                _ = try connection.statement("SELECT \(i)")
+            }
+        }
+
+        // then the cache doesn't grow past it
+        XCTAssertLessThanOrEqual(connection.cachedStatementCount, 4)
+    }
+
+    func test_transaction_rollsBackOnError() throws {
+        // given a connection
+        let connection = try SQLiteConnection(location: .inMemory)
+        try connection.execute("CREATE TABLE t (value INTEGER);")
+
+        // when a transaction throws halfway
+        struct Failure: Error {}
+        XCTAssertThrowsError(
+            try connection.transaction {
+                try connection.statement("INSERT INTO t (value) VALUES (1)").run()
+                throw Failure()
+            }
+        )
+
+        // then nothing is written
+        let count = try connection.withLock {
+            try connection.statement("SELECT COUNT(*) FROM t").first { $0.int(0) }
+        }
+        XCTAssertEqual(count, 0)
+    }
+
+    func test_nestedTransactions_joinTheOuterOne() throws {
+        // given a connection
+        let connection = try SQLiteConnection(location: .inMemory)
+        try connection.execute("CREATE TABLE t (value INTEGER);")
+
+        // when nesting transactions
+        try connection.transaction {
+            try connection.statement("INSERT INTO t (value) VALUES (1)").run()
+            try connection.transaction {
+                try connection.statement("INSERT INTO t (value) VALUES (2)").run()
+            }
+        }
+
+        // then both writes are committed
+        let count = try connection.withLock {
+            try connection.statement("SELECT COUNT(*) FROM t").first { $0.int(0) }
+        }
+        XCTAssertEqual(count, 2)
+    }
+
+    func test_invalidSQL_throws() throws {
+        let connection = try SQLiteConnection(location: .inMemory)
+
+        XCTAssertThrowsError(try connection.withLock { try connection.statement("SELECT FROM nowhere") }) { error in
+            guard case .cannotPrepare = error as? SQLiteError else {
+                return XCTFail("unexpected error \(error)")
+            }
+        }
+    }
+
+    func test_values_roundTrip() throws {
+        // given a table with every storage class
+        let connection = try SQLiteConnection(location: .inMemory)
+        try connection.execute("CREATE TABLE t (i INTEGER, r REAL, s TEXT, b BLOB, n TEXT, e BLOB);")
+
+        let date = Date(timeIntervalSinceReferenceDate: 123_456.789_012)
+        let blob = Data([0x00, 0x01, 0xFF])
+
+        // when writing and reading them back
+        try connection.withLock {
+            try connection.statement("INSERT INTO t VALUES (?, ?, ?, ?, ?, ?)").run([
+                .integer(.max), SQLiteValue(date), .text("héllo ✨"), .blob(blob), .null, .blob(Data())
+            ])
+        }
+
+        try connection.withLock {
+            try connection.statement("SELECT i, r, s, b, n, e FROM t").forEachRow { row in
+                // then every value is preserved
+                XCTAssertEqual(row.int64(0), .max)
+                XCTAssertEqual(row.date(1), date)
+                XCTAssertEqual(row.string(2), "héllo ✨")
+                XCTAssertEqual(row.data(3), blob)
+                XCTAssertNil(row.optionalString(4))
+                XCTAssertEqual(row.data(5), Data())
+                return true
+            }
+        }
+    }
+}
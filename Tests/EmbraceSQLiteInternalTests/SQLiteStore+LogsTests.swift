@@ -0,0 +1,65 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+import XCTest
+
+@testable import EmbraceSQLiteInternal
+
+class SQLiteStoreLogsTests: XCTestCase {
+
+    var store: SQLiteStore!
+    let start = Date(timeIntervalSinceReferenceDate: 1_000)
+
+    override func setUpWithError() throws {
+        store = try SQLiteStore(location: .inMemory)
+    }
+
+    func log(_ id: String, process: String = "process", at offset: TimeInterval = 0) -> SQLiteLogRow {
+        return SQLiteLogRow(
+            id: id,
+            processId: process,
+            sessionId: "session",
+            severity: 9,
+            body: "body \(id)",
+            timestamp: start.addingTimeInterval(offset),
+            attributes: [SQLiteLogRow.Attribute(key: "key", value: "42", type: 1)]
+        )
+    }
+
+    func test_insertLogs_inBulk() throws {
+        let rows = (0..<2_000).map { log("\($0)", at: TimeInterval($0)) }
+        try store.insertLogs(rows)
+
+        XCTAssertEqual(try store.logCount(), 2_000)
+    }
+
+    func test_insertLogs_ignoresDuplicates() throws {
+        try store.insertLogs([log("a"), log("a"), log("a", process: "other")])
+        XCTAssertEqual(try store.logCount(), 2)
+    }
+
+    func test_forEachLog_excludesProcessAndKeepsOrder() throws {
+        try store.insertLogs([log("b", process: "old", at: 2), log("a", process: "old", at: 1), log("c", process: "current")])
+
+        var logs: [SQLiteLogRow] = []
+        try store.forEachLog(excludingProcessId: "current") {
+            logs.append($0)
+            return true
+        }
+
+        XCTAssertEqual(logs.map(\.id), ["a", "b"])
+        XCTAssertEqual(logs.first, log("a", process: "old", at: 1))
+    }
+
+    func test_deleteLogs() throws {
+        try store.insertLogs([log("a"), log("b"), log("c")])
+
+        XCTAssertEqual(try store.deleteLogs([(id: "a", processId: "process"), (id: "b", processId: "other")]), 1)
+        XCTAssertEqual(try store.logCount(), 2)
+
+        XCTAssertEqual(try store.deleteAllLogs(), 2)
+        XCTAssertEqual(try store.logCount(), 0)
+    }
+}
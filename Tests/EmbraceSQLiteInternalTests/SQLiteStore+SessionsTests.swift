@@ -0,0 +1,101 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+import XCTest
+
+@testable import EmbraceSQLiteInternal
+
+class SQLiteStoreSessionsTests: XCTestCase {
+
+    var store: SQLiteStore!
+    let start = Date(timeIntervalSinceReferenceDate: 1_000)
+
+    override func setUpWithError() throws {
+        store = try SQLiteStore(location: .inMemory)
+    }
+
+    func session(_ id: String, start offset: TimeInterval = 0) -> SQLiteSessionRow {
+        return SQLiteSessionRow(
+            id: id,
+            processId: "process",
+            state: "foreground",
+            traceId: "trace-\(id)",
+            spanId: "span-\(id)",
+            startTime: start.addingTimeInterval(offset),
+            lastHeartbeatTime: start.addingTimeInterval(offset),
+            coldStart: true,
+            sessionNumber: 7
+        )
+    }
+
+    func test_insertAndFetch() throws {
+        let row = session("a")
+        try store.insertSession(row)
+
+        XCTAssertEqual(try store.session(id: "a"), row)
+        XCTAssertNil(try store.session(id: "missing"))
+    }
+
+    func test_insert_existingSessionIsKept() throws {
+        let row = session("a")
+        try store.insertSession(row)
+
+        var duplicate = session("a")
+        duplicate.state = "background"
+        try store.insertSession(duplicate)
+
+        XCTAssertEqual(try store.session(id: "a"), row)
+    }
+
+    func test_latestAndOldest() throws {
+        try store.insertSession(session("old", start: 0))
+        try store.insertSession(session("mid", start: 10))
+        try store.insertSession(session("new", start: 20))
+
+        XCTAssertEqual(try store.latestSession()?.id, "new")
+        XCTAssertEqual(try store.latestSession(excludingId: "new")?.id, "mid")
+        XCTAssertEqual(try store.oldestSession()?.id, "old")
+        XCTAssertEqual(try store.oldestSession(excludingId: "old")?.id, "mid")
+    }
+
+    func test_update_onlyChangesGivenFields() throws {
+        // given a stored session
+        try store.insertSession(session("a"))
+
+        // when updating some fields
+        let updated = try store.updateSession(
+            id: "a",
+            state: "background",
+            lastHeartbeatTime: start.addingTimeInterval(30),
+            cleanExit: true
+        )
+
+        // then only those change
+        XCTAssertTrue(updated)
+        let row = try XCTUnwrap(try store.session(id: "a"))
+        XCTAssertEqual(row.state, "background")
+        XCTAssertEqual(row.lastHeartbeatTime, start.addingTimeInterval(30))
+        XCTAssertTrue(row.cleanExit)
+        XCTAssertFalse(row.appTerminated)
+        XCTAssertNil(row.endTime)
+        XCTAssertNil(row.crashReportId)
+
+        XCTAssertFalse(try store.updateSession(id: "missing", state: "background"))
+    }
+
+    func test_forEachAndDelete() throws {
+        for i in 0..<5 {
+            try store.insertSession(session("\(i)", start: TimeInterval(i)))
+        }
+        XCTAssertTrue(try store.deleteSession(id: "2"))
+
+        var ids: Set<String> = []
+        try store.forEachSession {
+            ids.insert($0.id)
+            return true
+        }
+        XCTAssertEqual(ids, ["0", "1", "3", "4"])
+    }
+}
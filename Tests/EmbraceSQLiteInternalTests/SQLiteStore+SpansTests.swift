@@ -0,0 +1,230 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+import XCTest
+
+@testable import EmbraceSQLiteInternal
+
+class SQLiteStoreSpansTests: XCTestCase {
+
+    var store: SQLiteStore!
+    let start = Date(timeIntervalSinceReferenceDate: 1_000)
+
+    override func setUpWithError() throws {
+        store = try SQLiteStore(location: .inMemory)
+    }
+
+    func span(_ id: String, trace: String = "trace", type: String = "perf", start offset: TimeInterval = 0, ended: Bool = false) -> SQLiteSpanRow {
+        return SQLiteSpanRow(
+            id: id,
+            traceId: trace,
+            name: "span-\(id)",
+            type: type,
+            data: Data(id.utf8),
+            startTime: start.addingTimeInterval(offset),
+            endTime: ended ? start.addingTimeInterval(offset + 1) : nil,
+            processId: "process"
+        )
+    }
+
+    func test_upsert_insertsManyRowsAcrossStatements() throws {
+        // given more spans than fit in a single statement
+        let rows = (0..<1_000).map { span("\($0)", start: TimeInterval($0)) }
+
+        // when upserting them at once
+        try store.upsertSpans(rows)
+
+        // then they are all stored
+        XCTAssertEqual(try store.spanCount(typePrefix: "perf"), 1_000)
+        XCTAssertEqual(try store.span(id: "999", traceId: "trace"), rows[999])
+    }
+
+    func test_upsert_updatesOpenSpans() throws {
+        // given an open span
+        try store.upsertSpans([span("a")])
+
+        // when upserting it again with new values
+        var updated = span("a", type: "perf.ux", ended: true)
+        updated.name = "renamed"
+        try store.upsertSpans([updated])
+
+        // then the stored span is updated
+        XCTAssertEqual(try store.span(id: "a", traceId: "trace"), updated)
+        XCTAssertEqual(try store.spanCount(typePrefix: "perf"), 1)
+    }
+
+    func test_upsert_ignoresClosedSpans() throws {
+        // given a closed span
+        let closed = span("a", ended: true)
+        try store.upsertSpans([closed])
+
+        // when upserting it again
+        var updated = span("a")
+        updated.name = "renamed"
+        try store.upsertSpans([updated])
+
+        // then it is not modified
+        XCTAssertEqual(try store.span(id: "a", traceId: "trace"), closed)
+    }
+
+    func test_upsertSpan_reportsWhatItDid() throws {
+        // given a new span
+        var row = span("a")
+
+        // then upserting it inserts, updates while open and ignores once closed
+        XCTAssertEqual(try store.upsertSpan(row), .inserted)
+
+        row.name = "renamed"
+        row.endTime = start.addingTimeInterval(1)
+        XCTAssertEqual(try store.upsertSpan(row), .updated)
+
+        row.name = "ignored"
+        XCTAssertEqual(try store.upsertSpan(row), .ignored)
+        XCTAssertEqual(try store.span(id: "a", traceId: "trace")?.name, "renamed")
+    }
+
+    func test_endSpan_onlyClosesOpenSpans() throws {
+        try store.upsertSpans([span("a"), span("b", ended: true)])
+
+        XCTAssertTrue(try store.endSpan(id: "a", traceId: "trace", endTime: start.addingTimeInterval(5)))
+        XCTAssertFalse(try store.endSpan(id: "b", traceId: "trace", endTime: start.addingTimeInterval(5)))
+
+        XCTAssertEqual(try store.span(id: "a", traceId: "trace")?.endTime, start.addingTimeInterval(5))
+        XCTAssertEqual(try store.span(id: "b", traceId: "trace")?.endTime, start.addingTimeInterval(1))
+    }
+
+    func test_spanCount_matchesTypePrefix() throws {
+        try store.upsertSpans([
+            span("a", type: "perf"),
+            span("b", type: "perf.ux"),
+            span("c", type: "perfx"),
+            span("d", type: "sys")
+        ])
+
+        XCTAssertEqual(try store.spanCount(typePrefix: "perf"), 3)
+        XCTAssertEqual(try store.spanCount(typePrefix: "perf."), 1)
+        XCTAssertEqual(try store.spanCount(typePrefix: "sys"), 1)
+        XCTAssertEqual(try store.spanCount(typePrefix: ""), 4)
+    }
+
+    func test_trimSpans_deletesOldestAndKeepsGivenSpan() throws {
+        // given 5 spans where the one being kept is the oldest
+        try store.upsertSpans((0..<5).map { span("\($0)", start: TimeInterval($0)) })
+
+        // when trimming to 3
+        let deleted = try store.trimSpans(typePrefix: "perf", limit: 3, keeping: (id: "0", traceId: "trace"))
+
+        // then the oldest other spans are removed
+        XCTAssertEqual(deleted, 2)
+        XCTAssertNotNil(try store.span(id: "0", traceId: "trace"))
+        XCTAssertNil(try store.span(id: "1", traceId: "trace"))
+        XCTAssertNil(try store.span(id: "2", traceId: "trace"))
+        XCTAssertNotNil(try store.span(id: "3", traceId: "trace"))
+    }
+
+    func test_closeOpenSpans_skipsCurrentProcess() throws {
+        var current = span("a")
+        current.processId = "current"
+        try store.upsertSpans([current, span("b")])
+
+        XCTAssertEqual(try store.closeOpenSpans(excludingProcessId: "current", endTime: start), 1)
+        XCTAssertNil(try store.span(id: "a", traceId: "trace")?.endTime)
+        XCTAssertEqual(try store.span(id: "b", traceId: "trace")?.endTime, start)
+    }
+
+    func test_deleteClosedSpans() throws {
+        try store.upsertSpans([span("a", start: 0, ended: true), span("b", start: 10, ended: true), span("c")])
+
+        XCTAssertEqual(try store.deleteClosedSpans(endedBefore: start.addingTimeInterval(5)), 1)
+        XCTAssertEqual(try store.deleteClosedSpans(excludingProcessId: "other"), 1)
+        XCTAssertEqual(try store.spanCount(typePrefix: ""), 1)
+    }
+
+    func test_events_areStoredAndDeletedWithTheirSpan() throws {
+        // given a span with events
+        try store.upsertSpans([span("a", ended: true)])
+        try store.addSpanEvents(
+            [
+                SQLiteSpanEventRow(name: "second", timestamp: start.addingTimeInterval(2), attributes: ["k": "v"]),
+                SQLiteSpanEventRow(name: "first", timestamp: start.addingTimeInterval(1), attributes: [:])
+            ],
+            spanId: "a",
+            traceId: "trace"
+        )
+
+        // then they are returned in order
+        XCTAssertEqual(try store.spanEvents(spanId: "a", traceId: "trace").map(\.name), ["first", "second"])
+        XCTAssertEqual(try store.spanEvents(spanId: "a", traceId: "trace").last?.attributes, ["k": "v"])
+
+        // when the span is deleted
+        try store.deleteClosedSpans(excludingProcessId: "other")
+
+        // then its events are gone too
+        XCTAssertTrue(try store.spanEvents(spanId: "a", traceId: "trace").isEmpty)
+    }
+
+    func test_addEvents_toMissingSpan_isIgnored() throws {
+        try store.addSpanEvents(
+            [SQLiteSpanEventRow(name: "event", timestamp: start, attributes: [:])],
+            spanId: "missing",
+            traceId: "trace"
+        )
+        XCTAssertTrue(try store.spanEvents(spanId: "missing", traceId: "trace").isEmpty)
+    }
+
+    func test_forEachSpan_overlappingSession() throws {
+        // given spans around a session from 10 to 20
+        var tagged = span("tagged", start: 100)
+        tagged.sessionId = "session"
+        try store.upsertSpans([
+            span("before-ended", start: 0, ended: true),  // ends at 1
+            span("before-open", start: 5),
+            span("inside", start: 15),
+            span("after", start: 25),
+            span("session-span", type: "ux.session", start: 10),
+            tagged
+        ])
+
+        // when streaming the session's spans
+        var ids: [String] = []
+        try store.forEachSpan(
+            in: .overlapping(sessionId: "session", startTime: start.addingTimeInterval(10), endTime: start.addingTimeInterval(20)),
+            excludingType: "ux.session",
+            limit: 100
+        ) {
+            ids.append($0.id)
+            return true
+        }
+
+        // then only overlapping or tagged spans are returned
+        XCTAssertEqual(Set(ids), ["before-open", "inside", "tagged"])
+    }
+
+    func test_forEachSpan_coldStartUsesProcess() throws {
+        var other = span("other", start: 0)
+        other.processId = "other"
+        try store.upsertSpans([span("early", start: -100), span("late", start: 100), other])
+
+        var ids: [String] = []
+        try store.forEachSpan(in: .process(processId: "process", endTime: start), limit: 100) {
+            ids.append($0.id)
+            return true
+        }
+
+        XCTAssertEqual(ids, ["early"])
+    }
+
+    func test_forEachSpan_streamsAndStopsEarly() throws {
+        try store.upsertSpans((0..<50).map { span("\($0)", start: TimeInterval($0)) })
+
+        var visited = 0
+        try store.forEachSpan(in: .process(processId: "process", endTime: start.addingTimeInterval(100)), limit: 100) { _ in
+            visited += 1
+            return visited < 10
+        }
+
+        XCTAssertEqual(visited, 10)
+    }
+}
@@ -0,0 +1,80 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+import XCTest
+
+@testable import EmbraceSQLiteInternal
+
+class SQLiteStoreUploadDataTests: XCTestCase {
+
+    var store: SQLiteStore!
+    let start = Date(timeIntervalSinceReferenceDate: 1_000)
+
+    override func setUpWithError() throws {
+        store = try SQLiteStore(location: .inMemory)
+    }
+
+    func row(_ id: String, type: Int = 0, at offset: TimeInterval = 0) -> SQLiteUploadDataRow {
+        return SQLiteUploadDataRow(id: id, type: type, data: Data(id.utf8), payloadTypes: "spans", date: start.addingTimeInterval(offset))
+    }
+
+    func test_save_updatesExistingEntryAndKeepsDate() throws {
+        try store.saveUploadData(row("a"))
+
+        var updated = row("a", at: 100)
+        updated.data = Data("new".utf8)
+        updated.payloadTypes = nil
+        try store.saveUploadData(updated)
+
+        let stored = try XCTUnwrap(try store.uploadData(id: "a", type: 0))
+        XCTAssertEqual(stored.data, Data("new".utf8))
+        XCTAssertNil(stored.payloadTypes)
+        XCTAssertEqual(stored.date, start)
+        XCTAssertEqual(try store.uploadDataCount(), 1)
+    }
+
+    func test_save_evictsOldestWhenReachingTheLimit() throws {
+        // given a full cache
+        for i in 0..<20 {
+            try store.saveUploadData(row("\(i)", at: TimeInterval(i)), countLimit: 20, evictionSlack: 5)
+        }
+        XCTAssertEqual(try store.uploadDataCount(), 20)
+
+        // when saving a new entry
+        try store.saveUploadData(row("new", at: 100), countLimit: 20, evictionSlack: 5)
+
+        // then the oldest entries make room for it
+        XCTAssertEqual(try store.uploadDataCount(), 16)
+        XCTAssertNil(try store.uploadData(id: "4", type: 0))
+        XCTAssertNotNil(try store.uploadData(id: "5", type: 0))
+        XCTAssertNotNil(try store.uploadData(id: "new", type: 0))
+    }
+
+    func test_forEach_filtersByTypeExclusionsAndLimit() throws {
+        for i in 0..<10 {
+            try store.saveUploadData(row("\(i)", type: i % 2, at: TimeInterval(i)))
+        }
+
+        var ids: [String] = []
+        try store.forEachUploadData(type: 0, excludingIds: ["0", "4"], limit: 2) {
+            ids.append($0.id)
+            return true
+        }
+
+        XCTAssertEqual(ids, ["2", "6"])
+    }
+
+    func test_deleteOlderThan() throws {
+        for i in 0..<10 {
+            try store.saveUploadData(row("\(i)", at: TimeInterval(i)))
+        }
+
+        XCTAssertEqual(try store.uploadDataCount(olderThan: start.addingTimeInterval(4)), 4)
+        XCTAssertEqual(try store.deleteUploadData(olderThan: start.addingTimeInterval(4)), 4)
+        XCTAssertEqual(try store.uploadDataCount(), 6)
+        XCTAssertTrue(try store.deleteUploadData(id: "9", type: 0))
+        XCTAssertFalse(try store.deleteUploadData(id: "9", type: 0))
+    }
+}
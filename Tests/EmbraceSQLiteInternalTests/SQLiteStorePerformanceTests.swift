@@ -0,0 +1,112 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import Foundation
+import XCTest
+
+@testable import EmbraceSQLiteInternal
+
+/// Storage baseline that runs on any platform with SQLite (including Linux CI), against an on-disk
+/// WAL database so fsync and page cache behavior are part of the numbers.
+class SQLiteStorePerformanceTests: XCTestCase {
+
+    var directory: URL!
+
+    override func setUpWithError() throws {
+        directory = URL(fileURLWithPath: NSTemporaryDirectory())
+            .appendingPathComponent("SQLiteStorePerformanceTests-\(UUID().uuidString)")
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    func makeStore() throws -> SQLiteStore {
+        return try SQLiteStore(location: .file(directory.appendingPathComponent(UUID().uuidString + ".db")))
+    }
+
+    /// 10k logs written in one bulk call, then streamed back.
+    func test_logs_bulkInsertAndStream() throws {
+        let logs = (0..<10_000).map {
+            SQLiteLogRow(
+                id: "\($0)",
+                processId: "old",
+                sessionId: "session",
+                severity: 9,
+                body: String(repeating: "x", count: 128),
+                timestamp: Date(timeIntervalSinceReferenceDate: TimeInterval($0)),
+                attributes: [SQLiteLogRow.Attribute(key: "emb.type", value: "sys.log", type: 0)]
+            )
+        }
+
+        measure {
+            do {
+                let store = try makeStore()
+                try store.insertLogs(logs)
+
+                var count = 0
+                try store.forEachLog(excludingProcessId: "current") { _ in
+                    count += 1
+                    return true
+                }
+                XCTAssertEqual(count, logs.count)
+            } catch {
+                XCTFail("\(error)")
+            }
+        }
+    }
+
+    /// 500 open spans updated 10 times each, one upsert per update, then closed.
+    func test_spans_frequentUpdates() throws {
+        let spanCount = 500
+        let updatesPerSpan = 10
+        let start = Date()
+
+        measure {
+            do {
+                let store = try makeStore()
+                for update in 0...updatesPerSpan {
+                    for i in 0..<spanCount {
+                        try store.upsertSpans([
+                            SQLiteSpanRow(
+                                id: "\(i)",
+                                traceId: "trace",
+                                name: "span-\(update)",
+                                type: "perf",
+                                data: Data(count: 64),
+                                startTime: start,
+                                endTime: update == updatesPerSpan ? start.addingTimeInterval(1) : nil,
+                                processId: "process"
+                            )
+                        ])
+                    }
+                }
+                XCTAssertEqual(try store.spanCount(typePrefix: "perf"), spanCount)
+            } catch {
+                XCTFail("\(error)")
+            }
+        }
+    }
+
+    /// Expiring 5k cached payloads of 4 KB each.
+    func test_uploadData_expiry() throws {
+        let payload = Data(count: 4_096)
+
+        measure {
+            do {
+                let store = try makeStore()
+                try store.connection.transaction {
+                    for i in 0..<5_000 {
+                        try store.saveUploadData(
+                            SQLiteUploadDataRow(id: "\(i)", type: 0, data: payload, date: Date(timeIntervalSinceReferenceDate: TimeInterval(i)))
+                        )
+                    }
+                }
+                XCTAssertEqual(try store.deleteUploadData(olderThan: Date(timeIntervalSinceReferenceDate: 5_000)), 5_000)
+            } catch {
+                XCTFail("\(error)")
+            }
+        }
+    }
+}
@@ -0,0 +1,150 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import EmbraceCommonInternal
+import EmbraceSemantics
+import OpenTelemetryApi
+import TestSupport
+import XCTest
+
+@testable import EmbraceStorageInternal
+
+/// Exercises the public storage API with `StorageEngine.sqlite`.
+class EmbraceStorageSQLiteTests: XCTestCase {
+    var storage: EmbraceStorage!
+
+    override func setUpWithError() throws {
+        storage = try EmbraceStorage.createInMemoryDb(engine: .sqlite)
+    }
+
+    override func tearDownWithError() throws {
+        storage.coreData.destroy()
+    }
+
+    func test_engine_isSelectedThroughOptions() throws {
+        XCTAssertNotNil(storage.sqlite)
+        XCTAssertNil(try EmbraceStorage.createInMemoryDb().sqlite)
+    }
+
+    func test_spans_upsertUpdateAndEnd() throws {
+        let start = Date()
+
+        // given an open span
+        storage.upsertSpan(id: "id", name: "a", traceId: "trace", type: .performance, data: Data(), startTime: start)
+
+        // when updating and ending it
+        storage.upsertSpan(id: "id", name: "b", traceId: "trace", type: .performance, data: Data(), startTime: start)
+        storage.addEventsToSpan(
+            id: "id",
+            traceId: "trace",
+            events: [ImmutableSpanEventRecord(name: "event", timestamp: start, attributes: ["k": "v"])]
+        )
+        storage.endSpan(id: "id", traceId: "trace", endTime: start.addingTimeInterval(1))
+
+        // then the stored span reflects every change
+        let span = try XCTUnwrap(storage.fetchSpan(id: "id", traceId: "trace"))
+        XCTAssertEqual(span.name, "b")
+        XCTAssertEqual(span.endTime, start.addingTimeInterval(1))
+        XCTAssertEqual(span.events.first?.attributes, ["k": "v"])
+
+        // and closed spans are not modified anymore
+        storage.upsertSpan(id: "id", name: "c", traceId: "trace", type: .performance, data: Data(), startTime: start)
+        XCTAssertEqual(storage.fetchSpan(id: "id", traceId: "trace")?.name, "b")
+    }
+
+    func test_spans_typeLimit() throws {
+        // given a limit of 3 spans
+        storage.options.spanLimits[.performance] = 3
+
+        // when inserting 5 spans
+        for i in 0..<5 {
+            storage.upsertSpan(
+                id: "\(i)", name: "span", traceId: "trace", type: .performance, data: Data(),
+                startTime: Date(timeIntervalSince1970: TimeInterval(i)))
+        }
+
+        // then only the newest 3 remain
+        XCTAssertNil(storage.fetchSpan(id: "1", traceId: "trace"))
+        XCTAssertNotNil(storage.fetchSpan(id: "2", traceId: "trace"))
+        XCTAssertNotNil(storage.fetchSpan(id: "4", traceId: "trace"))
+        XCTAssertEqual(try storage.sqlite?.spanCount(typePrefix: SpanType.performance.rawValue), 3)
+    }
+
+    func test_spans_upsertReturnsStoredSpan() throws {
+        let start = Date()
+
+        // given a full span type
+        storage.options.spanLimits[.performance] = 2
+        storage.upsertSpan(id: "a", name: "a", traceId: "trace", type: .performance, data: Data(), startTime: start)
+        storage.upsertSpan(id: "b", name: "b", traceId: "trace", type: .performance, data: Data(), startTime: start)
+
+        // when updating a span after lowering the limit
+        storage.options.spanLimits[.performance] = 1
+        let updated = storage.upsertSpan(
+            id: "b", name: "b2", traceId: "trace", type: .performance, data: Data(), startTime: start, endTime: start)
+
+        // then the written span is returned and nothing is trimmed
+        XCTAssertEqual(updated?.name, "b2")
+        XCTAssertEqual(updated?.endTime, start)
+        XCTAssertNotNil(storage.fetchSpan(id: "a", traceId: "trace"))
+
+        // and upserting a closed span returns the stored one
+        let ignored = storage.upsertSpan(id: "b", name: "b3", traceId: "trace", type: .performance, data: Data(), startTime: start)
+        XCTAssertEqual(ignored?.name, "b2")
+    }
+
+    func test_sessions() throws {
+        let start = Date()
+
+        // given two sessions
+        storage.addSession(
+            id: TestConstants.sessionId, processId: ProcessIdentifier.current, state: .foreground,
+            traceId: "trace", spanId: "span", startTime: start)
+        storage.addSession(
+            id: EmbraceIdentifier.random, processId: ProcessIdentifier.current, state: .foreground,
+            traceId: "trace", spanId: "span", startTime: start.addingTimeInterval(-10))
+
+        // when updating one
+        let session = try XCTUnwrap(storage.fetchSession(id: TestConstants.sessionId))
+        storage.updateSession(session: session, state: .background, cleanExit: true)
+
+        // then it is returned updated
+        let updated = try XCTUnwrap(storage.fetchLatestSession())
+        XCTAssertEqual(updated.idRaw, TestConstants.sessionId.stringValue)
+        XCTAssertEqual(updated.state, SessionState.background.rawValue)
+        XCTAssertTrue(updated.cleanExit)
+        XCTAssertEqual(storage.fetchAllSessions().count, 2)
+        XCTAssertNotEqual(storage.fetchOldestSession()?.idRaw, TestConstants.sessionId.stringValue)
+
+        // when deleting it
+        storage.deleteSession(id: TestConstants.sessionId)
+
+        // then it is gone
+        XCTAssertNil(storage.fetchSession(id: TestConstants.sessionId))
+    }
+
+    func test_logs() throws {
+        // given logs from the current and a previous process
+        let oldProcess = EmbraceIdentifier.random
+        storage.createLog(
+            id: .random, processId: oldProcess, severity: .info, body: "old", timestamp: Date(),
+            attributes: [LogSemantics.keySessionId: .string("session"), "count": .int(2)])
+        storage.createLog(
+            id: .random, processId: ProcessIdentifier.current, severity: .info, body: "current",
+            timestamp: Date(), attributes: [:])
+
+        // then only the previous process' logs are fetched
+        let logs = storage.fetchAll(excludingProcessIdentifier: ProcessIdentifier.current)
+        XCTAssertEqual(logs.map(\.body), ["old"])
+        XCTAssertEqual(logs.first?.attribute(forKey: "count")?.value, .int(2))
+
+        // when removing them
+        storage.remove(logs: logs)
+
+        // then they are gone
+        XCTAssertTrue(storage.fetchAll(excludingProcessIdentifier: ProcessIdentifier.current).isEmpty)
+        storage.removeAllLogs()
+        XCTAssertEqual(try storage.sqlite?.logCount(), 0)
+    }
+}
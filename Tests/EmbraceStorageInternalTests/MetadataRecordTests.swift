@@ -1232,4 +1232,85 @@ class MetadataRecordTests: XCTestCase {
         XCTAssertNil(resources.first(where: { $0.key == "test6" }))
         XCTAssertNotNil(resources.first(where: { $0.key == "test7" }))
     }
+
+    func test_metadataSnapshots_matchStoreQueries() throws {
+        let sessionId = TestConstants.sessionId.stringValue
+        let processId = TestConstants.processId.stringValue
+        let otherSessionId = "other-session"
+
+        // given metadata of every lifespan, read once so the snapshots are built
+        storage.addMetadata(key: "permanent", value: "1", type: .resource, lifespan: .permanent)
+        storage.addMetadata(key: "process", value: "1", type: .customProperty, lifespan: .process, lifespanId: processId)
+        storage.addMetadata(key: "session", value: "1", type: .personaTag, lifespan: .session, lifespanId: sessionId)
+        storage.addMetadata(key: "other", value: "1", type: .resource, lifespan: .session, lifespanId: otherSessionId)
+        assertSnapshotsMatchStore(sessionIds: [sessionId, otherSessionId], processId: processId)
+
+        // when metadata is added, updated and removed afterwards
+        storage.addMetadata(key: "permanent", value: "2", type: .resource, lifespan: .permanent)
+        storage.addMetadata(key: "session2", value: "1", type: .customProperty, lifespan: .session, lifespanId: sessionId)
+        storage.addMetadata(key: "process2", value: "1", type: .personaTag, lifespan: .process, lifespanId: "other-process")
+        storage.addCriticalResources(["critical": "1"], processId: TestConstants.processId)
+        _ = storage.incrementCountForPermanentResource(key: "counter")
+        _ = storage.incrementCountForPermanentResource(key: "counter")
+        storage.removeMetadata(key: "session", type: .personaTag, lifespan: .session, lifespanId: sessionId)
+
+        // then the snapshots still match what the store returns
+        assertSnapshotsMatchStore(sessionIds: [sessionId, otherSessionId], processId: processId)
+
+        // when removing in bulk
+        storage.removeAllMetadata(type: .customProperty, lifespans: [.session])
+        storage.removeAllMetadata(keys: ["other", "critical"], lifespan: .session)
+
+        // then the snapshots still match
+        assertSnapshotsMatchStore(sessionIds: [sessionId, otherSessionId], processId: processId)
+        let resources = storage.fetchResources(sessionId: sessionId, processId: processId)
+        XCTAssertNotNil(resources.first(where: { $0.key == "critical" }))
+        XCTAssertEqual(resources.first(where: { $0.key == "permanent" })?.value, "2")
+        XCTAssertEqual(resources.first(where: { $0.key == "counter" })?.value, "2")
+    }
+}
+
+extension MetadataRecordTests {
+
+    private struct Entry: Hashable {
+        let key: String
+        let value: String
+        let typeRaw: String
+        let lifespanRaw: String
+        let lifespanId: String
+
+        init(_ metadata: EmbraceMetadata) {
+            key = metadata.key
+            value = metadata.value
+            typeRaw = metadata.typeRaw
+            lifespanRaw = metadata.lifespanRaw
+            lifespanId = metadata.lifespanId
+        }
+    }
+
+    private func assertSnapshotsMatchStore(
+        sessionIds: [String],
+        processId: String,
+        file: StaticString = #filePath,
+        line: UInt = #line
+    ) {
+        for sessionId in sessionIds {
+            let snapshot =
+                storage.fetchResources(sessionId: sessionId, processId: processId)
+                + storage.fetchCustomProperties(sessionId: sessionId, processId: processId)
+                + storage.fetchPersonaTags(sessionId: sessionId, processId: processId)
+            let stored = storage.queryMetadata(sessionId: sessionId, processId: processId)
+
+            XCTAssertEqual(snapshot.count, stored.count, file: file, line: line)
+            XCTAssertEqual(Set(snapshot.map(Entry.init)), Set(stored.map(Entry.init)), file: file, line: line)
+        }
+
+        let processSnapshot =
+            storage.fetchResourcesForProcessId(TestConstants.processId)
+            + storage.fetchPersonaTagsForProcessId(TestConstants.processId)
+        let processStored = storage.queryMetadata(sessionId: nil, processId: processId)
+            .filter { $0.type != .customProperty }
+
+        XCTAssertEqual(Set(processSnapshot.map(Entry.init)), Set(processStored.map(Entry.init)), file: file, line: line)
+    }
 }
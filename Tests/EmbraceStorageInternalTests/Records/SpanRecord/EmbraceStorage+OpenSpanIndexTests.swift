@@ -0,0 +1,127 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import EmbraceCommonInternal
+import OpenTelemetryApi
+import TestSupport
+import XCTest
+
+@testable import EmbraceStorageInternal
+
+final class EmbraceStorage_OpenSpanIndexTests: XCTestCase {
+
+    var storage: EmbraceStorage!
+
+    override func setUpWithError() throws {
+        storage = try EmbraceStorage.createInMemoryDb()
+    }
+
+    override func tearDownWithError() throws {
+        storage.coreData.destroy()
+        storage = nil
+    }
+
+    func test_openSpan_isIndexedAndUpdatedInPlace() throws {
+        let id = SpanId.random().hexString
+        let traceId = TraceId.random().hexString
+        let startTime = Date()
+
+        // given an open span
+        storage.upsertSpan(id: id, name: "a", traceId: traceId, type: .performance, data: Data(), startTime: startTime)
+        XCTAssertEqual(storage.openSpans.openSpanCount, 1)
+
+        // when updating it
+        storage.upsertSpan(id: id, name: "b", traceId: traceId, type: .performance, data: Data(), startTime: startTime)
+
+        // then the same record is updated
+        let records: [SpanRecord] = storage.fetchAll()
+        XCTAssertEqual(records.count, 1)
+        XCTAssertEqual(records.first?.name, "b")
+        XCTAssertEqual(storage.openSpans.openSpanCount, 1)
+    }
+
+    func test_endingSpan_evictsItFromTheIndex() throws {
+        let id = SpanId.random().hexString
+        let traceId = TraceId.random().hexString
+        let startTime = Date()
+
+        // given an open span
+        storage.upsertSpan(id: id, name: "a", traceId: traceId, type: .performance, data: Data(), startTime: startTime)
+
+        // when it ends
+        storage.upsertSpan(
+            id: id, name: "a", traceId: traceId, type: .performance, data: Data(), startTime: startTime,
+            endTime: startTime.addingTimeInterval(1))
+
+        // then it's no longer indexed and can't be modified
+        XCTAssertEqual(storage.openSpans.openSpanCount, 0)
+        storage.upsertSpan(id: id, name: "c", traceId: traceId, type: .performance, data: Data(), startTime: startTime)
+        XCTAssertEqual(storage.fetchSpan(id: id, traceId: traceId)?.name, "a")
+    }
+
+    func test_endSpan_evictsItFromTheIndex() throws {
+        let id = SpanId.random().hexString
+        let traceId = TraceId.random().hexString
+
+        storage.upsertSpan(id: id, name: "a", traceId: traceId, type: .session, data: Data(), startTime: Date())
+        storage.endSpan(id: id, traceId: traceId, endTime: Date())
+
+        wait(timeout: 2) {
+            self.storage.openSpans.openSpanCount == 0
+        }
+        XCTAssertNotNil(storage.fetchSpan(id: id, traceId: traceId)?.endTime)
+    }
+
+    func test_addEventsToIndexedSpan() throws {
+        struct TestEvent: EmbraceSpanEvent {
+            let name: String
+            let timestamp: Date
+            let attributes: [String: String]
+        }
+
+        let id = SpanId.random().hexString
+        let traceId = TraceId.random().hexString
+        storage.upsertSpan(id: id, name: "a", traceId: traceId, type: .performance, data: Data(), startTime: Date())
+
+        storage.addEventsToSpan(
+            id: id, traceId: traceId, events: [TestEvent(name: "event", timestamp: Date(), attributes: [:])])
+
+        XCTAssertEqual(storage.fetchSpan(id: id, traceId: traceId)?.events.count, 1)
+    }
+
+    func test_typeCounter_isSeededOnceAndTracksInsertsAndLimitDeletes() throws {
+        storage.options.spanLimits[.performance] = 2
+
+        for i in 0..<4 {
+            storage.upsertSpan(
+                id: SpanId.random().hexString,
+                name: "\(i)",
+                traceId: TraceId.random().hexString,
+                type: .performance,
+                data: Data(),
+                startTime: Date().addingTimeInterval(Double(i))
+            )
+        }
+
+        // then the counter matches the store without being recounted
+        let request = SpanRecord.createFetchRequest()
+        request.predicate = NSPredicate(format: "typeRaw BEGINSWITH %@", SpanType.performance.rawValue)
+        XCTAssertEqual(storage.coreData.count(withRequest: request), 2)
+        XCTAssertEqual(storage.openSpans.count(forType: SpanType.performance.rawValue), 2)
+
+        // and spans removed by the limit left the index
+        XCTAssertEqual(storage.openSpans.openSpanCount, 2)
+    }
+
+    func test_bulkCleanup_invalidatesCounters() throws {
+        storage.upsertSpan(
+            id: SpanId.random().hexString, name: "a", traceId: TraceId.random().hexString, type: .performance,
+            data: Data(), startTime: Date(), endTime: Date())
+        XCTAssertNotNil(storage.openSpans.count(forType: SpanType.performance.rawValue))
+
+        storage.cleanUpSpans(date: Date().addingTimeInterval(10))
+
+        XCTAssertNil(storage.openSpans.count(forType: SpanType.performance.rawValue))
+    }
+}
@@ -56,6 +56,31 @@ class SessionRecordTests: XCTestCase {
         XCTAssertEqual(session?.sessionNumber, 3)
     }
 
+    func test_sessionRecords_areCommittedRightAway() throws {
+        // given a storage that coalesces commits
+        XCTAssertEqual(storage.options.commitPolicy, .default)
+
+        // when adding a session
+        let session = storage.addSession(
+            id: TestConstants.sessionId,
+            processId: ProcessIdentifier.current,
+            state: .foreground,
+            traceId: TestConstants.traceId,
+            spanId: TestConstants.spanId,
+            startTime: Date()
+        )
+
+        // then it's saved without waiting for the commit window
+        wait(timeout: .defaultTimeout) { self.storage.coreData.saveCount == 1 }
+
+        // when ending it
+        storage.updateSession(session: session!, endTime: Date(), cleanExit: true)
+
+        // then the change is saved too
+        wait(timeout: .defaultTimeout) { self.storage.coreData.saveCount == 2 }
+        XCTAssertFalse(storage.coreData.performOperation { $0.hasChanges })
+    }
+
     func test_fetchSession() throws {
         // given inserted session
         let sessionId = EmbraceIdentifier.random
@@ -0,0 +1,115 @@
+//
+//  Copyright © 2026 Embrace Mobile, Inc. All rights reserved.
+//
+
+import EmbraceCommonInternal
+import EmbraceOTelInternal
+import EmbraceSQLiteInternal
+import TestSupport
+import XCTest
+
+@testable import EmbraceUploadInternal
+
+class EmbraceUploadCacheSQLiteTests: XCTestCase {
+    let logger = MockLogger()
+    let fileProvider = TemporaryFilepathProvider()
+
+    override func setUpWithError() throws {
+        EmbraceOTel.setup(spanProcessors: [MockSpanProcessor()])
+    }
+
+    func createCache(cacheLimit: UInt = 0, cacheDaysLimit: UInt = 7) throws -> EmbraceUploadCache {
+        let options = EmbraceUpload.CacheOptions(
+            storageMechanism: .inMemory(name: testName),
+            enableBackgroundTasks: false,
+            cacheLimit: cacheLimit,
+            cacheDaysLimit: cacheDaysLimit,
+            engine: .sqlite
+        )
+        return try EmbraceUploadCache(options: options, logger: logger)
+    }
+
+    func test_saveFetchAndDelete() throws {
+        let cache = try createCache()
+        XCTAssertNotNil(cache.sqlite)
+
+        // given saved upload data
+        XCTAssertTrue(cache.saveUploadData(id: "a", type: .spans, data: Data("a".utf8), payloadTypes: "spans"))
+        XCTAssertTrue(cache.saveUploadData(id: "b", type: .spans, data: Data("b".utf8)))
+        XCTAssertTrue(cache.saveUploadData(id: "c", type: .log, data: Data("c".utf8)))
+
+        // then it can be fetched by type, skipping in-flight ids
+        let spans = cache.fetchUploadData(type: .spans, excludingIDs: ["a"], limit: 10)
+        XCTAssertEqual(spans.map(\.id), ["b"])
+        XCTAssertEqual(cache.fetchAllUploadData().count, 3)
+
+        // when deleting one
+        cache.deleteUploadData(id: "b", type: .spans)
+
+        // then it is gone
+        XCTAssertTrue(cache.fetchUploadData(type: .spans, excludingIDs: ["a"], limit: 10).isEmpty)
+    }
+
+    func test_fetchUploadData_readsFromStore() throws {
+        let cache = try createCache()
+
+        // given saved upload data
+        cache.saveUploadData(id: "a", type: .spans, data: Data("a".utf8), payloadTypes: "spans")
+
+        // when fetching it by id
+        let record = try XCTUnwrap(cache.fetchUploadData(id: "a", type: .spans))
+
+        // then it comes from the SQLite store
+        XCTAssertEqual(record.data, Data("a".utf8))
+        XCTAssertEqual(record.payloadTypes, "spans")
+        XCTAssertNil(cache.fetchUploadData(id: "a", type: .log))
+        XCTAssertEqual(cache.coreData.fetch(withRequest: cache.fetchUploadDataRequest(id: "a", type: .spans)).count, 0)
+    }
+
+    func test_countLimit() throws {
+        let cache = try createCache(cacheLimit: 20)
+
+        for i in 0..<25 {
+            cache.saveUploadData(id: "\(i)", type: .spans, data: Data())
+        }
+
+        XCTAssertLessThanOrEqual(cache.fetchAllUploadData().count, 20)
+        XCTAssertNotNil(cache.fetchAllUploadData().first(where: { $0.id == "24" }))
+    }
+
+    func test_clearStaleData() throws {
+        let cache = try createCache(cacheDaysLimit: 1)
+
+        // given old and recent entries
+        try cache.sqlite?.saveUploadData(
+            SQLiteUploadDataRow(id: "old", type: EmbraceUploadType.spans.rawValue, data: Data(), date: Date(timeIntervalSinceNow: -3 * 86400)))
+        cache.saveUploadData(id: "new", type: .spans, data: Data())
+
+        // when clearing stale data
+        let removed = cache.clearStaleDataIfNeeded()
+
+        // then only the old entry is removed
+        XCTAssertEqual(removed, 1)
+        XCTAssertEqual(cache.fetchAllUploadData().map(\.id), ["new"])
+    }
+
+    func test_resetCache_removesDatabaseFiles() throws {
+        try FileManager.default.createDirectory(at: fileProvider.tmpDirectory, withIntermediateDirectories: true)
+
+        // given a cache with data on disk
+        let storageMechanism: StorageMechanism = .onDisk(
+            name: testName, baseURL: fileProvider.tmpDirectory, journalMode: .wal)
+        var options = EmbraceUpload.CacheOptions(storageMechanism: storageMechanism, enableBackgroundTasks: false, engine: .sqlite)
+        var cache: EmbraceUploadCache? = try EmbraceUploadCache(options: options, logger: logger)
+        cache?.saveUploadData(id: "a", type: .spans, data: Data())
+        cache = nil
+
+        // when creating it again with the reset flag
+        options = EmbraceUpload.CacheOptions(
+            storageMechanism: storageMechanism, enableBackgroundTasks: false, resetCache: true, engine: .sqlite)
+        cache = try EmbraceUploadCache(options: options, logger: logger)
+
+        // then the previous data is gone
+        XCTAssertEqual(cache?.fetchAllUploadData().count, 0)
+    }
+}
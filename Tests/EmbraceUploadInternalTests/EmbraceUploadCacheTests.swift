@@ -51,7 +51,7 @@ class EmbraceUploadCacheTests: XCTestCase {
         let cache = try EmbraceUploadCache(options: options, logger: logger)
 
         // given inserted upload data
-        let original = UploadDataRecord.create(
+        _ = UploadDataRecord.create(
             context: cache.coreData.context,
             id: "id",
             type: EmbraceUploadType.spans.rawValue,
@@ -66,8 +66,10 @@ class EmbraceUploadCacheTests: XCTestCase {
         let uploadData = cache.fetchUploadData(id: "id", type: .spans)
 
         // then the upload data should be valid
-        XCTAssertNotNil(uploadData)
-        XCTAssertEqual(original, uploadData)
+        let record = try XCTUnwrap(uploadData)
+        XCTAssertEqual(record.id, "id")
+        XCTAssertEqual(record.type, EmbraceUploadType.spans.rawValue)
+        XCTAssertEqual(record.payloadTypes, "test")
     }
 
     func test_fetchAllUploadData() throws {
@@ -168,6 +170,24 @@ class EmbraceUploadCacheTests: XCTestCase {
         wait(for: [expectation], timeout: .defaultTimeout)
     }
 
+    func test_saveUploadData_limit_tracksDeletions() throws {
+        // given a full cache with a limit of 3
+        let options = EmbraceUpload.CacheOptions(
+            storageMechanism: .inMemory(name: testName), enableBackgroundTasks: false, cacheLimit: 3)
+        let cache = try EmbraceUploadCache(options: options, logger: logger)
+
+        _ = cache.saveUploadData(id: "id1", type: .spans, data: Data())
+        _ = cache.saveUploadData(id: "id2", type: .spans, data: Data())
+        _ = cache.saveUploadData(id: "id3", type: .spans, data: Data())
+
+        // when deleting one entry and saving a new one
+        cache.deleteUploadData(id: "id2", type: .spans)
+        _ = cache.saveUploadData(id: "id4", type: .spans, data: Data())
+
+        // then nothing is evicted
+        XCTAssertEqual(Set(cache.fetchAllUploadData().map(\.id)), ["id1", "id3", "id4"])
+    }
+
     func test_deleteUploadData() throws {
         let options = EmbraceUpload.CacheOptions(
             storageMechanism: .inMemory(name: testName), enableBackgroundTasks: false)
@@ -202,6 +202,55 @@ class EmbraceUploadTests: XCTestCase {
         listener.onDeletedObjects = nil
     }
 
+    func test_deliveryCompletion_success() throws {
+        try XCTSkipIf(XCTestCase.isWatchOS())
+
+        EmbraceHTTPMock.mock(url: testSpansUrl())
+
+        // when uploading data
+        let expectation = XCTestExpectation()
+        module.uploadSpans(
+            id: "id",
+            data: TestConstants.data,
+            completion: nil,
+            deliveryCompletion: { delivered in
+                // then delivery is reported once the request succeeds
+                XCTAssertTrue(delivered)
+                XCTAssertEqual(EmbraceHTTPMock.requestsForUrl(self.testSpansUrl()).count, 1)
+                expectation.fulfill()
+            }
+        )
+
+        wait(for: [expectation], timeout: .veryLongTimeout)
+    }
+
+    func test_deliveryCompletion_failureAfterCaching() throws {
+        try XCTSkipIf(XCTestCase.isWatchOS())
+
+        EmbraceHTTPMock.mock(url: testSpansUrl(), errorCode: 500)
+
+        // when uploading data that's cached, but fails to upload
+        let cached = XCTestExpectation(description: "Data should be cached")
+        let delivery = XCTestExpectation(description: "Delivery should fail")
+        module.uploadSpans(
+            id: "id",
+            data: TestConstants.data,
+            completion: { result in
+                if case .success = result {
+                    cached.fulfill()
+                }
+            },
+            deliveryCompletion: { delivered in
+                // then it's reported as not delivered
+                XCTAssertFalse(delivered)
+                delivery.fulfill()
+            }
+        )
+
+        wait(for: [cached, delivery], timeout: .veryLongTimeout, enforceOrder: true)
+        XCTAssertTrue(module.cache.fetchAllUploadData().isEmpty)
+    }
+
     func test_retryCachedData() throws {
         try XCTSkipIf(XCTestCase.isWatchOS())
 
@@ -48,6 +48,10 @@ public class EditableConfig: EmbraceConfigurable {
 
     public var traceparentInjectionEnabled: Bool = false
 
+    public var isSpanSnapshotDiffingEnabled: Bool = false
+
+    public var isMemoryBudgetEnabled: Bool = false
+
     public func update(completion: (Bool, (any Error)?) -> Void) {
         completion(false, nil)
     }
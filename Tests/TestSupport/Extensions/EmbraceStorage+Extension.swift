@@ -8,9 +8,12 @@ import Foundation
 @testable import EmbraceStorageInternal
 
 extension EmbraceStorage {
-    public static func createInMemoryDb() throws -> EmbraceStorage {
+    public static func createInMemoryDb(engine: StorageEngine = .coreData) throws -> EmbraceStorage {
+        let options = EmbraceStorage.Options(storageMechanism: .inMemory(name: UUID().uuidString), enableBackgroundTasks: false)
+        options.engine = engine
+
         let storage = try EmbraceStorage(
-            options: .init(storageMechanism: .inMemory(name: UUID().uuidString), enableBackgroundTasks: false),
+            options: options,
             logger: MockLogger()
         )
         return storage
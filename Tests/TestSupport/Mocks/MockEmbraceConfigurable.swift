@@ -313,6 +313,10 @@ public class MockEmbraceConfigurable: EmbraceConfigurable {
 
     public var traceparentInjectionEnabled: Bool = false
 
+    public var isSpanSnapshotDiffingEnabled: Bool = false
+
+    public var isMemoryBudgetEnabled: Bool = false
+
     public var updateCallCount = 0
     public var updateCompletionParamDidUpdate: Bool
     public var updateCompletionParamError: Error?